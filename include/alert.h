@@ -0,0 +1,119 @@
+/**
+ * Alert Module Header
+ *
+ * Drives alert outputs (LED, buzzer, relay) straight from the analysis
+ * stage. The main loop analyzes every packet waiting in the event stream
+ * and feeds it here before it logs, prints or draws any of them, and
+ * repaints the display once per pass, so an alert waits for neither.
+ *
+ * Each emitter (track key) runs a small state machine so one noisy packet
+ * cannot raise an alert and a short fade cannot drop one:
+ *   IDLE     -> ARMING     first drone packet at ALERT_MIN_CONFIDENCE
+ *   ARMING   -> CONFIRMED  ALERT_CONFIRM_PACKETS drone packets within
+ *                          ALERT_CONFIRM_WINDOW_MS, or one packet at
+ *                          ALERT_INSTANT_CONFIDENCE (decoded/fingerprinted)
+ *   ARMING   -> IDLE       confirm window expires
+ *   CONFIRMED -> CLEARING  no drone packet for ALERT_CLEAR_MS
+ *   CLEARING -> CONFIRMED  drone packet again
+ *   CLEARING -> IDLE       still quiet after ALERT_HOLD_MS
+ * The LED and relay are on while any emitter is CONFIRMED or CLEARING;
+ * the buzzer sounds for ALERT_BUZZER_MS at each new confirmation.
+ *
+ * The time from the packet's DIO1 interrupt to the output edge is
+ * measured for every confirmation and checked against
+ * ALERT_LATENCY_BUDGET_US; the budget is measured, not enforced.
+ * Transitions are printed afterwards as
+ *   ALERT,<state>,<key hex>,<type>,<MHz>,<confidence>,<latency us>
+ * Output pins come from build flags (ALERT_LED_PIN, ALERT_BUZZER_PIN,
+ * ALERT_RELAY_PIN); without any the state machine still runs and reports.
+ */
+
+#ifndef ALERT_H
+#define ALERT_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Alert Configuration
+// ============================================================================
+
+#define ALERT_TRACKS                8         // Emitters followed at once
+#define ALERT_MIN_CONFIDENCE        50        // Confidence for a packet to count (%)
+#define ALERT_INSTANT_CONFIDENCE    90        // Confidence that confirms at once (%)
+#define ALERT_CONFIRM_PACKETS       3         // Packets needed to confirm
+#define ALERT_CONFIRM_WINDOW_MS     3000      // Time allowed to collect them
+#define ALERT_CLEAR_MS              3000      // Quiet time before clearing starts
+#define ALERT_HOLD_MS               5000      // Further quiet time before the alert ends
+#define ALERT_BUZZER_MS             500       // Buzzer pulse per confirmation
+#define ALERT_ACTIVE_LEVEL          HIGH      // Output level while alerting
+#define ALERT_LATENCY_BUDGET_US     100000    // Packet to output edge budget
+
+/**
+ * Alert state of one emitter
+ */
+typedef enum {
+    ALERT_IDLE,
+    ALERT_ARMING,
+    ALERT_CONFIRMED,
+    ALERT_CLEARING
+} AlertState;
+
+/**
+ * Alert statistics
+ */
+typedef struct {
+    uint32_t confirmed;         // Confirmations (output edges)
+    uint32_t suppressed;        // Arming emitters that never confirmed
+    uint32_t cleared;           // Alerts ended
+    uint8_t alerting;           // Emitters confirmed or clearing now
+    float latencyMeanUs;        // EWMA of packet to output edge
+    uint32_t latencyMaxUs;      // Worst packet to output edge
+    uint32_t overBudget;        // Confirmations slower than the budget
+} AlertStats;
+
+// ============================================================================
+// Alert Functions
+// ============================================================================
+
+/**
+ * Configure the output pins (all off)
+ */
+void alertInit();
+
+/**
+ * Feed an analyzed packet to its emitter's state machine (main loop)
+ * Call directly after analysis; drives the outputs before returning.
+ * @param signal Analyzed packet
+ * @param key Emitter identity key (trackKeyForSignal())
+ * @param isDrone Analysis result
+ * @param timestampUs DIO1 interrupt time of the packet (micros)
+ */
+void alertObserve(const DroneSignal* signal, uint32_t key, bool isDrone, uint32_t timestampUs);
+
+/**
+ * Advance timeouts (clearing, arming expiry, buzzer pulse)
+ * Call regularly from the main loop
+ */
+void alertService();
+
+/**
+ * Check whether any emitter is alerting
+ * @return true while the alert outputs are on
+ */
+bool alertActive();
+
+/**
+ * Get a state name
+ * @param state Alert state
+ * @return Name string
+ */
+const char* alertStateName(AlertState state);
+
+/**
+ * Get alert statistics
+ * @param stats Output statistics
+ */
+void alertGetStats(AlertStats* stats);
+
+#endif // ALERT_H
@@ -0,0 +1,120 @@
+/**
+ * Arena Module Header
+ *
+ * Static memory for heap-free steady-state operation. Every long-lived
+ * runtime object is carved at boot from one of two bump arenas and never
+ * freed, so the general heap is not touched after initialisation:
+ *
+ *   Internal RAM (hot: touched per packet or from interrupts)
+ *     scanner event queue and its packet buffers, scanner and log writer
+ *     task stacks. Track, cluster and noise floor tables, the main loop's
+ *     event batch and the log's flash page and sector buffers stay static
+ *     (.bss) for the same reason.
+ *   PSRAM (cold: touched per detection, per sector or per second)
+ *     detection log record queue and sector index, mesh report frame
+ *     queue, localizer grids, coverage ledger epochs, capture export
+ *     blocks, occupancy history, traffic sketches.
+ *
+ * Without PSRAM the second arena comes from internal RAM if that much is
+ * free; otherwise its blocks fall back to the heap one by one, and the
+ * largest (occupancy history) may not fit at all. The display draws
+ * directly to the panel and needs no sprite memory.
+ *
+ * arenaSeal() marks the end of initialisation. From then on the heap guard
+ * flags heap allocations: exactly, through the heap allocation hook when
+ * the IDF is built with CONFIG_HEAP_USE_HOOKS, otherwise by watching the
+ * heap's allocated block count. NVS writes (Preferences) allocate briefly
+ * inside the IDF and show up as short-lived allocations.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// Arena Configuration
+// ============================================================================
+
+#define ARENA_ENABLED               true      // Carve runtime objects from arenas
+#define ARENA_INTERNAL_BYTES        (24 * 1024)   // Internal RAM arena (two radios)
+#define ARENA_PSRAM_BYTES           (352 * 1024)  // PSRAM arena
+#define ARENA_ALIGN                 8         // Alignment of every arena block
+#define ARENA_GUARD_CHECK_MS        1000      // Heap block count check interval
+
+/**
+ * Memory an arena block is placed in
+ */
+typedef enum {
+    ARENA_INTERNAL,             // Internal SRAM: hot, DMA and interrupt safe
+    ARENA_PSRAM                 // External PSRAM: large, cold
+} ArenaRegion;
+
+/**
+ * Memory telemetry
+ */
+typedef struct {
+    uint32_t internalUsed;      // Internal arena bytes handed out (high-watermark)
+    uint32_t internalSize;
+    uint32_t psramUsed;         // PSRAM arena bytes handed out (high-watermark)
+    uint32_t psramSize;
+    bool psramArenaExternal;    // PSRAM arena really is in PSRAM
+    uint32_t arenaFailures;     // Requests that did not fit (served from the heap)
+    uint32_t heapFree;          // Internal heap free bytes
+    uint32_t heapMinFree;       // Internal heap low-watermark
+    uint32_t heapLargestBlock;  // Largest internal block (fragmentation)
+    uint32_t psramFree;         // PSRAM heap free bytes (0 without PSRAM)
+    uint32_t psramMinFree;      // PSRAM heap low-watermark
+    uint32_t psramTotal;        // PSRAM heap size
+    bool sealed;                // Initialisation finished, guard armed
+    uint32_t allocationsAfterSeal;  // Heap allocations seen after sealing
+    int32_t blocksSinceSeal;    // Change of allocated heap blocks since sealing
+    uint32_t blocksPeakSinceSeal;   // Highest increase seen
+    uint32_t failedAllocations; // Heap allocations that failed
+} ArenaStats;
+
+// ============================================================================
+// Arena Functions
+// ============================================================================
+
+/**
+ * Reserve the arenas (call first in setup())
+ */
+void arenaInit();
+
+/**
+ * Carve a zeroed block from an arena (main loop and setup() only)
+ * Falls back to the heap, counted in arenaFailures, if the arena is full
+ * @param region Memory the block belongs in
+ * @param size Bytes
+ * @param owner Name reported if the block does not fit
+ * @return Block, or NULL if no memory is available
+ */
+void* arenaAlloc(ArenaRegion region, size_t size, const char* owner);
+
+/**
+ * End of initialisation: print arena usage and arm the heap guard
+ */
+void arenaSeal();
+
+/**
+ * Check the heap for allocations since sealing
+ * Call regularly from the main loop
+ */
+void arenaService();
+
+/**
+ * Print one "MEM," telemetry line:
+ * MEM,<heap free>,<heap min free>,<largest block>,<psram free>,<psram min free>,
+ * <internal arena used>,<internal arena size>,<psram arena used>,<psram arena size>,
+ * <allocations after seal>,<heap blocks since seal>
+ */
+void arenaReport();
+
+/**
+ * Get memory telemetry
+ * @param stats Output statistics
+ */
+void arenaGetStats(ArenaStats* stats);
+
+#endif // ARENA_H
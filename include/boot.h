@@ -0,0 +1,113 @@
+/**
+ * Boot Module Header
+ *
+ * Fast boot support: boot phase timing and warm-start scan state.
+ *
+ * setup() arms the radios before anything else and leaves the display,
+ * detection log and GPS to the main loop, so the node is listening within
+ * tens of milliseconds of reset. Each step marks its boot phase here and
+ * the phase times are reported once initialisation completes. Times are
+ * measured from the start of the esp_timer counter, which starts just
+ * before setup() (ROM and bootloader time is not included).
+ *
+ * So the scanners resume where they left off instead of at the band start,
+ * each scanner's sweep position and modulation and the most active
+ * ("hot") channels are kept in a snapshot:
+ * - In RTC memory, rewritten every BOOT_SNAPSHOT_MS. It survives software
+ *   resets, panics, watchdog resets and deep sleep.
+ * - In NVS, every BOOT_NVS_SAVE_MS, for restores after power loss.
+ * Hot channels are queued ahead of the sweep so they are checked first.
+ * Noise floors follow the same scheme in the noise floor module.
+ */
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Boot Configuration
+// ============================================================================
+
+#define BOOT_SERIAL_WAIT_MS         0         // Wait for a USB host before logging (0 = never)
+#define BOOT_CHANNELS               64        // Max sweep channels tracked for activity
+#define BOOT_HOT_CHANNELS           8         // Hot channels saved and revisited first
+#define BOOT_HOT_HALF_LIFE_MS       600000UL  // Channel activity half-life (10 minutes)
+#define BOOT_SNAPSHOT_MS            1000UL    // RTC snapshot interval
+#define BOOT_NVS_SAVE_MS            900000UL  // NVS snapshot interval (15 minutes)
+
+/**
+ * Boot phases, in the order they normally complete
+ */
+typedef enum {
+    BOOT_PHASE_RADIO,           // Radio configured
+    BOOT_PHASE_RX,              // Scanner tasks receiving
+    BOOT_PHASE_STATE,           // Scan state and noise floors restored
+    BOOT_PHASE_DISPLAY,         // Display initialised (deferred)
+    BOOT_PHASE_LOG,             // Detection log recovered (deferred)
+    BOOT_PHASE_GPS,             // GPS receiver started (deferred)
+    BOOT_PHASE_READY,           // All initialisation complete
+    BOOT_PHASE_COUNT
+} BootPhase;
+
+/**
+ * Where the warm-start snapshot came from
+ */
+typedef enum {
+    BOOT_SOURCE_NONE,           // Cold start
+    BOOT_SOURCE_RTC,            // RTC memory (reset without power loss)
+    BOOT_SOURCE_NVS             // NVS (after power loss)
+} BootSource;
+
+// ============================================================================
+// Boot Functions
+// ============================================================================
+
+/**
+ * Record the completion time of a boot phase (first call per phase counts)
+ * @param phase Boot phase
+ */
+void bootMark(BootPhase phase);
+
+/**
+ * Get the completion time of a boot phase
+ * @param phase Boot phase
+ * @return Microseconds since the counter started, or 0 if not reached
+ */
+uint32_t bootPhaseUs(BootPhase phase);
+
+/**
+ * Print the boot phase times and warm-start source as one "[Boot]" line
+ */
+void bootReport();
+
+/**
+ * Load the warm-start snapshot from RTC memory, or NVS after power loss
+ * @return Source of the snapshot
+ */
+BootSource bootRestore();
+
+/**
+ * Move a scanner to its saved position, queue its hot channels, and
+ * include it in future snapshots
+ * Call after the scanner's sub-band is final and before its task starts
+ * @param scanner Initialized scanner
+ * @return true if saved state was applied
+ */
+bool bootResumeScanner(DroneScanner* scanner);
+
+/**
+ * Count a packet towards its channel's activity
+ * @param channel Sweep channel index
+ */
+void bootNotePacket(int channel);
+
+/**
+ * Snapshot scan state to RTC memory and NVS when their intervals elapse
+ * Call regularly from the main loop
+ * @param force Write both copies now
+ */
+void bootService(bool force);
+
+#endif // BOOT_H
@@ -0,0 +1,90 @@
+/**
+ * Change Channel Module Header
+ *
+ * The change-point detector of one channel as plain functions on a state
+ * struct. It has no Arduino dependencies, so the native unit tests replay
+ * the dwell trace of tools/change_sim.py through it; src/change_detect.cpp
+ * runs one per sweep channel.
+ *
+ * Each channel learns its background busy rate and excess mean and
+ * spread, and runs two one-sided sequential tests in fixed memory with
+ * O(1) work per dwell:
+ *   - a CUSUM of the Bernoulli log-likelihood ratio of the busy rate
+ *     against the background rate + CHANGE_BUSY_SHIFT
+ *   - a Page-Hinkley sum of the excess in spreads above the background,
+ *     less CHANGE_RSSI_DRIFT, each dwell clipped to CHANGE_RSSI_CLIP so one
+ *     strong burst cannot raise it alone
+ * A test crossing its threshold marks a new persistent emitter. The
+ * emitter ends after CHANGE_CLEAR_DWELLS background dwells, or becomes the
+ * new background after CHANGE_ABSORB_DWELLS. Background learning pauses
+ * while a test is above half its threshold.
+ */
+
+#ifndef CHANGE_CHANNEL_H
+#define CHANGE_CHANNEL_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Change Channel Configuration
+// ============================================================================
+
+#define CHANGE_LEARN_DWELLS         32        // Dwells before a channel is armed
+#define CHANGE_BACKGROUND_ALPHA     0.02f     // EWMA weight of a background dwell
+#define CHANGE_BUSY_MIN             0.01f     // Lowest background busy rate assumed
+#define CHANGE_BUSY_MAX             0.5f      // Highest background busy rate tested
+#define CHANGE_BUSY_SHIFT           0.3f      // Busy rate increase tested for
+#define CHANGE_BUSY_THRESHOLD       10.0f     // CUSUM alarm threshold (nats)
+#define CHANGE_RSSI_DRIFT           1.0f      // Page-Hinkley allowance (spreads per dwell)
+#define CHANGE_RSSI_CLIP            3.0f      // Largest excess counted per dwell (spreads)
+#define CHANGE_RSSI_THRESHOLD       12.0f     // Page-Hinkley alarm threshold (spreads)
+#define CHANGE_SPREAD_MIN_DB        1.0f      // Smallest excess spread assumed
+#define CHANGE_CLEAR_DWELLS         16        // Background dwells that end an emitter
+#define CHANGE_ABSORB_DWELLS        1000      // Dwells after which an emitter is background
+
+/**
+ * Result of one dwell update
+ */
+typedef enum {
+    CHANGE_STEP_NONE,           // No change
+    CHANGE_STEP_ONSET,          // New persistent emitter
+    CHANGE_STEP_QUIET,          // Emitter ended, channel back to background
+    CHANGE_STEP_ABSORBED        // Emitter persisted and became the background
+} ChangeStep;
+
+/**
+ * Detector state of one channel
+ */
+typedef struct {
+    float busyRate;             // Background busy rate
+    float excessMean;           // Background RSSI excess (dB)
+    float excessSpread;         // Mean absolute deviation of the excess (dB)
+    float busySum;              // CUSUM of the busy-rate log-likelihood ratio
+    float rssiSum;              // Page-Hinkley sum of the excess
+    uint16_t dwells;            // Dwells learned (up to CHANGE_LEARN_DWELLS)
+    uint16_t alarmDwells;       // Dwells since the onset
+    uint16_t quietDwells;       // Consecutive background dwells since the onset
+    bool alarmed;               // Emitter present
+    bool busyCause;             // Onset raised by the busy test
+} ChangeChannel;
+
+// ============================================================================
+// Change Channel Functions
+// ============================================================================
+
+/**
+ * Reset a channel detector to its learning state
+ * @param channel Detector state
+ */
+void changeChannelReset(ChangeChannel* channel);
+
+/**
+ * Update a channel detector with one dwell (O(1), no side effects)
+ * @param channel Detector state
+ * @param busy Packet or energy above the detection threshold in the dwell
+ * @param excessDb Peak RSSI over the noise floor in the dwell
+ * @return Change the dwell caused
+ */
+ChangeStep changeChannelStep(ChangeChannel* channel, bool busy, float excessDb);
+
+#endif // CHANGE_CHANNEL_H
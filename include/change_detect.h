@@ -0,0 +1,104 @@
+/**
+ * Change Detect Module Header
+ *
+ * New-emitter detection without a signature. analyzeDroneSignal() only
+ * flags links it finds in the signature database; this module flags any
+ * channel whose behaviour departs from its learned background, so a novel
+ * or custom link is reported too.
+ *
+ * Every sweep gives each channel it samples one dwell observation: busy
+ * (a packet, or a background sample above the detection threshold) and
+ * the peak RSSI excess over the channel's noise floor, which go to the
+ * channel's detector of change_channel.h. An onset prints
+ *   EMITTER,<channel>,<MHz>,<busy|rssi>,<signature|unknown>,
+ *           <background busy rate>,<excess dB>,<background excess dB>
+ * where the signature field tells whether the analysis stage matched a
+ * known signature on the channel recently. The end of the emitter prints
+ *   EMITTER_END,<channel>,<MHz>,<quiet|absorbed>,<duration s>
+ *
+ * "change bench" replays the occupancy history (one dwell per row)
+ * through a fresh detector and prints
+ *   CHANGEBENCH,<rows>,<channels>,<alarms>,<alarms per channel-hour>,
+ *               <update mean ns>
+ * tools/change_sim.py measures false alarms and detection delay on a
+ * simulated band with the same detector.
+ */
+
+#ifndef CHANGE_DETECT_H
+#define CHANGE_DETECT_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+#include "change_channel.h"
+
+// ============================================================================
+// Change Detect Configuration
+// ============================================================================
+
+#define CHANGE_DETECT_ENABLED       true      // Report new emitters
+#define CHANGE_CHANNELS             64        // Max sweep channels tracked
+#define CHANGE_SIGNATURE_MS         60000     // Signature match age counted as known
+
+/**
+ * Change detection statistics
+ */
+typedef struct {
+    uint32_t dwells;            // Dwell updates
+    uint32_t onsets;            // New emitters reported
+    uint32_t unknownOnsets;     // Of which without a recent signature match
+    uint32_t ended;             // Emitters gone quiet
+    uint32_t absorbed;          // Emitters that became background
+    uint8_t active;             // Channels with an emitter now
+    float updateMeanNs;         // EWMA of the update time per dwell
+} ChangeDetectStats;
+
+// ============================================================================
+// Change Detect Functions
+// ============================================================================
+
+/**
+ * Record an observation in the channel's open dwell (main loop)
+ * @param channel Sweep channel
+ * @param excessDb RSSI over the channel's noise floor
+ * @param busy Packet received or energy above the detection threshold
+ */
+void changeDetectNote(int channel, float excessDb, bool busy);
+
+/**
+ * Note a known signature match on a channel (main loop)
+ * @param channel Sweep channel
+ */
+void changeDetectNoteSignature(int channel);
+
+/**
+ * Close the dwells of a finished sweep and update their detectors (main loop)
+ * @param firstChannel First channel of the sweep's sub-band
+ * @param lastChannel Last channel of the sweep's sub-band
+ */
+void changeDetectSweepEnd(uint16_t firstChannel, uint16_t lastChannel);
+
+/**
+ * Start or stop reporting (detectors keep learning)
+ * @param enable true to print EMITTER lines
+ */
+void changeDetectEnable(bool enable);
+
+/**
+ * Check whether EMITTER lines are printed
+ */
+bool changeDetectEnabled();
+
+/**
+ * Replay the occupancy history through fresh detectors and print a
+ * CHANGEBENCH line
+ * @param rows Rows to replay, oldest first (at most the history)
+ */
+void changeDetectBenchmark(uint16_t rows);
+
+/**
+ * Get change detection statistics
+ * @param stats Output statistics
+ */
+void changeDetectGetStats(ChangeDetectStats* stats);
+
+#endif // CHANGE_DETECT_H
@@ -0,0 +1,79 @@
+/**
+ * Detection Classifier Module Header
+ *
+ * Compact learned model that scores how drone-like a detection is from
+ * signal and emitter-track features. The model is trained and quantised
+ * on the host by tools/classifier_compile.py and compiled in as constexpr
+ * tables (classifier_model.h), so evaluation is a handful of integer
+ * multiply/shift operations with no floating point and no heap.
+ *
+ * The score augments the rule-based signature match: for detections not
+ * identified exactly by a decoder or fingerprint it can raise the
+ * confidence, never lower it, and it never marks a signal as a drone.
+ *
+ * The shipped model is a hand-set prior, not a trained one, so the
+ * classifier is off by default. Enable it once a model trained on
+ * recorded traces has a measured accuracy (classifier_compile.py
+ * evaluate). -DCLASSIFIER_TRACE prints the features either way.
+ */
+
+#ifndef CLASSIFIER_H
+#define CLASSIFIER_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+#include "emitter_track.h"
+#include "classifier_model.h"
+
+// ============================================================================
+// Classifier Configuration
+// ============================================================================
+
+#define CLASSIFIER_ENABLED          false     // Raise confidence by the model score
+#define CLASSIFIER_NO_TIMING_US     100000    // Inter-arrival value when no timing yet
+
+/**
+ * Feature indices, in model order (see FEATURES in tools/classifier_compile.py)
+ */
+typedef enum {
+    FEATURE_RSSI_MARGIN = 0,    // RSSI above noise floor (0.1 dB)
+    FEATURE_SNR,                // SNR (0.1 dB)
+    FEATURE_FREQ_ERROR,         // Absolute frequency error (Hz)
+    FEATURE_BANDWIDTH,          // Receiver bandwidth (kHz)
+    FEATURE_INTERARRIVAL,       // Shortest track inter-arrival (us)
+    FEATURE_HOP_SPACING,        // Track hop spacing (kHz, 0 if not hopping)
+    FEATURE_PAYLOAD_LENGTH      // Payload length (bytes)
+} ClassifierFeature;
+
+/**
+ * Integer feature vector
+ */
+typedef struct {
+    int32_t value[CLASSIFIER_NUM_FEATURES];
+} ClassifierFeatures;
+
+// ============================================================================
+// Classifier Functions
+// ============================================================================
+
+/**
+ * Build the feature vector for a detection
+ * @param signal Analyzed detection
+ * @param track Emitter track of the detection (may be NULL)
+ * @param capture Packet capture (may be NULL)
+ * @param noiseFloor Noise floor of the channel (dBm)
+ * @param bandwidthKHz Receiver bandwidth the signal was received with
+ * @param features Output feature vector
+ */
+void classifierExtractFeatures(const DroneSignal* signal, const EmitterTrack* track,
+                               const PacketCapture* capture, float noiseFloor,
+                               float bandwidthKHz, ClassifierFeatures* features);
+
+/**
+ * Evaluate the model
+ * @param features Feature vector
+ * @return Drone likelihood as a confidence percentage (0-100)
+ */
+uint8_t classifierConfidence(const ClassifierFeatures* features);
+
+#endif // CLASSIFIER_H
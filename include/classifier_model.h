@@ -0,0 +1,52 @@
+/**
+ * Classifier Model Tables
+ *
+ * GENERATED by tools/classifier_compile.py from tools/classifier_model.json - do not edit.
+ *
+ * Quantised logistic model over ClassifierFeatures (see classifier.h).
+ */
+
+#ifndef CLASSIFIER_MODEL_H
+#define CLASSIFIER_MODEL_H
+
+#include <stdint.h>
+
+#define CLASSIFIER_NUM_FEATURES     7
+#define CLASSIFIER_SCORE_FRAC_BITS  8
+#define CLASSIFIER_SCORE_RANGE      8
+#define CLASSIFIER_SIGMOID_ENTRIES  256
+
+// Feature clamp range (training range, avoids extrapolation)
+constexpr int32_t kClassifierMin[CLASSIFIER_NUM_FEATURES] = { -200, -300, 0, 0, 0, 0, 0 };
+constexpr int32_t kClassifierMax[CLASSIFIER_NUM_FEATURES] = { 1000, 300, 30000, 600, 100000, 26000, 255 };
+
+// Standardisation mean folded into integer offsets
+constexpr int32_t kClassifierMean[CLASSIFIER_NUM_FEATURES] = { 100, 0, 3000, 150, 50000, 200, 16 };
+
+// Weights scaled by 2^shift, contribution = ((x - mean) * weight) >> shift
+constexpr int16_t kClassifierWeight[CLASSIFIER_NUM_FEATURES] = { 20972, 31457, -22370, 22370, -21475, 20133, -19661 };
+constexpr uint8_t kClassifierShift[CLASSIFIER_NUM_FEATURES] = { 13, 14, 19, 16, 21, 18, 12 };
+
+constexpr int32_t kClassifierBias = -128;
+
+// Logistic function over [-8, 8) in confidence percent
+constexpr uint8_t kClassifierSigmoid[CLASSIFIER_SIGMOID_ENTRIES] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,
+      2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   5,
+      5,   5,   6,   6,   6,   7,   7,   7,   8,   8,   9,   9,  10,  10,  11,  12,
+     12,  13,  14,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,
+     28,  29,  30,  31,  33,  34,  36,  37,  38,  40,  41,  43,  45,  46,  48,  49,
+     51,  52,  54,  55,  57,  59,  60,  62,  63,  64,  66,  67,  69,  70,  71,  72,
+     74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  86,  87,  88,
+     88,  89,  90,  90,  91,  91,  92,  92,  93,  93,  93,  94,  94,  94,  95,  95,
+     95,  96,  96,  96,  96,  97,  97,  97,  97,  97,  97,  98,  98,  98,  98,  98,
+     98,  98,  98,  99,  99,  99,  99,  99,  99,  99,  99,  99,  99,  99,  99,  99,
+     99,  99,  99,  99,  99, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,
+    100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,
+    100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100
+};
+
+#endif // CLASSIFIER_MODEL_H
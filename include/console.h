@@ -0,0 +1,79 @@
+/**
+ * Console Module Header
+ *
+ * Line-based serial command console for tuning without reflashing. Input
+ * is read without blocking from the main loop, a bounded number of bytes
+ * per pass, so scanner tasks are never delayed. Setting commands go
+ * through scan_config.h: they are validated, saved to NVS and applied at
+ * the next sweep boundary.
+ *
+ * Commands (one per line):
+ *   help                          List commands
+ *   show                          Current settings and scanner plans
+ *   band <min MHz> <max MHz> [step kHz]   Band plan and sweep step
+ *   dwell <ms>                    Dwell per channel
+ *   mods <lora,fsk,ook>           Modulation set
+ *   modtime <ms>                  Time per modulation
+ *   lora <sf> <bw kHz>            LoRa spreading factor and bandwidth
+ *   thresh <margin dB> <k>        Detection margin and spread multiple
+ *   defaults                      Restore compile-time settings
+ *   stats                         Counters, as STAT,<name>,<value> lines
+ *   hist <rssi|snr|chan|noise>    Histograms, as HIST,... lines
+ *   cov [lora,fsk,ook]            Scan coverage, as COVSUM or COV lines
+ *   pcap <on|off>                 Packet capture export, as PCAP lines
+ *   lock <on|off>                 Lock-on to unknown-parameter energy, as LOCK lines
+ *   hier <on|off>                 Coarse-to-fine sweep, as HSWEEP lines
+ *   spec <on|off>                 Compressed spectrum rows, as SPEC lines
+ *   spec bench [rows]             Codec benchmark on the occupancy history, as SPECBENCH
+ *   change <on|off>               New-emitter change detection, as EMITTER lines
+ *   change bench [rows]           Change detector replay of the occupancy history, as CHANGEBENCH
+ *   occ <min MHz> <max MHz> <min> Band occupancy, as an OCC line
+ *   top <k> <minutes>             Busiest channels, as TOP lines
+ *   new <seconds>                 Newly active channels, as NEW lines
+ *   uniq [minutes]                Distinct counts and heavy hitters, as UNIQ/HEAVY lines
+ *   sketch [minutes]              Mergeable sketches, as HLL/CMS lines
+ *   clear                         Reset the packet histograms
+ */
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <Arduino.h>
+#include "scanner_task.h"
+
+// ============================================================================
+// Console Configuration
+// ============================================================================
+
+#define CONSOLE_LINE_MAX            96        // Longest command line
+#define CONSOLE_BYTES_PER_PASS      64        // Input bytes handled per service call
+#define CONSOLE_CHANNELS            64        // Sweep channels in the channel histogram
+#define CONSOLE_RSSI_MIN_DBM        -140      // Lower edge of the RSSI histogram
+#define CONSOLE_RSSI_BIN_DB         10
+#define CONSOLE_RSSI_BINS           12        // -140 to -20 dBm
+#define CONSOLE_SNR_MIN_DB          -20       // Lower edge of the SNR histogram
+#define CONSOLE_SNR_BIN_DB          4
+#define CONSOLE_SNR_BINS            10        // -20 to +20 dB
+
+// ============================================================================
+// Console Functions
+// ============================================================================
+
+/**
+ * Reset the line buffer and histograms
+ */
+void consoleInit();
+
+/**
+ * Read pending serial input and run complete command lines
+ * Call regularly from the main loop
+ */
+void consoleService();
+
+/**
+ * Count a received packet in the histograms
+ * @param event Packet event
+ */
+void consoleNotePacket(const ScanEvent* event);
+
+#endif // CONSOLE_H
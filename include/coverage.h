@@ -0,0 +1,130 @@
+/**
+ * Coverage Module Header
+ *
+ * Scan coverage and blind-time ledger. Each scanner task reports when its
+ * radio starts and stops listening on a (channel, modulation) cell and the
+ * time lost to every packet interrupt. The ledger splits the time into:
+ *   listen   radio receiving with the task free to service it
+ *   retune   moving onto the cell: reconfiguration, modulation switches and
+ *            mesh report transmissions in between
+ *   service  reading a packet and re-arming the receiver
+ *   stall    a packet interrupt waiting for the task and the bus lock
+ *            (other interrupts, higher priority tasks, display and SPI
+ *            contention)
+ * and records the revisit gap: the time from leaving a cell until a radio
+ * listens on it again.
+ *
+ * Totals are kept per cell in COVERAGE_EPOCHS epochs of COVERAGE_EPOCH_MS,
+ * so the window answers "how long was 917.5 MHz unobserved in LoRa mode in
+ * the last hour" in fixed memory. A gap is counted in the epoch it ends in.
+ * In the low-power mode "listen" is the duty-cycled RX time.
+ *
+ * Every sweep closes with one summary line:
+ * SWEEP,<scanner>,<modulation>,<complete>,<channels>,<sweep ms>,<listen ms>,
+ * <retune ms>,<service ms>,<stall ms>,<max retune us>
+ * A sweep cut short by a modulation switch has complete = 0.
+ */
+
+#ifndef COVERAGE_H
+#define COVERAGE_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Coverage Configuration
+// ============================================================================
+
+#define COVERAGE_CHANNELS           64        // Max sweep channels tracked
+#define COVERAGE_MODULATIONS        3         // LoRa, FSK, OOK
+#define COVERAGE_EPOCH_MS           600000    // Length of one window epoch (10 min)
+#define COVERAGE_EPOCHS             6         // Epochs in the window (1 hour)
+#define COVERAGE_SWEEP_LINES        true      // Print a SWEEP line per sweep
+
+/**
+ * Coverage of one (channel, modulation) cell over the window
+ */
+typedef struct {
+    uint32_t windowMs;          // Window length covered by the totals
+    uint32_t listenMs;          // Time listening
+    uint32_t unobservedMs;      // windowMs - listenMs
+    uint32_t retuneMs;          // Time moving onto the cell
+    uint32_t serviceMs;         // Time reading packets
+    uint32_t stallMs;           // Time packet interrupts waited
+    uint32_t maxGapMs;          // Longest revisit gap, including the open one
+    uint32_t visits;            // Dwells on the cell
+} CoverageStats;
+
+// ============================================================================
+// Coverage Functions
+// ============================================================================
+
+/**
+ * Allocate and clear the ledger
+ */
+void coverageInit();
+
+/**
+ * Radio starts listening on a cell (scanner task)
+ * @param scanner Scanner index
+ * @param channel Sweep channel
+ * @param modulation Modulation the radio is in
+ * @param leftUs Time the radio left its previous cell (esp_timer counter)
+ * @param nowUs Time the radio is listening again
+ */
+void coverageEnter(uint8_t scanner, int channel, ModulationType modulation,
+                   int64_t leftUs, int64_t nowUs);
+
+/**
+ * Radio stops listening on its cell (scanner task)
+ * @param scanner Scanner index
+ * @param nowUs Time the dwell ended
+ */
+void coverageLeave(uint8_t scanner, int64_t nowUs);
+
+/**
+ * Account for a packet interrupt on the current cell (scanner task)
+ * @param scanner Scanner index
+ * @param stallUs Interrupt until the task held the bus
+ * @param serviceUs Packet read until the radio was receiving again
+ */
+void coverageLost(uint8_t scanner, uint32_t stallUs, uint32_t serviceUs);
+
+/**
+ * Close the scanner's current sweep (scanner task, after coverageLeave)
+ * @param scanner Scanner index
+ * @param complete Sweep reached the end of the sub-band
+ */
+void coverageSweepEnd(uint8_t scanner, bool complete);
+
+/**
+ * Advance the window and print sweep summaries
+ * Call regularly from the main loop
+ */
+void coverageService();
+
+/**
+ * Get the coverage of a cell over the window
+ * @param channel Sweep channel
+ * @param modulation Modulation
+ * @param stats Output statistics
+ * @return false if the cell is outside the ledger
+ */
+bool coverageGet(int channel, ModulationType modulation, CoverageStats* stats);
+
+/**
+ * Print one line per modulation over the window:
+ * COVSUM,<modulation>,<window s>,<listen %>,<channels unheard>,
+ * <worst MHz>,<worst unobserved s>,<max gap s>
+ */
+void coverageReport();
+
+/**
+ * Print one line per channel of a modulation over the window:
+ * COV,<MHz>,<modulation>,<window s>,<listen ms>,<unobserved ms>,<max gap ms>,
+ * <retune ms>,<service ms>,<stall ms>,<visits>
+ * @param modulation Modulation
+ */
+void coveragePrint(ModulationType modulation);
+
+#endif // COVERAGE_H
@@ -0,0 +1,188 @@
+/**
+ * Detection Log Module Header
+ *
+ * Append-only, wear-aware store for detection and track records kept in a
+ * dedicated flash partition ("detlog", see partitions.csv).
+ *
+ * Layout:
+ * - The partition is treated as a ring of 4 KB flash sectors
+ * - Each sector starts with a header (magic, sequence number, erase count)
+ *   and ends with a summary footer written when the sector is closed
+ * - Records are appended between header and footer, each with its own CRC32
+ *
+ * Records are queued from the radio path without blocking and written in
+ * page-sized batches by a low-priority writer task. A small RAM index with
+ * one summary per sector (time range, channel mask, modulation mask) lets
+ * time/frequency queries skip sectors without reading them.
+ *
+ * Flash erase and program run with the flash cache disabled on both
+ * cores, so code outside IRAM, the scanner tasks included, stalls for
+ * their duration. Programs are one page (well under a millisecond); a
+ * sector erase takes tens of milliseconds. Once the open sector is half
+ * full the next one is due for erasure, and a scanner task runs that
+ * erase between two of its dwells (detectionLogEraseAhead()), where the
+ * stall costs retune time instead of a packet. Only if no scanner has
+ * done so by DETLOG_ERASE_DEADLINE does the writer erase on its own. The
+ * longest erase is kept as eraseMaxUs.
+ *
+ * A sector erased ahead of need has no header, so its erase count is not
+ * on flash; recovery carries the highest count of the ring forward to it.
+ */
+
+#ifndef DETECTION_LOG_H
+#define DETECTION_LOG_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Log Configuration
+// ============================================================================
+
+#define DETLOG_PARTITION_LABEL  "detlog"  // Partition label in partitions.csv
+#define DETLOG_SECTOR_SIZE      4096      // Flash erase unit in bytes
+#define DETLOG_PAGE_SIZE        256       // Flash program page in bytes
+#define DETLOG_QUEUE_DEPTH      64        // Records buffered ahead of the writer
+#define DETLOG_MAX_PAYLOAD      48        // Largest record payload in bytes
+#define DETLOG_FLUSH_MS         1000      // Flush partial pages after this idle time
+#define DETLOG_MAX_SECTORS      512       // Upper bound on indexed sectors
+#define DETLOG_ERASE_DEADLINE   (DETLOG_SECTOR_SIZE * 7 / 8)  // Sector fill at which the writer erases itself
+
+// Record types stored in the log
+#define DETLOG_RECORD_DETECTION 0x01      // DetectionLogRecord payload
+#define DETLOG_RECORD_TRACK     0x02      // Track summary payload
+
+// Channel value for records not tied to a sweep channel
+#define DETLOG_NO_CHANNEL       0xFF
+
+// ============================================================================
+// Record Formats
+// ============================================================================
+
+/**
+ * On-flash payload of a single detection (DETLOG_RECORD_DETECTION)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t uptimeMs;          // millis() at detection
+    uint32_t frequencyKHz;      // Detection frequency (kHz)
+    int16_t rssiDeci;           // RSSI in 0.1 dBm
+    int16_t snrDeci;            // SNR in 0.1 dB
+    int32_t freqErrorHz;        // Frequency error (Hz)
+    uint8_t modulation;         // ModulationType
+    uint8_t confidence;         // Detection confidence (0-100%)
+    int8_t signatureIndex;      // Matched signature index (-1 if none)
+    uint8_t flags;              // Bit 0: drone signature matched
+    int64_t utcUs;              // PPS-disciplined UTC arrival time (us, 0 if unknown)
+} DetectionLogRecord;
+
+/**
+ * Decoded record passed to query callbacks
+ */
+typedef struct {
+    uint8_t type;               // DETLOG_RECORD_* type
+    uint8_t channel;            // Sweep channel index (DETLOG_NO_CHANNEL if none)
+    uint32_t timestamp;         // Log time in seconds
+    uint8_t length;             // Payload length in bytes
+    const uint8_t* payload;     // Payload bytes (valid during callback only)
+} DetectionLogEntry;
+
+/**
+ * Query filter for detectionLogQuery()
+ */
+typedef struct {
+    uint32_t timeFrom;          // Oldest log time to include (seconds)
+    uint32_t timeTo;            // Newest log time to include (seconds)
+    float frequencyMin;         // Lowest frequency to include (MHz)
+    float frequencyMax;         // Highest frequency to include (MHz)
+    uint8_t typeMask;           // Bit (1 << type) for each type to include
+} DetectionLogQuery;
+
+/**
+ * Callback invoked for each record matching a query
+ * @param entry Decoded record
+ * @param context User context pointer
+ * @return false to stop the query early
+ */
+typedef bool (*DetectionLogCallback)(const DetectionLogEntry* entry, void* context);
+
+/**
+ * Log health and throughput counters
+ */
+typedef struct {
+    uint32_t recordsWritten;    // Records committed to flash since boot
+    uint32_t recordsDropped;    // Records lost to a full queue
+    uint32_t recordsRecovered;  // Valid records found at boot
+    uint32_t corruptRecords;    // Records rejected by CRC during recovery
+    uint32_t pageWrites;        // Flash program operations
+    uint32_t sectorErases;      // Flash erase operations
+    uint32_t minEraseCount;     // Least-worn sector erase count
+    uint32_t maxEraseCount;     // Most-worn sector erase count
+    uint16_t sectorCount;       // Sectors in the log partition
+    uint16_t queueHighWater;    // Peak queued records
+    uint32_t eraseMaxUs;        // Longest sector erase (flash cache off)
+    uint32_t erasesBetweenDwells;   // Erases run by a scanner between dwells
+} DetectionLogStats;
+
+// ============================================================================
+// Log Functions
+// ============================================================================
+
+/**
+ * Mount the log partition, recover the write position and start the writer
+ * @return true if the log is ready for appends
+ */
+bool detectionLogInit();
+
+/**
+ * Queue a detection for logging (non-blocking, safe from the radio task)
+ * @param signal Analyzed detection to record
+ * @return true if queued, false if the log is unavailable or the queue is full
+ */
+bool detectionLogAppendDetection(const DroneSignal* signal);
+
+/**
+ * Queue a raw record for logging (non-blocking)
+ * @param type DETLOG_RECORD_* type
+ * @param channel Sweep channel index or DETLOG_NO_CHANNEL
+ * @param payload Record payload
+ * @param length Payload length (at most DETLOG_MAX_PAYLOAD)
+ * @return true if queued
+ */
+bool detectionLogAppend(uint8_t type, uint8_t channel, const void* payload, uint8_t length);
+
+/**
+ * Run a time/frequency query over committed records, newest sector first
+ * The callback runs without the flash lock held; queries are serialised.
+ * @param query Filter to apply
+ * @param callback Function invoked for each match
+ * @param context User context passed to callback
+ * @return Number of matching records delivered
+ */
+uint32_t detectionLogQuery(const DetectionLogQuery* query,
+                           DetectionLogCallback callback, void* context);
+
+/**
+ * Get the current log time used for record timestamps
+ * @return Log time in seconds (monotonic across reboots)
+ */
+uint32_t detectionLogTime();
+
+/**
+ * Erase the next sector if one is due (scanner task, between dwells).
+ * Does nothing while the writer holds the flash.
+ * @return true if an erase ran
+ */
+bool detectionLogEraseAhead();
+
+/**
+ * Request that buffered records be written to flash promptly
+ */
+void detectionLogFlush();
+
+/**
+ * Get log counters
+ * @param stats Output structure for counters
+ */
+void detectionLogGetStats(DetectionLogStats* stats);
+
+#endif // DETECTION_LOG_H
@@ -37,6 +37,9 @@ typedef enum {
  */
 const char* getModulationName(ModulationType mod);
 
+#define MOD_MASK(mod)       (1U << (mod))
+#define MOD_MASK_ALL        (MOD_MASK(MOD_LORA) | MOD_MASK(MOD_FSK) | MOD_MASK(MOD_OOK))
+
 // ============================================================================
 // 900MHz Band Configuration
 // ============================================================================
@@ -60,6 +63,12 @@ const char* getModulationName(ModulationType mod);
 #define SWEEP_STEP_KHZ      500.0f    // Frequency step in kHz
 #define SWEEP_DWELL_MS      50        // Dwell time per channel in ms
 #define NUM_SWEEP_CHANNELS  ((FREQ_900_MAX - FREQ_900_MIN) * 1000.0f / SWEEP_STEP_KHZ)
+#define SCANNER_MODULATION_MS   10000 // Time per modulation before switching
+
+// The values above are defaults: the band plan, dwell, modulations and LoRa
+// parameters can be changed at runtime (see scan_config.h). The sweep channel
+// grid itself (FREQ_900_MIN + n * SWEEP_STEP_KHZ) is fixed, so channel indices
+// stored by other modules keep their meaning.
 
 // ============================================================================
 // LoRa Configuration for 900MHz (ExpressLRS compatible)
@@ -83,6 +92,7 @@ const char* getModulationName(ModulationType mod);
 #define FSK_FREQUENCY_DEV       50.0f     // 50 kHz frequency deviation
 #define FSK_RX_BANDWIDTH        156.2f    // Receiver bandwidth in kHz
 #define FSK_RX_BANDWIDTH_WIDE   250.0f    // Wide bandwidth for FHSS detection
+#define FSK_RX_BANDWIDTH_MAX    467.0f    // Widest SX126x RX bandwidth (energy probes)
 #define FSK_PREAMBLE_LEN        16        // Preamble length in bits
 
 // FHSS hopping bandwidth for different systems
@@ -97,6 +107,72 @@ const char* getModulationName(ModulationType mod);
 #define OOK_BITRATE         4.8f      // 4.8 kbps (typical for simple remotes)
 #define OOK_RX_BANDWIDTH    58.0f     // Receiver bandwidth in kHz
 
+// ============================================================================
+// Raw Capture Configuration (FSK/OOK fingerprinting)
+// ============================================================================
+
+// Capture modes trigger on preamble detect with sync word matching, CRC and
+// whitening disabled, and receive a fixed-length raw block for fingerprinting
+#define FSK_CAPTURE_RX_BANDWIDTH    234.3f    // Wide RX bandwidth (SX126x step)
+#define OOK_CAPTURE_RX_BANDWIDTH    58.6f     // OOK RX bandwidth (SX126x step)
+#define RAW_CAPTURE_ENABLED         true      // Use capture modes for FSK/OOK scanning
+
+// ============================================================================
+// Scanner State
+// ============================================================================
+
+#define MAX_SCANNERS        4         // Radios that can scan concurrently
+#define SCANNER_PRIORITY_CHANNELS   8 // Channels that can be queued ahead of the sweep
+
+/**
+ * Runtime scan parameters of one scanner
+ */
+typedef struct {
+    uint16_t firstChannel;      // First sweep channel of the sub-band
+    uint16_t lastChannel;       // Last sweep channel of the sub-band (inclusive)
+    uint8_t channelStride;      // Sweep channels advanced per retune
+    uint8_t modulationMask;     // Modulations cycled through (MOD_MASK bits)
+    uint16_t dwellMs;           // Dwell time per channel
+    uint32_t modulationMs;      // Time per modulation before switching
+    uint8_t loraSpreadingFactor;    // LoRa spreading factor scanned for
+    float loraBandwidth;        // LoRa bandwidth scanned for (kHz)
+} ScanPlan;
+
+/**
+ * Scanning state of one radio
+ *
+ * Each scanner owns one SX1262 and sweeps its own sub-band of the sweep
+ * channel grid with its assigned modulations, so several radios can cover
+ * the band in parallel. The single-radio API below operates on a default
+ * scanner set up by droneDetectionInit().
+ */
+typedef struct {
+    SX1262* radio;              // Radio owned by this scanner
+    uint8_t index;              // Scanner number (event source)
+    bool initialized;           // Radio configured successfully
+    uint16_t firstChannel;      // First sweep channel of the sub-band
+    uint16_t lastChannel;       // Last sweep channel of the sub-band (inclusive)
+    uint8_t modulationMask;     // Modulations cycled through (MOD_MASK bits)
+    ModulationType modulation;  // Current modulation
+    float sweepFrequency;       // Current sweep frequency (MHz)
+    uint16_t sweepChannel;      // Current sweep channel
+    bool sweepComplete;         // Sub-band swept at least once
+    uint32_t sweepCount;        // Sweep wraps
+    uint8_t captureBitrateIndex;    // Raw capture bit rate rotation
+    float captureBitrate;       // Current raw capture bit rate (kbps, 0 if none)
+    uint32_t lastNoiseSampleMs; // millis() of last noise floor sample
+    uint16_t priorityChannels[SCANNER_PRIORITY_CHANNELS];  // Visited before the sweep continues
+    uint8_t priorityCount;      // Queued priority channels
+    uint8_t channelStride;      // Sweep channels advanced per retune
+    uint16_t dwellMs;           // Dwell time per channel
+    uint32_t modulationMs;      // Time per modulation before switching
+    uint8_t loraSpreadingFactor;    // LoRa spreading factor scanned for
+    float loraBandwidth;        // LoRa bandwidth scanned for (kHz)
+    uint64_t sweepSkipMask;     // Channels the current sweep passes over (bit per channel)
+    ScanPlan pendingPlan;       // Plan staged for the next sweep boundary
+    volatile bool planPending;  // pendingPlan not yet applied
+} DroneScanner;
+
 // ============================================================================
 // Drone Signature Detection
 // ============================================================================
@@ -113,8 +189,28 @@ typedef struct {
     bool isDroneSignature;      // True if matches known drone signature
     uint8_t confidence;         // Detection confidence (0-100%)
     const char* droneType;      // Identified drone type/protocol
+    int8_t signatureIndex;      // Index into signature database (-1 if none)
+    uint32_t transmitterId;     // Decoded or clustered transmitter identifier (0 if unknown)
+    uint32_t trackId;           // Emitter track number (0 if untracked)
+    uint16_t packetRateHz;      // Classified packet rate of the track (0 if unknown)
+    int64_t utcUs;              // PPS-disciplined UTC arrival time (us, 0 if unknown)
+    float noiseFloor;           // Channel noise floor at analysis (dBm)
+    const char* decodedProtocol;    // Decoded framing (NULL if not decoded)
+    uint8_t packetType;         // Protocol-specific type of a decoded packet
 } DroneSignal;
 
+/**
+ * Raw packet data accompanying a detection
+ */
+typedef struct {
+    const uint8_t* data;        // Received bytes (NULL if not available)
+    size_t length;              // Number of received bytes
+    bool isRawCapture;          // Bytes are a raw FSK/OOK capture
+    float bitrateKbps;          // Capture bit rate for raw captures (kbps)
+    uint32_t timestampUs;       // Packet arrival time from the DIO1 ISR (micros)
+    int64_t utcUs;              // Arrival time as UTC from the DIO1 ISR (us, 0 if unknown)
+} PacketCapture;
+
 /**
  * Known drone protocol signatures for 900MHz band
  */
@@ -124,7 +220,9 @@ typedef struct {
     float frequencyMax;         // Maximum frequency (MHz)
     ModulationType modulation;  // Expected modulation type
     float bandwidth;            // Expected bandwidth (kHz)
-    float minRSSI;              // Minimum expected RSSI (dBm)
+    float minRSSI;              // Absolute sensitivity limit (dBm), see noise_floor.h
+                                // for the adaptive threshold applied on top
+    uint16_t packetRates;       // Known packet rate modes (RATE_MASK bits, 0 = none)
 } DroneSignature;
 
 // ============================================================================
@@ -132,7 +230,8 @@ typedef struct {
 // ============================================================================
 
 /**
- * Initialize drone detection module
+ * Initialize drone detection module and the default scanner (whole band,
+ * all modulations) on a radio
  * @param radio Pointer to SX1262 radio instance
  * @return true if initialization successful
  */
@@ -146,6 +245,16 @@ bool droneDetectionInit(SX1262* radio);
  */
 int configureLoRaMode(SX1262* radio, float frequency);
 
+/**
+ * Configure radio for LoRa modulation detection with given parameters
+ * @param radio Pointer to SX1262 radio instance
+ * @param frequency Center frequency in MHz
+ * @param bandwidth Bandwidth in kHz
+ * @param spreadingFactor Spreading factor (5-12)
+ * @return RadioLib status code
+ */
+int configureLoRaModeWith(SX1262* radio, float frequency, float bandwidth, uint8_t spreadingFactor);
+
 /**
  * Configure radio for FSK modulation detection
  * @param radio Pointer to SX1262 radio instance
@@ -162,17 +271,94 @@ int configureFSKMode(SX1262* radio, float frequency);
  */
 int configureOOKMode(SX1262* radio, float frequency);
 
+/**
+ * Configure radio for raw FSK capture (preamble triggered, no sync match)
+ * @param radio Pointer to SX1262 radio instance
+ * @param frequency Center frequency in MHz
+ * @param bitrate Capture bit rate in kbps
+ * @return RadioLib status code
+ */
+int configureFSKCaptureMode(SX1262* radio, float frequency, float bitrate);
+
+/**
+ * Configure radio for raw FSK capture with given deviation and RX bandwidth
+ * @param radio Pointer to SX1262 radio instance
+ * @param frequency Center frequency in MHz
+ * @param bitrate Capture bit rate in kbps
+ * @param deviation Frequency deviation in kHz
+ * @param rxBandwidth Receiver bandwidth in kHz (an SX126x step)
+ * @return RadioLib status code
+ */
+int configureFSKCaptureModeWith(SX1262* radio, float frequency, float bitrate,
+                                float deviation, float rxBandwidth);
+
+/**
+ * Configure radio for raw OOK capture (preamble triggered, no sync match)
+ * @param radio Pointer to SX1262 radio instance
+ * @param frequency Center frequency in MHz
+ * @param bitrate Capture bit rate in kbps
+ * @return RadioLib status code
+ */
+int configureOOKCaptureMode(SX1262* radio, float frequency, float bitrate);
+
+/**
+ * Configure radio for RSSI energy probes at the widest RX bandwidth
+ * @param radio Pointer to SX1262 radio instance
+ * @param frequency Center frequency in MHz
+ * @return RadioLib status code
+ */
+int configureEnergyProbeMode(SX1262* radio, float frequency);
+
+/**
+ * Get the bit rate raw captures of the default scanner are sampled at
+ * @return Capture bit rate in kbps (0 if not in a capture mode)
+ */
+float getCaptureBitrate();
+
 /**
  * Analyze received signal for drone signatures
  * @param rssi Signal strength in dBm
  * @param snr Signal-to-noise ratio in dB
  * @param freqError Frequency error in Hz
  * @param currentMod Current modulation mode
+ * @param capture Received packet bytes (NULL if not available)
  * @param signal Output structure for detection results
  * @return true if signal matches drone signature
  */
 bool analyzeDroneSignal(float rssi, float snr, float freqError, 
-                        ModulationType currentMod, DroneSignal* signal);
+                        ModulationType currentMod, const PacketCapture* capture,
+                        DroneSignal* signal);
+
+/**
+ * Analyze a signal received at a given frequency (any scanner). Nothing is
+ * printed, so the caller can act on the result first; see
+ * printDroneAnalysis().
+ * @param frequency Frequency the receiving radio was tuned to (MHz)
+ * @param rssi Signal strength in dBm
+ * @param snr Signal-to-noise ratio in dB
+ * @param freqError Frequency error in Hz
+ * @param currentMod Modulation the signal was received with
+ * @param capture Received packet bytes (NULL if not available)
+ * @param signal Output structure for detection results
+ * @return true if signal matches drone signature
+ */
+bool analyzeDroneSignalAt(float frequency, float rssi, float snr, float freqError,
+                          ModulationType currentMod, const PacketCapture* capture,
+                          DroneSignal* signal);
+
+/**
+ * Print the analysis of a signal to Serial
+ * @param signal Result of analyzeDroneSignalAt()
+ * @param capture The packet bytes it was analyzed with (NULL if none)
+ */
+void printDroneAnalysis(const DroneSignal* signal, const PacketCapture* capture);
+
+/**
+ * Sample background RSSI on the current channel for noise floor estimation
+ * Rate limited internally; call while the radio is in receive mode
+ * @param radio Pointer to SX1262 radio instance
+ */
+void sampleNoiseFloor(SX1262* radio);
 
 /**
  * Get the currently active modulation type
@@ -188,6 +374,20 @@ ModulationType getCurrentModulation();
  */
 ModulationType switchToNextModulation(SX1262* radio, float frequency);
 
+/**
+ * Get the protocol name of a signature database entry
+ * @param index Signature index as stored in DroneSignal::signatureIndex
+ * @return Protocol name, or "Unknown" for an invalid index
+ */
+const char* getSignatureName(int index);
+
+/**
+ * Find a signature database entry by protocol name
+ * @param name Protocol name
+ * @return Signature index, or -1 if not found
+ */
+int findSignature(const char* name);
+
 /**
  * Check if frequency is in valid 900MHz band
  * @param frequency Frequency to check in MHz
@@ -212,6 +412,13 @@ float getCurrentSweepFrequency();
  */
 float sweepToNextFrequency(SX1262* radio);
 
+/**
+ * Map a frequency to its sweep channel index
+ * @param frequency Frequency in MHz
+ * @return Channel index, or -1 if outside the sweep range
+ */
+int frequencyToSweepChannel(float frequency);
+
 /**
  * Reset sweep scan to starting frequency
  */
@@ -223,4 +430,124 @@ void resetSweepScan();
  */
 bool isSweepComplete();
 
+// ============================================================================
+// Scanner Functions (multi-radio)
+// ============================================================================
+
+/**
+ * Set up a scanner on a radio and configure its first channel
+ * @param scanner Scanner state to initialize
+ * @param radio Radio owned by the scanner
+ * @param index Scanner number reported with its events
+ * @param firstChannel First sweep channel of its sub-band
+ * @param lastChannel Last sweep channel of its sub-band (inclusive)
+ * @param modulationMask Modulations to cycle through (MOD_MASK bits)
+ * @return true if the radio was configured
+ */
+bool scannerInit(DroneScanner* scanner, SX1262* radio, uint8_t index,
+                 uint16_t firstChannel, uint16_t lastChannel, uint8_t modulationMask);
+
+/**
+ * Get the scanner used by the single-radio API
+ * @return Default scanner
+ */
+DroneScanner* getDefaultScanner();
+
+/**
+ * Restrict a scanner to a sub-band and restart its sweep
+ * @param scanner Scanner
+ * @param firstChannel First sweep channel
+ * @param lastChannel Last sweep channel (inclusive)
+ */
+void scannerSetSubBand(DroneScanner* scanner, uint16_t firstChannel, uint16_t lastChannel);
+
+/**
+ * Switch a scanner to its next assigned modulation
+ * @param scanner Scanner
+ * @return New modulation type
+ */
+ModulationType scannerNextModulation(DroneScanner* scanner);
+
+/**
+ * Advance a scanner to the next channel of its sub-band
+ * @param scanner Scanner
+ * @return New frequency in MHz
+ */
+float scannerSweepNext(DroneScanner* scanner);
+
+/**
+ * Continue a scanner from a saved sweep position (warm start)
+ * @param scanner Scanner
+ * @param channel Sweep channel to resume at (ignored outside the sub-band)
+ * @param modulation Modulation to resume in (ignored if not assigned)
+ * @return true if the radio was reconfigured at the saved position
+ */
+bool scannerResume(DroneScanner* scanner, uint16_t channel, ModulationType modulation);
+
+/**
+ * Queue a channel to be visited at the next retunes, ahead of the sweep
+ * @param scanner Scanner
+ * @param channel Sweep channel within the scanner's sub-band
+ * @return true if the channel was queued
+ */
+bool scannerQueueChannel(DroneScanner* scanner, uint16_t channel);
+
+/**
+ * Stage new scan parameters for a scanner. They are applied together at
+ * its next sweep boundary (sweep wrap or modulation switch), so a sweep
+ * never mixes old and new settings.
+ * @param scanner Scanner
+ * @param plan New parameters
+ * @return true if the plan is valid and was staged
+ */
+bool scannerSetPlan(DroneScanner* scanner, const ScanPlan* plan);
+
+/**
+ * Apply a staged plan now and restart the sweep at the new sub-band start
+ * Called at sweep boundaries, and before the scanner's task starts
+ * @param scanner Scanner
+ * @return true if a staged plan was applied
+ */
+bool scannerApplyPlan(DroneScanner* scanner);
+
+/**
+ * Get the scan parameters a scanner is running with
+ * @param scanner Scanner
+ * @param plan Output parameters
+ */
+void scannerGetPlan(const DroneScanner* scanner, ScanPlan* plan);
+
+/**
+ * Restart a scanner's sweep at the start of its sub-band
+ * (takes effect at the next retune)
+ * @param scanner Scanner
+ */
+void scannerResetSweep(DroneScanner* scanner);
+
+/**
+ * Pass over channels for the rest of the current sweep and retune to the
+ * first channel kept, from the current sweep position (the mask clears
+ * when the sweep wraps)
+ * @param scanner Scanner
+ * @param skipMask Channels to pass over (bit per sweep channel)
+ * @return true if the radio was reconfigured
+ */
+bool scannerSetSweepSkip(DroneScanner* scanner, uint64_t skipMask);
+
+/**
+ * Read background RSSI for noise floor estimation, rate limited to
+ * NOISE_FLOOR_SAMPLE_MS per scanner
+ * @param scanner Scanner (radio in receive mode)
+ * @param rssi Output RSSI in dBm
+ * @return true if a sample was taken
+ */
+bool scannerSampleNoise(DroneScanner* scanner, float* rssi);
+
+/**
+ * Get the bit rate a scanner's raw captures are sampled at
+ * @param scanner Scanner
+ * @return Capture bit rate in kbps (0 if not in a capture mode)
+ */
+float scannerCaptureBitrate(const DroneScanner* scanner);
+
 #endif // DRONE_DETECTION_H
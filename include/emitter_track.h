@@ -0,0 +1,99 @@
+/**
+ * Emitter Track Module Header
+ *
+ * Groups detections from the same emitter into tracks so per-emitter
+ * statistics (packet rate mode, signal strength, lifetime) can be built
+ * up over many packets. Tracks live in a fixed-size table; idle tracks
+ * are closed, summarised to the detection log and reused.
+ */
+
+#ifndef EMITTER_TRACK_H
+#define EMITTER_TRACK_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+#include "interarrival.h"
+
+// ============================================================================
+// Track Configuration
+// ============================================================================
+
+#define MAX_EMITTER_TRACKS      16        // Concurrent tracks
+#define TRACK_TIMEOUT_MS        5000      // Idle time before a track closes
+
+/**
+ * State of one emitter track
+ */
+typedef struct {
+    bool active;                    // Slot in use
+    uint32_t key;                   // Emitter identity key
+    uint32_t id;                    // Sequential track number
+    ModulationType modulation;      // Modulation of the emitter
+    int8_t signatureIndex;          // Matched signature (-1 if none)
+    uint32_t firstSeenMs;           // millis() of first packet
+    uint32_t lastSeenMs;            // millis() of latest packet
+    float lastFrequency;            // Frequency of latest packet (MHz)
+    uint32_t hopSpacingKHz;         // Smallest frequency change between packets (0 if none)
+    float peakRssi;                 // Strongest RSSI seen (dBm)
+    float meanRssi;                 // EWMA of RSSI (dBm)
+    InterArrivalAnalyzer timing;    // Packet rate analyzer
+    PacketRateMode rateMode;        // Latest rate classification
+} EmitterTrack;
+
+/**
+ * On-flash track summary (DETLOG_RECORD_TRACK payload)
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t trackId;               // Sequential track number
+    uint32_t key;                   // Emitter identity key
+    uint32_t firstSeenMs;           // millis() of first packet
+    uint32_t durationMs;            // Track lifetime
+    uint32_t packets;               // Packets attributed to track
+    uint8_t modulation;             // ModulationType
+    int8_t signatureIndex;          // Matched signature (-1 if none)
+    uint16_t rateHz;                // Classified packet rate (0 if unknown)
+    int16_t peakRssiDeci;           // Peak RSSI in 0.1 dBm
+} TrackLogRecord;
+
+// ============================================================================
+// Track Functions
+// ============================================================================
+
+/**
+ * Compute the track key for a detection
+ * @param signal Analyzed detection
+ * @return Emitter identity key
+ */
+uint32_t trackKeyForSignal(const DroneSignal* signal);
+
+/**
+ * Compute a key that names the same emitter on every node: the decoded
+ * transmitter ID, otherwise modulation and protocol (crystal-offset
+ * cluster IDs are numbered per node)
+ * @param signal Analyzed detection
+ * @return Network-wide emitter key
+ */
+uint32_t networkKeyForSignal(const DroneSignal* signal);
+
+/**
+ * Attribute a packet to its emitter track, creating one if needed
+ * @param key Emitter identity key
+ * @param signal Analyzed detection
+ * @param timestampUs Packet arrival time in microseconds
+ * @return Updated track
+ */
+EmitterTrack* trackObserve(uint32_t key, const DroneSignal* signal, uint32_t timestampUs);
+
+/**
+ * Close tracks that have been idle longer than TRACK_TIMEOUT_MS
+ */
+void trackService();
+
+/**
+ * Get a track table slot
+ * @param index Slot index (0 to MAX_EMITTER_TRACKS - 1)
+ * @return Track, or NULL if the slot is inactive
+ */
+const EmitterTrack* getTrack(int index);
+
+#endif // EMITTER_TRACK_H
@@ -0,0 +1,63 @@
+/**
+ * GPS Module Header
+ *
+ * Reads NMEA from the T-Beam GPS receiver with TinyGPSPlus and provides the
+ * node's current position and UTC time, so detections can be tagged with
+ * where and when they were observed.
+ */
+
+#ifndef GPS_H
+#define GPS_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// GPS Configuration
+// ============================================================================
+
+#define GPS_BAUD                9600      // NMEA baud rate
+#define GPS_FIX_MAX_AGE_MS      2000      // Older fixes are not used for geotagging
+#define GPS_MAX_HDOP            5.0f      // Fixes with worse geometry are ignored
+
+/**
+ * Current position of the node
+ */
+typedef struct {
+    double latitude;            // Degrees
+    double longitude;           // Degrees
+    float hdop;                 // Horizontal dilution of precision
+    uint8_t satellites;         // Satellites used
+    uint32_t ageMs;             // Time since the fix was received
+} GpsFix;
+
+// ============================================================================
+// GPS Functions
+// ============================================================================
+
+/**
+ * Start the GPS serial port
+ */
+void gpsInit();
+
+/**
+ * Feed pending NMEA characters to the parser (non-blocking)
+ * Call regularly from the main loop
+ */
+void gpsService();
+
+/**
+ * Get the current UTC time from the latest NMEA time and date
+ * Resolution is limited by NMEA latency; see timebase.h for PPS timing
+ * @param utcMs Output UTC time (ms since the Unix epoch)
+ * @return true if a recent time and date are available
+ */
+bool gpsGetUtcMs(int64_t* utcMs);
+
+/**
+ * Get the current position
+ * @param fix Output position
+ * @return true if a recent fix with usable geometry is available
+ */
+bool gpsGetFix(GpsFix* fix);
+
+#endif // GPS_H
@@ -0,0 +1,113 @@
+/**
+ * Hierarchical Sweep Module Header
+ *
+ * Coarse-to-fine sweep. The flat sweep dwells on every channel of a
+ * scanner's sub-band, so a full-band revisit takes channels x dwell per
+ * modulation. At the start of each sweep the hierarchical sweep instead
+ * takes a coarse pass of RSSI energy probes at the widest SX1262 receive
+ * bandwidth (467 kHz, one probe per 500 kHz channel, well under a
+ * millisecond each), grouped into blocks of HIER_BLOCK_CHANNELS:
+ *
+ *   coarse  One probe per channel. A block is active if any probe exceeds
+ *           the channel's probe floor by HIER_MARGIN_DB.
+ *   fine    An active block is split in halves. A half without a hit so
+ *           far is probed again with twice the samples; a half with energy
+ *           is split again, down to HIER_MIN_BLOCK channels.
+ *
+ * The sweep then dwells (demodulates) only on the channels of the active
+ * leaf blocks, plus a roving share of 1/HIER_REVISIT_PASSES of the
+ * sub-band that moves on from sweep to sweep. Every channel therefore gets
+ * a dwell at least once in HIER_REVISIT_PASSES sweeps, which bounds the
+ * revisit of a quiet channel, or of a hopping emitter's channel that a
+ * sub-millisecond probe missed.
+ *
+ * The pass runs in the scanner task with the bus lock held and counts as
+ * retune time of the first cell in the coverage ledger. The low-power mode
+ * keeps the flat sweep. Every complete sweep, flat or coarse-to-fine,
+ * prints its measured figures:
+ *   HSWEEP,<scanner>,<modulation>,<mode>,<channels>,<channels dwelt>,
+ *          <probes>,<coarse pass us>,<sweep ms>,<max revisit ms>
+ * where the revisit is the longest time a channel of the sub-band went
+ * without a dwell, measured between dwell starts within one modulation
+ * period (including gaps still open when the sweep ends). Running with
+ * "hier on" and "hier off" compares the two sweeps on the same traffic.
+ * The coarse-to-fine sweep stays off by default until such a benchmark
+ * shows detection latency is not worse.
+ */
+
+#ifndef HIER_SWEEP_H
+#define HIER_SWEEP_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Hierarchical Sweep Configuration
+// ============================================================================
+
+#define HIER_SWEEP_ENABLED          false     // Coarse energy pass before each sweep
+#define HIER_REVISIT_PASSES         2         // Sweeps in which every channel gets a dwell
+#define HIER_BLOCK_CHANNELS         8         // Sweep channels per coarse block
+#define HIER_MIN_BLOCK              2         // Block size the refinement stops at
+#define HIER_MARGIN_DB              6.0f      // Probe peak above the probe floor
+#define HIER_SETTLE_US              250       // RSSI settling after the receiver starts
+#define HIER_SAMPLE_US              100       // Spacing of repeated probe samples
+#define HIER_MAX_SAMPLES            8         // Samples per channel at the finest level
+#define HIER_FLOOR_ALPHA            0.1f      // Probe floor EWMA weight
+#define HIER_MAX_CHANNELS           64        // Sweep channels the masks cover
+
+/**
+ * Hierarchical sweep statistics (all scanners)
+ */
+typedef struct {
+    uint32_t passes;            // Coarse passes run
+    uint32_t probes;            // RSSI samples taken
+    float coarseMeanUs;         // EWMA of the pass duration
+    uint32_t coarseMaxUs;       // Longest pass
+    float dwellChannelsMean;    // EWMA of channels dwelt on per sweep
+    float sweepMeanMs;          // EWMA of the measured coarse-to-fine sweep time
+    uint32_t revisitMaxMs;      // Longest measured channel revisit, coarse-to-fine
+    float flatSweepMeanMs;      // EWMA of the measured flat sweep time
+    uint32_t flatRevisitMaxMs;  // Longest measured channel revisit, flat
+} HierSweepStats;
+
+// ============================================================================
+// Hierarchical Sweep Functions
+// ============================================================================
+
+/**
+ * Enable or disable the coarse pass (takes effect at the next sweep)
+ * @param enable true for the coarse-to-fine sweep, false for the flat sweep
+ */
+void hierSweepEnable(bool enable);
+
+/**
+ * Check whether the coarse-to-fine sweep is enabled
+ */
+bool hierSweepEnabled();
+
+/**
+ * Run the coarse pass at the start of a sweep and restrict the sweep to
+ * the active channels (scanner task, bus lock held)
+ * @param scanner Scanner at the first channel of a new sweep
+ * @param previousComplete true if the sweep that just ended ran to its end
+ * @return true if a pass ran and the radio is listening-ready on the first
+ *         channel kept; false if the flat sweep continues unchanged
+ */
+bool hierSweepPass(DroneScanner* scanner, bool previousComplete);
+
+/**
+ * Record a sweep dwell starting on the scanner's current channel (scanner
+ * task)
+ * @param scanner Scanner that retuned
+ * @param nowUs Time the radio is listening
+ */
+void hierSweepNoteDwell(const DroneScanner* scanner, int64_t nowUs);
+
+/**
+ * Get hierarchical sweep statistics
+ * @param stats Output statistics
+ */
+void hierSweepGetStats(HierSweepStats* stats);
+
+#endif // HIER_SWEEP_H
@@ -0,0 +1,92 @@
+/**
+ * Inter-Arrival Analyzer Module Header
+ *
+ * Classifies the packet rate mode of an emitter (e.g. ELRS 25/50/100/200 Hz,
+ * Crossfire 50/150 Hz) from precise per-packet arrival timestamps.
+ *
+ * For every candidate rate the analyzer keeps an exponentially decayed
+ * phase vector of arrival times modulo the candidate period. Arrivals from
+ * an emitter at that rate stay phase coherent even when most packets are
+ * missed (the emitter hops away from the channel being monitored), while
+ * unrelated arrivals average out. Memory is fixed per analyzer and each
+ * update costs one table lookup per candidate rate.
+ */
+
+#ifndef INTERARRIVAL_H
+#define INTERARRIVAL_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// Rate Mode Definitions
+// ============================================================================
+
+/**
+ * Candidate packet rate modes (bit positions for rate masks)
+ */
+typedef enum {
+    RATE_25HZ,
+    RATE_50HZ,
+    RATE_100HZ,
+    RATE_150HZ,
+    RATE_200HZ,
+    RATE_250HZ,
+    RATE_333HZ,
+    RATE_500HZ,
+    RATE_1000HZ,
+    NUM_RATE_MODES,
+    RATE_UNKNOWN = NUM_RATE_MODES
+} PacketRateMode;
+
+#define RATE_MASK(mode)             (1U << (mode))
+
+#define INTERARRIVAL_DECAY          0.97f     // Per-packet weight decay
+#define INTERARRIVAL_MIN_PACKETS    8         // Packets before classifying
+#define INTERARRIVAL_COHERENCE_MIN  0.8f      // Phase coherence to accept a rate
+
+/**
+ * Streaming inter-arrival state for one emitter
+ */
+typedef struct {
+    float sumCos[NUM_RATE_MODES];   // Decayed phase vector, real part
+    float sumSin[NUM_RATE_MODES];   // Decayed phase vector, imaginary part
+    float weight;                   // Decayed packet count
+    uint32_t originUs;              // Timestamp of first arrival
+    uint32_t lastUs;                // Timestamp of previous arrival
+    uint32_t minDeltaUs;            // Shortest inter-arrival seen
+    uint32_t packets;               // Total arrivals
+} InterArrivalAnalyzer;
+
+// ============================================================================
+// Analyzer Functions
+// ============================================================================
+
+/**
+ * Reset analyzer state
+ * @param analyzer Analyzer to reset
+ */
+void interArrivalReset(InterArrivalAnalyzer* analyzer);
+
+/**
+ * Add one packet arrival
+ * @param analyzer Analyzer to update
+ * @param timestampUs Arrival time in microseconds
+ */
+void interArrivalUpdate(InterArrivalAnalyzer* analyzer, uint32_t timestampUs);
+
+/**
+ * Classify the packet rate mode
+ * @param analyzer Analyzer to query
+ * @param coherence Optional output for the winning phase coherence (0-1)
+ * @return Detected rate mode or RATE_UNKNOWN
+ */
+PacketRateMode interArrivalClassify(const InterArrivalAnalyzer* analyzer, float* coherence);
+
+/**
+ * Get the packet rate of a rate mode
+ * @param mode Rate mode
+ * @return Packet rate in Hz (0 for RATE_UNKNOWN)
+ */
+uint16_t getPacketRateHz(PacketRateMode mode);
+
+#endif // INTERARRIVAL_H
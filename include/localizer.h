@@ -0,0 +1,73 @@
+/**
+ * Localizer Module Header
+ *
+ * Estimates emitter positions from geotagged RSSI observations, e.g. one
+ * node driven past an emitter or several fixed nodes (on the host
+ * aggregator, tools/report_aggregator.py runs the same filter on a larger
+ * grid).
+ *
+ * Each localized emitter owns a position filter of localizer_grid.h,
+ * centred on where it was first heard.
+ */
+
+#ifndef LOCALIZER_H
+#define LOCALIZER_H
+
+#include <Arduino.h>
+#include "gps.h"
+#include "localizer_grid.h"
+
+// ============================================================================
+// Localizer Configuration
+// ============================================================================
+
+#define LOCALIZER_ENABLED           true      // Localize drone emitters from GPS-tagged RSSI
+#define LOCALIZER_MAX_EMITTERS      4         // Emitters localized at once
+#define LOCALIZER_TIMEOUT_MS        600000UL  // Idle time before an emitter is reusable
+#define LOCALIZER_PRINT_MS          10000     // Interval of "LOC," serial lines
+
+/**
+ * Position estimate of one emitter
+ */
+typedef struct {
+    uint32_t key;               // Emitter identity key
+    double latitude;            // Estimated latitude (degrees)
+    double longitude;           // Estimated longitude (degrees)
+    float uncertaintyM;         // Radial 1-sigma uncertainty (m)
+    uint16_t observations;      // Observations committed to the grid
+} LocalizerEstimate;
+
+// ============================================================================
+// Localizer Functions
+// ============================================================================
+
+/**
+ * Initialize (clear) all emitter grids
+ */
+void localizerInit();
+
+/**
+ * Feed one RSSI observation of an emitter
+ * @param key Emitter identity key
+ * @param rssi Packet RSSI (dBm)
+ * @param fix Observer position
+ * @return true if the observation was committed to the emitter's grid
+ */
+bool localizerObserve(uint32_t key, float rssi, const GpsFix* fix);
+
+/**
+ * Get the current position estimate of an emitter
+ * @param key Emitter identity key
+ * @param estimate Output estimate
+ * @return true if the emitter has enough observations for an estimate
+ */
+bool localizerGetEstimate(uint32_t key, LocalizerEstimate* estimate);
+
+/**
+ * Print "LOC,<key>,<lat>,<lon>,<uncertainty m>,<observations>" lines for
+ * emitters updated since the last call, every LOCALIZER_PRINT_MS
+ * Call regularly from the main loop
+ */
+void localizerService();
+
+#endif // LOCALIZER_H
@@ -0,0 +1,114 @@
+/**
+ * Localizer Grid Module Header
+ *
+ * The position filter of one emitter as plain functions on a state struct.
+ * It has no Arduino dependencies, so the native unit tests run the same
+ * filter on the simulated drive-by scenario of tools/report_aggregator.py
+ * --benchmark; src/localizer.cpp keeps one grid per localized emitter.
+ *
+ * The grid holds candidate positions centred on where the emitter was
+ * first heard. Observations follow a log-distance path loss model,
+ * RSSI = P - 10 n log10(d), with the transmit power P unknown. For every
+ * cell the grid keeps the running mean and squared deviation of
+ * z = RSSI + 10 n log10(d); the spread of z is the model misfit with P
+ * eliminated, so the posterior over cells is exp(-misfit / 2 sigma^2).
+ * Updates are O(cells), incremental and allocation free.
+ *
+ * Repeated observations from one spot add fading noise but no geometry, so
+ * they are averaged and only committed to the grid once the observer has
+ * moved LOCALIZER_MIN_SPACING_M away. A single fixed observer therefore
+ * never produces an estimate.
+ *
+ * The grid covers LOCALIZER_GRID x LOCALIZER_CELL_M metres. When the
+ * estimate nears its edge, the grid is moved onto the estimate and rebuilt
+ * from the last LOCALIZER_HISTORY committed observations.
+ */
+
+#ifndef LOCALIZER_GRID_H
+#define LOCALIZER_GRID_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Localizer Grid Configuration
+// ============================================================================
+
+#define LOCALIZER_GRID              24        // Grid cells per side
+#define LOCALIZER_CELL_M            75.0f     // Grid cell size (m), 1.8 km square
+#define LOCALIZER_PATH_LOSS_EXP     2.7f      // Path loss exponent n
+#define LOCALIZER_RSSI_SIGMA_DB     6.0f      // RSSI fading standard deviation
+#define LOCALIZER_ANTENNA_M         2.0f      // Height difference floor on distance
+#define LOCALIZER_MIN_SPACING_M     15.0f     // Observer movement between observations
+#define LOCALIZER_MIN_OBSERVATIONS  5         // Observations before an estimate
+#define LOCALIZER_HISTORY           48        // Observations kept for recentring
+#define LOCALIZER_RECENTRE_CELLS    3         // Recentre when the estimate is this close to the edge
+
+#define LOCALIZER_CELLS             (LOCALIZER_GRID * LOCALIZER_GRID)
+
+/**
+ * Averaged observation committed to a grid
+ */
+typedef struct {
+    float x;                        // Observer position (m)
+    float y;
+    float rssi;                     // Averaged RSSI (dBm)
+} LocalizerObservation;
+
+/**
+ * Position filter of one emitter
+ */
+typedef struct {
+    double originLat;               // Grid centre latitude (degrees)
+    double originLon;               // Grid centre longitude (degrees)
+    float metresPerDegLon;          // Longitude scale at the origin
+    uint16_t observations;          // Observations committed
+
+    // Observations from the current spot, not yet committed
+    float pendingX;                 // Observer position (m)
+    float pendingY;
+    float pendingRssiSum;           // Sum of RSSI (dBm)
+    uint16_t pendingCount;          // Observations averaged
+
+    // Latest committed observations, replayed when the grid recentres
+    LocalizerObservation history[LOCALIZER_HISTORY];
+    uint8_t historyNext;
+    uint8_t historyCount;
+
+    float mean[LOCALIZER_CELLS];    // Running mean of z per cell
+    float m2[LOCALIZER_CELLS];      // Running sum of squared deviations of z
+} LocalizerGrid;
+
+// ============================================================================
+// Localizer Grid Functions
+// ============================================================================
+
+/**
+ * Clear a grid and centre it on a position
+ * @param grid Filter state
+ * @param latitude Grid centre latitude (degrees)
+ * @param longitude Grid centre longitude (degrees)
+ */
+void localizerGridInit(LocalizerGrid* grid, double latitude, double longitude);
+
+/**
+ * Feed one RSSI observation
+ * @param grid Filter state
+ * @param rssi Packet RSSI (dBm)
+ * @param latitude Observer latitude (degrees)
+ * @param longitude Observer longitude (degrees)
+ * @return true if an averaged observation was committed to the grid
+ */
+bool localizerGridObserve(LocalizerGrid* grid, float rssi, double latitude, double longitude);
+
+/**
+ * Get the position estimate
+ * @param grid Filter state
+ * @param latitude Output latitude (degrees)
+ * @param longitude Output longitude (degrees)
+ * @param uncertaintyM Output radial 1-sigma uncertainty (m)
+ * @return true if the grid has enough observations for an estimate
+ */
+bool localizerGridEstimate(const LocalizerGrid* grid, double* latitude, double* longitude,
+                           float* uncertaintyM);
+
+#endif // LOCALIZER_GRID_H
@@ -0,0 +1,146 @@
+/**
+ * Lock-On Module Header
+ *
+ * The sweep listens to each channel with one fixed parameter set, so an
+ * emitter on other LoRa SF/BW or FSK bit rate/deviation settings shows up
+ * as energy but is never demodulated. When a scanner sees energy well
+ * above a channel's detection threshold, or a packet fails to read (right
+ * channel, wrong or marginal parameters), it leaves the sweep and locks on:
+ *
+ *   SEARCH  Tries the parameter candidates in turn on that channel, each
+ *           for its own listen window. Candidates are ordered by prior
+ *           likelihood: signatures seen recently by the analysis stage and
+ *           candidates that demodulated before come first, then the
+ *           database order. Modulations the scanner is not assigned are
+ *           skipped.
+ *   FOLLOW  After the first packet the scanner stays on the channel with
+ *           those parameters; every packet extends the stay by
+ *           LOCK_FOLLOW_MS.
+ *
+ * A session never keeps a scanner away from its sweep for longer than
+ * LOCK_MAX_AWAY_MS, and a scanner waits LOCK_COOLDOWN_MS between sessions,
+ * so the sweep's revisit time stays bounded. Each session ends with
+ *   LOCK,<scanner>,<MHz>,<result>,<parameters>,<candidates tried>,
+ *        <time to demodulation us>,<time away us>
+ * and the means and maxima are kept for "stats". Packets received while
+ * locked go through the normal event stream with the parameters they were
+ * received with.
+ */
+
+#ifndef LOCK_ON_H
+#define LOCK_ON_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+#include "scanner_task.h"
+
+// ============================================================================
+// Lock-On Configuration
+// ============================================================================
+
+#define LOCK_ON_ENABLED             true      // Lock on to energy outside the sweep parameters
+#define LOCK_TRIGGER_MARGIN_DB      3.0f      // Energy above the detection threshold to trigger
+#define LOCK_MAX_AWAY_MS            2500      // Longest a session keeps a scanner off its sweep
+#define LOCK_SEARCH_MS              800       // Time for the parameter search
+#define LOCK_FOLLOW_MS              1000      // Stay per demodulated packet
+#define LOCK_COOLDOWN_MS            5000      // Time between sessions of one scanner
+#define LOCK_SIGNATURE_WEIGHT       1         // Order score per recent signature detection
+#define LOCK_HIT_WEIGHT             4         // Order score per earlier demodulation
+#define LOCK_SCORE_MAX              1000      // Cap of the adaptive order scores
+
+/**
+ * Lock-on statistics
+ */
+typedef struct {
+    uint32_t sessions;          // Sessions started
+    uint32_t demodulated;       // Sessions that demodulated a packet
+    uint32_t packets;           // Packets received while locked
+    float timeToDemodMeanUs;    // EWMA of trigger to first packet
+    uint32_t timeToDemodMaxUs;  // Worst trigger to first packet
+    float awayMeanUs;           // EWMA of time away from the sweep per session
+    uint32_t awayMaxUs;         // Longest session
+    uint32_t awayTotalMs;       // Time away from the sweep, all scanners
+} LockOnStats;
+
+// ============================================================================
+// Lock-On Functions
+// ============================================================================
+
+/**
+ * Enable or disable lock-on (sessions in progress finish)
+ * @param enable true to lock on to triggers
+ */
+void lockOnEnable(bool enable);
+
+/**
+ * Check whether lock-on is enabled
+ */
+bool lockOnEnabled();
+
+/**
+ * Check a background sample for a lock-on trigger (scanner task)
+ * @param scanner Scanner that took the sample
+ * @param rssi Background RSSI in dBm
+ * @return true if a session should start
+ */
+bool lockOnEnergyTrigger(const DroneScanner* scanner, float rssi);
+
+/**
+ * Start a session on the scanner's current channel and configure the
+ * first candidate (scanner task, bus lock held)
+ * @param scanner Scanner
+ * @param triggerUs Counter time of the trigger
+ * @return true if a session started
+ */
+bool lockOnStart(DroneScanner* scanner, int64_t triggerUs);
+
+/**
+ * Check whether a scanner is locked on
+ */
+bool lockOnActive(uint8_t index);
+
+/**
+ * Listen window before the next lockOnStep() call
+ * @param index Scanner number
+ * @param nowUs Counter time
+ * @return Window in microseconds
+ */
+uint32_t lockOnWindowUs(uint8_t index, int64_t nowUs);
+
+/**
+ * Account a packet received while locked (scanner task)
+ * @param scanner Scanner
+ * @param irqUs Counter time of the packet interrupt
+ */
+void lockOnPacket(DroneScanner* scanner, int64_t irqUs);
+
+/**
+ * Fill in the parameters a packet was received with while locked
+ * @param index Scanner number
+ * @param event Packet event
+ */
+void lockOnAnnotate(uint8_t index, ScanEvent* event);
+
+/**
+ * Advance a session at the end of a listen window (scanner task, bus
+ * lock held): next candidate, keep following, or end
+ * @param scanner Scanner
+ * @param nowUs Counter time
+ * @return true while the session continues (radio possibly reconfigured);
+ *         false once it ended and the scanner's sweep modulation is restored
+ */
+bool lockOnStep(DroneScanner* scanner, int64_t nowUs);
+
+/**
+ * Tell the candidate order which protocol the analysis stage saw (main loop)
+ * @param signatureIndex Signature database index
+ */
+void lockOnNoteSignature(int signatureIndex);
+
+/**
+ * Get lock-on statistics
+ * @param stats Output statistics
+ */
+void lockOnGetStats(LockOnStats* stats);
+
+#endif // LOCK_ON_H
@@ -0,0 +1,133 @@
+/**
+ * Low Power Module Header
+ *
+ * Battery scan mode. Two mechanisms cut current draw:
+ * - The SX1262 listens in RX duty cycle ("sniff") mode. It sleeps and
+ *   wakes periodically for a window just long enough to detect a preamble,
+ *   and stays in RX for the rest of the packet once a preamble is found.
+ * - The ESP32-S3 enters light sleep whenever all scanner tasks are waiting.
+ *   DIO1 (GPIO wakeup) or the next esp_timer alarm (dwell end) wakes it.
+ *
+ * Each duty-cycle setting trades current for detection probability. A
+ * packet is caught if an RX window overlaps its preamble by at least the
+ * preamble detection time. Every retune restarts the duty cycle with a
+ * window, so P(packet) is the share of preamble start times within a dwell
+ * that some window catches. An emitter sending one packet per
+ * LOW_POWER_TARGET_INTERVAL_MS is seen in a dwell with
+ * P(dwell) = 1 - (1 - P(packet))^k, where k is the number of packets per
+ * dwell. A scanner revisits a channel every R = channels x dwell, in each
+ * of its M modulations in turn. The mean time to first detection is then
+ * about M R (1 / P(dwell) - 1/2).
+ *
+ * lowPowerInit() prints one "DUTY," line per setting and modulation, with
+ * the modelled current and battery life. While the mode runs,
+ * lowPowerReport() adds the measured CPU sleep fraction. Serial output over
+ * USB and GPS NMEA are lost while the CPU sleeps.
+ */
+
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Low Power Configuration
+// ============================================================================
+
+#define LOW_POWER_ENABLED           false     // Duty-cycled RX and light sleep
+#define LOW_POWER_SETTING           3         // Duty-cycle setting (0 = continuous RX)
+#define LOW_POWER_RADIO_WAKE_US     400       // SX1262 sleep to RX (warm start, TCXO)
+#define LOW_POWER_LORA_PREAMBLE     8         // Emitter LoRa preamble symbols assumed
+#define LOW_POWER_LORA_DETECT_SYMBOLS   4     // LoRa preamble symbols needed to detect
+#define LOW_POWER_FSK_DETECT_BITS   8         // FSK/OOK preamble bits needed to detect
+#define LOW_POWER_NOISE_SETTLE_US   500       // Continuous RX before a noise sample
+#define LOW_POWER_MIN_SLEEP_US      3000      // Shorter idle periods stay awake
+#define LOW_POWER_WAKE_MARGIN_US    1000      // Wake this early for the next timer
+#define LOW_POWER_TARGET_INTERVAL_MS    100   // Packet interval of the modelled emitter
+
+// Current draw (mA) for the power model
+#define LOW_POWER_RX_MA             5.3f      // SX1262 RX, boosted gain
+#define LOW_POWER_RADIO_SLEEP_MA    0.0016f   // SX1262 sleep with configuration retention
+#define LOW_POWER_CPU_ACTIVE_MA     45.0f     // ESP32-S3 at 240 MHz, mostly idle
+#define LOW_POWER_CPU_SLEEP_MA      0.25f     // ESP32-S3 light sleep
+#define LOW_POWER_CPU_AWAKE_EST     0.05f     // CPU awake fraction assumed before measuring
+#define LOW_POWER_BOARD_MA          28.0f     // GPS, PMU and regulators (display dark)
+#define LOW_POWER_BATTERY_MAH       3000.0f   // 18650 cell
+
+#define LOW_POWER_SETTINGS          6         // Entries in the duty-cycle table
+
+/**
+ * RX duty-cycle timing for one modulation
+ */
+typedef struct {
+    uint32_t rxUs;              // RX window
+    uint32_t sleepUs;           // Sleep between windows (0 = continuous RX)
+    float preambleUs;           // Emitter preamble length
+    float detectUs;             // Preamble needed for detection
+} LowPowerWindow;
+
+/**
+ * Low power statistics
+ */
+typedef struct {
+    uint32_t sleeps;            // Light sleeps entered
+    uint32_t timerWakeups;      // Woken by a timer
+    uint32_t radioWakeups;      // Woken by DIO1
+    uint64_t asleepUs;          // Total time in light sleep
+    float cpuAsleep;            // Fraction of the last report interval asleep
+} LowPowerStats;
+
+// ============================================================================
+// Low Power Functions
+// ============================================================================
+
+/**
+ * Print the modelled detection and power figures of every setting
+ * @param scanner Scanner whose sub-band and modulations are modelled
+ * @param radios Number of radios scanning
+ */
+void lowPowerInit(const DroneScanner* scanner, uint8_t radios);
+
+/**
+ * Check whether the low-power scan mode is active
+ * @return true if scanners duty-cycle the radio and the CPU may sleep
+ */
+bool lowPowerEnabled();
+
+/**
+ * RX duty-cycle timing of the active setting
+ * @param scanner Scanner, for its current modulation, capture bit rate and
+ *                LoRa parameters
+ * @param window Output timing
+ * @return true if the radio should duty-cycle, false for continuous RX
+ */
+bool lowPowerGetWindow(const DroneScanner* scanner, LowPowerWindow* window);
+
+/**
+ * Wake the CPU from light sleep when a scanner's DIO1 pin goes high
+ * @param scanner Scanner index
+ * @param pin DIO1 GPIO number
+ */
+void lowPowerAddWakePin(uint8_t scanner, int pin);
+
+/**
+ * Light sleep until the next timer alarm or radio interrupt, if every
+ * scanner task is waiting
+ * @param maxUs Longest sleep (bounds how late the main loop runs)
+ * @return true if the CPU slept
+ */
+bool lowPowerSleep(uint32_t maxUs);
+
+/**
+ * Print measured sleep statistics and the resulting current estimate
+ */
+void lowPowerReport();
+
+/**
+ * Get low power statistics
+ * @param stats Output statistics
+ */
+void lowPowerGetStats(LowPowerStats* stats);
+
+#endif // LOW_POWER_H
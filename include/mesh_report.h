@@ -0,0 +1,126 @@
+/**
+ * Mesh Report Module Header
+ *
+ * Shares this node's emitter picture with other nodes. Instead of raw
+ * detections, a report carries compact summaries of the active emitter
+ * tracks (15 bytes each), batched into one LoRa frame.
+ *
+ * Reporting must never starve the scan schedule:
+ * - Reports are only built in this node's time slot of the report period
+ *   (slot = node ID modulo REPORT_SLOTS), so nodes sharing a channel do not
+ *   collide.
+ * - Airtime is limited by a token bucket to REPORT_DUTY_PERMILLE of the time.
+ * - Transmission happens in the default scanner task, between two dwells,
+ *   early in the node's slot (REPORT_TX_GUARD_MS to REPORT_TX_WINDOW_MS
+ *   after it opens). Relayed frames wait for the relaying node's slot too.
+ *
+ * The scanners listen with the scan PHY, which never demodulates a report,
+ * so the default scanner leaves the sweep for a listen window with the
+ * report PHY at the start of every other node's slot (REPORT_LISTEN_MS,
+ * about an eighth of its time). Slots line up across nodes only once their
+ * timebases are locked to PPS, so a node without lock does not listen.
+ *
+ * Reports carry the originator's GPS position, so the aggregator can
+ * localize emitters from the RSSI seen by several nodes.
+ *
+ * Report frames heard from other nodes are de-duplicated, forwarded to the
+ * serial port as "RPT,<hex>" lines for tools/report_aggregator.py, and
+ * relayed while their hop limit lasts. The frame format and these
+ * decisions live in report_codec.h.
+ */
+
+#ifndef MESH_REPORT_H
+#define MESH_REPORT_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+#include "report_codec.h"
+
+// ============================================================================
+// Report Configuration
+// ============================================================================
+
+#define REPORT_ENABLED          true      // Transmit detection reports
+#define REPORT_FREQUENCY        927.5f    // Report channel (MHz)
+#define REPORT_BANDWIDTH        250.0f    // Report LoRa bandwidth (kHz)
+#define REPORT_SPREADING_FACTOR 7         // Report LoRa spreading factor
+#define REPORT_CODING_RATE      5         // Report LoRa coding rate (4/5)
+#define REPORT_SYNC_WORD        0x2B      // Distinguishes reports from other LoRa traffic
+#define REPORT_TX_POWER         14        // Report transmit power (dBm)
+
+#define REPORT_PERIOD_S         30        // Report period (one slot per node per period)
+#define REPORT_SLOTS            10        // Time slots per period
+#define REPORT_SLOT_MS          (REPORT_PERIOD_S * 1000 / REPORT_SLOTS)
+#define REPORT_TX_GUARD_MS      100       // Slot start left to listeners still finishing a dwell
+#define REPORT_TX_WINDOW_MS     250       // Frames start no later than this into the slot
+#define REPORT_LISTEN_MS        400       // Listen window at the start of other nodes' slots
+#define REPORT_DUTY_PERMILLE    10        // Max share of time spent transmitting (1%)
+
+/**
+ * Report statistics
+ */
+typedef struct {
+    uint32_t sent;              // Own reports transmitted
+    uint32_t relayed;           // Reports relayed for other nodes
+    uint32_t received;          // Valid reports heard from other nodes
+    uint32_t duplicates;        // Reports heard again and ignored
+    uint32_t throttled;         // Frames dropped by the airtime budget
+    uint32_t airtimeMs;         // Total time spent transmitting
+    uint32_t listenMs;          // Total time spent in report listen windows
+} ReportStats;
+
+// ============================================================================
+// Report Functions
+// ============================================================================
+
+/**
+ * Initialize reporting (node ID from the MAC address)
+ */
+void meshReportInit();
+
+/**
+ * Build a report from the track table when this node's slot is open
+ * Call regularly from the main loop
+ */
+void meshReportService();
+
+/**
+ * Transmit a pending frame, if any, then leave the radio for the caller to
+ * retune. Called from the default scanner task at a dwell boundary with
+ * the SPI bus held.
+ * @param radio Radio to transmit on
+ * @return true if the radio was used (caller must reconfigure it)
+ */
+bool meshReportTransmit(SX1262* radio);
+
+/**
+ * Open a listen window on the report channel if another node's slot has
+ * just started. Called from the default scanner task at a dwell boundary
+ * with the SPI bus held; the caller retunes the radio when the window ends.
+ * @param radio Radio to listen with
+ * @param windowUs Output length of the window
+ * @return true if the radio is now receiving on the report channel
+ */
+bool meshReportListen(SX1262* radio, uint32_t* windowUs);
+
+/**
+ * Handle a received packet that may be a report from another node
+ * @param data Packet bytes
+ * @param length Packet length
+ * @return true if the packet was a report (not a detection)
+ */
+bool meshReportReceive(const uint8_t* data, size_t length);
+
+/**
+ * Get this node's report identifier
+ * @return Node ID
+ */
+uint16_t meshReportNodeId();
+
+/**
+ * Get report statistics
+ * @param stats Output statistics
+ */
+void meshReportGetStats(ReportStats* stats);
+
+#endif // MESH_REPORT_H
@@ -0,0 +1,95 @@
+/**
+ * Noise Floor Module Header
+ *
+ * Per-(channel, modulation) background RSSI estimation used to express
+ * detection thresholds and confidence relative to the local RF environment
+ * instead of absolute dBm constants.
+ *
+ * Each cell keeps, in fixed memory:
+ * - A streaming low-percentile estimate (frugal quantile) used to gate out
+ *   samples that contain signal energy
+ * - An EWMA of the gated samples (the noise floor) and of their absolute
+ *   deviation (the noise spread)
+ *
+ * Estimates are saved to NVS periodically, and more often to RTC memory,
+ * and restored at boot so the detector is calibrated immediately after
+ * power-up (from NVS) or a reset (from RTC memory).
+ */
+
+#ifndef NOISE_FLOOR_H
+#define NOISE_FLOOR_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Noise Floor Configuration
+// ============================================================================
+
+#define NOISE_FLOOR_CHANNELS        64        // Max sweep channels tracked
+#define NOISE_FLOOR_MODULATIONS     3         // LoRa, FSK, OOK
+#define NOISE_FLOOR_DEFAULT_DBM     -120.0f   // Floor assumed before calibration
+#define NOISE_FLOOR_QUANTILE        0.25f     // Percentile tracked for gating
+#define NOISE_FLOOR_GATE_DB         6.0f      // Samples above quantile + gate are not noise
+#define NOISE_FLOOR_EWMA_ALPHA      0.05f     // EWMA weight of each new sample
+#define NOISE_FLOOR_MIN_SAMPLES     16        // Samples before a cell is trusted
+#define NOISE_FLOOR_SAMPLE_MS       10        // Min interval between RSSI samples
+#define NOISE_FLOOR_SAVE_MS         900000UL  // Persist estimates every 15 minutes
+#define NOISE_FLOOR_RTC_SAVE_MS     5000UL    // Copy estimates to RTC memory every 5 s
+
+// Detection threshold relative to the floor (defaults, see noiseFloorSetThresholds)
+#define NOISE_DETECT_MARGIN_DB      6.0f      // Minimum margin above floor
+#define NOISE_DETECT_SPREAD_K       3.0f      // Margin in units of noise spread
+
+// Confidence RSSI term: floor = 0%, floor + span = full RSSI score
+#define NOISE_CONFIDENCE_SPAN_DB    60.0f
+
+// ============================================================================
+// Noise Floor Functions
+// ============================================================================
+
+/**
+ * Initialize estimator cells and restore saved estimates from RTC memory
+ * (after a reset) or NVS
+ * @return true if saved estimates were restored
+ */
+bool noiseFloorInit();
+
+/**
+ * Feed one background RSSI sample
+ * @param channel Sweep channel index
+ * @param modulation Modulation the radio was configured for
+ * @param rssi Instantaneous RSSI in dBm
+ */
+void noiseFloorUpdate(int channel, ModulationType modulation, float rssi);
+
+/**
+ * Get the estimated noise floor
+ * @param channel Sweep channel index (-1 for band-wide estimate)
+ * @param modulation Modulation type
+ * @return Noise floor in dBm (NOISE_FLOOR_DEFAULT_DBM until calibrated)
+ */
+float noiseFloorGet(int channel, ModulationType modulation);
+
+/**
+ * Get the detection threshold for a cell
+ * @param channel Sweep channel index
+ * @param modulation Modulation type
+ * @return RSSI in dBm a signal must exceed to be considered present
+ */
+float noiseFloorThreshold(int channel, ModulationType modulation);
+
+/**
+ * Set the detection threshold relative to the floor
+ * @param marginDb Minimum margin above the floor (dB)
+ * @param spreadK Margin in units of noise spread
+ */
+void noiseFloorSetThresholds(float marginDb, float spreadK);
+
+/**
+ * Persist estimates to RTC memory and NVS if their save intervals have elapsed
+ * @param force Save regardless of interval
+ */
+void noiseFloorService(bool force);
+
+#endif // NOISE_FLOOR_H
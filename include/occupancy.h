@@ -0,0 +1,150 @@
+/**
+ * Occupancy Module Header
+ *
+ * Spectrum occupancy history in PSRAM. Time is cut into rows of
+ * OCC_ROW_MS (about two sweeps at the default settings) and each row holds,
+ * for every sweep channel, the peak RSSI seen quantised to 8 bits and an
+ * activity bit: a packet was received, or a background sample rose above
+ * the channel's detection threshold. OCC_ROWS rows form a ring covering
+ * the last hour.
+ *
+ * Storage is column-major: one channel's rows are contiguous, so a
+ * channel's history is read in one pass. Next to the activity bits each
+ * channel keeps a running count of active rows, stored per row when the
+ * row opens. The active rows of a channel in any window are then one
+ * subtraction, and range, top-K and new-activity queries cost
+ * O(channels) however long the window.
+ */
+
+#ifndef OCCUPANCY_H
+#define OCCUPANCY_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Occupancy Configuration
+// ============================================================================
+
+#define OCC_CHANNELS                64        // Max sweep channels tracked
+#define OCC_ROW_MS                  5000      // Time per history row
+#define OCC_ROWS                    720       // Rows kept (1 hour)
+#define OCC_RSSI_MIN_DBM            -160.0f   // RSSI of quantised value 1
+#define OCC_RSSI_STEP_DB            0.5f      // Quantisation step (value 0 = no sample)
+#define OCC_TOP_MAX                 8         // Most channels returned by a top-K query
+
+/**
+ * Occupancy of a channel range over a window
+ */
+typedef struct {
+    uint16_t rows;              // Rows in the window
+    uint16_t channels;          // Channels in the range
+    uint32_t activeCells;       // Active (channel, row) cells
+    float occupancy;            // activeCells / (rows x channels)
+    int16_t busiestChannel;     // Channel with most active rows (-1 if none)
+    uint16_t busiestRows;       // Its active rows
+} OccupancyRange;
+
+/**
+ * One channel of a top-K or new-activity result
+ */
+typedef struct {
+    uint16_t channel;           // Sweep channel
+    uint16_t activeRows;        // Active rows in the window
+    float occupancy;            // Share of the window's rows active
+    uint32_t lastActiveAgoMs;   // Time since the channel was last active
+} OccupancyChannel;
+
+// ============================================================================
+// Occupancy Functions
+// ============================================================================
+
+/**
+ * Allocate and clear the history
+ */
+void occupancyInit();
+
+/**
+ * Record an RSSI observation in the current row (main loop)
+ * @param channel Sweep channel
+ * @param rssi RSSI in dBm
+ * @param active Packet received or energy above the detection threshold
+ */
+void occupancyNote(int channel, float rssi, bool active);
+
+/**
+ * Open new rows as time passes
+ * Call regularly from the main loop
+ */
+void occupancyService();
+
+/**
+ * Occupancy of a channel range
+ * @param firstChannel First sweep channel
+ * @param lastChannel Last sweep channel (inclusive)
+ * @param windowMs Window length ending now (rounded up to whole rows)
+ * @param result Output
+ * @return false if the range is invalid or no history exists
+ */
+bool occupancyQueryRange(int firstChannel, int lastChannel, uint32_t windowMs,
+                         OccupancyRange* result);
+
+/**
+ * Busiest channels over a window, most active first
+ * @param windowMs Window length ending now
+ * @param k Channels wanted (at most OCC_TOP_MAX)
+ * @param out Output array of k entries
+ * @return Channels returned (only channels with activity)
+ */
+uint8_t occupancyTopK(uint32_t windowMs, uint8_t k, OccupancyChannel* out);
+
+/**
+ * Channels active within the last sinceMs that were quiet for the rest of
+ * the history
+ * @param sinceMs Age of the start of the new period
+ * @param out Output array
+ * @param maxCount Entries in out
+ * @return Channels returned
+ */
+uint8_t occupancyNewSince(uint32_t sinceMs, OccupancyChannel* out, uint8_t maxCount);
+
+/**
+ * Copy a channel's recent quantised RSSI, oldest first
+ * @param channel Sweep channel
+ * @param rows Rows wanted
+ * @param rssi Output array of rows entries (0 = no sample)
+ * @return Rows copied
+ */
+uint16_t occupancyColumn(int channel, uint16_t rows, uint8_t* rssi);
+
+/**
+ * Copy one row of quantised RSSI across all channels
+ * @param rowsAgo Rows before the current one (0 = current row)
+ * @param rssi Output array of OCC_CHANNELS entries (0 = no sample)
+ * @return false if the row is not in the history
+ */
+bool occupancyRow(uint16_t rowsAgo, uint8_t* rssi);
+
+/**
+ * Check a channel's activity bit in one row
+ * @param channel Sweep channel
+ * @param rowsAgo Rows before the current one (0 = current row)
+ * @return true if the row is in the history and active
+ */
+bool occupancyRowActive(int channel, uint16_t rowsAgo);
+
+/**
+ * Quantise an RSSI as the history stores it
+ * @param rssi RSSI in dBm
+ * @return Quantised RSSI (1-255, 0 for NAN)
+ */
+uint8_t occupancyQuantize(float rssi);
+
+/**
+ * Convert a quantised RSSI back to dBm
+ * @param value Quantised RSSI
+ * @return RSSI in dBm (NAN for 0)
+ */
+float occupancyRssiDbm(uint8_t value);
+
+#endif // OCCUPANCY_H
@@ -0,0 +1,94 @@
+/**
+ * Packet Decoder Module Header
+ *
+ * Table-driven over-the-air decoders for demodulated 900MHz drone link
+ * packets. Decoders work in place on the captured payload buffer (no copies)
+ * and give a definitive protocol identification, rate mode and a stable
+ * per-transmitter identifier.
+ *
+ * Supported framings:
+ * - ExpressLRS v3 OTA4 (8 byte packets, CRC14, LoRa rates 25-200 Hz)
+ * - ExpressLRS v3 OTA8 (13 byte packets, CRC16, 100 Hz Full)
+ *
+ * ELRS seeds its packet CRC with bytes of the binding UID. The CRC is
+ * linear in that seed, so the seed of any packet can be solved for directly
+ * from its bytes, but any 8 or 13 byte LoRa packet yields some seed. A seed
+ * only becomes the transmitter identifier once a SYNC packet carrying the
+ * UID verifies against it, or once it has recurred DECODER_ID_CONFIRM
+ * times in a row with gaps that are whole numbers of ELRS packet periods
+ * (all 900 MHz rates send on a 5 ms grid). Until then the packet is not
+ * reported as decoded.
+ *
+ * ELRS sends in LoRa implicit header mode, with the IQ polarity chosen by
+ * the UID, so only the lock-on candidates configured that way
+ * (src/lock_on.cpp) demodulate it.
+ */
+
+#ifndef PACKET_DECODER_H
+#define PACKET_DECODER_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+#include "interarrival.h"
+
+// ============================================================================
+// Decoder Configuration
+// ============================================================================
+
+#define ELRS_OTA4_PACKET_SIZE   8         // OTA4 packet length in bytes
+#define ELRS_OTA8_PACKET_SIZE   13        // OTA8 packet length in bytes
+#define ELRS_CRC14_POLY         0x2E57    // OTA4 CRC polynomial
+#define ELRS_CRC16_POLY         0x3D65    // OTA8 CRC polynomial
+#define ELRS_OTA_VERSION_ID     4         // Mixed into the CRC seed (ELRS v3)
+#define ELRS_ID_TAG             0x45000000UL  // 'E' tag of decoded transmitter IDs
+#define DECODER_ID_SLOTS        8         // Candidate transmitter seeds tracked
+#define DECODER_ID_CONFIRM      4         // Timing-consistent sightings before trusting a seed
+#define DECODER_ID_MAX_GAP_MS   2000      // Longest gap between sightings that still counts
+#define ELRS_PACKET_GRID_US     5000      // Every ELRS 900 packet period is a multiple
+#define ELRS_TIMING_TOLERANCE_US 250      // Arrival jitter and clock drift allowed
+
+/**
+ * ELRS OTA packet types (low two bits of the first byte)
+ */
+typedef enum {
+    ELRS_PACKET_RC_DATA = 0,
+    ELRS_PACKET_MSP_DATA = 1,
+    ELRS_PACKET_SYNC = 2,
+    ELRS_PACKET_TLM_DATA = 3
+} ElrsPacketType;
+
+/**
+ * Result of decoding one packet
+ */
+typedef struct {
+    const char* protocol;       // Decoded protocol name
+    const char* signatureName;  // Related signature database entry
+    uint8_t packetType;         // Protocol-specific packet type
+    uint32_t transmitterId;     // Stable transmitter identifier (0 if unconfirmed)
+    PacketRateMode rateMode;    // Rate mode if the packet announces it
+    bool crcValid;              // CRC verified against a confirmed or announced seed
+} DecodedPacket;
+
+// ============================================================================
+// Decoder Functions
+// ============================================================================
+
+/**
+ * Build CRC tables and seed solvers
+ */
+void packetDecoderInit();
+
+/**
+ * Decode a demodulated packet in place
+ * @param data Captured payload bytes
+ * @param length Payload length in bytes
+ * @param modulation Modulation the packet was received with
+ * @param timestampUs Packet arrival time (micros)
+ * @param decoded Output decode result
+ * @return true if a decoder recognised the packet and confirmed its
+ *         transmitter
+ */
+bool decodePacket(const uint8_t* data, size_t length, ModulationType modulation,
+                  uint32_t timestampUs, DecodedPacket* decoded);
+
+#endif // PACKET_DECODER_H
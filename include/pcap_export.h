@@ -0,0 +1,100 @@
+/**
+ * Packet Capture Export Module Header
+ *
+ * Streams received packets as pcapng over the serial port for Wireshark
+ * and other standard tools. Each packet becomes an Enhanced Packet Block
+ * with link type LoRaTap (270): a LoRaTap v1 header carries frequency,
+ * bandwidth, SF, RSSI, channel noise, SNR, coding rate, FSK bit rate and
+ * the DIO1 counter timestamp, followed by the payload. The packet
+ * timestamp is PPS-disciplined UTC when the timebase is locked, otherwise
+ * time since boot. A packet comment adds what LoRaTap has no field for:
+ * scanner, modulation name (OOK is marked FSK in LoRaTap), exact bit rate
+ * and frequency error.
+ *
+ * Packets are encoded from the main loop's event straight into one of
+ * PCAP_BLOCKS large blocks; the scanner tasks are not involved. A full
+ * block is drained as text lines so it can share the serial port with the
+ * log output:
+ *   PCAP,<block>,<offset>,<block length>,<hex>
+ * Each line is written in one call and only when the serial TX buffer has
+ * room, so export never blocks the loop. A block holds whole pcapng blocks
+ * and the first block of a session starts with the section and interface
+ * headers, so a lost block costs only its packets. tools/pcap_capture.py
+ * turns a serial log or live stream back into a .pcapng file.
+ */
+
+#ifndef PCAP_EXPORT_H
+#define PCAP_EXPORT_H
+
+#include <Arduino.h>
+#include "scanner_task.h"
+
+// ============================================================================
+// Packet Capture Configuration
+// ============================================================================
+
+#define PCAP_AUTOSTART              false     // Export from boot (else console "pcap on")
+#define PCAP_BLOCK_BYTES            4096      // Batch size; holds whole pcapng blocks
+#define PCAP_BLOCKS                 2         // One filling while one drains
+#define PCAP_LINE_BYTES             96        // Block bytes per serial line
+#define PCAP_LINES_PER_PASS         16        // Serial lines written per service call
+#define PCAP_FLUSH_MS               250       // Send a partly filled block after this
+#define PCAP_SNAPLEN                512       // Interface snapshot length
+#define PCAP_LORA_SYNC_WORD         0x12      // Sync word the LoRa scan runs with (RadioLib default)
+
+/**
+ * Export statistics
+ */
+typedef struct {
+    bool running;               // Export session active
+    uint32_t packets;           // Packets encoded
+    uint32_t dropped;           // Packets lost to full blocks
+    uint32_t blocks;            // Blocks sent
+    uint32_t bytes;             // pcapng bytes sent
+} PcapExportStats;
+
+// ============================================================================
+// Packet Capture Functions
+// ============================================================================
+
+/**
+ * Allocate the blocks (starts a session if PCAP_AUTOSTART)
+ */
+void pcapExportInit();
+
+/**
+ * Start a session: a new pcapng section
+ */
+void pcapExportStart();
+
+/**
+ * Stop the session after sending what is buffered
+ */
+void pcapExportStop();
+
+/**
+ * Add a received packet to the capture (main loop)
+ * @param event Packet event
+ * @param noiseFloor Channel noise floor in dBm (NAN if unknown)
+ */
+void pcapExportPacket(const ScanEvent* event, float noiseFloor);
+
+/**
+ * Send buffered blocks as serial lines
+ * Call regularly from the main loop
+ */
+void pcapExportService();
+
+/**
+ * Check for buffered data not yet sent
+ * @return true if the loop should call pcapExportService() again soon
+ */
+bool pcapExportPending();
+
+/**
+ * Get export statistics
+ * @param stats Output statistics
+ */
+void pcapExportGetStats(PcapExportStats* stats);
+
+#endif // PCAP_EXPORT_H
@@ -0,0 +1,71 @@
+/**
+ * Protocol Fingerprint Module Header
+ *
+ * Identifies unknown FSK/OOK protocols from raw captures taken with sync
+ * word matching disabled (see configureFSKCaptureMode()).
+ *
+ * A fingerprint is extracted from the raw bit stream:
+ * - Bit rate estimate from preamble run lengths
+ * - Header word (first 16 bits after the preamble) and its hash
+ * - Length hint (first byte after the header word)
+ *
+ * It is then looked up in a compact open-addressing hash table built from
+ * the known protocol list at init.
+ */
+
+#ifndef PROTOCOL_FINGERPRINT_H
+#define PROTOCOL_FINGERPRINT_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// Fingerprint Configuration
+// ============================================================================
+
+#define RAW_CAPTURE_LENGTH      32        // Bytes captured per raw FSK/OOK packet
+#define FINGERPRINT_MIN_PREAMBLE 8        // Alternating bits required before header
+#define FINGERPRINT_TABLE_SIZE  32        // Hash table slots (power of two)
+#define FINGERPRINT_ANY_RATE    0xFF      // Table wildcard for bit rate class
+
+/**
+ * Fingerprint extracted from one raw capture
+ */
+typedef struct {
+    float bitrateKbps;          // Estimated over-the-air bit rate (kbps)
+    uint8_t bitrateClass;       // Half-octave bit rate bucket
+    uint16_t headerWord;        // First 16 bits after the preamble
+    uint32_t headerHash;        // FNV-1a hash of the header word bytes
+    uint8_t length;             // First byte after the header word
+    const char* name;           // Identified protocol (NULL if unknown)
+    bool isDrone;               // Identified protocol is a drone link
+    int8_t signatureIndex;      // Related signature database entry (-1 if none)
+} ProtocolFingerprint;
+
+// ============================================================================
+// Fingerprint Functions
+// ============================================================================
+
+/**
+ * Build the known-protocol hash table
+ */
+void fingerprintInit();
+
+/**
+ * Extract a fingerprint from a raw capture and look it up
+ * @param data Raw captured bytes
+ * @param length Number of captured bytes
+ * @param captureBitrate Bit rate the radio sampled at (kbps)
+ * @param fingerprint Output fingerprint (filled even when no match)
+ * @return true if the capture matched a known protocol
+ */
+bool fingerprintCapture(const uint8_t* data, size_t length, float captureBitrate,
+                        ProtocolFingerprint* fingerprint);
+
+/**
+ * Convert a bit rate to its half-octave class
+ * @param bitrateKbps Bit rate in kbps
+ * @return Bit rate class
+ */
+uint8_t fingerprintBitrateClass(float bitrateKbps);
+
+#endif // PROTOCOL_FINGERPRINT_H
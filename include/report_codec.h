@@ -0,0 +1,152 @@
+/**
+ * Report Codec Module Header
+ *
+ * Frame format of the mesh detection reports and the per-frame decisions
+ * of a node: encoding its own report, accepting a heard frame, dropping
+ * duplicates and preparing the relay copy. The codec has no Arduino
+ * dependencies, so the native unit tests run it for several simulated
+ * nodes; src/mesh_report.cpp schedules, transmits and listens around it,
+ * and tools/report_aggregator.py implements the same format.
+ *
+ * Frame layout (little-endian):
+ *   ReportHeader, count ReportEntry records, CRC-32 (IEEE, as zlib.crc32)
+ *   of everything before it.
+ * A relay copy differs from the frame heard only in its hop count and CRC.
+ */
+
+#ifndef REPORT_CODEC_H
+#define REPORT_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Report Codec Configuration
+// ============================================================================
+
+#define REPORT_MAX_ENTRIES      8         // Track summaries per frame
+#define REPORT_HOP_LIMIT        2         // Relays allowed for a report
+#define REPORT_SEEN_CACHE       16        // Reports remembered for de-duplication
+
+#define REPORT_MAGIC            0xD7      // First byte of every report frame
+#define REPORT_VERSION          2         // Frame format version
+#define REPORT_NO_POSITION      INT32_MIN // Position field of a node without GPS fix
+
+/**
+ * Report frame header
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t magic;              // REPORT_MAGIC
+    uint8_t versionHops;        // Version (high nibble), relays remaining (low nibble)
+    uint16_t nodeId;            // Originating node
+    uint16_t sequence;          // Per-node report counter
+    uint32_t timeS;             // Originator UTC (s) when PPS locked, otherwise log time
+    int32_t latitudeE7;         // Originator latitude (1e-7 degrees, REPORT_NO_POSITION if unknown)
+    int32_t longitudeE7;        // Originator longitude (1e-7 degrees)
+    uint8_t count;              // ReportEntry records following
+} ReportHeader;
+
+/**
+ * Emitter track summary carried in a report
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t key;               // Track key (decoded transmitter ID or protocol key)
+    uint16_t frequencyKHz;      // Last frequency above FREQ_900_MIN (kHz)
+    int8_t signatureIndex;      // Matched signature (-1 if none)
+    uint8_t modulationRate;     // Modulation (bits 4-7), rate mode (bits 0-3, 0xF unknown)
+    int8_t peakRssi;            // Peak RSSI (dBm)
+    int8_t meanRssi;            // Mean RSSI (dBm)
+    uint16_t packets;           // Packets seen (saturating)
+    uint16_t durationS;         // Track lifetime (s, saturating)
+    uint8_t ageS;               // Time since last packet at report (s, saturating)
+} ReportEntry;
+
+// Header, entries and CRC32 trailer
+#define REPORT_MAX_FRAME    (sizeof(ReportHeader) + REPORT_MAX_ENTRIES * sizeof(ReportEntry) + 4)
+
+/**
+ * Reports a node has already handled
+ */
+typedef struct {
+    uint16_t nodeId[REPORT_SEEN_CACHE];
+    uint16_t sequence[REPORT_SEEN_CACHE];
+    uint8_t next;               // Slot replaced next
+} ReportSeenCache;
+
+/**
+ * What a heard frame was
+ */
+typedef enum {
+    REPORT_RX_INVALID,          // Not a report (a detection candidate)
+    REPORT_RX_DUPLICATE,        // Report already handled
+    REPORT_RX_NEW,              // Report heard for the first time, no relay left
+    REPORT_RX_RELAY             // Report heard for the first time, relay copy built
+} ReportRxResult;
+
+// ============================================================================
+// Report Codec Functions
+// ============================================================================
+
+/**
+ * CRC-32 of a frame (IEEE, reflected; zlib.crc32)
+ * @param data Bytes
+ * @param length Byte count
+ * @return CRC
+ */
+uint32_t reportCrc32(const uint8_t* data, size_t length);
+
+/**
+ * Encode a frame
+ * @param header Header (magic, version and hops are set here)
+ * @param entries header->count track summaries
+ * @param frame Output buffer of REPORT_MAX_FRAME bytes
+ * @return Frame length, or 0 if count exceeds REPORT_MAX_ENTRIES
+ */
+size_t reportEncode(const ReportHeader* header, const ReportEntry* entries, uint8_t* frame);
+
+/**
+ * Check a frame's magic, version, length and CRC
+ * @param data Frame bytes
+ * @param length Frame length
+ * @param header Output header (may be NULL)
+ * @return true if the frame is a valid report
+ */
+bool reportDecode(const uint8_t* data, size_t length, ReportHeader* header);
+
+/**
+ * Get a track summary of a valid frame
+ * @param data Frame bytes
+ * @param index Entry index (below the header's count)
+ * @param entry Output summary
+ */
+void reportGetEntry(const uint8_t* data, uint8_t index, ReportEntry* entry);
+
+/**
+ * Forget every report
+ * @param cache Seen cache
+ */
+void reportSeenReset(ReportSeenCache* cache);
+
+/**
+ * Remember a report
+ * @param cache Seen cache
+ * @param nodeId Originating node
+ * @param sequence Report counter
+ * @return false if the report was already seen
+ */
+bool reportMarkSeen(ReportSeenCache* cache, uint16_t nodeId, uint16_t sequence);
+
+/**
+ * Handle a heard frame: validate, de-duplicate and build the relay copy
+ * with one hop fewer while hops remain
+ * @param cache Seen cache of the receiving node
+ * @param data Frame bytes
+ * @param length Frame length
+ * @param relay Output relay copy (REPORT_MAX_FRAME bytes, same length as
+ *              the frame; written only for REPORT_RX_RELAY)
+ * @return What the frame was
+ */
+ReportRxResult reportReceive(ReportSeenCache* cache, const uint8_t* data, size_t length,
+                             uint8_t* relay);
+
+#endif // REPORT_CODEC_H
@@ -0,0 +1,113 @@
+/**
+ * Scan Configuration Module Header
+ *
+ * Runtime scan settings: band plan, sweep step, dwell, modulation set and
+ * rotation time, LoRa spreading factor and bandwidth, and the detection
+ * threshold. Defaults come from the #defines in drone_detection.h and
+ * noise_floor.h; changed settings are saved to NVS and restored at boot.
+ *
+ * The band plan selects a range of the fixed sweep channel grid, and the
+ * step is a whole number of grid channels, so per-channel state (noise
+ * floors, hot channels, log records) keeps its meaning across changes. The
+ * band is split evenly between the attached scanners.
+ *
+ * A change is staged on every scanner and each applies it at its next
+ * sweep boundary, so no sweep mixes old and new settings. The threshold
+ * follows once all scanners have switched.
+ */
+
+#ifndef SCAN_CONFIG_H
+#define SCAN_CONFIG_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Scan Configuration Limits
+// ============================================================================
+
+#define SCAN_CONFIG_MIN_DWELL_MS        5         // Shorter dwells cannot settle the radio
+#define SCAN_CONFIG_MAX_DWELL_MS        5000
+#define SCAN_CONFIG_MIN_MODULATION_MS   1000      // Time per modulation before switching
+#define SCAN_CONFIG_MAX_MODULATION_MS   600000UL
+#define SCAN_CONFIG_MAX_MARGIN_DB       40.0f     // Detection margin above the floor
+#define SCAN_CONFIG_MAX_SPREAD_K        10.0f
+
+/**
+ * Scan settings
+ */
+typedef struct {
+    uint16_t firstChannel;      // First sweep channel of the band plan
+    uint16_t lastChannel;       // Last sweep channel of the band plan (inclusive)
+    uint8_t channelStride;      // Sweep step in grid channels (SWEEP_STEP_KHZ each)
+    uint8_t modulationMask;     // Modulations scanned (MOD_MASK bits)
+    uint16_t dwellMs;           // Dwell time per channel
+    uint32_t modulationMs;      // Time per modulation before switching
+    uint8_t loraSpreadingFactor;    // LoRa spreading factor (5-12)
+    float loraBandwidth;        // LoRa bandwidth (kHz, an SX126x setting)
+    float detectMarginDb;       // Minimum detection margin above the floor
+    float detectSpreadK;        // Detection margin in units of noise spread
+} ScanConfig;
+
+// ============================================================================
+// Scan Configuration Functions
+// ============================================================================
+
+/**
+ * Load saved settings from NVS (defaults if none are saved or valid)
+ * @return true if saved settings were restored
+ */
+bool scanConfigInit();
+
+/**
+ * Fill in the compile-time default settings
+ * @param config Output settings
+ */
+void scanConfigDefaults(ScanConfig* config);
+
+/**
+ * Check settings against the limits above and the attached scanners
+ * @param config Settings
+ * @return NULL if valid, otherwise a short reason
+ */
+const char* scanConfigCheck(const ScanConfig* config);
+
+/**
+ * Get the current settings (scanners may still be switching to them)
+ * @return Settings
+ */
+const ScanConfig* scanConfigGet();
+
+/**
+ * Adopt new settings: stage them on every scanner and save them to NVS
+ * @param config New settings
+ * @return true if the settings were valid and adopted
+ */
+bool scanConfigSet(const ScanConfig* config);
+
+/**
+ * Give the scanners their share of the current settings and apply them now
+ * Call once, after the scanners are initialized and before their tasks start
+ * @param scanners Initialized scanners
+ * @param count Number of scanners
+ */
+void scanConfigAttach(DroneScanner* const* scanners, uint8_t count);
+
+/**
+ * Check whether any scanner is still waiting for a sweep boundary
+ * @return true while a change is being applied
+ */
+bool scanConfigPending();
+
+/**
+ * Apply the detection threshold once every scanner runs the new settings
+ * Call regularly from the main loop
+ */
+void scanConfigService();
+
+/**
+ * Print the current settings and each scanner's running plan
+ */
+void scanConfigPrint();
+
+#endif // SCAN_CONFIG_H
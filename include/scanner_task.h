@@ -0,0 +1,125 @@
+/**
+ * Scanner Task Module Header
+ *
+ * Runs each DroneScanner in its own FreeRTOS task so several SX1262 radios
+ * scan in parallel. Each task blocks on task notifications: its radio's
+ * DIO1 interrupt wakes it to read a packet, and a one-shot esp_timer
+ * armed at the start of every dwell wakes it to retune, so no task polls. Radios on
+ * a shared SPI bus hold a common bus lock around every radio transaction;
+ * radios on separate buses pass NULL and run fully independently.
+ *
+ * Tasks only talk to their radio. Packets and noise samples from all
+ * scanners are merged into a single event queue that the main loop drains,
+ * so analysis, tracking and logging stay single-threaded.
+ */
+
+#ifndef SCANNER_TASK_H
+#define SCANNER_TASK_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Scanner Task Configuration
+// ============================================================================
+
+#define SCAN_EVENT_QUEUE_DEPTH      16        // Merged events buffered for the main loop
+#define SCAN_EVENT_MAX_DATA         256       // Packet bytes carried per event
+#define SCANNER_TASK_STACK          4096      // Stack per scanner task (bytes)
+#define SCANNER_TASK_PRIORITY       3         // Above loop(), below WiFi/BT
+#define SCANNER_TIMING_EWMA         0.0625f   // Weight of each latency/jitter sample
+
+/**
+ * Kind of scanner event
+ */
+typedef enum {
+    SCAN_EVENT_PACKET,          // Packet received
+    SCAN_EVENT_NOISE,           // Background RSSI sample
+    SCAN_EVENT_SWEEP            // Sweep ended (after its last dwell's events)
+} ScanEventType;
+
+/**
+ * One entry of the merged event stream
+ */
+typedef struct {
+    ScanEventType type;         // Event kind
+    uint8_t scanner;            // Index of the originating scanner
+    ModulationType modulation;  // Modulation the radio was in
+    float frequency;            // Frequency the radio was tuned to (MHz)
+    float rssi;                 // RSSI in dBm (packet or background)
+    float snr;                  // SNR in dB (packets only)
+    float freqError;            // Frequency error in Hz (packets only)
+    float bitrateKbps;          // Raw capture bit rate (0 if not a raw capture)
+    float bandwidthKhz;         // LoRa bandwidth (packets only, 0 for FSK/OOK)
+    uint8_t spreadingFactor;    // LoRa spreading factor (packets only, 0 for FSK/OOK)
+    uint16_t firstChannel;      // Sub-band of the ended sweep (sweep events only)
+    uint16_t lastChannel;
+    uint32_t timestampUs;       // DIO1 interrupt time (micros)
+    int64_t utcUs;              // DIO1 interrupt time as UTC (us, 0 if no timebase)
+    uint16_t length;            // Packet bytes in data
+    uint8_t data[SCAN_EVENT_MAX_DATA];  // Packet bytes
+} ScanEvent;
+
+/**
+ * Scanner task statistics
+ */
+typedef struct {
+    uint32_t packets;           // Packets read
+    uint32_t readErrors;        // Failed packet reads
+    uint32_t dropped;           // Events lost to a full queue
+    uint32_t dwells;            // Dwells completed
+    float latencyMeanUs;        // EWMA of DIO1 interrupt to packet service
+    uint32_t latencyMaxUs;      // Worst DIO1 interrupt to packet service
+    float dwellJitterMeanUs;    // EWMA of dwell length error
+    uint32_t dwellJitterMaxUs;  // Worst dwell length error
+} ScannerTaskStats;
+
+// ============================================================================
+// Scanner Task Functions
+// ============================================================================
+
+/**
+ * Create a lock for radios sharing one SPI bus
+ * @return Bus lock, or NULL on failure
+ */
+SemaphoreHandle_t scannerCreateBusLock();
+
+/**
+ * Start scanning on an initialized scanner in its own task
+ * @param scanner Scanner (see scannerInit), index below MAX_SCANNERS
+ * @param busLock Shared SPI bus lock, or NULL for a dedicated bus
+ * @param core CPU core to pin the task to
+ * @return true if the task was started
+ */
+bool scannerTaskStart(DroneScanner* scanner, SemaphoreHandle_t busLock, BaseType_t core);
+
+/**
+ * Take the next event from the merged stream
+ * @param event Output event
+ * @param timeout Ticks to wait for an event
+ * @return true if an event was returned
+ */
+bool scannerNextEvent(ScanEvent* event, TickType_t timeout);
+
+/**
+ * Check whether every scanner task is blocked and no event is queued
+ * @return true if the CPU may sleep without delaying a scanner
+ */
+bool scannerTasksIdle();
+
+/**
+ * Notify a scanner of a DIO1 interrupt that was not delivered (edge during
+ * light sleep)
+ * @param index Scanner index
+ * @param sinceUs Counter value before which a recorded interrupt time is stale
+ */
+void scannerTaskKick(uint8_t index, int64_t sinceUs);
+
+/**
+ * Get statistics of a scanner task
+ * @param index Scanner index
+ * @param stats Output statistics
+ */
+void scannerTaskGetStats(uint8_t index, ScannerTaskStats* stats);
+
+#endif // SCANNER_TASK_H
@@ -0,0 +1,191 @@
+/**
+ * Sketch Module Header
+ *
+ * Fixed-memory traffic summaries for questions like "how many distinct
+ * transmitters were active in the last 10 minutes" without keeping
+ * per-packet history. Every analyzed packet adds three 32-bit hashes:
+ *   transmitter  network-wide emitter key (decoded ID, otherwise
+ *                modulation and protocol; never a per-node cluster ID,
+ *                so sketches of several nodes merge)
+ *   payload      all packet bytes
+ *   header       modulation, length and the first SKETCH_HEADER_BYTES
+ * Each goes into a HyperLogLog sketch (distinct count, about 3 % standard
+ * error), and transmitter keys also into a count-min sketch from which the
+ * busiest transmitters are estimated.
+ *
+ * Sketches are kept per time slice of SKETCH_SLICE_MS in a ring of
+ * SKETCH_SLICES (the PSRAM arena), so memory is the same at 1 or 1000
+ * packets per second. A window query merges the slices it covers: register
+ * maximum for HyperLogLog, counter sum for count-min. The same merge
+ * combines sketches from several nodes; "sketch" on the console prints
+ * them as HLL/CMS lines and tools/sketch_merge.py merges node logs.
+ */
+
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Sketch Configuration
+// ============================================================================
+
+#define SKETCH_HLL_BITS             10        // Index bits: 1024 registers, ~3.3 % error
+#define SKETCH_HLL_REGISTERS        (1 << SKETCH_HLL_BITS)
+#define SKETCH_CMS_DEPTH            4         // Count-min rows (independent hashes)
+#define SKETCH_CMS_WIDTH            256       // Counters per row (power of two)
+#define SKETCH_HEAVY_MAX            8         // Heavy-hitter candidates kept per slice
+#define SKETCH_SLICE_MS             60000     // Time per slice
+#define SKETCH_SLICES               10        // Slices kept (10 minutes)
+#define SKETCH_HEADER_BYTES         4         // Payload bytes hashed as the header
+#define SKETCH_REPORT_WINDOW_MS     600000    // Window of the periodic UNIQ line (all slices)
+
+/**
+ * What a HyperLogLog sketch counts
+ */
+typedef enum {
+    SKETCH_TRANSMITTERS,
+    SKETCH_PAYLOADS,
+    SKETCH_HEADERS,
+    SKETCH_KINDS
+} SketchKind;
+
+/**
+ * HyperLogLog distinct counter
+ */
+typedef struct {
+    uint8_t registers[SKETCH_HLL_REGISTERS];
+} HllSketch;
+
+/**
+ * Count-min frequency table
+ */
+typedef struct {
+    uint32_t counts[SKETCH_CMS_DEPTH][SKETCH_CMS_WIDTH];
+} CountMinSketch;
+
+/**
+ * Distinct counts over a window
+ */
+typedef struct {
+    uint32_t windowMs;          // Time covered (past slices and the current one)
+    uint32_t packets;           // Packets added
+    float distinct[SKETCH_KINDS];   // Estimated distinct items per kind
+} SketchSummary;
+
+/**
+ * One heavy hitter
+ */
+typedef struct {
+    uint32_t key;               // Transmitter key
+    uint32_t packets;           // Estimated packets (never under the true count)
+} SketchHeavyHitter;
+
+// ============================================================================
+// Sketch Primitives
+// ============================================================================
+
+/**
+ * Hash bytes to 32 bits (FNV-1a with a murmur3 finaliser)
+ * @param data Bytes
+ * @param length Byte count
+ * @param seed Hash seed
+ * @return Hash
+ */
+uint32_t sketchHash(const uint8_t* data, size_t length, uint32_t seed);
+
+/**
+ * Add a hashed item to a HyperLogLog sketch
+ */
+void hllAdd(HllSketch* hll, uint32_t hash);
+
+/**
+ * Merge src into dst (union of the item sets)
+ */
+void hllMerge(HllSketch* dst, const HllSketch* src);
+
+/**
+ * Estimate the number of distinct items
+ * @return Estimate (linear counting at small cardinalities)
+ */
+float hllEstimate(const HllSketch* hll);
+
+/**
+ * Count an occurrence of a key
+ */
+void cmsAdd(CountMinSketch* cms, uint32_t key, uint32_t count);
+
+/**
+ * Merge src into dst (sum of the counts)
+ */
+void cmsMerge(CountMinSketch* dst, const CountMinSketch* src);
+
+/**
+ * Estimate a key's count (an upper bound)
+ */
+uint32_t cmsEstimate(const CountMinSketch* cms, uint32_t key);
+
+// ============================================================================
+// Windowed Sketch Functions
+// ============================================================================
+
+/**
+ * Allocate and clear the slice ring
+ */
+void sketchInit();
+
+/**
+ * Add an analyzed packet (main loop)
+ * @param transmitterKey Network-wide emitter key (networkKeyForSignal())
+ * @param modulation Modulation the packet was received in
+ * @param data Packet bytes
+ * @param length Byte count
+ */
+void sketchNotePacket(uint32_t transmitterKey, ModulationType modulation,
+                      const uint8_t* data, uint16_t length);
+
+/**
+ * Start new slices as time passes
+ * Call regularly from the main loop
+ */
+void sketchService();
+
+/**
+ * Distinct counts over a window ending now
+ * @param windowMs Window length (rounded up to whole slices)
+ * @param summary Output
+ * @return false before initialisation
+ */
+bool sketchQuery(uint32_t windowMs, SketchSummary* summary);
+
+/**
+ * Busiest transmitters over a window, most packets first
+ * @param windowMs Window length
+ * @param out Output array
+ * @param maxCount Entries in out
+ * @return Entries returned
+ */
+uint8_t sketchHeavyHitters(uint32_t windowMs, SketchHeavyHitter* out, uint8_t maxCount);
+
+/**
+ * Print the merged window sketches for merging across nodes
+ * HLL,<kind>,<window s>,<bits>,<hex registers>
+ * CMS,<window s>,<row>,<width>,<hex counters, 8 digits each>
+ * @param windowMs Window length
+ */
+void sketchExport(uint32_t windowMs);
+
+/**
+ * Print distinct counts over a window
+ * UNIQ,<window s>,<packets>,<transmitters>,<payloads>,<headers>
+ * @param windowMs Window length
+ */
+void sketchReport(uint32_t windowMs);
+
+/**
+ * Get a sketch kind name
+ */
+const char* sketchKindName(SketchKind kind);
+
+#endif // SKETCH_H
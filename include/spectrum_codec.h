@@ -0,0 +1,136 @@
+/**
+ * Spectrum Codec Module Header
+ *
+ * Compact encoding of per-sweep spectrum rows (one quantised RSSI byte per
+ * sweep channel, 0 = no sample) for narrow uplinks. The codec has no
+ * Arduino dependencies and allocates nothing, so the same code runs in the
+ * firmware and in host tools; tools/spectrum_decode.py implements the same
+ * format.
+ *
+ * Frame layout:
+ *   flags     (SPEC_VERSION << 4) | (tag << 1) | keyframe
+ *   sequence  uint8, +1 per frame of a stream
+ *   first     varint, first sweep channel of the row
+ *   count     varint, channels in the row
+ *   tokens    varints until count channels are covered:
+ *               (run - 1) << 1 | 1     run of channels equal to the prediction
+ *               zigzag(delta) << 1     one channel, value = prediction + delta
+ *
+ * A delta frame predicts each channel from the previous row of the stream,
+ * a keyframe from the channel before it in the same row (0 for the first).
+ * Quiet channels cost nothing beyond their run token: a value within
+ * deadband steps of a non-zero prediction is sent as unchanged, and a
+ * channel without a sample in a delta frame keeps its previous value. The
+ * reconstruction error is at most deadband steps (0 = lossless). Varints
+ * are little-endian base 128. A stream starts and restarts with a
+ * keyframe; the encoder sends one every keyframe interval and whenever the
+ * tag, first channel or count changes, and the decoder drops delta frames
+ * after a sequence gap until the next keyframe.
+ */
+
+#ifndef SPECTRUM_CODEC_H
+#define SPECTRUM_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Spectrum Codec Configuration
+// ============================================================================
+
+#define SPEC_VERSION                1         // Frame format version
+#define SPEC_MAX_CHANNELS           64        // Channels per row
+#define SPEC_MAX_FRAME              136       // Largest frame (4 header + 2 per channel)
+#define SPEC_FLAG_KEYFRAME          0x01      // Frame predicts within the row
+
+/**
+ * Encoder state of one stream
+ */
+typedef struct {
+    uint8_t reference[SPEC_MAX_CHANNELS];   // Row as the decoder reconstructs it
+    uint8_t deadband;           // Steps treated as unchanged
+    uint16_t keyframeRows;      // Rows between keyframes
+    uint16_t sinceKeyframe;     // Rows since the last keyframe
+    uint8_t sequence;           // Sequence number of the next frame
+    uint8_t tag;                // Stream tag of the last frame (0-7)
+    uint16_t first;             // First channel of the last frame
+    uint16_t count;             // Channels of the last frame
+    bool primed;                // A keyframe was sent
+} SpectrumEncoder;
+
+/**
+ * Decoder result for one byte
+ */
+typedef enum {
+    SPEC_DECODE_MORE,           // Frame incomplete
+    SPEC_DECODE_ROW,            // Row complete (decoder row fields valid)
+    SPEC_DECODE_SKIPPED,        // Frame complete but dropped (waiting for a keyframe)
+    SPEC_DECODE_ERROR           // Malformed frame; waiting for the next keyframe
+} SpectrumDecodeResult;
+
+/**
+ * Streaming decoder state of one stream
+ */
+typedef struct {
+    uint8_t row[SPEC_MAX_CHANNELS];     // Last decoded row
+    uint8_t work[SPEC_MAX_CHANNELS];    // Row being decoded
+    uint8_t state;              // Parser state
+    uint8_t flags;              // Flags of the frame being decoded
+    uint8_t sequence;           // Sequence of the frame being decoded
+    uint8_t lastSequence;       // Sequence of the last row
+    uint16_t first;             // First channel of the row
+    uint16_t count;             // Channels of the row
+    uint16_t frameFirst;        // First channel of the frame being decoded
+    uint16_t frameCount;        // Channels of the frame being decoded
+    uint16_t position;          // Channels decoded
+    uint32_t varint;            // Varint being assembled
+    uint8_t shift;              // Bits in varint
+    bool primed;                // row holds a valid row
+} SpectrumDecoder;
+
+// ============================================================================
+// Spectrum Codec Functions
+// ============================================================================
+
+/**
+ * Start an encoder stream
+ * @param encoder Encoder
+ * @param deadband Quantisation steps sent as unchanged (0 = lossless)
+ * @param keyframeRows Rows between keyframes (at least 1)
+ */
+void spectrumEncoderInit(SpectrumEncoder* encoder, uint8_t deadband, uint16_t keyframeRows);
+
+/**
+ * Encode one row
+ * @param encoder Encoder
+ * @param tag Stream tag (0-7), a change forces a keyframe
+ * @param first First sweep channel of the row
+ * @param row Quantised RSSI per channel (0 = no sample)
+ * @param count Channels in the row (1 to SPEC_MAX_CHANNELS)
+ * @param out Output buffer
+ * @param outSize Bytes available (SPEC_MAX_FRAME always suffices)
+ * @return Frame length, 0 on invalid arguments
+ */
+size_t spectrumEncode(SpectrumEncoder* encoder, uint8_t tag, uint16_t first,
+                      const uint8_t* row, uint16_t count, uint8_t* out, size_t outSize);
+
+/**
+ * Start a decoder stream
+ */
+void spectrumDecoderInit(SpectrumDecoder* decoder);
+
+/**
+ * Feed one byte of the stream
+ * @param decoder Decoder
+ * @param byte Next byte
+ * @return SPEC_DECODE_ROW when decoder->row holds a new row of
+ *         decoder->count channels from decoder->first
+ */
+SpectrumDecodeResult spectrumDecoderPush(SpectrumDecoder* decoder, uint8_t byte);
+
+/**
+ * Get the stream tag of the last decoded frame
+ */
+uint8_t spectrumDecoderTag(const SpectrumDecoder* decoder);
+
+#endif // SPECTRUM_CODEC_H
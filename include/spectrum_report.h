@@ -0,0 +1,96 @@
+/**
+ * Spectrum Report Module Header
+ *
+ * Per-sweep spectrum rows for narrow uplinks. Every packet and background
+ * sample above the detection threshold raises its channel's peak in the
+ * row of the scanner that took it, quantised like the occupancy history
+ * (0.5 dB steps, 0 = no sample). A channel sampled only below the
+ * threshold is coded SPEC_QUIET instead of its RSSI, so noise jitter on
+ * idle channels repeats exactly from sweep to sweep. When the scanner's
+ * sweep ends the row is encoded with the spectrum codec (delta against the
+ * previous sweep, zigzag varints, runs of unchanged channels), so a quiet
+ * band costs a few bytes per sweep instead of one byte per channel. With "spec on" each row is printed as
+ *   SPEC,<scanner>,<hex frame>
+ * and tools/spectrum_decode.py turns the lines back into rows. Each
+ * scanner is its own stream; the frame tag is the sweep's modulation.
+ *
+ * "spec bench" replays the occupancy history through the encoder and the
+ * decoder and prints
+ *   SPECBENCH,<rows>,<raw bytes>,<encoded bytes>,<ratio>,<encode mean us>,
+ *             <encode max us>,<max error steps>
+ */
+
+#ifndef SPECTRUM_REPORT_H
+#define SPECTRUM_REPORT_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+#include "spectrum_codec.h"
+
+// ============================================================================
+// Spectrum Report Configuration
+// ============================================================================
+
+#define SPEC_REPORT_ENABLED         false     // Print SPEC lines from boot
+#define SPEC_DEADBAND_STEPS         6         // Steps sent as unchanged (3 dB)
+#define SPEC_KEYFRAME_ROWS          32        // Rows between keyframes
+#define SPEC_QUIET                  1         // Row value of a channel sampled only below threshold
+
+/**
+ * Spectrum report statistics
+ */
+typedef struct {
+    uint32_t rows;              // Rows encoded
+    uint32_t rawBytes;          // One byte per channel
+    uint32_t encodedBytes;      // Frame bytes
+    float encodeMeanUs;         // EWMA of the encode time per row
+    uint32_t encodeMaxUs;       // Longest encode
+} SpectrumReportStats;
+
+// ============================================================================
+// Spectrum Report Functions
+// ============================================================================
+
+/**
+ * Raise a channel's peak in the scanner's current row (main loop)
+ * @param scanner Scanner index
+ * @param channel Sweep channel
+ * @param rssi RSSI in dBm
+ * @param busy Packet received or energy above the detection threshold
+ */
+void spectrumReportNote(uint8_t scanner, int channel, float rssi, bool busy);
+
+/**
+ * Encode and start a new row when a scanner's sweep ends (main loop)
+ * @param scanner Scanner index
+ * @param modulation Modulation of the ended sweep
+ * @param firstChannel First channel of its sub-band
+ * @param lastChannel Last channel of its sub-band
+ */
+void spectrumReportSweepEnd(uint8_t scanner, ModulationType modulation,
+                            uint16_t firstChannel, uint16_t lastChannel);
+
+/**
+ * Start or stop printing SPEC lines (encoding and statistics continue)
+ * @param enable true to print
+ */
+void spectrumReportEnable(bool enable);
+
+/**
+ * Check whether SPEC lines are printed
+ */
+bool spectrumReportEnabled();
+
+/**
+ * Replay the occupancy history through the codec and print a SPECBENCH line
+ * @param rows Rows to replay, oldest first (at most the history)
+ */
+void spectrumReportBenchmark(uint16_t rows);
+
+/**
+ * Get spectrum report statistics
+ * @param stats Output statistics
+ */
+void spectrumReportGetStats(SpectrumReportStats* stats);
+
+#endif // SPECTRUM_REPORT_H
@@ -0,0 +1,85 @@
+/**
+ * Timebase Module Header
+ *
+ * Disciplines the 64-bit esp_timer microsecond counter to the GPS PPS
+ * output so packet timestamps are comparable between nodes (millis() on
+ * each unit drifts independently by tens of ppm).
+ *
+ * The PPS interrupt only captures the counter. The main loop labels each
+ * pulse with its UTC second (counted from the previous pulse, checked
+ * against NMEA time) and runs the PI servo of timebase_servo.h on it,
+ * which steers the counter-to-UTC mapping and learns the crystal's
+ * frequency offset for holdover through PPS outages.
+ *
+ * timebaseUtcUs() and timebaseToUtcUs() use fixed-point arithmetic only
+ * and are safe to call from interrupt handlers.
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <Arduino.h>
+#include "timebase_servo.h"
+
+// ============================================================================
+// Timebase Configuration
+// ============================================================================
+
+#define TIMEBASE_NMEA_LATENCY_MS    450       // Typical NMEA delay after its PPS
+
+/**
+ * Timebase statistics
+ */
+typedef struct {
+    bool anchored;              // Mapping to UTC established
+    bool locked;                // Tracking PPS within TIMEBASE_LOCK_US
+    uint32_t pulses;            // PPS edges captured
+    uint32_t outliers;          // Pulses ignored as outliers
+    uint32_t steps;             // Times the mapping was stepped
+    float phaseErrorUs;         // Latest phase error
+    float jitterUs;             // EWMA of absolute phase error
+    float frequencyPpb;         // Learned counter frequency correction
+    uint32_t sinceLastPulseMs;  // Time since the latest pulse
+} TimebaseStats;
+
+// ============================================================================
+// Timebase Functions
+// ============================================================================
+
+/**
+ * Attach the PPS interrupt
+ */
+void timebaseInit();
+
+/**
+ * Run the servo on captured pulses and track lock state
+ * Call regularly from the main loop
+ */
+void timebaseService();
+
+/**
+ * Current UTC time (ISR safe)
+ * @return Microseconds since the Unix epoch, or 0 before the first anchor
+ */
+int64_t timebaseUtcUs();
+
+/**
+ * Convert a captured esp_timer_get_time() value to UTC (ISR safe)
+ * @param counterUs Counter value
+ * @return Microseconds since the Unix epoch, or 0 before the first anchor
+ */
+int64_t timebaseToUtcUs(int64_t counterUs);
+
+/**
+ * Check whether timestamps are PPS disciplined
+ * @return true while locked to PPS
+ */
+bool timebaseLocked();
+
+/**
+ * Get timebase statistics
+ * @param stats Output statistics
+ */
+void timebaseGetStats(TimebaseStats* stats);
+
+#endif // TIMEBASE_H
@@ -0,0 +1,134 @@
+/**
+ * Timebase Servo Module Header
+ *
+ * The PPS servo of the timebase as plain functions on a state struct. It
+ * has no Arduino or ESP-IDF dependencies, so the native unit tests run the
+ * same servo on simulated pulses; src/timebase.cpp feeds it the captured
+ * pulses and publishes its mapping to interrupt handlers.
+ *
+ * The counter-to-UTC mapping is utc = anchorUtc + dt + dt * rate / 2^32
+ * with dt = counter - anchorCounter, so conversion needs only 64-bit
+ * integer arithmetic. The anchor is re-laid at every accepted pulse, which
+ * keeps dt (and the error of the rate term) small.
+ *
+ * Each pulse is labelled with its UTC second, then its phase error against
+ * the mapping goes to a PI loop:
+ * - The proportional term removes part of the phase error at every pulse
+ * - The integral term learns the crystal's frequency offset, which carries
+ *   the mapping through PPS outages (holdover)
+ * Single outlying pulses (interrupt latency spikes) are ignored once
+ * locked; a persistent offset steps the mapping instead of slewing.
+ */
+
+#ifndef TIMEBASE_SERVO_H
+#define TIMEBASE_SERVO_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Timebase Servo Configuration
+// ============================================================================
+
+#define TIMEBASE_KP                 0.5f      // Phase error removed per pulse
+#define TIMEBASE_KI                 0.1f      // Frequency gain (per pulse)
+#define TIMEBASE_STEP_US            500       // Phase error that steps the mapping
+#define TIMEBASE_OUTLIER_US         50        // Locked pulses off by more are ignored
+#define TIMEBASE_MAX_OUTLIERS       3         // Consecutive outliers before a step
+#define TIMEBASE_LOCK_US            10        // Phase error counted as in lock
+#define TIMEBASE_LOCK_PULSES        5         // Consecutive good pulses to lock
+#define TIMEBASE_HOLDOVER_MS        2500      // Time without PPS before unlocking
+#define TIMEBASE_MAX_PPM            200       // Frequency correction limit
+
+#define TIMEBASE_US_PER_S           1000000LL
+
+/**
+ * Counter-to-UTC mapping
+ */
+typedef struct {
+    int64_t anchorCounterUs;    // Counter value of the anchor
+    int64_t anchorUtcUs;        // UTC of the anchor (us since the Unix epoch)
+    int32_t rateQ32;            // Frequency correction (2^-32 units)
+    bool anchored;              // Mapping established
+} TimebaseMapping;
+
+/**
+ * Outcome of one pulse
+ */
+typedef enum {
+    SERVO_PULSE_ANCHORED,       // First pulse laid the anchor
+    SERVO_PULSE_STEPPED,        // Phase error too large, mapping stepped
+    SERVO_PULSE_OUTLIER,        // Pulse ignored
+    SERVO_PULSE_TRACKED,        // PI update applied
+    SERVO_PULSE_LOCKED          // PI update applied and lock acquired
+} ServoPulseResult;
+
+/**
+ * Servo state
+ */
+typedef struct {
+    TimebaseMapping mapping;    // Current mapping
+    int64_t lastPulseCounterUs; // Counter value of the latest labelled pulse (0 = none)
+    int64_t lastPulseUtcS;      // UTC second of the latest labelled pulse
+    uint8_t goodPulses;         // Consecutive pulses within TIMEBASE_LOCK_US
+    uint8_t outlierRun;         // Consecutive outliers while locked
+    bool locked;                // Tracking PPS within TIMEBASE_LOCK_US
+    uint32_t outliers;          // Pulses ignored as outliers
+    uint32_t steps;             // Times the mapping was stepped
+    float phaseErrorUs;         // Latest phase error
+    float jitterUs;             // EWMA of absolute phase error
+    float frequencyPpb;         // Learned counter frequency correction
+} TimebaseServo;
+
+// ============================================================================
+// Timebase Servo Functions
+// ============================================================================
+
+/**
+ * Convert a counter value with a mapping (no locking, ISR safe)
+ * @param mapping Mapping
+ * @param counterUs Counter value
+ * @return Microseconds since the Unix epoch, or 0 if not anchored
+ */
+static inline int64_t timebaseMapToUtc(const TimebaseMapping* mapping, int64_t counterUs) {
+    if (!mapping->anchored) {
+        return 0;
+    }
+    int64_t dt = counterUs - mapping->anchorCounterUs;
+    return mapping->anchorUtcUs + dt + ((dt * mapping->rateQ32) >> 32);
+}
+
+/**
+ * Clear a servo (not anchored, no frequency correction)
+ * @param servo Servo state
+ */
+void timebaseServoReset(TimebaseServo* servo);
+
+/**
+ * Label a pulse by counting seconds from the previous one
+ * Only the first pulse, or one after an outage, needs an external label.
+ * @param servo Servo state
+ * @param counterUs Counter value captured at the pulse
+ * @param utcSecond Output UTC second of the pulse
+ * @return false if the pulse needs an external (NMEA) label
+ */
+bool timebaseServoCountPulse(const TimebaseServo* servo, int64_t counterUs, int64_t* utcSecond);
+
+/**
+ * Run the servo on a labelled pulse
+ * @param servo Servo state
+ * @param counterUs Counter value captured at the pulse
+ * @param utcSecond UTC second the pulse marks
+ * @return What the pulse did to the mapping
+ */
+ServoPulseResult timebaseServoPulse(TimebaseServo* servo, int64_t counterUs, int64_t utcSecond);
+
+/**
+ * Drop lock after TIMEBASE_HOLDOVER_MS without a pulse (the learned
+ * frequency is kept)
+ * @param servo Servo state
+ * @param counterUs Current counter value
+ * @return true if lock was dropped by this call
+ */
+bool timebaseServoHoldover(TimebaseServo* servo, int64_t counterUs);
+
+#endif // TIMEBASE_SERVO_H
@@ -0,0 +1,87 @@
+/**
+ * Transmitter Cluster Module Header
+ *
+ * Separates individual transmitters that share a protocol by the crystal
+ * offset of their radios. The SX1262 LoRa frequency error estimate of each
+ * packet is normalised to parts per billion of the carrier (so offsets stay
+ * comparable while an emitter hops) and assigned to the nearest of a fixed
+ * set of online clusters.
+ *
+ * Each cluster tracks its centroid with an alpha-beta filter so slow
+ * temperature drift of the crystal is followed rather than splitting the
+ * cluster, and its gate widens with the time since it was last seen. The
+ * drift rate is measured from the centroid change over a baseline of at
+ * least CLUSTER_DRIFT_BASELINE_MS: packets are milliseconds apart, and the
+ * residual of one packet over that interval is noise, not drift. RSSI
+ * and recency break ties between clusters with similar offsets. A cluster
+ * started by an outlier is absorbed once its centroid converges onto an
+ * older cluster of the same protocol.
+ *
+ * Assignment is O(MAX_TX_CLUSTERS) per packet with no allocation.
+ */
+
+#ifndef TRANSMITTER_CLUSTER_H
+#define TRANSMITTER_CLUSTER_H
+
+#include <Arduino.h>
+#include "drone_detection.h"
+
+// ============================================================================
+// Cluster Configuration
+// ============================================================================
+
+#define MAX_TX_CLUSTERS             16        // Concurrent transmitter clusters
+#define CLUSTER_TIMEOUT_MS          60000     // Idle time before a cluster is reusable
+#define CLUSTER_GATE_SPREADS        5.0f      // Assignment gate in cluster spreads (~4 sigma)
+#define CLUSTER_MIN_SPREAD_PPB      80.0f     // Floor on spread (estimator noise)
+#define CLUSTER_INITIAL_SPREAD_PPB  200.0f    // Spread of a new cluster
+#define CLUSTER_DRIFT_PPB_PER_S     20.0f     // Max crystal drift rate tolerated
+#define CLUSTER_RSSI_SCALE_DB       12.0f     // RSSI difference costing one gate unit
+#define CLUSTER_ALPHA               0.2f      // Centroid gain
+#define CLUSTER_BETA                0.3f      // Drift rate gain per baseline
+#define CLUSTER_DRIFT_BASELINE_MS   20000     // Shortest interval a drift rate is measured over
+#define CLUSTER_ID_TAG              0x46000000UL  // 'F' tag of cluster transmitter IDs
+
+/**
+ * State of one transmitter cluster
+ */
+typedef struct {
+    bool active;                    // Slot in use
+    uint16_t id;                    // Sequential cluster number
+    int8_t signatureIndex;          // Protocol of the member packets (-1 if none)
+    float centroidPpb;              // Frequency offset centroid (ppb)
+    float driftPpbPerS;             // Centroid drift rate (ppb/s)
+    float spreadPpb;                // EWMA of absolute residual (ppb, ~0.8 sigma)
+    float meanRssi;                 // EWMA of member RSSI (dBm)
+    float baselinePpb;              // Centroid at the start of the drift baseline
+    uint32_t baselineMs;            // millis() at the start of the drift baseline
+    uint32_t firstSeenMs;           // millis() of first packet
+    uint32_t lastSeenMs;            // millis() of latest packet
+    uint32_t hits;                  // Packets assigned
+} TransmitterCluster;
+
+// ============================================================================
+// Cluster Functions
+// ============================================================================
+
+/**
+ * Clear all clusters
+ */
+void transmitterClusterInit();
+
+/**
+ * Assign a detection to a transmitter cluster, creating one if no cluster
+ * gates it
+ * @param signal Analyzed detection (frequency, freqError, rssi, signatureIndex)
+ * @return Transmitter identifier of the cluster (CLUSTER_ID_TAG | id)
+ */
+uint32_t transmitterClusterAssign(const DroneSignal* signal);
+
+/**
+ * Get a cluster table slot
+ * @param index Slot index (0 to MAX_TX_CLUSTERS - 1)
+ * @return Cluster, or NULL if the slot is inactive
+ */
+const TransmitterCluster* getTransmitterCluster(int index);
+
+#endif // TRANSMITTER_CLUSTER_H
@@ -0,0 +1,307 @@
+/**
+ * Alert Module Implementation
+ *
+ * Everything runs in the main loop. Packets move an emitter forward in
+ * alertObserve(); the quiet-time transitions back happen in alertService()
+ * and also before a packet is applied, so a late service call never lets
+ * a stale ARMING emitter confirm. Outputs are written only when their
+ * level changes.
+ */
+
+#include "alert.h"
+#include "scanner_task.h"
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+typedef struct {
+    AlertState state;
+    uint32_t key;                   // Emitter identity key
+    uint32_t armedMs;               // millis() of the first arming packet
+    uint32_t lastPacketMs;          // millis() of the latest drone packet
+    uint8_t packets;                // Drone packets while arming
+    uint8_t confidence;             // Latest confidence
+    float frequency;                // Latest frequency (MHz)
+    const char* droneType;          // Latest identified type
+} AlertTrack;
+
+static AlertTrack alerts[ALERT_TRACKS];
+static bool outputsOn = false;
+static bool buzzerOn = false;
+static uint32_t buzzerStartMs = 0;
+static AlertStats stats;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void writeOutput(int pin, bool on) {
+    if (pin >= 0) {
+        digitalWrite(pin, on ? ALERT_ACTIVE_LEVEL : !ALERT_ACTIVE_LEVEL);
+    }
+}
+
+static void setupOutput(int pin) {
+    if (pin >= 0) {
+        pinMode(pin, OUTPUT);
+        writeOutput(pin, false);
+    }
+}
+
+#if defined(ALERT_LED_PIN)
+static const int ledPin = ALERT_LED_PIN;
+#else
+static const int ledPin = -1;
+#endif
+#if defined(ALERT_BUZZER_PIN)
+static const int buzzerPin = ALERT_BUZZER_PIN;
+#else
+static const int buzzerPin = -1;
+#endif
+#if defined(ALERT_RELAY_PIN)
+static const int relayPin = ALERT_RELAY_PIN;
+#else
+static const int relayPin = -1;
+#endif
+
+/**
+ * Bring the LED and relay in line with the emitter table
+ */
+static void updateOutputs() {
+    uint8_t alerting = 0;
+    for (int i = 0; i < ALERT_TRACKS; i++) {
+        if (alerts[i].state == ALERT_CONFIRMED || alerts[i].state == ALERT_CLEARING) {
+            alerting++;
+        }
+    }
+    stats.alerting = alerting;
+
+    bool on = alerting > 0;
+    if (on != outputsOn) {
+        writeOutput(ledPin, on);
+        writeOutput(relayPin, on);
+        outputsOn = on;
+    }
+}
+
+static void setBuzzer(bool on) {
+    if (on != buzzerOn) {
+        writeOutput(buzzerPin, on);
+        buzzerOn = on;
+    }
+    if (on) {
+        buzzerStartMs = millis();
+    }
+}
+
+/**
+ * ALERT,<state>,<key hex>,<type>,<MHz>,<confidence>,<latency us>
+ */
+static void printTransition(const AlertTrack* alert, int32_t latencyUs) {
+    Serial.print(F("ALERT,"));
+    Serial.print(alertStateName(alert->state));
+    Serial.print(',');
+    Serial.print(alert->key, HEX);
+    Serial.print(',');
+    Serial.print(alert->droneType != NULL ? alert->droneType : "");
+    Serial.print(',');
+    Serial.print(alert->frequency, 3);
+    Serial.print(',');
+    Serial.print(alert->confidence);
+    Serial.print(',');
+    if (latencyUs >= 0) {
+        Serial.println(latencyUs);
+    } else {
+        Serial.println();
+    }
+}
+
+/**
+ * Apply quiet-time transitions due at now
+ * @return true if the state changed
+ */
+static bool expire(AlertTrack* alert, uint32_t now) {
+    uint32_t quietMs = now - alert->lastPacketMs;
+    switch (alert->state) {
+        case ALERT_ARMING:
+            if (now - alert->armedMs > ALERT_CONFIRM_WINDOW_MS) {
+                alert->state = ALERT_IDLE;
+                stats.suppressed++;
+                return true;
+            }
+            break;
+        case ALERT_CONFIRMED:
+            if (quietMs > ALERT_CLEAR_MS) {
+                alert->state = ALERT_CLEARING;
+                return true;
+            }
+            break;
+        case ALERT_CLEARING:
+            if (quietMs > ALERT_CLEAR_MS + ALERT_HOLD_MS) {
+                alert->state = ALERT_IDLE;
+                stats.cleared++;
+                return true;
+            }
+            break;
+        default:
+            break;
+    }
+    return false;
+}
+
+/**
+ * Apply and report all transitions due at now
+ * @return true if the state changed
+ */
+static bool settle(AlertTrack* alert, uint32_t now) {
+    AlertState before = alert->state;
+    while (expire(alert, now)) {
+    }
+    if (alert->state == before) {
+        return false;
+    }
+    // Arming emitters that never confirmed go quietly
+    if (before != ALERT_ARMING) {
+        printTransition(alert, -1);
+    }
+    return true;
+}
+
+/**
+ * Entry for a key: its own, else a free one, else the oldest arming one.
+ * Alerting emitters are never evicted.
+ */
+static AlertTrack* findAlert(uint32_t key) {
+    AlertTrack* freeSlot = NULL;
+    AlertTrack* oldestArming = NULL;
+    for (int i = 0; i < ALERT_TRACKS; i++) {
+        AlertTrack* alert = &alerts[i];
+        if (alert->state != ALERT_IDLE && alert->key == key) {
+            return alert;
+        }
+        if (alert->state == ALERT_IDLE) {
+            if (freeSlot == NULL) {
+                freeSlot = alert;
+            }
+        } else if (alert->state == ALERT_ARMING &&
+                   (oldestArming == NULL || alert->armedMs < oldestArming->armedMs)) {
+            oldestArming = alert;
+        }
+    }
+    if (freeSlot == NULL && oldestArming != NULL) {
+        stats.suppressed++;
+        freeSlot = oldestArming;
+    }
+    if (freeSlot != NULL) {
+        freeSlot->state = ALERT_IDLE;
+        freeSlot->key = key;
+    }
+    return freeSlot;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void alertInit() {
+    memset(alerts, 0, sizeof(alerts));
+    memset(&stats, 0, sizeof(stats));
+    setupOutput(ledPin);
+    setupOutput(buzzerPin);
+    setupOutput(relayPin);
+    outputsOn = false;
+    buzzerOn = false;
+}
+
+void alertObserve(const DroneSignal* signal, uint32_t key, bool isDrone, uint32_t timestampUs) {
+    if (signal == NULL || !isDrone || signal->confidence < ALERT_MIN_CONFIDENCE) {
+        return;
+    }
+    uint32_t now = millis();
+    AlertTrack* alert = findAlert(key);
+    if (alert == NULL) {
+        return;
+    }
+    if (settle(alert, now)) {
+        updateOutputs();
+    }
+
+    alert->lastPacketMs = now;
+    alert->confidence = signal->confidence;
+    alert->frequency = signal->frequency;
+    alert->droneType = signal->droneType;
+
+    bool instant = signal->confidence >= ALERT_INSTANT_CONFIDENCE;
+    switch (alert->state) {
+        case ALERT_IDLE:
+            alert->state = ALERT_ARMING;
+            alert->armedMs = now;
+            alert->packets = 1;
+            break;
+        case ALERT_ARMING:
+            alert->packets++;
+            break;
+        case ALERT_CLEARING:
+            // Back before the hold ran out: the alert never dropped
+            alert->state = ALERT_CONFIRMED;
+            printTransition(alert, -1);
+            return;
+        default:
+            return;
+    }
+    if (!instant && alert->packets < ALERT_CONFIRM_PACKETS) {
+        return;
+    }
+
+    // Confirmed: outputs first, bookkeeping and printing after
+    alert->state = ALERT_CONFIRMED;
+    updateOutputs();
+    setBuzzer(true);
+    uint32_t latencyUs = micros() - timestampUs;
+
+    stats.confirmed++;
+    stats.latencyMeanUs += SCANNER_TIMING_EWMA * ((float)latencyUs - stats.latencyMeanUs);
+    stats.latencyMaxUs = max(stats.latencyMaxUs, latencyUs);
+    if (latencyUs > ALERT_LATENCY_BUDGET_US) {
+        stats.overBudget++;
+    }
+    printTransition(alert, (int32_t)latencyUs);
+}
+
+void alertService() {
+    uint32_t now = millis();
+    bool changed = false;
+    for (int i = 0; i < ALERT_TRACKS; i++) {
+        if (settle(&alerts[i], now)) {
+            changed = true;
+        }
+    }
+    if (changed) {
+        updateOutputs();
+    }
+    if (buzzerOn && now - buzzerStartMs >= ALERT_BUZZER_MS) {
+        setBuzzer(false);
+    }
+}
+
+bool alertActive() {
+    return outputsOn;
+}
+
+const char* alertStateName(AlertState state) {
+    switch (state) {
+        case ALERT_IDLE:      return "idle";
+        case ALERT_ARMING:    return "arming";
+        case ALERT_CONFIRMED: return "confirmed";
+        case ALERT_CLEARING:  return "clearing";
+        default:              return "unknown";
+    }
+}
+
+void alertGetStats(AlertStats* out) {
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
@@ -0,0 +1,234 @@
+/**
+ * Arena Module Implementation
+ *
+ * Both arenas are bump allocators: blocks are never freed, so the used
+ * size is also the high-watermark. The internal arena is a static array
+ * (placed in internal DRAM by the linker); the PSRAM arena is the single
+ * PSRAM allocation made at boot.
+ */
+
+#include "arena.h"
+#include <esp_heap_caps.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+static uint8_t internalArena[ARENA_ENABLED ? ARENA_INTERNAL_BYTES : ARENA_ALIGN]
+    __attribute__((aligned(ARENA_ALIGN)));
+static size_t internalUsed = 0;
+
+static uint8_t* psramArena = NULL;
+static size_t psramArenaSize = 0;
+static size_t psramUsed = 0;
+static bool psramExternal = false;
+
+static uint32_t arenaFailures = 0;
+
+// Heap guard (the hooks run inside the allocator, on any task or core)
+static volatile bool sealed = false;
+static volatile uint32_t failedAllocations = 0;
+static volatile uint32_t hookAllocations = 0;
+static volatile uint32_t hookLastSize = 0;
+static uint32_t reportedAllocations = 0;
+static size_t sealedBlocks = 0;
+static int32_t blocksSinceSeal = 0;
+static uint32_t blocksPeak = 0;
+static uint32_t lastCheckMs = 0;
+
+// ============================================================================
+// Heap Hooks
+// ============================================================================
+
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+static void allocFailed(size_t size, uint32_t caps, const char* function) {
+    failedAllocations = failedAllocations + 1;
+}
+
+#if defined(CONFIG_HEAP_USE_HOOKS) && CONFIG_HEAP_USE_HOOKS
+// Called by the IDF heap for every successful allocation
+extern "C"
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+    if (sealed) {
+        hookAllocations = hookAllocations + 1;
+        hookLastSize = (uint32_t)size;
+    }
+}
+#endif
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static size_t heapBlocks() {
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    return info.allocated_blocks;
+}
+
+static void printArena(const char* name, size_t used, size_t size) {
+    Serial.print(name);
+    Serial.print(used);
+    Serial.print('/');
+    Serial.print(size);
+    Serial.print(F(" bytes"));
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void arenaInit() {
+    internalUsed = 0;
+    psramUsed = 0;
+    heap_caps_register_failed_alloc_callback(allocFailed);
+    if (!ARENA_ENABLED) {
+        return;
+    }
+
+    psramArena = (uint8_t*)heap_caps_malloc(ARENA_PSRAM_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    psramExternal = psramArena != NULL;
+    if (psramArena == NULL) {
+        // No PSRAM: cold objects share internal RAM
+        psramArena = (uint8_t*)heap_caps_malloc(ARENA_PSRAM_BYTES, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    psramArenaSize = psramArena != NULL ? ARENA_PSRAM_BYTES : 0;
+}
+
+void* arenaAlloc(ArenaRegion region, size_t size, const char* owner) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    uint8_t* base = region == ARENA_PSRAM ? psramArena : internalArena;
+    size_t* used = region == ARENA_PSRAM ? &psramUsed : &internalUsed;
+    size_t capacity = region == ARENA_PSRAM ? psramArenaSize : (size_t)ARENA_INTERNAL_BYTES;
+
+    if (ARENA_ENABLED && base != NULL && *used + size <= capacity) {
+        void* block = base + *used;
+        *used += size;
+        memset(block, 0, size);
+        return block;
+    }
+
+    if (ARENA_ENABLED) {
+        arenaFailures++;
+        Serial.print(F("[Arena] "));
+        Serial.print(owner);
+        Serial.print(F(" ("));
+        Serial.print(size);
+        Serial.print(region == ARENA_PSRAM ? F(" bytes) does not fit the PSRAM arena") :
+                                             F(" bytes) does not fit the internal arena"));
+        Serial.println(F(", using the heap"));
+    }
+    uint32_t caps = region == ARENA_PSRAM ? MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT :
+                                            MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    void* block = heap_caps_malloc(size, caps);
+    if (block == NULL && region == ARENA_PSRAM) {
+        block = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    }
+    if (block != NULL) {
+        memset(block, 0, size);
+    }
+    return block;
+}
+
+void arenaSeal() {
+    sealedBlocks = heapBlocks();
+    blocksSinceSeal = 0;
+    blocksPeak = 0;
+    reportedAllocations = 0;
+    lastCheckMs = millis();
+    sealed = true;
+
+    Serial.print(F("[Arena] Sealed: "));
+    printArena("internal ", internalUsed, ARENA_INTERNAL_BYTES);
+    printArena(psramExternal ? ", PSRAM " : ", cold (internal, no PSRAM) ",
+               psramUsed, psramArenaSize);
+    Serial.print(F(", "));
+    Serial.print(sealedBlocks);
+    Serial.println(F(" heap blocks in use"));
+}
+
+void arenaService() {
+    if (!sealed || millis() - lastCheckMs < ARENA_GUARD_CHECK_MS) {
+        return;
+    }
+    lastCheckMs = millis();
+
+    // Exact count from the allocation hook, if built in
+    uint32_t allocations = hookAllocations;
+    if (allocations != reportedAllocations) {
+        Serial.print(F("[Arena] Heap allocated after boot: "));
+        Serial.print(allocations - reportedAllocations);
+        Serial.print(F(" allocation(s), last "));
+        Serial.print(hookLastSize);
+        Serial.println(F(" bytes"));
+        reportedAllocations = allocations;
+    }
+
+    // Blocks that stay allocated are what fragments the heap over days
+    blocksSinceSeal = (int32_t)heapBlocks() - (int32_t)sealedBlocks;
+    if (blocksSinceSeal > (int32_t)blocksPeak) {
+        blocksPeak = (uint32_t)blocksSinceSeal;
+        Serial.print(F("[Arena] Heap grew after boot: "));
+        Serial.print(blocksPeak);
+        Serial.println(F(" more block(s) in use than at boot"));
+    }
+}
+
+void arenaReport() {
+    ArenaStats stats;
+    arenaGetStats(&stats);
+
+    Serial.print(F("MEM,"));
+    Serial.print(stats.heapFree);
+    Serial.print(',');
+    Serial.print(stats.heapMinFree);
+    Serial.print(',');
+    Serial.print(stats.heapLargestBlock);
+    Serial.print(',');
+    Serial.print(stats.psramFree);
+    Serial.print(',');
+    Serial.print(stats.psramMinFree);
+    Serial.print(',');
+    Serial.print(stats.internalUsed);
+    Serial.print(',');
+    Serial.print(stats.internalSize);
+    Serial.print(',');
+    Serial.print(stats.psramUsed);
+    Serial.print(',');
+    Serial.print(stats.psramSize);
+    Serial.print(',');
+    Serial.print(stats.allocationsAfterSeal);
+    Serial.print(',');
+    Serial.println(stats.blocksSinceSeal);
+}
+
+void arenaGetStats(ArenaStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+    const uint32_t internalCaps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+
+    stats->internalUsed = internalUsed;
+    stats->internalSize = ARENA_ENABLED ? ARENA_INTERNAL_BYTES : 0;
+    stats->psramUsed = psramUsed;
+    stats->psramSize = psramArenaSize;
+    stats->psramArenaExternal = psramExternal;
+    stats->arenaFailures = arenaFailures;
+    stats->heapFree = heap_caps_get_free_size(internalCaps);
+    stats->heapMinFree = heap_caps_get_minimum_free_size(internalCaps);
+    stats->heapLargestBlock = heap_caps_get_largest_free_block(internalCaps);
+    stats->psramFree = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    stats->psramMinFree = heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM);
+    stats->psramTotal = heap_caps_get_total_size(MALLOC_CAP_SPIRAM);
+    stats->sealed = sealed;
+    stats->allocationsAfterSeal = hookAllocations;
+    stats->blocksSinceSeal = blocksSinceSeal;
+    stats->blocksPeakSinceSeal = blocksPeak;
+    stats->failedAllocations = failedAllocations;
+}
@@ -0,0 +1,227 @@
+/**
+ * Boot Module Implementation
+ *
+ * The snapshot is small (tens of bytes), so the RTC copy is rewritten
+ * wholesale. A CRC guards both copies: RTC memory holds garbage after power
+ * loss, and a torn NVS write must not resume the scanners on a bad channel.
+ */
+
+#include "boot.h"
+#include <Preferences.h>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+#include <stddef.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+#define BOOT_MAGIC      0x424F5431UL    // "BOT1"
+#define NVS_NAMESPACE   "boot"
+#define NVS_KEY_SCAN    "scan"
+
+// Saved scan state
+typedef struct {
+    uint32_t magic;
+    uint16_t channel[MAX_SCANNERS];     // Sweep position per scanner
+    uint8_t modulation[MAX_SCANNERS];   // Modulation per scanner
+    uint8_t scannerMask;                // Scanners with a saved position
+    uint8_t hotCount;                   // Entries in hotChannels
+    uint8_t hotChannels[BOOT_HOT_CHANNELS];  // Most active first
+    uint32_t crc;
+} BootSnapshot;
+
+RTC_NOINIT_ATTR static BootSnapshot rtcSnapshot;
+
+static BootSnapshot restored;
+static BootSource source = BOOT_SOURCE_NONE;
+static DroneScanner* scanners[MAX_SCANNERS];
+
+// Decaying packet count per channel
+static float activity[BOOT_CHANNELS];
+static uint32_t lastDecayMs = 0;
+static uint32_t lastSnapshotMs = 0;
+static uint32_t lastNvsSaveMs = 0;
+
+static uint32_t phaseUs[BOOT_PHASE_COUNT];
+
+static const char* const phaseNames[BOOT_PHASE_COUNT] = {
+    "radio", "rx", "state", "display", "log", "gps", "ready"
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t snapshotChecksum(const BootSnapshot* snapshot) {
+    return esp_rom_crc32_le(0, (const uint8_t*)snapshot, offsetof(BootSnapshot, crc));
+}
+
+static bool snapshotValid(const BootSnapshot* snapshot) {
+    return snapshot->magic == BOOT_MAGIC && snapshot->hotCount <= BOOT_HOT_CHANNELS &&
+           snapshotChecksum(snapshot) == snapshot->crc;
+}
+
+/**
+ * Capture the running scanners and the most active channels
+ */
+static void buildSnapshot(BootSnapshot* snapshot) {
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->magic = BOOT_MAGIC;
+
+    for (int i = 0; i < MAX_SCANNERS; i++) {
+        if (scanners[i] != NULL) {
+            snapshot->channel[i] = scanners[i]->sweepChannel;
+            snapshot->modulation[i] = (uint8_t)scanners[i]->modulation;
+            snapshot->scannerMask |= (uint8_t)(1U << i);
+        }
+    }
+
+    // Top channels by activity (selection, the list is short)
+    bool taken[BOOT_CHANNELS] = {};
+    while (snapshot->hotCount < BOOT_HOT_CHANNELS) {
+        int best = -1;
+        for (int ch = 0; ch < BOOT_CHANNELS; ch++) {
+            if (!taken[ch] && activity[ch] > 0.0f && (best < 0 || activity[ch] > activity[best])) {
+                best = ch;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        taken[best] = true;
+        snapshot->hotChannels[snapshot->hotCount++] = (uint8_t)best;
+    }
+
+    snapshot->crc = snapshotChecksum(snapshot);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void bootMark(BootPhase phase) {
+    if (phase >= BOOT_PHASE_COUNT || phaseUs[phase] != 0) {
+        return;
+    }
+    phaseUs[phase] = (uint32_t)max(esp_timer_get_time(), (int64_t)1);
+}
+
+uint32_t bootPhaseUs(BootPhase phase) {
+    return phase < BOOT_PHASE_COUNT ? phaseUs[phase] : 0;
+}
+
+void bootReport() {
+    static const char* const sourceNames[] = { "Cold start", "Warm start from RTC", "Warm start from NVS" };
+
+    Serial.print(F("[Boot] "));
+    Serial.print(sourceNames[source]);
+    Serial.print(F(" (reset reason "));
+    Serial.print((int)esp_reset_reason());
+    Serial.print(F(")"));
+    bool first = true;
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        if (phaseUs[i] == 0) {
+            continue;
+        }
+        Serial.print(first ? F(": ") : F(", "));
+        first = false;
+        Serial.print(phaseNames[i]);
+        Serial.print(' ');
+        Serial.print(phaseUs[i] / 1000.0f, 1);
+        Serial.print(F(" ms"));
+    }
+    Serial.println();
+}
+
+BootSource bootRestore() {
+    memset(activity, 0, sizeof(activity));
+    lastDecayMs = millis();
+    lastSnapshotMs = millis();
+    lastNvsSaveMs = millis();
+
+    source = BOOT_SOURCE_NONE;
+    if (snapshotValid(&rtcSnapshot)) {
+        restored = rtcSnapshot;
+        source = BOOT_SOURCE_RTC;
+    } else {
+        Preferences prefs;
+        if (prefs.begin(NVS_NAMESPACE, true)) {
+            if (prefs.getBytesLength(NVS_KEY_SCAN) == sizeof(restored) &&
+                prefs.getBytes(NVS_KEY_SCAN, &restored, sizeof(restored)) == sizeof(restored) &&
+                snapshotValid(&restored)) {
+                source = BOOT_SOURCE_NVS;
+            }
+            prefs.end();
+        }
+    }
+
+    if (source == BOOT_SOURCE_NONE) {
+        memset(&restored, 0, sizeof(restored));
+        return source;
+    }
+
+    // Restored hot channels keep their order until new traffic is seen
+    for (int i = 0; i < restored.hotCount; i++) {
+        if (restored.hotChannels[i] < BOOT_CHANNELS) {
+            activity[restored.hotChannels[i]] = (float)(restored.hotCount - i);
+        }
+    }
+    return source;
+}
+
+bool bootResumeScanner(DroneScanner* scanner) {
+    if (scanner == NULL || scanner->index >= MAX_SCANNERS) {
+        return false;
+    }
+    scanners[scanner->index] = scanner;
+
+    if (source == BOOT_SOURCE_NONE) {
+        return false;
+    }
+
+    if (restored.scannerMask & (1U << scanner->index)) {
+        scannerResume(scanner, restored.channel[scanner->index],
+                      (ModulationType)restored.modulation[scanner->index]);
+    }
+    for (int i = 0; i < restored.hotCount; i++) {
+        scannerQueueChannel(scanner, restored.hotChannels[i]);
+    }
+    return true;
+}
+
+void bootNotePacket(int channel) {
+    if (channel >= 0 && channel < BOOT_CHANNELS) {
+        activity[channel] += 1.0f;
+    }
+}
+
+void bootService(bool force) {
+    uint32_t now = millis();
+
+    if (now - lastDecayMs >= BOOT_HOT_HALF_LIFE_MS) {
+        for (int ch = 0; ch < BOOT_CHANNELS; ch++) {
+            activity[ch] *= 0.5f;
+        }
+        lastDecayMs = now;
+    }
+
+    if (!force && now - lastSnapshotMs < BOOT_SNAPSHOT_MS) {
+        return;
+    }
+    BootSnapshot snapshot;
+    buildSnapshot(&snapshot);
+    rtcSnapshot = snapshot;
+    lastSnapshotMs = now;
+
+    if (!force && now - lastNvsSaveMs < BOOT_NVS_SAVE_MS) {
+        return;
+    }
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, false)) {
+        prefs.putBytes(NVS_KEY_SCAN, &snapshot, sizeof(snapshot));
+        prefs.end();
+    }
+    lastNvsSaveMs = now;
+}
@@ -0,0 +1,92 @@
+/**
+ * Change Channel Module Implementation
+ */
+
+#include "change_channel.h"
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * Fold a background dwell into the learned busy rate and excess
+ */
+static void learn(ChangeChannel* channel, bool busy, float excessDb) {
+    float alpha = fmaxf(1.0f / (channel->dwells + 1), CHANGE_BACKGROUND_ALPHA);
+    float deviation = fabsf(excessDb - channel->excessMean);
+    channel->busyRate += alpha * ((busy ? 1.0f : 0.0f) - channel->busyRate);
+    channel->excessMean += alpha * (excessDb - channel->excessMean);
+    channel->excessSpread += alpha * (deviation - channel->excessSpread);
+    if (channel->dwells < CHANGE_LEARN_DWELLS) {
+        channel->dwells++;
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void changeChannelReset(ChangeChannel* channel) {
+    if (channel != NULL) {
+        memset(channel, 0, sizeof(*channel));
+    }
+}
+
+ChangeStep changeChannelStep(ChangeChannel* channel, bool busy, float excessDb) {
+    if (channel == NULL || isnan(excessDb)) {
+        return CHANGE_STEP_NONE;
+    }
+    if (channel->dwells < CHANGE_LEARN_DWELLS) {
+        learn(channel, busy, excessDb);
+        return CHANGE_STEP_NONE;
+    }
+
+    float z = (excessDb - channel->excessMean) / fmaxf(channel->excessSpread, CHANGE_SPREAD_MIN_DB);
+    if (channel->alarmed) {
+        channel->alarmDwells++;
+        channel->quietDwells = (!busy && z <= CHANGE_RSSI_DRIFT) ? channel->quietDwells + 1 : 0;
+        if (channel->quietDwells >= CHANGE_CLEAR_DWELLS) {
+            channel->alarmed = false;
+            channel->busySum = 0.0f;
+            channel->rssiSum = 0.0f;
+            return CHANGE_STEP_QUIET;
+        }
+        if (channel->alarmDwells >= CHANGE_ABSORB_DWELLS) {
+            // Relearn the background with the emitter in it
+            changeChannelReset(channel);
+            return CHANGE_STEP_ABSORBED;
+        }
+        return CHANGE_STEP_NONE;
+    }
+
+    // CUSUM of the busy rate against background + shift; a background
+    // busier than CHANGE_BUSY_MAX (an absorbed emitter) leaves no increase
+    // to test for
+    if (channel->busyRate < CHANGE_BUSY_MAX) {
+        float p0 = fmaxf(channel->busyRate, CHANGE_BUSY_MIN);
+        float p1 = p0 + CHANGE_BUSY_SHIFT;
+        float llr = busy ? logf(p1 / p0) : logf((1.0f - p1) / (1.0f - p0));
+        channel->busySum = fmaxf(0.0f, channel->busySum + llr);
+    } else {
+        channel->busySum = 0.0f;
+    }
+
+    // Page-Hinkley on the excess
+    channel->rssiSum = fmaxf(0.0f, channel->rssiSum + fminf(z, CHANGE_RSSI_CLIP) - CHANGE_RSSI_DRIFT);
+
+    if (channel->busySum > CHANGE_BUSY_THRESHOLD || channel->rssiSum > CHANGE_RSSI_THRESHOLD) {
+        channel->alarmed = true;
+        channel->busyCause = channel->busySum > CHANGE_BUSY_THRESHOLD;
+        channel->alarmDwells = 0;
+        channel->quietDwells = 0;
+        return CHANGE_STEP_ONSET;
+    }
+    // A change in progress must not become the background
+    if (channel->busySum < CHANGE_BUSY_THRESHOLD / 2 && channel->rssiSum < CHANGE_RSSI_THRESHOLD / 2) {
+        learn(channel, busy, excessDb);
+    }
+    return CHANGE_STEP_NONE;
+}
+
@@ -0,0 +1,198 @@
+/**
+ * Change Detect Module Implementation
+ *
+ * Everything runs in the main loop. Observations of a channel are folded
+ * into its open dwell (peak excess, busy flag) until the sweep covering it
+ * ends; the detector then sees one update per channel per sweep.
+ */
+
+#include "change_detect.h"
+#include "noise_floor.h"
+#include "occupancy.h"
+#include "scanner_task.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+static ChangeChannel channels[CHANGE_CHANNELS];
+static float dwellExcess[CHANGE_CHANNELS];          // Peak excess of the open dwell
+static uint64_t dwellSampled = 0;                   // Open dwell has a sample (bit per channel)
+static uint64_t dwellBusy = 0;                      // Open dwell was busy (bit per channel)
+static uint32_t onsetMs[CHANGE_CHANNELS];
+static uint32_t signatureMs[CHANGE_CHANNELS];       // Last signature match (0 = never)
+static bool enabled = CHANGE_DETECT_ENABLED;
+static ChangeDetectStats stats;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static float channelMHz(int channel) {
+    return FREQ_900_MIN + channel * (SWEEP_STEP_KHZ / 1000.0f);
+}
+
+static bool signatureRecent(int channel, uint32_t nowMs) {
+    return signatureMs[channel] != 0 && nowMs - signatureMs[channel] < CHANGE_SIGNATURE_MS;
+}
+
+static void reportOnset(int channel, const ChangeChannel* state, float excessDb, bool known) {
+    // EMITTER,<channel>,<MHz>,<busy|rssi>,<signature|unknown>,
+    // <background busy rate>,<excess dB>,<background excess dB>
+    Serial.print(F("EMITTER,"));
+    Serial.print(channel);
+    Serial.print(',');
+    Serial.print(channelMHz(channel), 1);
+    Serial.print(',');
+    Serial.print(state->busyCause ? F("busy") : F("rssi"));
+    Serial.print(',');
+    Serial.print(known ? F("signature") : F("unknown"));
+    Serial.print(',');
+    Serial.print(state->busyRate, 3);
+    Serial.print(',');
+    Serial.print(excessDb, 1);
+    Serial.print(',');
+    Serial.println(state->excessMean, 1);
+}
+
+static void reportEnd(int channel, ChangeStep step, uint32_t nowMs) {
+    // EMITTER_END,<channel>,<MHz>,<quiet|absorbed>,<duration s>
+    Serial.print(F("EMITTER_END,"));
+    Serial.print(channel);
+    Serial.print(',');
+    Serial.print(channelMHz(channel), 1);
+    Serial.print(',');
+    Serial.print(step == CHANGE_STEP_ABSORBED ? F("absorbed") : F("quiet"));
+    Serial.print(',');
+    Serial.println((nowMs - onsetMs[channel]) / 1000);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void changeDetectNote(int channel, float excessDb, bool busy) {
+    if (channel < 0 || channel >= CHANGE_CHANNELS || isnan(excessDb)) {
+        return;
+    }
+    uint64_t bit = 1ULL << channel;
+    dwellExcess[channel] = (dwellSampled & bit) ? max(dwellExcess[channel], excessDb) : excessDb;
+    dwellSampled |= bit;
+    if (busy) {
+        dwellBusy |= bit;
+    }
+}
+
+void changeDetectNoteSignature(int channel) {
+    if (channel >= 0 && channel < CHANGE_CHANNELS) {
+        signatureMs[channel] = max(millis(), 1UL);
+    }
+}
+
+void changeDetectSweepEnd(uint16_t firstChannel, uint16_t lastChannel) {
+    uint32_t nowMs = millis();
+    int64_t startUs = esp_timer_get_time();
+    uint32_t updates = 0;
+
+    for (uint16_t ch = firstChannel; ch <= lastChannel && ch < CHANGE_CHANNELS; ch++) {
+        uint64_t bit = 1ULL << ch;
+        if (!(dwellSampled & bit)) {
+            // Skipped by this sweep: no dwell
+            continue;
+        }
+        bool busy = (dwellBusy & bit) != 0;
+        float excessDb = dwellExcess[ch];
+        dwellSampled &= ~bit;
+        dwellBusy &= ~bit;
+
+        ChangeChannel* state = &channels[ch];
+        ChangeStep step = changeChannelStep(state, busy, excessDb);
+        updates++;
+
+        if (step == CHANGE_STEP_ONSET) {
+            bool known = signatureRecent(ch, nowMs);
+            onsetMs[ch] = nowMs;
+            stats.onsets++;
+            stats.unknownOnsets += known ? 0 : 1;
+            stats.active++;
+            if (enabled) {
+                reportOnset(ch, state, excessDb, known);
+            }
+        } else if (step == CHANGE_STEP_QUIET || step == CHANGE_STEP_ABSORBED) {
+            stats.ended += step == CHANGE_STEP_QUIET ? 1 : 0;
+            stats.absorbed += step == CHANGE_STEP_ABSORBED ? 1 : 0;
+            stats.active--;
+            if (enabled) {
+                reportEnd(ch, step, nowMs);
+            }
+        }
+    }
+
+    if (updates > 0) {
+        float perUpdateNs = (float)(esp_timer_get_time() - startUs) * 1000.0f / updates;
+        stats.dwells += updates;
+        stats.updateMeanNs += SCANNER_TIMING_EWMA * (perUpdateNs - stats.updateMeanNs);
+    }
+}
+
+void changeDetectEnable(bool enable) {
+    enabled = enable;
+}
+
+bool changeDetectEnabled() {
+    return enabled;
+}
+
+void changeDetectBenchmark(uint16_t rowCount) {
+    uint8_t column[OCC_ROWS];
+    int channelCount = min((int)NUM_SWEEP_CHANNELS, CHANGE_CHANNELS);
+    uint16_t replayed = 0;
+    uint32_t updates = 0;
+    uint32_t alarms = 0;
+    uint32_t totalUs = 0;
+
+    for (int ch = 0; ch < channelCount; ch++) {
+        uint16_t rows = occupancyColumn(ch, min(rowCount, (uint16_t)OCC_ROWS), column);
+        // Any fixed reference will do: the detector learns the offset
+        float floorDbm = noiseFloorGet(ch, MOD_LORA);
+        ChangeChannel state;
+        changeChannelReset(&state);
+
+        int64_t startUs = esp_timer_get_time();
+        for (uint16_t i = 0; i < rows; i++) {
+            if (column[i] == 0) {
+                continue;
+            }
+            bool busy = occupancyRowActive(ch, rows - 1 - i);
+            if (changeChannelStep(&state, busy, occupancyRssiDbm(column[i]) - floorDbm) ==
+                CHANGE_STEP_ONSET) {
+                alarms++;
+            }
+            updates++;
+        }
+        totalUs += (uint32_t)(esp_timer_get_time() - startUs);
+        replayed = max(replayed, rows);
+    }
+
+    // CHANGEBENCH,<rows>,<channels>,<alarms>,<alarms per channel-hour>,
+    // <update mean ns>
+    float channelHours = (float)replayed * channelCount * OCC_ROW_MS / 3600000.0f;
+    Serial.print(F("CHANGEBENCH,"));
+    Serial.print(replayed);
+    Serial.print(',');
+    Serial.print(channelCount);
+    Serial.print(',');
+    Serial.print(alarms);
+    Serial.print(',');
+    Serial.print(channelHours > 0.0f ? alarms / channelHours : 0.0f, 4);
+    Serial.print(',');
+    Serial.println(updates > 0 ? (float)totalUs * 1000.0f / updates : 0.0f, 0);
+}
+
+void changeDetectGetStats(ChangeDetectStats* out) {
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
@@ -0,0 +1,68 @@
+/**
+ * Detection Classifier Module Implementation
+ *
+ * Evaluation must stay bit-exact with evaluate_int() in
+ * tools/classifier_compile.py so host accuracy figures hold on the device.
+ */
+
+#include "classifier.h"
+
+// ============================================================================
+// Feature Extraction
+// ============================================================================
+
+void classifierExtractFeatures(const DroneSignal* signal, const EmitterTrack* track,
+                               const PacketCapture* capture, float noiseFloor,
+                               float bandwidthKHz, ClassifierFeatures* features) {
+    int32_t* x = features->value;
+
+    x[FEATURE_RSSI_MARGIN] = (int32_t)lroundf((signal->rssi - noiseFloor) * 10.0f);
+    x[FEATURE_SNR] = (int32_t)lroundf(signal->snr * 10.0f);
+    x[FEATURE_FREQ_ERROR] = (int32_t)lroundf(fabsf(signal->freqError));
+    x[FEATURE_BANDWIDTH] = (int32_t)lroundf(bandwidthKHz);
+
+    x[FEATURE_INTERARRIVAL] = CLASSIFIER_NO_TIMING_US;
+    x[FEATURE_HOP_SPACING] = 0;
+    if (track != NULL) {
+        if (track->timing.packets > 1) {
+            x[FEATURE_INTERARRIVAL] = (int32_t)min(track->timing.minDeltaUs,
+                                                   (uint32_t)CLASSIFIER_NO_TIMING_US);
+        }
+        x[FEATURE_HOP_SPACING] = (int32_t)track->hopSpacingKHz;
+    }
+
+    x[FEATURE_PAYLOAD_LENGTH] = (capture != NULL) ? (int32_t)capture->length : 0;
+
+#ifdef CLASSIFIER_TRACE
+    // Feature trace for host-side training (tools/classifier_compile.py)
+    Serial.print(F("FEAT"));
+    for (int i = 0; i < CLASSIFIER_NUM_FEATURES; i++) {
+        Serial.print(',');
+        Serial.print(x[i]);
+    }
+    Serial.println();
+#endif
+}
+
+// ============================================================================
+// Model Evaluation
+// ============================================================================
+
+uint8_t classifierConfidence(const ClassifierFeatures* features) {
+    if (features == NULL) {
+        return 0;
+    }
+
+    int32_t score = kClassifierBias;
+    for (int i = 0; i < CLASSIFIER_NUM_FEATURES; i++) {
+        int32_t v = constrain(features->value[i], kClassifierMin[i], kClassifierMax[i]);
+        score += ((v - kClassifierMean[i]) * kClassifierWeight[i]) >> kClassifierShift[i];
+    }
+
+    // Map the Q8 score onto the sigmoid table
+    const int32_t span = CLASSIFIER_SCORE_RANGE << CLASSIFIER_SCORE_FRAC_BITS;
+    score = constrain(score, -span, span - 1);
+    int32_t index = (score + span) * CLASSIFIER_SIGMOID_ENTRIES / (2 * span);
+
+    return kClassifierSigmoid[index];
+}
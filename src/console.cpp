@@ -0,0 +1,681 @@
+/**
+ * Console Module Implementation
+ *
+ * Commands edit a copy of the current settings and hand it to
+ * scanConfigSet() whole, so a rejected command changes nothing.
+ */
+
+#include "console.h"
+#include "scan_config.h"
+#include "noise_floor.h"
+#include "detection_log.h"
+#include "mesh_report.h"
+#include "timebase.h"
+#include "low_power.h"
+#include "arena.h"
+#include "coverage.h"
+#include "pcap_export.h"
+#include "occupancy.h"
+#include "alert.h"
+#include "sketch.h"
+#include "lock_on.h"
+#include "hier_sweep.h"
+#include "spectrum_report.h"
+#include "change_detect.h"
+#include <stdlib.h>
+#include <strings.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+#define CONSOLE_MAX_ARGS    5
+
+static char line[CONSOLE_LINE_MAX];
+static size_t lineLength = 0;
+static bool lineOverflow = false;
+
+// Packet histograms (main loop only)
+static uint32_t packets = 0;
+static uint32_t rssiBins[CONSOLE_RSSI_BINS];
+static uint32_t snrBins[CONSOLE_SNR_BINS];
+static uint32_t channelPackets[CONSOLE_CHANNELS];
+static uint32_t modulationPackets[MOD_UNKNOWN];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void clearHistograms() {
+    packets = 0;
+    memset(rssiBins, 0, sizeof(rssiBins));
+    memset(snrBins, 0, sizeof(snrBins));
+    memset(channelPackets, 0, sizeof(channelPackets));
+    memset(modulationPackets, 0, sizeof(modulationPackets));
+}
+
+static int histogramBin(float value, int lower, int width, int bins) {
+    int bin = (int)floorf((value - lower) / width);
+    return constrain(bin, 0, bins - 1);
+}
+
+static bool parseFloat(const char* text, float* value) {
+    char* end;
+    *value = strtof(text, &end);
+    return end != text && *end == '\0' && !isnan(*value);
+}
+
+static bool parseUnsigned(const char* text, uint32_t* value) {
+    char* end;
+    unsigned long parsed = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-') {
+        return false;
+    }
+    *value = (uint32_t)parsed;
+    return true;
+}
+
+/**
+ * Sweep channel of a frequency on the channel grid
+ * @return Channel index, or -1 if off the grid
+ */
+static int gridChannel(float frequency) {
+    float position = (frequency - FREQ_900_MIN) * 1000.0f / SWEEP_STEP_KHZ;
+    int channel = (int)lroundf(position);
+    if (fabsf(position - channel) > 0.01f || channel < 0 || channel >= (int)NUM_SWEEP_CHANNELS) {
+        return -1;
+    }
+    return channel;
+}
+
+static bool parseModulations(char* list, uint8_t* mask) {
+    *mask = 0;
+    for (char* name = strtok(list, ","); name != NULL; name = strtok(NULL, ",")) {
+        int m = MOD_LORA;
+        while (m < MOD_UNKNOWN && strcasecmp(name, getModulationName((ModulationType)m)) != 0) {
+            m++;
+        }
+        if (m == MOD_UNKNOWN) {
+            return false;
+        }
+        *mask |= MOD_MASK(m);
+    }
+    return *mask != 0;
+}
+
+static void printStat(const char* name, uint32_t value) {
+    Serial.print(F("STAT,"));
+    Serial.print(name);
+    Serial.print(',');
+    Serial.println(value);
+}
+
+static void printStat(const char* name, float value, int digits) {
+    Serial.print(F("STAT,"));
+    Serial.print(name);
+    Serial.print(',');
+    Serial.println(value, digits);
+}
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+static void printHelp() {
+    Serial.println(F("[Console] Commands:"));
+    Serial.println(F("  show                                 settings and scanner plans"));
+    Serial.println(F("  band <min MHz> <max MHz> [step kHz]  band plan and sweep step"));
+    Serial.println(F("  dwell <ms>                           dwell per channel"));
+    Serial.println(F("  mods <lora,fsk,ook>                  modulation set"));
+    Serial.println(F("  modtime <ms>                         time per modulation"));
+    Serial.println(F("  lora <sf> <bw kHz>                   LoRa spreading factor and bandwidth"));
+    Serial.println(F("  thresh <margin dB> <k>               detection margin above the noise floor"));
+    Serial.println(F("  defaults                             restore compile-time settings"));
+    Serial.println(F("  stats                                counters"));
+    Serial.println(F("  hist <rssi|snr|chan|noise>           histograms"));
+    Serial.println(F("  cov [lora,fsk,ook]                   scan coverage over the last hour"));
+    Serial.println(F("  pcap <on|off>                        stream packets as pcapng (PCAP lines)"));
+    Serial.println(F("  lock <on|off>                        lock on to energy the sweep misses"));
+    Serial.println(F("  hier <on|off>                        coarse-to-fine sweep (HSWEEP lines)"));
+    Serial.println(F("  spec <on|off>                        compressed spectrum rows (SPEC lines)"));
+    Serial.println(F("  spec bench [rows]                    codec benchmark on the occupancy history"));
+    Serial.println(F("  change <on|off>                      new-emitter reports (EMITTER lines)"));
+    Serial.println(F("  change bench [rows]                  change detector replay of the occupancy history"));
+    Serial.println(F("  occ <min MHz> <max MHz> <minutes>    occupancy of a band"));
+    Serial.println(F("  top <k> <minutes>                    busiest channels"));
+    Serial.println(F("  new <seconds>                        channels newly active"));
+    Serial.println(F("  uniq [minutes]                       distinct transmitters and busiest ones"));
+    Serial.println(F("  sketch [minutes]                     sketches for merging across nodes"));
+    Serial.println(F("  clear                                reset packet histograms"));
+}
+
+static void printStats() {
+    printStat("uptime_s", (uint32_t)(millis() / 1000));
+    printStat("packets", packets);
+    for (int m = MOD_LORA; m < MOD_UNKNOWN; m++) {
+        Serial.print(F("STAT,packets_"));
+        Serial.print(getModulationName((ModulationType)m));
+        Serial.print(',');
+        Serial.println(modulationPackets[m]);
+    }
+
+    for (uint8_t i = 0; i < MAX_SCANNERS; i++) {
+        ScannerTaskStats scanner;
+        scannerTaskGetStats(i, &scanner);
+        if (scanner.dwells == 0) {
+            continue;
+        }
+        // STAT,scan<i>,<packets>,<read errors>,<dropped>,<dwells>,
+        // <latency mean us>,<latency max us>,<jitter mean us>,<jitter max us>
+        Serial.print(F("STAT,scan"));
+        Serial.print(i);
+        Serial.print(',');
+        Serial.print(scanner.packets);
+        Serial.print(',');
+        Serial.print(scanner.readErrors);
+        Serial.print(',');
+        Serial.print(scanner.dropped);
+        Serial.print(',');
+        Serial.print(scanner.dwells);
+        Serial.print(',');
+        Serial.print(scanner.latencyMeanUs, 0);
+        Serial.print(',');
+        Serial.print(scanner.latencyMaxUs);
+        Serial.print(',');
+        Serial.print(scanner.dwellJitterMeanUs, 0);
+        Serial.print(',');
+        Serial.println(scanner.dwellJitterMaxUs);
+    }
+
+    DetectionLogStats log;
+    detectionLogGetStats(&log);
+    printStat("log_written", log.recordsWritten);
+    printStat("log_dropped", log.recordsDropped);
+    printStat("log_recovered", log.recordsRecovered);
+    printStat("log_corrupt", log.corruptRecords);
+    printStat("log_erases", log.sectorErases);
+    printStat("log_erase_max_us", log.eraseMaxUs);
+    printStat("log_erases_between_dwells", log.erasesBetweenDwells);
+
+    ReportStats report;
+    meshReportGetStats(&report);
+    printStat("report_sent", report.sent);
+    printStat("report_relayed", report.relayed);
+    printStat("report_received", report.received);
+    printStat("report_throttled", report.throttled);
+    printStat("report_airtime_ms", report.airtimeMs);
+    printStat("report_listen_ms", report.listenMs);
+
+    TimebaseStats timebase;
+    timebaseGetStats(&timebase);
+    printStat("pps_locked", (uint32_t)timebase.locked);
+    printStat("pps_pulses", timebase.pulses);
+    printStat("pps_outliers", timebase.outliers);
+    printStat("pps_jitter_us", timebase.jitterUs, 2);
+
+    if (lowPowerEnabled()) {
+        LowPowerStats power;
+        lowPowerGetStats(&power);
+        printStat("sleeps", power.sleeps);
+        printStat("asleep_ms", (uint32_t)(power.asleepUs / 1000));
+    }
+
+    ArenaStats memory;
+    arenaGetStats(&memory);
+    printStat("heap_free", memory.heapFree);
+    printStat("heap_min_free", memory.heapMinFree);
+    printStat("heap_largest_block", memory.heapLargestBlock);
+    printStat("psram_free", memory.psramFree);
+    printStat("psram_min_free", memory.psramMinFree);
+    printStat("arena_internal_used", memory.internalUsed);
+    printStat("arena_psram_used", memory.psramUsed);
+    printStat("arena_failures", memory.arenaFailures);
+    printStat("heap_allocs_after_boot", memory.allocationsAfterSeal);
+    printStat("heap_blocks_peak_after_boot", memory.blocksPeakSinceSeal);
+    printStat("heap_alloc_failures", memory.failedAllocations);
+
+    AlertStats alert;
+    alertGetStats(&alert);
+    printStat("alert_confirmed", alert.confirmed);
+    printStat("alert_suppressed", alert.suppressed);
+    printStat("alert_cleared", alert.cleared);
+    printStat("alert_active", (uint32_t)alert.alerting);
+    printStat("alert_latency_mean_us", alert.latencyMeanUs, 0);
+    printStat("alert_latency_max_us", alert.latencyMaxUs);
+    printStat("alert_over_budget", alert.overBudget);
+
+    LockOnStats lock;
+    lockOnGetStats(&lock);
+    printStat("lock_enabled", (uint32_t)lockOnEnabled());
+    printStat("lock_sessions", lock.sessions);
+    printStat("lock_demodulated", lock.demodulated);
+    printStat("lock_packets", lock.packets);
+    printStat("lock_demod_mean_us", lock.timeToDemodMeanUs, 0);
+    printStat("lock_demod_max_us", lock.timeToDemodMaxUs);
+    printStat("lock_away_mean_us", lock.awayMeanUs, 0);
+    printStat("lock_away_max_us", lock.awayMaxUs);
+    printStat("lock_away_ms", lock.awayTotalMs);
+
+    HierSweepStats hier;
+    hierSweepGetStats(&hier);
+    printStat("hier_enabled", (uint32_t)hierSweepEnabled());
+    printStat("hier_passes", hier.passes);
+    printStat("hier_probes", hier.probes);
+    printStat("hier_pass_mean_us", hier.coarseMeanUs, 0);
+    printStat("hier_pass_max_us", hier.coarseMaxUs);
+    printStat("hier_dwell_channels_mean", hier.dwellChannelsMean, 1);
+    printStat("hier_sweep_mean_ms", hier.sweepMeanMs, 0);
+    printStat("hier_revisit_max_ms", hier.revisitMaxMs);
+    printStat("flat_sweep_mean_ms", hier.flatSweepMeanMs, 0);
+    printStat("flat_revisit_max_ms", hier.flatRevisitMaxMs);
+
+    SpectrumReportStats spectrum;
+    spectrumReportGetStats(&spectrum);
+    printStat("spec_rows", spectrum.rows);
+    printStat("spec_raw_bytes", spectrum.rawBytes);
+    printStat("spec_encoded_bytes", spectrum.encodedBytes);
+    printStat("spec_encode_mean_us", spectrum.encodeMeanUs, 1);
+    printStat("spec_encode_max_us", spectrum.encodeMaxUs);
+
+    ChangeDetectStats change;
+    changeDetectGetStats(&change);
+    printStat("change_enabled", (uint32_t)changeDetectEnabled());
+    printStat("change_dwells", change.dwells);
+    printStat("change_onsets", change.onsets);
+    printStat("change_unknown_onsets", change.unknownOnsets);
+    printStat("change_ended", change.ended);
+    printStat("change_absorbed", change.absorbed);
+    printStat("change_active", (uint32_t)change.active);
+    printStat("change_update_mean_ns", change.updateMeanNs, 0);
+
+    PcapExportStats capture;
+    pcapExportGetStats(&capture);
+    if (capture.running || capture.packets > 0) {
+        printStat("pcap_packets", capture.packets);
+        printStat("pcap_dropped", capture.dropped);
+        printStat("pcap_bytes", capture.bytes);
+    }
+}
+
+static float channelMHz(int channel) {
+    return FREQ_900_MIN + channel * (SWEEP_STEP_KHZ / 1000.0f);
+}
+
+/**
+ * OCC,<min MHz>,<max MHz>,<window s>,<occupancy %>,<busiest MHz>,<busiest %>
+ */
+static void printOccupancy(int first, int last, uint32_t windowMs) {
+    OccupancyRange range;
+    if (!occupancyQueryRange(first, last, windowMs, &range)) {
+        Serial.println(F("[Console] Error: no occupancy history for that band"));
+        return;
+    }
+    Serial.print(F("OCC,"));
+    Serial.print(channelMHz(first), 3);
+    Serial.print(',');
+    Serial.print(channelMHz(last), 3);
+    Serial.print(',');
+    Serial.print((uint32_t)range.rows * OCC_ROW_MS / 1000);
+    Serial.print(',');
+    Serial.print(range.occupancy * 100.0f, 2);
+    Serial.print(',');
+    if (range.busiestChannel >= 0) {
+        Serial.print(channelMHz(range.busiestChannel), 3);
+        Serial.print(',');
+        Serial.println(100.0f * range.busiestRows / range.rows, 2);
+    } else {
+        Serial.println(F(","));
+    }
+}
+
+/**
+ * <tag>,<MHz>,<active rows>,<occupancy %>,<last active s ago>
+ */
+static void printChannels(const char* tag, const OccupancyChannel* channels, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        Serial.print(tag);
+        Serial.print(',');
+        Serial.print(channelMHz(channels[i].channel), 3);
+        Serial.print(',');
+        Serial.print(channels[i].activeRows);
+        Serial.print(',');
+        Serial.print(channels[i].occupancy * 100.0f, 2);
+        Serial.print(',');
+        Serial.println(channels[i].lastActiveAgoMs / 1000);
+    }
+    if (count == 0) {
+        Serial.println(F("[Console] No channels"));
+    }
+}
+
+/**
+ * HEAVY,<transmitter key hex>,<packets>, busiest first
+ */
+static void printHeavyHitters(uint32_t windowMs) {
+    SketchHeavyHitter heavy[SKETCH_HEAVY_MAX];
+    uint8_t count = sketchHeavyHitters(windowMs, heavy, SKETCH_HEAVY_MAX);
+    for (uint8_t i = 0; i < count; i++) {
+        Serial.print(F("HEAVY,"));
+        Serial.print(heavy[i].key, HEX);
+        Serial.print(',');
+        Serial.println(heavy[i].packets);
+    }
+}
+
+static void printHistogram(const char* name) {
+    const ScanConfig* config = scanConfigGet();
+
+    if (strcasecmp(name, "rssi") == 0) {
+        // HIST,rssi,<bin lower dBm>,<packets>
+        for (int i = 0; i < CONSOLE_RSSI_BINS; i++) {
+            Serial.print(F("HIST,rssi,"));
+            Serial.print(CONSOLE_RSSI_MIN_DBM + i * CONSOLE_RSSI_BIN_DB);
+            Serial.print(',');
+            Serial.println(rssiBins[i]);
+        }
+    } else if (strcasecmp(name, "snr") == 0) {
+        // HIST,snr,<bin lower dB>,<packets>
+        for (int i = 0; i < CONSOLE_SNR_BINS; i++) {
+            Serial.print(F("HIST,snr,"));
+            Serial.print(CONSOLE_SNR_MIN_DB + i * CONSOLE_SNR_BIN_DB);
+            Serial.print(',');
+            Serial.println(snrBins[i]);
+        }
+    } else if (strcasecmp(name, "chan") == 0 || strcasecmp(name, "noise") == 0) {
+        bool noise = strcasecmp(name, "noise") == 0;
+        // HIST,chan,<channel>,<MHz>,<packets>
+        // HIST,noise,<channel>,<MHz>,<LoRa dBm>,<FSK dBm>,<OOK dBm>
+        for (int ch = config->firstChannel; ch <= config->lastChannel && ch < CONSOLE_CHANNELS;
+             ch += config->channelStride) {
+            Serial.print(noise ? F("HIST,noise,") : F("HIST,chan,"));
+            Serial.print(ch);
+            Serial.print(',');
+            Serial.print(FREQ_900_MIN + ch * (SWEEP_STEP_KHZ / 1000.0f), 3);
+            if (noise) {
+                for (int m = MOD_LORA; m < MOD_UNKNOWN; m++) {
+                    Serial.print(',');
+                    Serial.print(noiseFloorGet(ch, (ModulationType)m), 1);
+                }
+                Serial.println();
+            } else {
+                Serial.print(',');
+                Serial.println(channelPackets[ch]);
+            }
+        }
+    } else {
+        Serial.println(F("[Console] Error: histogram must be rssi, snr, chan or noise"));
+    }
+}
+
+/**
+ * Validate and adopt edited settings
+ */
+static void applyConfig(const ScanConfig* config) {
+    const char* error = scanConfigCheck(config);
+    if (error != NULL) {
+        Serial.print(F("[Console] Error: "));
+        Serial.println(error);
+        return;
+    }
+    scanConfigSet(config);
+    Serial.println(F("[Console] OK, saved; applies at the next sweep boundary"));
+}
+
+static void runCommand(char* text) {
+    char* args[CONSOLE_MAX_ARGS];
+    int argc = 0;
+    for (char* token = strtok(text, " \t"); token != NULL && argc < CONSOLE_MAX_ARGS;
+         token = strtok(NULL, " \t")) {
+        args[argc++] = token;
+    }
+    if (argc == 0) {
+        return;
+    }
+
+    const char* command = args[0];
+    ScanConfig config = *scanConfigGet();
+    bool usage = false;
+
+    if (strcasecmp(command, "help") == 0 || strcmp(command, "?") == 0) {
+        printHelp();
+    } else if (strcasecmp(command, "show") == 0) {
+        scanConfigPrint();
+    } else if (strcasecmp(command, "stats") == 0) {
+        printStats();
+    } else if (strcasecmp(command, "hist") == 0) {
+        if (argc == 2) {
+            printHistogram(args[1]);
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "cov") == 0) {
+        uint8_t mask;
+        if (argc == 1) {
+            coverageReport();
+        } else if (argc == 2 && parseModulations(args[1], &mask)) {
+            for (int m = MOD_LORA; m < MOD_UNKNOWN; m++) {
+                if (mask & MOD_MASK(m)) {
+                    coveragePrint((ModulationType)m);
+                }
+            }
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "pcap") == 0) {
+        if (argc == 2 && strcasecmp(args[1], "on") == 0) {
+            pcapExportStart();
+        } else if (argc == 2 && strcasecmp(args[1], "off") == 0) {
+            pcapExportStop();
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "lock") == 0) {
+        if (argc == 2 && (strcasecmp(args[1], "on") == 0 || strcasecmp(args[1], "off") == 0)) {
+            lockOnEnable(strcasecmp(args[1], "on") == 0);
+            Serial.print(F("[Console] Lock-on "));
+            Serial.println(lockOnEnabled() ? F("enabled") : F("disabled"));
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "hier") == 0) {
+        if (argc == 2 && (strcasecmp(args[1], "on") == 0 || strcasecmp(args[1], "off") == 0)) {
+            hierSweepEnable(strcasecmp(args[1], "on") == 0);
+            Serial.print(F("[Console] Coarse-to-fine sweep "));
+            Serial.println(hierSweepEnabled() ? F("enabled from the next sweep")
+                                              : F("disabled from the next sweep"));
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "spec") == 0) {
+        uint32_t rows = OCC_ROWS;
+        if (argc == 2 && strcasecmp(args[1], "on") == 0) {
+            spectrumReportEnable(true);
+        } else if (argc == 2 && strcasecmp(args[1], "off") == 0) {
+            spectrumReportEnable(false);
+        } else if ((argc == 2 || argc == 3) && strcasecmp(args[1], "bench") == 0 &&
+                   (argc == 2 || (parseUnsigned(args[2], &rows) && rows > 0))) {
+            spectrumReportBenchmark((uint16_t)min(rows, (uint32_t)OCC_ROWS));
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "change") == 0) {
+        uint32_t rows = OCC_ROWS;
+        if (argc == 2 && (strcasecmp(args[1], "on") == 0 || strcasecmp(args[1], "off") == 0)) {
+            changeDetectEnable(strcasecmp(args[1], "on") == 0);
+            Serial.print(F("[Console] New-emitter reports "));
+            Serial.println(changeDetectEnabled() ? F("enabled") : F("disabled"));
+        } else if ((argc == 2 || argc == 3) && strcasecmp(args[1], "bench") == 0 &&
+                   (argc == 2 || (parseUnsigned(args[2], &rows) && rows > 0))) {
+            changeDetectBenchmark((uint16_t)min(rows, (uint32_t)OCC_ROWS));
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "occ") == 0) {
+        float minMHz, maxMHz;
+        uint32_t minutes;
+        if (argc == 4 && parseFloat(args[1], &minMHz) && parseFloat(args[2], &maxMHz) &&
+            parseUnsigned(args[3], &minutes) && minutes <= 24 * 60) {
+            int first = gridChannel(minMHz);
+            int last = gridChannel(maxMHz);
+            if (first < 0 || last < 0 || first > last) {
+                Serial.println(F("[Console] Error: band edges must lie on the channel grid"));
+            } else {
+                printOccupancy(first, last, minutes * 60000UL);
+            }
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "top") == 0) {
+        uint32_t k, minutes;
+        if (argc == 3 && parseUnsigned(args[1], &k) && k >= 1 && k <= OCC_TOP_MAX &&
+            parseUnsigned(args[2], &minutes) && minutes <= 24 * 60) {
+            OccupancyChannel top[OCC_TOP_MAX];
+            printChannels("TOP", top, occupancyTopK(minutes * 60000UL, (uint8_t)k, top));
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "new") == 0) {
+        uint32_t seconds;
+        if (argc == 2 && parseUnsigned(args[1], &seconds) && seconds <= 24 * 3600) {
+            OccupancyChannel fresh[OCC_CHANNELS];
+            printChannels("NEW", fresh, occupancyNewSince(seconds * 1000UL, fresh, OCC_CHANNELS));
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "uniq") == 0 || strcasecmp(command, "sketch") == 0) {
+        uint32_t minutes = SKETCH_SLICES * SKETCH_SLICE_MS / 60000UL;
+        if (argc > 2 || (argc == 2 && (!parseUnsigned(args[1], &minutes) || minutes == 0))) {
+            usage = true;
+        } else if (strcasecmp(command, "sketch") == 0) {
+            sketchExport(minutes * 60000UL);
+        } else {
+            sketchReport(minutes * 60000UL);
+            printHeavyHitters(minutes * 60000UL);
+        }
+    } else if (strcasecmp(command, "clear") == 0) {
+        clearHistograms();
+        Serial.println(F("[Console] Histograms cleared"));
+    } else if (strcasecmp(command, "defaults") == 0) {
+        scanConfigDefaults(&config);
+        applyConfig(&config);
+    } else if (strcasecmp(command, "band") == 0) {
+        float minMHz, maxMHz, stepKHz = SWEEP_STEP_KHZ;
+        if ((argc == 3 || argc == 4) && parseFloat(args[1], &minMHz) &&
+            parseFloat(args[2], &maxMHz) && (argc == 3 || parseFloat(args[3], &stepKHz))) {
+            int first = gridChannel(minMHz);
+            int last = gridChannel(maxMHz);
+            long stride = lroundf(stepKHz / SWEEP_STEP_KHZ);
+            if (first < 0 || last < 0) {
+                Serial.println(F("[Console] Error: band edges must lie on the channel grid"));
+            } else if (stride < 1 || stride > 255 || fabsf(stride * SWEEP_STEP_KHZ - stepKHz) > 1.0f) {
+                Serial.println(F("[Console] Error: step must be a multiple of the channel grid"));
+            } else {
+                config.firstChannel = (uint16_t)first;
+                config.lastChannel = (uint16_t)last;
+                config.channelStride = (uint8_t)stride;
+                applyConfig(&config);
+            }
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "dwell") == 0) {
+        uint32_t ms;
+        if (argc == 2 && parseUnsigned(args[1], &ms) && ms <= UINT16_MAX) {
+            config.dwellMs = (uint16_t)ms;
+            applyConfig(&config);
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "modtime") == 0) {
+        uint32_t ms;
+        if (argc == 2 && parseUnsigned(args[1], &ms)) {
+            config.modulationMs = ms;
+            applyConfig(&config);
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "mods") == 0) {
+        if (argc == 2 && parseModulations(args[1], &config.modulationMask)) {
+            applyConfig(&config);
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "lora") == 0) {
+        uint32_t sf;
+        float bandwidth;
+        if (argc == 3 && parseUnsigned(args[1], &sf) && sf <= UINT8_MAX &&
+            parseFloat(args[2], &bandwidth)) {
+            config.loraSpreadingFactor = (uint8_t)sf;
+            config.loraBandwidth = bandwidth;
+            applyConfig(&config);
+        } else {
+            usage = true;
+        }
+    } else if (strcasecmp(command, "thresh") == 0) {
+        if (argc == 3 && parseFloat(args[1], &config.detectMarginDb) &&
+            parseFloat(args[2], &config.detectSpreadK)) {
+            applyConfig(&config);
+        } else {
+            usage = true;
+        }
+    } else {
+        Serial.print(F("[Console] Unknown command: "));
+        Serial.println(command);
+        return;
+    }
+
+    if (usage) {
+        Serial.print(F("[Console] Bad arguments for "));
+        Serial.print(command);
+        Serial.println(F(" (see help)"));
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void consoleInit() {
+    lineLength = 0;
+    lineOverflow = false;
+    clearHistograms();
+}
+
+void consoleService() {
+    for (int budget = CONSOLE_BYTES_PER_PASS; budget > 0 && Serial.available() > 0; budget--) {
+        int c = Serial.read();
+        if (c < 0) {
+            break;
+        }
+        if (c == '\r' || c == '\n') {
+            if (lineOverflow) {
+                Serial.println(F("[Console] Error: line too long"));
+            } else if (lineLength > 0) {
+                line[lineLength] = '\0';
+                runCommand(line);
+            }
+            lineLength = 0;
+            lineOverflow = false;
+        } else if (lineLength < CONSOLE_LINE_MAX - 1) {
+            line[lineLength++] = (char)c;
+        } else {
+            lineOverflow = true;
+        }
+    }
+}
+
+void consoleNotePacket(const ScanEvent* event) {
+    if (event == NULL) {
+        return;
+    }
+    packets++;
+    rssiBins[histogramBin(event->rssi, CONSOLE_RSSI_MIN_DBM, CONSOLE_RSSI_BIN_DB, CONSOLE_RSSI_BINS)]++;
+    snrBins[histogramBin(event->snr, CONSOLE_SNR_MIN_DB, CONSOLE_SNR_BIN_DB, CONSOLE_SNR_BINS)]++;
+    int channel = frequencyToSweepChannel(event->frequency);
+    if (channel >= 0 && channel < CONSOLE_CHANNELS) {
+        channelPackets[channel]++;
+    }
+    if (event->modulation < MOD_UNKNOWN) {
+        modulationPackets[event->modulation]++;
+    }
+}
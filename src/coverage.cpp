@@ -0,0 +1,365 @@
+/**
+ * Coverage Module Implementation
+ *
+ * Scanner tasks on both cores write the ledger, so every update and every
+ * read of a cell happens under one spinlock. Updates are a few additions
+ * per dwell or packet. The epoch table lives in the PSRAM arena; per-cell
+ * visit state and the per-scanner sweep accumulators are small and stay
+ * in internal RAM.
+ */
+
+#include "coverage.h"
+#include "arena.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+// Totals of one cell in one epoch
+typedef struct {
+    uint32_t listenUs;
+    uint32_t retuneUs;
+    uint32_t serviceUs;
+    uint32_t stallUs;
+    uint32_t maxGapMs;
+    uint32_t visits;
+} EpochCell;
+
+typedef EpochCell EpochTable[COVERAGE_CHANNELS][COVERAGE_MODULATIONS];
+
+// Visit state of one cell
+typedef struct {
+    int64_t leftUs;             // Last time a radio left the cell (0 = boot)
+    uint8_t listeners;          // Radios listening on the cell now
+} CellState;
+
+// Time split of one sweep
+typedef struct {
+    ModulationType modulation;
+    bool complete;
+    uint16_t channels;
+    uint32_t sweepUs;
+    uint32_t listenUs;
+    uint32_t retuneUs;
+    uint32_t serviceUs;
+    uint32_t stallUs;
+    uint32_t maxRetuneUs;
+} SweepSummary;
+
+// Per-scanner state (written by that scanner's task)
+typedef struct {
+    int channel;                // Current cell (-1 = none)
+    ModulationType modulation;
+    int64_t enteredUs;          // Radio listening on the cell since
+    uint32_t lostUs;            // Service and stall time of this visit
+    int64_t sweepStartUs;       // Current sweep began (0 = not started)
+    int64_t lastLeftUs;         // End of the last visit
+    SweepSummary sweep;         // Current sweep so far
+    SweepSummary done;          // Last closed sweep, for the main loop
+    bool doneReady;
+} ScannerLedger;
+
+static portMUX_TYPE ledgerLock = portMUX_INITIALIZER_UNLOCKED;
+static EpochTable* epochs = NULL;           // COVERAGE_EPOCHS tables (PSRAM)
+static volatile uint8_t currentEpoch = 0;
+static uint8_t epochsFilled = 1;
+static uint32_t epochStartMs = 0;
+static CellState cells[COVERAGE_CHANNELS][COVERAGE_MODULATIONS];
+static ScannerLedger ledgers[MAX_SCANNERS];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline void addSaturating(uint32_t* total, int64_t value) {
+    if (value <= 0) {
+        return;
+    }
+    uint64_t sum = (uint64_t)*total + (uint64_t)value;
+    *total = sum > UINT32_MAX ? UINT32_MAX : (uint32_t)sum;
+}
+
+static inline bool validCell(int channel, ModulationType modulation) {
+    return channel >= 0 && channel < COVERAGE_CHANNELS && modulation < COVERAGE_MODULATIONS;
+}
+
+static uint32_t windowMs() {
+    return (uint32_t)(epochsFilled - 1) * COVERAGE_EPOCH_MS + (millis() - epochStartMs);
+}
+
+static int sweptChannels() {
+    return min((int)NUM_SWEEP_CHANNELS, COVERAGE_CHANNELS);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void coverageInit() {
+    if (epochs == NULL) {
+        // Touched a few times per dwell: PSRAM is fast enough
+        epochs = (EpochTable*)arenaAlloc(ARENA_PSRAM, COVERAGE_EPOCHS * sizeof(EpochTable),
+                                         "coverage");
+    } else {
+        memset(epochs, 0, COVERAGE_EPOCHS * sizeof(EpochTable));
+    }
+    memset(cells, 0, sizeof(cells));
+    memset(ledgers, 0, sizeof(ledgers));
+    for (int i = 0; i < MAX_SCANNERS; i++) {
+        ledgers[i].channel = -1;
+    }
+    currentEpoch = 0;
+    epochsFilled = 1;
+    epochStartMs = millis();
+}
+
+void coverageEnter(uint8_t scanner, int channel, ModulationType modulation,
+                   int64_t leftUs, int64_t nowUs) {
+    if (epochs == NULL || scanner >= MAX_SCANNERS || !validCell(channel, modulation)) {
+        return;
+    }
+    ScannerLedger* ledger = &ledgers[scanner];
+    int64_t retuneUs = nowUs - leftUs;
+
+    portENTER_CRITICAL(&ledgerLock);
+    EpochCell* totals = &epochs[currentEpoch][channel][modulation];
+    CellState* cell = &cells[channel][modulation];
+    if (cell->listeners == 0) {
+        uint32_t gapMs = (uint32_t)min((nowUs - cell->leftUs) / 1000, (int64_t)UINT32_MAX);
+        totals->maxGapMs = max(totals->maxGapMs, gapMs);
+    }
+    cell->listeners++;
+    addSaturating(&totals->retuneUs, retuneUs);
+    totals->visits++;
+
+    if (ledger->sweepStartUs == 0) {
+        ledger->sweepStartUs = leftUs;
+    }
+    ledger->sweep.modulation = modulation;
+    ledger->sweep.channels++;
+    addSaturating(&ledger->sweep.retuneUs, retuneUs);
+    ledger->sweep.maxRetuneUs = max(ledger->sweep.maxRetuneUs,
+                                    (uint32_t)min(max(retuneUs, (int64_t)0), (int64_t)UINT32_MAX));
+
+    ledger->channel = channel;
+    ledger->modulation = modulation;
+    ledger->enteredUs = nowUs;
+    ledger->lostUs = 0;
+    portEXIT_CRITICAL(&ledgerLock);
+}
+
+void coverageLeave(uint8_t scanner, int64_t nowUs) {
+    if (epochs == NULL || scanner >= MAX_SCANNERS || ledgers[scanner].channel < 0) {
+        return;
+    }
+    ScannerLedger* ledger = &ledgers[scanner];
+    int64_t listenUs = nowUs - ledger->enteredUs - ledger->lostUs;
+
+    portENTER_CRITICAL(&ledgerLock);
+    EpochCell* totals = &epochs[currentEpoch][ledger->channel][ledger->modulation];
+    CellState* cell = &cells[ledger->channel][ledger->modulation];
+    addSaturating(&totals->listenUs, listenUs);
+    addSaturating(&ledger->sweep.listenUs, listenUs);
+    if (cell->listeners > 0 && --cell->listeners == 0) {
+        cell->leftUs = nowUs;
+    }
+    ledger->channel = -1;
+    ledger->lastLeftUs = nowUs;
+    portEXIT_CRITICAL(&ledgerLock);
+}
+
+void coverageLost(uint8_t scanner, uint32_t stallUs, uint32_t serviceUs) {
+    if (epochs == NULL || scanner >= MAX_SCANNERS || ledgers[scanner].channel < 0) {
+        return;
+    }
+    ScannerLedger* ledger = &ledgers[scanner];
+
+    portENTER_CRITICAL(&ledgerLock);
+    EpochCell* totals = &epochs[currentEpoch][ledger->channel][ledger->modulation];
+    addSaturating(&totals->stallUs, stallUs);
+    addSaturating(&totals->serviceUs, serviceUs);
+    addSaturating(&ledger->sweep.stallUs, stallUs);
+    addSaturating(&ledger->sweep.serviceUs, serviceUs);
+    addSaturating(&ledger->lostUs, (int64_t)stallUs + serviceUs);
+    portEXIT_CRITICAL(&ledgerLock);
+}
+
+void coverageSweepEnd(uint8_t scanner, bool complete) {
+    if (epochs == NULL || scanner >= MAX_SCANNERS || ledgers[scanner].sweep.channels == 0) {
+        return;
+    }
+    ScannerLedger* ledger = &ledgers[scanner];
+
+    portENTER_CRITICAL(&ledgerLock);
+    ledger->sweep.complete = complete;
+    ledger->sweep.sweepUs = (uint32_t)min(max(ledger->lastLeftUs - ledger->sweepStartUs, (int64_t)0),
+                                          (int64_t)UINT32_MAX);
+    ledger->done = ledger->sweep;
+    ledger->doneReady = true;
+    memset(&ledger->sweep, 0, sizeof(ledger->sweep));
+    ledger->sweepStartUs = ledger->lastLeftUs;
+    portEXIT_CRITICAL(&ledgerLock);
+}
+
+void coverageService() {
+    if (epochs == NULL) {
+        return;
+    }
+
+    if (millis() - epochStartMs >= COVERAGE_EPOCH_MS) {
+        // Clear the oldest epoch before the tasks write to it
+        uint8_t next = (uint8_t)((currentEpoch + 1) % COVERAGE_EPOCHS);
+        memset(&epochs[next], 0, sizeof(EpochTable));
+        portENTER_CRITICAL(&ledgerLock);
+        currentEpoch = next;
+        portEXIT_CRITICAL(&ledgerLock);
+        epochStartMs += COVERAGE_EPOCH_MS;
+        epochsFilled = (uint8_t)min(epochsFilled + 1, COVERAGE_EPOCHS);
+    }
+
+    for (int i = 0; i < MAX_SCANNERS; i++) {
+        SweepSummary sweep;
+        bool ready;
+        portENTER_CRITICAL(&ledgerLock);
+        ready = ledgers[i].doneReady;
+        sweep = ledgers[i].done;
+        ledgers[i].doneReady = false;
+        portEXIT_CRITICAL(&ledgerLock);
+        if (!ready || !COVERAGE_SWEEP_LINES) {
+            continue;
+        }
+
+        Serial.print(F("SWEEP,"));
+        Serial.print(i);
+        Serial.print(',');
+        Serial.print(getModulationName(sweep.modulation));
+        Serial.print(',');
+        Serial.print(sweep.complete ? 1 : 0);
+        Serial.print(',');
+        Serial.print(sweep.channels);
+        Serial.print(',');
+        Serial.print(sweep.sweepUs / 1000);
+        Serial.print(',');
+        Serial.print(sweep.listenUs / 1000);
+        Serial.print(',');
+        Serial.print(sweep.retuneUs / 1000);
+        Serial.print(',');
+        Serial.print(sweep.serviceUs / 1000);
+        Serial.print(',');
+        Serial.print(sweep.stallUs / 1000);
+        Serial.print(',');
+        Serial.println(sweep.maxRetuneUs);
+    }
+}
+
+bool coverageGet(int channel, ModulationType modulation, CoverageStats* stats) {
+    if (stats == NULL || !validCell(channel, modulation)) {
+        return false;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->windowMs = windowMs();
+    if (epochs == NULL) {
+        stats->unobservedMs = stats->windowMs;
+        return true;
+    }
+
+    uint64_t listenUs = 0, retuneUs = 0, serviceUs = 0, stallUs = 0;
+    int64_t nowUs = esp_timer_get_time();
+    portENTER_CRITICAL(&ledgerLock);
+    for (int e = 0; e < epochsFilled; e++) {
+        const EpochCell* totals = &epochs[e][channel][modulation];
+        listenUs += totals->listenUs;
+        retuneUs += totals->retuneUs;
+        serviceUs += totals->serviceUs;
+        stallUs += totals->stallUs;
+        stats->maxGapMs = max(stats->maxGapMs, totals->maxGapMs);
+        stats->visits += totals->visits;
+    }
+    const CellState cell = cells[channel][modulation];
+    portEXIT_CRITICAL(&ledgerLock);
+
+    // A cell nobody listens on now has a gap still open
+    if (cell.listeners == 0) {
+        uint32_t openMs = (uint32_t)min((nowUs - cell.leftUs) / 1000, (int64_t)UINT32_MAX);
+        stats->maxGapMs = max(stats->maxGapMs, openMs);
+    }
+    stats->listenMs = (uint32_t)min(listenUs / 1000, (uint64_t)stats->windowMs);
+    stats->unobservedMs = stats->windowMs - stats->listenMs;
+    stats->retuneMs = (uint32_t)(retuneUs / 1000);
+    stats->serviceMs = (uint32_t)(serviceUs / 1000);
+    stats->stallMs = (uint32_t)(stallUs / 1000);
+    return true;
+}
+
+void coverageReport() {
+    for (int m = MOD_LORA; m < COVERAGE_MODULATIONS; m++) {
+        uint64_t listenMs = 0;
+        uint32_t window = 0;
+        uint32_t worstUnobservedMs = 0;
+        uint32_t maxGapMs = 0;
+        int worstChannel = 0;
+        int unheard = 0;
+
+        for (int ch = 0; ch < sweptChannels(); ch++) {
+            CoverageStats stats;
+            coverageGet(ch, (ModulationType)m, &stats);
+            window = stats.windowMs;
+            listenMs += stats.listenMs;
+            if (stats.listenMs == 0) {
+                unheard++;
+            }
+            if (stats.unobservedMs > worstUnobservedMs) {
+                worstUnobservedMs = stats.unobservedMs;
+                worstChannel = ch;
+            }
+            maxGapMs = max(maxGapMs, stats.maxGapMs);
+        }
+
+        float listenPct = window > 0 ? 100.0f * listenMs / ((float)window * sweptChannels()) : 0.0f;
+        Serial.print(F("COVSUM,"));
+        Serial.print(getModulationName((ModulationType)m));
+        Serial.print(',');
+        Serial.print(window / 1000);
+        Serial.print(',');
+        Serial.print(listenPct, 2);
+        Serial.print(',');
+        Serial.print(unheard);
+        Serial.print(',');
+        Serial.print(FREQ_900_MIN + worstChannel * (SWEEP_STEP_KHZ / 1000.0f), 3);
+        Serial.print(',');
+        Serial.print(worstUnobservedMs / 1000);
+        Serial.print(',');
+        Serial.println(maxGapMs / 1000);
+    }
+}
+
+void coveragePrint(ModulationType modulation) {
+    if (modulation >= COVERAGE_MODULATIONS) {
+        return;
+    }
+    for (int ch = 0; ch < sweptChannels(); ch++) {
+        CoverageStats stats;
+        coverageGet(ch, modulation, &stats);
+        Serial.print(F("COV,"));
+        Serial.print(FREQ_900_MIN + ch * (SWEEP_STEP_KHZ / 1000.0f), 3);
+        Serial.print(',');
+        Serial.print(getModulationName(modulation));
+        Serial.print(',');
+        Serial.print(stats.windowMs / 1000);
+        Serial.print(',');
+        Serial.print(stats.listenMs);
+        Serial.print(',');
+        Serial.print(stats.unobservedMs);
+        Serial.print(',');
+        Serial.print(stats.maxGapMs);
+        Serial.print(',');
+        Serial.print(stats.retuneMs);
+        Serial.print(',');
+        Serial.print(stats.serviceMs);
+        Serial.print(',');
+        Serial.print(stats.stallMs);
+        Serial.print(',');
+        Serial.println(stats.visits);
+    }
+}
@@ -0,0 +1,751 @@
+/**
+ * Detection Log Module Implementation
+ *
+ * Log-structured detection store in a dedicated flash partition.
+ *
+ * Sector layout (DETLOG_SECTOR_SIZE bytes):
+ *   [SectorHeader][record][record]...[free 0xFF]...[SectorFooter]
+ *
+ * Record layout (4-byte aligned):
+ *   [RecordHeader][payload][padding]
+ *
+ * Crash safety relies on NOR flash semantics: bytes are only ever programmed
+ * from the erased state, so a power loss can at worst leave one torn record
+ * (rejected by its CRC) or one sector without a footer (rebuilt by scanning).
+ * Sectors are reused strictly round-robin, which spreads erases evenly.
+ */
+
+#include "detection_log.h"
+#include "arena.h"
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <esp_timer.h>
+
+// ============================================================================
+// On-Flash Structures
+// ============================================================================
+
+#define SECTOR_HEADER_MAGIC     0x31474C44UL  // "DLG1"
+#define SECTOR_FOOTER_MAGIC     0x53474C44UL  // "DLGS"
+#define RECORD_MARKER           0xA5
+#define ERASED_BYTE             0xFF
+
+// Internal queue item type used to request a flush
+#define DETLOG_RECORD_FLUSH     0x00
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;             // SECTOR_HEADER_MAGIC
+    uint32_t sequence;          // Monotonic sector sequence number
+    uint32_t eraseCount;        // Times this sector has been erased
+    uint32_t crc;               // CRC32 of the fields above
+} SectorHeader;
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;             // SECTOR_FOOTER_MAGIC
+    uint32_t firstTime;         // Oldest record timestamp (seconds)
+    uint32_t lastTime;          // Newest record timestamp (seconds)
+    uint64_t channelMask;       // Bit per sweep channel present in sector
+    uint16_t recordCount;       // Valid records in sector
+    uint8_t typeMask;           // Bit per record type present in sector
+    uint8_t reserved;
+    uint32_t crc;               // CRC32 of the fields above
+} SectorFooter;
+
+typedef struct __attribute__((packed)) {
+    uint8_t marker;             // RECORD_MARKER
+    uint8_t type;               // DETLOG_RECORD_* type
+    uint8_t length;             // Payload length
+    uint8_t channel;            // Sweep channel index
+    uint32_t timestamp;         // Log time (seconds)
+    uint32_t crc;               // CRC32 of fields above plus payload
+} RecordHeader;
+
+#define RECORD_AREA_START   sizeof(SectorHeader)
+#define RECORD_AREA_END     (DETLOG_SECTOR_SIZE - sizeof(SectorFooter))
+#define RECORD_ALIGN(n)     (((n) + 3) & ~3U)
+
+// ============================================================================
+// In-RAM Sparse Index
+// ============================================================================
+
+typedef enum {
+    SECTOR_FREE,                // Erased or unreadable, holds no records
+    SECTOR_OPEN,                // Currently being appended to
+    SECTOR_CLOSED               // Full, summary valid
+} SectorState;
+
+typedef struct {
+    uint32_t sequence;
+    uint32_t eraseCount;
+    uint32_t firstTime;
+    uint32_t lastTime;
+    uint64_t channelMask;
+    uint16_t recordCount;
+    uint8_t typeMask;
+    uint8_t state;              // SectorState
+} SectorIndex;
+
+typedef struct {
+    uint8_t type;
+    uint8_t channel;
+    uint8_t length;
+    uint32_t timestamp;
+    uint8_t payload[DETLOG_MAX_PAYLOAD];
+} QueuedRecord;
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+static const esp_partition_t* logPartition = NULL;
+static SectorIndex* sectorIndex = NULL;     // DETLOG_MAX_SECTORS entries (PSRAM)
+static uint16_t sectorCount = 0;
+
+// Write position
+static uint16_t headSector = 0;
+static uint32_t writeOffset = RECORD_AREA_START;
+static uint32_t nextSequence = 1;
+static bool needNewSector = true;
+static bool nextSectorErased = false;
+static volatile bool eraseDue = false;     // Next sector waits for a scanner to erase it
+
+// Page staging buffer (records not yet programmed)
+static uint8_t pendingBuffer[DETLOG_PAGE_SIZE * 2];
+static uint32_t pendingLength = 0;
+
+// Shared sector buffer for recovery and queries (queries hold queryMutex)
+static uint8_t sectorBuffer[DETLOG_SECTOR_SIZE];
+
+// Log time base (seconds), continues from the newest recovered record
+static uint32_t logTimeBase = 0;
+
+static QueueHandle_t recordQueue = NULL;
+static SemaphoreHandle_t flashMutex = NULL;
+static SemaphoreHandle_t queryMutex = NULL;
+static TaskHandle_t writerTask = NULL;
+static StaticQueue_t recordQueueBuffer;
+static StaticSemaphore_t flashMutexBuffer;
+static StaticSemaphore_t queryMutexBuffer;
+static StaticTask_t writerTaskBuffer;
+
+#define WRITER_TASK_STACK       4096
+static DetectionLogStats stats;
+
+// Counters updated from every appending task
+static portMUX_TYPE statsLock = portMUX_INITIALIZER_UNLOCKED;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t computeCrc(const void* data, size_t length, uint32_t crc = 0) {
+    return esp_rom_crc32_le(crc, (const uint8_t*)data, length);
+}
+
+static uint64_t channelBit(uint8_t channel) {
+    return (channel < 63) ? (1ULL << channel) : (1ULL << 63);
+}
+
+static uint32_t sectorAddress(uint16_t sector) {
+    return (uint32_t)sector * DETLOG_SECTOR_SIZE;
+}
+
+static void resetIndex(SectorIndex* entry) {
+    entry->firstTime = UINT32_MAX;
+    entry->lastTime = 0;
+    entry->channelMask = 0;
+    entry->recordCount = 0;
+    entry->typeMask = 0;
+}
+
+static void indexRecord(SectorIndex* entry, const RecordHeader* header) {
+    if (header->timestamp < entry->firstTime) {
+        entry->firstTime = header->timestamp;
+    }
+    if (header->timestamp > entry->lastTime) {
+        entry->lastTime = header->timestamp;
+    }
+    entry->channelMask |= channelBit(header->channel);
+    entry->typeMask |= (uint8_t)(1 << (header->type & 0x07));
+    entry->recordCount++;
+}
+
+/**
+ * Walk the records of a sector held in sectorBuffer
+ * Returns the offset just past the last valid record; sets *corrupt if the
+ * walk stopped on a bad record rather than erased flash
+ */
+static uint32_t walkRecords(SectorIndex* entry, bool* corrupt,
+                            const DetectionLogQuery* query, uint64_t queryMask,
+                            DetectionLogCallback callback, void* context,
+                            uint32_t* matches, bool* stop) {
+    uint32_t offset = RECORD_AREA_START;
+    *corrupt = false;
+
+    while (offset + sizeof(RecordHeader) <= RECORD_AREA_END) {
+        const RecordHeader* header = (const RecordHeader*)&sectorBuffer[offset];
+
+        if (header->marker == ERASED_BYTE) {
+            break;
+        }
+
+        uint32_t size = RECORD_ALIGN(sizeof(RecordHeader) + header->length);
+        if (header->marker != RECORD_MARKER || header->length > DETLOG_MAX_PAYLOAD ||
+            offset + size > RECORD_AREA_END) {
+            *corrupt = true;
+            break;
+        }
+
+        const uint8_t* payload = &sectorBuffer[offset + sizeof(RecordHeader)];
+        uint32_t crc = computeCrc(header, offsetof(RecordHeader, crc));
+        crc = computeCrc(payload, header->length, crc);
+        if (crc != header->crc) {
+            *corrupt = true;
+            break;
+        }
+
+        if (entry != NULL) {
+            indexRecord(entry, header);
+        }
+
+        if (callback != NULL && !*stop &&
+            header->timestamp >= query->timeFrom && header->timestamp <= query->timeTo &&
+            (channelBit(header->channel) & queryMask) != 0 &&
+            (query->typeMask & (1 << (header->type & 0x07))) != 0) {
+            DetectionLogEntry logEntry;
+            logEntry.type = header->type;
+            logEntry.channel = header->channel;
+            logEntry.timestamp = header->timestamp;
+            logEntry.length = header->length;
+            logEntry.payload = payload;
+            (*matches)++;
+            if (!callback(&logEntry, context)) {
+                *stop = true;
+            }
+        }
+
+        offset += size;
+    }
+
+    return offset;
+}
+
+// ============================================================================
+// Flash Operations (called with flashMutex held)
+// ============================================================================
+
+static bool eraseSector(uint16_t sector) {
+    // The flash cache is off on both cores for the whole erase: this is the
+    // longest stall the log imposes on the scanner tasks
+    int64_t startUs = esp_timer_get_time();
+    esp_err_t result = esp_partition_erase_range(logPartition, sectorAddress(sector),
+                                                 DETLOG_SECTOR_SIZE);
+    uint32_t eraseUs = (uint32_t)(esp_timer_get_time() - startUs);
+    stats.eraseMaxUs = max(stats.eraseMaxUs, eraseUs);
+    if (result != ESP_OK) {
+        return false;
+    }
+    SectorIndex* entry = &sectorIndex[sector];
+    entry->eraseCount++;
+    entry->state = SECTOR_FREE;
+    entry->sequence = 0;
+    resetIndex(entry);
+    stats.sectorErases++;
+    return true;
+}
+
+static void flushPending() {
+    if (pendingLength == 0 || needNewSector) {
+        return;
+    }
+
+    if (esp_partition_write(logPartition, sectorAddress(headSector) + writeOffset,
+                            pendingBuffer, pendingLength) == ESP_OK) {
+        stats.pageWrites++;
+    } else {
+        Serial.println(F("[DetLog] Page write failed"));
+    }
+
+    writeOffset += pendingLength;
+    pendingLength = 0;
+
+    // Erase the following sector ahead of time so a burst of records never
+    // waits on a sector erase when the current sector fills up. A scanner
+    // does it between dwells; the writer only steps in near the end.
+    if (!nextSectorErased && writeOffset > DETLOG_SECTOR_SIZE / 2) {
+        eraseDue = true;
+        if (writeOffset > DETLOG_ERASE_DEADLINE) {
+            nextSectorErased = eraseSector((headSector + 1) % sectorCount);
+            eraseDue = false;
+        }
+    }
+}
+
+static void closeHeadSector() {
+    SectorIndex* entry = &sectorIndex[headSector];
+    SectorFooter footer;
+    memset(&footer, 0, sizeof(footer));
+    footer.magic = SECTOR_FOOTER_MAGIC;
+    footer.firstTime = entry->firstTime;
+    footer.lastTime = entry->lastTime;
+    footer.channelMask = entry->channelMask;
+    footer.recordCount = entry->recordCount;
+    footer.typeMask = entry->typeMask;
+    footer.crc = computeCrc(&footer, offsetof(SectorFooter, crc));
+
+    esp_partition_write(logPartition, sectorAddress(headSector) + RECORD_AREA_END,
+                        &footer, sizeof(footer));
+    entry->state = SECTOR_CLOSED;
+}
+
+static bool openNextSector() {
+    uint16_t sector = needNewSector && sectorIndex[headSector].state == SECTOR_FREE
+                          ? headSector
+                          : (headSector + 1) % sectorCount;
+
+    if (!(nextSectorErased && sector != headSector)) {
+        if (!eraseSector(sector)) {
+            Serial.println(F("[DetLog] Sector erase failed"));
+            return false;
+        }
+    }
+    nextSectorErased = false;
+    eraseDue = false;
+
+    SectorHeader header;
+    header.magic = SECTOR_HEADER_MAGIC;
+    header.sequence = nextSequence++;
+    header.eraseCount = sectorIndex[sector].eraseCount;
+    header.crc = computeCrc(&header, offsetof(SectorHeader, crc));
+
+    if (esp_partition_write(logPartition, sectorAddress(sector),
+                            &header, sizeof(header)) != ESP_OK) {
+        Serial.println(F("[DetLog] Sector header write failed"));
+        return false;
+    }
+
+    SectorIndex* entry = &sectorIndex[sector];
+    entry->sequence = header.sequence;
+    entry->state = SECTOR_OPEN;
+    resetIndex(entry);
+
+    headSector = sector;
+    writeOffset = RECORD_AREA_START;
+    needNewSector = false;
+    return true;
+}
+
+static void appendRecord(const QueuedRecord* item) {
+    uint32_t size = RECORD_ALIGN(sizeof(RecordHeader) + item->length);
+
+    // Records never span sectors: close the head sector when full
+    if (!needNewSector && writeOffset + pendingLength + size > RECORD_AREA_END) {
+        flushPending();
+        closeHeadSector();
+        needNewSector = true;
+    }
+    if (needNewSector && !openNextSector()) {
+        portENTER_CRITICAL(&statsLock);
+        stats.recordsDropped++;
+        portEXIT_CRITICAL(&statsLock);
+        return;
+    }
+
+    RecordHeader header;
+    header.marker = RECORD_MARKER;
+    header.type = item->type;
+    header.length = item->length;
+    header.channel = item->channel;
+    header.timestamp = item->timestamp;
+    header.crc = computeCrc(&header, offsetof(RecordHeader, crc));
+    header.crc = computeCrc(item->payload, item->length, header.crc);
+
+    uint8_t* dest = &pendingBuffer[pendingLength];
+    memcpy(dest, &header, sizeof(header));
+    memcpy(dest + sizeof(header), item->payload, item->length);
+    memset(dest + sizeof(header) + item->length, ERASED_BYTE,
+           size - sizeof(header) - item->length);
+    pendingLength += size;
+
+    indexRecord(&sectorIndex[headSector], &header);
+    stats.recordsWritten++;
+
+    if (pendingLength >= DETLOG_PAGE_SIZE) {
+        flushPending();
+    }
+}
+
+// ============================================================================
+// Recovery
+// ============================================================================
+
+static void recoverSector(uint16_t sector) {
+    SectorIndex* entry = &sectorIndex[sector];
+    entry->state = SECTOR_FREE;
+    entry->sequence = 0;
+    entry->eraseCount = 0;
+    resetIndex(entry);
+
+    SectorHeader header;
+    esp_partition_read(logPartition, sectorAddress(sector), &header, sizeof(header));
+    if (header.magic != SECTOR_HEADER_MAGIC ||
+        header.crc != computeCrc(&header, offsetof(SectorHeader, crc))) {
+        return;
+    }
+    entry->sequence = header.sequence;
+    entry->eraseCount = header.eraseCount;
+
+    // Closed sectors carry their own summary; only the footer is read
+    SectorFooter footer;
+    esp_partition_read(logPartition, sectorAddress(sector) + RECORD_AREA_END,
+                       &footer, sizeof(footer));
+    if (footer.magic == SECTOR_FOOTER_MAGIC &&
+        footer.crc == computeCrc(&footer, offsetof(SectorFooter, crc))) {
+        entry->firstTime = footer.firstTime;
+        entry->lastTime = footer.lastTime;
+        entry->channelMask = footer.channelMask;
+        entry->recordCount = footer.recordCount;
+        entry->typeMask = footer.typeMask;
+        entry->state = SECTOR_CLOSED;
+        stats.recordsRecovered += footer.recordCount;
+        return;
+    }
+
+    // No footer: the sector was open at power loss, rebuild by scanning
+    entry->state = SECTOR_OPEN;
+}
+
+static void recoverOpenSector(uint16_t sector, bool isHead) {
+    SectorIndex* entry = &sectorIndex[sector];
+    bool corrupt = false;
+    bool stop = false;
+    uint32_t matches = 0;
+
+    esp_partition_read(logPartition, sectorAddress(sector), sectorBuffer, DETLOG_SECTOR_SIZE);
+    resetIndex(entry);
+    uint32_t end = walkRecords(entry, &corrupt, NULL, 0, NULL, NULL, &matches, &stop);
+    stats.recordsRecovered += entry->recordCount;
+
+    if (corrupt) {
+        stats.corruptRecords++;
+    }
+
+    if (isHead && !corrupt) {
+        // Resume appending right after the last intact record
+        headSector = sector;
+        writeOffset = end;
+        needNewSector = false;
+    } else {
+        // Torn tail or stale open sector: seal it and never write there again
+        uint16_t savedHead = headSector;
+        headSector = sector;
+        closeHeadSector();
+        headSector = savedHead;
+        if (isHead) {
+            needNewSector = true;
+        }
+    }
+}
+
+static void recoverLog() {
+    uint32_t maxSequence = 0;
+    int32_t newest = -1;
+
+    for (uint16_t s = 0; s < sectorCount; s++) {
+        recoverSector(s);
+        if (sectorIndex[s].state != SECTOR_FREE && sectorIndex[s].sequence >= maxSequence) {
+            maxSequence = sectorIndex[s].sequence;
+            newest = s;
+        }
+    }
+
+    for (uint16_t s = 0; s < sectorCount; s++) {
+        if (sectorIndex[s].state == SECTOR_OPEN) {
+            recoverOpenSector(s, (int32_t)s == newest);
+        }
+    }
+
+    if (newest >= 0) {
+        headSector = (uint16_t)newest;
+        nextSequence = maxSequence + 1;
+        if (sectorIndex[newest].state == SECTOR_CLOSED) {
+            needNewSector = true;
+        }
+    } else {
+        headSector = 0;
+        needNewSector = true;
+    }
+
+    // A sector without a header was erased ahead of need (or its header
+    // write was lost); round-robin reuse means it has been erased about as
+    // often as the most worn sector, so that count carries forward instead
+    // of restarting at zero
+    uint32_t maxEraseCount = 0;
+    for (uint16_t s = 0; s < sectorCount; s++) {
+        maxEraseCount = max(maxEraseCount, sectorIndex[s].eraseCount);
+    }
+    for (uint16_t s = 0; s < sectorCount; s++) {
+        if (sectorIndex[s].sequence == 0) {
+            sectorIndex[s].eraseCount = maxEraseCount;
+        }
+    }
+
+    // Continue log time after the newest recovered record
+    for (uint16_t s = 0; s < sectorCount; s++) {
+        if (sectorIndex[s].state != SECTOR_FREE && sectorIndex[s].recordCount > 0 &&
+            sectorIndex[s].lastTime >= logTimeBase) {
+            logTimeBase = sectorIndex[s].lastTime + 1;
+        }
+    }
+}
+
+// ============================================================================
+// Writer Task
+// ============================================================================
+
+static void writerTaskMain(void* parameter) {
+    QueuedRecord item;
+
+    while (true) {
+        bool received = xQueueReceive(recordQueue, &item, pdMS_TO_TICKS(DETLOG_FLUSH_MS)) == pdTRUE;
+
+        xSemaphoreTake(flashMutex, portMAX_DELAY);
+        if (!received || item.type == DETLOG_RECORD_FLUSH) {
+            flushPending();
+        } else {
+            appendRecord(&item);
+        }
+        xSemaphoreGive(flashMutex);
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool detectionLogInit() {
+    memset(&stats, 0, sizeof(stats));
+
+    logPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                            ESP_PARTITION_SUBTYPE_ANY,
+                                            DETLOG_PARTITION_LABEL);
+    if (logPartition == NULL) {
+        Serial.println(F("[DetLog] No 'detlog' partition, logging disabled"));
+        return false;
+    }
+
+    sectorCount = (uint16_t)min((uint32_t)(logPartition->size / DETLOG_SECTOR_SIZE),
+                                (uint32_t)DETLOG_MAX_SECTORS);
+    if (sectorCount < 2) {
+        Serial.println(F("[DetLog] Partition too small"));
+        sectorCount = 0;
+        return false;
+    }
+
+    // Index and record queue are touched per sector and per detection:
+    // PSRAM. The writer's stack must be internal.
+    sectorIndex = (SectorIndex*)arenaAlloc(ARENA_PSRAM, DETLOG_MAX_SECTORS * sizeof(SectorIndex),
+                                           "detlog index");
+    uint8_t* queueStorage = (uint8_t*)arenaAlloc(ARENA_PSRAM,
+                                                 DETLOG_QUEUE_DEPTH * sizeof(QueuedRecord),
+                                                 "detlog queue");
+    StackType_t* writerStack = (StackType_t*)arenaAlloc(ARENA_INTERNAL, WRITER_TASK_STACK,
+                                                        "detlog");
+    if (sectorIndex == NULL || queueStorage == NULL || writerStack == NULL) {
+        Serial.println(F("[DetLog] Failed to allocate buffers"));
+        sectorCount = 0;
+        return false;
+    }
+
+    uint32_t start = millis();
+    recoverLog();
+
+    recordQueue = xQueueCreateStatic(DETLOG_QUEUE_DEPTH, sizeof(QueuedRecord), queueStorage,
+                                     &recordQueueBuffer);
+    flashMutex = xSemaphoreCreateMutexStatic(&flashMutexBuffer);
+    queryMutex = xSemaphoreCreateMutexStatic(&queryMutexBuffer);
+    if (recordQueue == NULL || flashMutex == NULL || queryMutex == NULL) {
+        Serial.println(F("[DetLog] Failed to allocate queue"));
+        return false;
+    }
+
+    // Writer runs on the core opposite the Arduino loop at low priority
+    writerTask = xTaskCreateStaticPinnedToCore(writerTaskMain, "detlog", WRITER_TASK_STACK, NULL, 1,
+                                               writerStack, &writerTaskBuffer, 0);
+
+    Serial.print(F("[DetLog] Recovered "));
+    Serial.print(stats.recordsRecovered);
+    Serial.print(F(" records in "));
+    Serial.print(sectorCount);
+    Serial.print(F(" sectors ("));
+    Serial.print(millis() - start);
+    Serial.println(F(" ms)"));
+    if (stats.corruptRecords > 0) {
+        Serial.print(F("[DetLog] Discarded torn records in "));
+        Serial.print(stats.corruptRecords);
+        Serial.println(F(" sector(s)"));
+    }
+
+    return true;
+}
+
+uint32_t detectionLogTime() {
+    return logTimeBase + millis() / 1000;
+}
+
+bool detectionLogAppend(uint8_t type, uint8_t channel, const void* payload, uint8_t length) {
+    if (recordQueue == NULL || length > DETLOG_MAX_PAYLOAD) {
+        return false;
+    }
+
+    QueuedRecord item;
+    item.type = type;
+    item.channel = channel;
+    item.length = length;
+    item.timestamp = detectionLogTime();
+    memcpy(item.payload, payload, length);
+
+    if (xQueueSend(recordQueue, &item, 0) != pdTRUE) {
+        portENTER_CRITICAL(&statsLock);
+        stats.recordsDropped++;
+        portEXIT_CRITICAL(&statsLock);
+        return false;
+    }
+
+    uint16_t waiting = (uint16_t)uxQueueMessagesWaiting(recordQueue);
+    portENTER_CRITICAL(&statsLock);
+    if (waiting > stats.queueHighWater) {
+        stats.queueHighWater = waiting;
+    }
+    portEXIT_CRITICAL(&statsLock);
+    return true;
+}
+
+bool detectionLogAppendDetection(const DroneSignal* signal) {
+    if (signal == NULL) {
+        return false;
+    }
+
+    DetectionLogRecord record;
+    record.uptimeMs = millis();
+    record.frequencyKHz = (uint32_t)lroundf(signal->frequency * 1000.0f);
+    record.rssiDeci = (int16_t)lroundf(signal->rssi * 10.0f);
+    record.snrDeci = (int16_t)lroundf(signal->snr * 10.0f);
+    record.freqErrorHz = (int32_t)lroundf(signal->freqError);
+    record.modulation = (uint8_t)signal->modulation;
+    record.confidence = signal->confidence;
+    record.signatureIndex = signal->signatureIndex;
+    record.flags = signal->isDroneSignature ? 0x01 : 0x00;
+    record.utcUs = signal->utcUs;
+
+    int channel = frequencyToSweepChannel(signal->frequency);
+    return detectionLogAppend(DETLOG_RECORD_DETECTION,
+                              channel >= 0 ? (uint8_t)channel : DETLOG_NO_CHANNEL,
+                              &record, sizeof(record));
+}
+
+bool detectionLogEraseAhead() {
+    if (!eraseDue || flashMutex == NULL || xSemaphoreTake(flashMutex, 0) != pdTRUE) {
+        return false;
+    }
+    bool erased = false;
+    if (eraseDue && !nextSectorErased && !needNewSector) {
+        nextSectorErased = eraseSector((headSector + 1) % sectorCount);
+        erased = true;
+        stats.erasesBetweenDwells++;
+    }
+    eraseDue = false;
+    xSemaphoreGive(flashMutex);
+    return erased;
+}
+
+void detectionLogFlush() {
+    if (recordQueue == NULL) {
+        return;
+    }
+    QueuedRecord item;
+    item.type = DETLOG_RECORD_FLUSH;
+    item.length = 0;
+    xQueueSend(recordQueue, &item, 0);
+}
+
+uint32_t detectionLogQuery(const DetectionLogQuery* query,
+                           DetectionLogCallback callback, void* context) {
+    if (logPartition == NULL || flashMutex == NULL || query == NULL || callback == NULL) {
+        return 0;
+    }
+
+    // Build the channel mask covered by the requested frequency range
+    uint64_t queryMask = 0;
+    for (uint8_t ch = 0; ch < 63; ch++) {
+        float freq = FREQ_900_MIN + ch * (SWEEP_STEP_KHZ / 1000.0f);
+        if (freq >= query->frequencyMin && freq <= query->frequencyMax) {
+            queryMask |= channelBit(ch);
+        }
+    }
+    if (query->frequencyMin <= FREQ_900_MIN && query->frequencyMax >= FREQ_900_MAX) {
+        queryMask |= channelBit(DETLOG_NO_CHANNEL);
+    }
+
+    uint32_t matches = 0;
+    bool stop = false;
+
+    xSemaphoreTake(queryMutex, portMAX_DELAY);
+    xSemaphoreTake(flashMutex, portMAX_DELAY);
+    uint16_t newest = headSector;
+    xSemaphoreGive(flashMutex);
+
+    // Newest sector first, walking backwards around the ring
+    for (uint16_t i = 0; i < sectorCount && !stop; i++) {
+        uint16_t sector = (newest + sectorCount - i) % sectorCount;
+
+        // The writer may recycle the sector once the lock is released, so
+        // the index is only read and the sector only copied while held
+        xSemaphoreTake(flashMutex, portMAX_DELAY);
+        const SectorIndex* entry = &sectorIndex[sector];
+        bool used = entry->state != SECTOR_FREE && entry->recordCount > 0;
+        bool candidate = used && entry->lastTime >= query->timeFrom &&
+                         entry->firstTime <= query->timeTo &&
+                         (entry->channelMask & queryMask) != 0 &&
+                         (entry->typeMask & query->typeMask) != 0;
+        // Sectors are time ordered, so stop once past the requested window
+        bool pastWindow = used && entry->lastTime < query->timeFrom;
+        if (candidate) {
+            esp_partition_read(logPartition, sectorAddress(sector),
+                               sectorBuffer, DETLOG_SECTOR_SIZE);
+        }
+        xSemaphoreGive(flashMutex);
+
+        // Callbacks run on the copy without the lock, so a slow consumer
+        // never holds up the writer task
+        if (candidate) {
+            bool corrupt;
+            walkRecords(NULL, &corrupt, query, queryMask, callback, context, &matches, &stop);
+        }
+        if (pastWindow) {
+            break;
+        }
+    }
+    xSemaphoreGive(queryMutex);
+
+    return matches;
+}
+
+void detectionLogGetStats(DetectionLogStats* out) {
+    if (out == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&statsLock);
+    *out = stats;
+    portEXIT_CRITICAL(&statsLock);
+    out->sectorCount = sectorCount;
+    out->minEraseCount = UINT32_MAX;
+    out->maxEraseCount = 0;
+    for (uint16_t s = 0; s < sectorCount; s++) {
+        out->minEraseCount = min(out->minEraseCount, sectorIndex[s].eraseCount);
+        out->maxEraseCount = max(out->maxEraseCount, sectorIndex[s].eraseCount);
+    }
+    if (sectorCount == 0) {
+        out->minEraseCount = 0;
+    }
+}
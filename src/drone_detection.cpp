@@ -11,21 +11,28 @@
  */
 
 #include "drone_detection.h"
+#include "noise_floor.h"
+#include "protocol_fingerprint.h"
+#include "emitter_track.h"
+#include "packet_decoder.h"
+#include "classifier.h"
+#include "transmitter_cluster.h"
 #include <math.h>
 
 // ============================================================================
 // Module State
 // ============================================================================
 
-// Current modulation mode for scanning
-static ModulationType currentModulation = MOD_LORA;
+// Scanner backing the single-radio API
+static DroneScanner defaultScanner;
 
-// Radio initialization status
-static bool isInitialized = false;
+// Guards staged scan plans (written by the main loop, read by scanner tasks)
+static portMUX_TYPE planLock = portMUX_INITIALIZER_UNLOCKED;
 
-// Current sweep frequency for FHSS detection
-static float currentSweepFrequency = FREQ_900_MIN;
-static bool sweepComplete = false;
+// Raw capture bit rates, rotated once per full sweep so preamble detection
+// covers the common air rates of each modulation
+static const float fskCaptureBitrates[] = { 100.0f, 64.0f, 38.4f, 19.2f };
+static const float ookCaptureBitrates[] = { 4.8f, 2.4f };
 
 // ============================================================================
 // Known Drone Signatures Database (900MHz Band)
@@ -49,7 +56,9 @@ static const DroneSignature knownSignatures[] = {
         .frequencyMax = 928.0f,
         .modulation = MOD_LORA,
         .bandwidth = 500.0f,       // 100-500 kHz depending on rate
-        .minRSSI = -120.0f
+        .minRSSI = -120.0f,
+        .packetRates = RATE_MASK(RATE_25HZ) | RATE_MASK(RATE_50HZ) |
+                       RATE_MASK(RATE_100HZ) | RATE_MASK(RATE_200HZ)   // ELRS 900 packet rates
     },
     // ExpressLRS 900MHz Narrow Mode
     {
@@ -58,7 +67,9 @@ static const DroneSignature knownSignatures[] = {
         .frequencyMax = 928.0f,
         .modulation = MOD_LORA,
         .bandwidth = 100.0f,       // 100 kHz for high rate mode
-        .minRSSI = -115.0f
+        .minRSSI = -115.0f,
+        .packetRates = RATE_MASK(RATE_100HZ) | RATE_MASK(RATE_200HZ) |
+                       RATE_MASK(RATE_250HZ)   // ELRS high rate modes
     },
     // TBS Crossfire - Commercial long-range system
     // Proprietary FSK with FHSS, ~10 MHz channel hopping bandwidth
@@ -69,7 +80,8 @@ static const DroneSignature knownSignatures[] = {
         .frequencyMax = 928.0f,
         .modulation = MOD_FSK,     // Proprietary FSK with FHSS
         .bandwidth = 10000.0f,     // ~10 MHz hopping bandwidth
-        .minRSSI = -130.0f
+        .minRSSI = -130.0f,
+        .packetRates = RATE_MASK(RATE_50HZ) | RATE_MASK(RATE_150HZ)   // CRSF 50 Hz / 150 Hz
     },
     // RFD900 / SiK Radios - Long-range telemetry
     // Proprietary FSK with FHSS, configurable parameters
@@ -80,7 +92,8 @@ static const DroneSignature knownSignatures[] = {
         .frequencyMax = 928.0f,
         .modulation = MOD_FSK,     // FSK with FHSS
         .bandwidth = 26000.0f,     // Full band hopping (configurable)
-        .minRSSI = -121.0f
+        .minRSSI = -121.0f,
+        .packetRates = 0
     },
     // FrSky R9 System - 900MHz long-range
     // LoRa-based modulation, ~200 kHz bandwidth
@@ -90,7 +103,8 @@ static const DroneSignature knownSignatures[] = {
         .frequencyMax = 928.0f,
         .modulation = MOD_LORA,
         .bandwidth = 200.0f,
-        .minRSSI = -120.0f
+        .minRSSI = -120.0f,
+        .packetRates = 0
     },
     // Generic FSK telemetry link (catch-all)
     {
@@ -99,7 +113,8 @@ static const DroneSignature knownSignatures[] = {
         .frequencyMax = 928.0f,
         .modulation = MOD_FSK,
         .bandwidth = 156.0f,
-        .minRSSI = -110.0f
+        .minRSSI = -110.0f,
+        .packetRates = 0
     },
     // Simple OOK remote control
     {
@@ -108,7 +123,8 @@ static const DroneSignature knownSignatures[] = {
         .frequencyMax = 928.0f,
         .modulation = MOD_OOK,
         .bandwidth = 58.0f,
-        .minRSSI = -100.0f
+        .minRSSI = -100.0f,
+        .packetRates = 0
     }
 };
 
@@ -132,6 +148,22 @@ const char* getModulationName(ModulationType mod) {
     }
 }
 
+const char* getSignatureName(int index) {
+    if (index < 0 || (size_t)index >= NUM_SIGNATURES) {
+        return "Unknown";
+    }
+    return knownSignatures[index].name;
+}
+
+int findSignature(const char* name) {
+    for (size_t i = 0; i < NUM_SIGNATURES; i++) {
+        if (strcmp(knownSignatures[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
 // ============================================================================
 // Frequency Validation
 // ============================================================================
@@ -149,19 +181,22 @@ bool droneDetectionInit(SX1262* radio) {
         return false;
     }
     
-    // Start with LoRa mode at 915 MHz
-    int state = configureLoRaMode(radio, FREQ_900_CENTER);
-    
-    if (state == RADIOLIB_ERR_NONE) {
-        isInitialized = true;
-        currentModulation = MOD_LORA;
-        return true;
-    }
+    // Build protocol fingerprint lookup table and packet decoder CRC tables
+    fingerprintInit();
+    packetDecoderInit();
+    transmitterClusterInit();
     
-    return false;
+    // Default scanner covers the whole band with every modulation, starting
+    // in LoRa mode at the band start
+    return scannerInit(&defaultScanner, radio, 0, 0, (uint16_t)NUM_SWEEP_CHANNELS - 1,
+                       MOD_MASK_ALL);
 }
 
 int configureLoRaMode(SX1262* radio, float frequency) {
+    return configureLoRaModeWith(radio, frequency, LORA_BANDWIDTH, LORA_SPREADING_FACTOR);
+}
+
+int configureLoRaModeWith(SX1262* radio, float frequency, float bandwidth, uint8_t spreadingFactor) {
     if (radio == NULL) {
         return RADIOLIB_ERR_INVALID_CALL;
     }
@@ -173,11 +208,9 @@ int configureLoRaMode(SX1262* radio, float frequency) {
     
     // Configure for LoRa mode
     // Parameters: frequency (MHz), bandwidth (kHz), SF, CR
-    int state = radio->begin(frequency, LORA_BANDWIDTH, 
-                             LORA_SPREADING_FACTOR, LORA_CODING_RATE);
+    int state = radio->begin(frequency, bandwidth, spreadingFactor, LORA_CODING_RATE);
     
     if (state == RADIOLIB_ERR_NONE) {
-        currentModulation = MOD_LORA;
         Serial.print(F("[DroneDetect] LoRa mode configured at "));
         Serial.print(frequency);
         Serial.println(F(" MHz"));
@@ -203,7 +236,6 @@ int configureFSKMode(SX1262* radio, float frequency) {
                                 FSK_RX_BANDWIDTH, 14, FSK_PREAMBLE_LEN, 1.6, false);
     
     if (state == RADIOLIB_ERR_NONE) {
-        currentModulation = MOD_FSK;
         Serial.print(F("[DroneDetect] FSK mode configured at "));
         Serial.print(frequency);
         Serial.println(F(" MHz"));
@@ -228,7 +260,6 @@ int configureOOKMode(SX1262* radio, float frequency) {
                                 OOK_RX_BANDWIDTH, 14, 16, 1.6, false);
     
     if (state == RADIOLIB_ERR_NONE) {
-        currentModulation = MOD_OOK;
         Serial.print(F("[DroneDetect] OOK mode configured at "));
         Serial.print(frequency);
         Serial.println(F(" MHz"));
@@ -237,52 +268,189 @@ int configureOOKMode(SX1262* radio, float frequency) {
     return state;
 }
 
-// ============================================================================
-// Modulation Switching
-// ============================================================================
+/**
+ * Disable sync word matching, CRC and whitening and switch to fixed-length
+ * packets so any preamble at the configured bit rate yields a raw capture
+ */
+static int configureRawPacket(SX1262* radio) {
+    uint8_t noSyncWord[1] = { 0 };
+    
+    int state = radio->setSyncWord(noSyncWord, 0);
+    if (state == RADIOLIB_ERR_NONE) {
+        state = radio->setCRC(0);
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = radio->setWhitening(false);
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = radio->setDataShaping(RADIOLIB_SHAPING_NONE);
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = radio->fixedPacketLengthMode(RAW_CAPTURE_LENGTH);
+    }
+    
+    return state;
+}
 
-ModulationType getCurrentModulation() {
-    return currentModulation;
+int configureFSKCaptureMode(SX1262* radio, float frequency, float bitrate) {
+    return configureFSKCaptureModeWith(radio, frequency, bitrate, FSK_FREQUENCY_DEV,
+                                       FSK_CAPTURE_RX_BANDWIDTH);
 }
 
-ModulationType switchToNextModulation(SX1262* radio, float frequency) {
+int configureFSKCaptureModeWith(SX1262* radio, float frequency, float bitrate,
+                                float deviation, float rxBandwidth) {
+    if (radio == NULL) {
+        return RADIOLIB_ERR_INVALID_CALL;
+    }
+    
+    int state = radio->beginFSK(frequency, bitrate, deviation, 
+                                rxBandwidth, 14, FSK_PREAMBLE_LEN, 1.6, false);
+    if (state == RADIOLIB_ERR_NONE) {
+        state = configureRawPacket(radio);
+    }
+    
+    if (state == RADIOLIB_ERR_NONE) {
+        Serial.print(F("[DroneDetect] FSK capture mode at "));
+        Serial.print(frequency);
+        Serial.print(F(" MHz, "));
+        Serial.print(bitrate);
+        Serial.println(F(" kbps"));
+    }
+    
+    return state;
+}
+
+int configureEnergyProbeMode(SX1262* radio, float frequency) {
     if (radio == NULL) {
-        return currentModulation;
+        return RADIOLIB_ERR_INVALID_CALL;
+    }
+    
+    // Only RSSI is read, so the packet settings do not matter
+    return radio->beginFSK(frequency, FSK_BITRATE, FSK_FREQUENCY_DEV,
+                           FSK_RX_BANDWIDTH_MAX, 14, FSK_PREAMBLE_LEN, 1.6, false);
+}
+
+int configureOOKCaptureMode(SX1262* radio, float frequency, float bitrate) {
+    if (radio == NULL) {
+        return RADIOLIB_ERR_INVALID_CALL;
     }
     
+    int state = radio->beginFSK(frequency, bitrate, 0.0, 
+                                OOK_CAPTURE_RX_BANDWIDTH, 14, 16, 1.6, false);
+    if (state == RADIOLIB_ERR_NONE) {
+        state = configureRawPacket(radio);
+    }
+    
+    if (state == RADIOLIB_ERR_NONE) {
+        Serial.print(F("[DroneDetect] OOK capture mode at "));
+        Serial.print(frequency);
+        Serial.print(F(" MHz, "));
+        Serial.print(bitrate);
+        Serial.println(F(" kbps"));
+    }
+    
+    return state;
+}
+
+float getCaptureBitrate() {
+    return scannerCaptureBitrate(&defaultScanner);
+}
+
+/**
+ * Configure a scanner's radio for a modulation, using raw capture modes for
+ * FSK/OOK when enabled, and record the new mode in the scanner
+ */
+static int scannerConfigure(DroneScanner* scanner, ModulationType mod, float frequency) {
     int state;
-    ModulationType nextMod;
+    float bitrate = 0.0f;
     
-    // Cycle through modulation types: LoRa -> FSK -> OOK -> LoRa
-    switch (currentModulation) {
-        case MOD_LORA:
-            nextMod = MOD_FSK;
-            state = configureFSKMode(radio, frequency);
-            break;
+    switch (mod) {
         case MOD_FSK:
-            nextMod = MOD_OOK;
-            state = configureOOKMode(radio, frequency);
+            if (RAW_CAPTURE_ENABLED) {
+                bitrate = fskCaptureBitrates[scanner->captureBitrateIndex %
+                                             (sizeof(fskCaptureBitrates) / sizeof(fskCaptureBitrates[0]))];
+                state = configureFSKCaptureMode(scanner->radio, frequency, bitrate);
+            } else {
+                state = configureFSKMode(scanner->radio, frequency);
+            }
             break;
         case MOD_OOK:
+            if (RAW_CAPTURE_ENABLED) {
+                bitrate = ookCaptureBitrates[scanner->captureBitrateIndex %
+                                             (sizeof(ookCaptureBitrates) / sizeof(ookCaptureBitrates[0]))];
+                state = configureOOKCaptureMode(scanner->radio, frequency, bitrate);
+            } else {
+                state = configureOOKMode(scanner->radio, frequency);
+            }
+            break;
+        case MOD_LORA:
         default:
-            nextMod = MOD_LORA;
-            state = configureLoRaMode(radio, frequency);
+            mod = MOD_LORA;
+            state = configureLoRaModeWith(scanner->radio, frequency, scanner->loraBandwidth,
+                                          scanner->loraSpreadingFactor);
             break;
     }
     
+    if (state == RADIOLIB_ERR_NONE) {
+        scanner->modulation = mod;
+        scanner->captureBitrate = bitrate;
+    }
+    
+    return state;
+}
+
+/**
+ * Frequency of a sweep channel in MHz
+ */
+static float sweepChannelFrequency(uint16_t channel) {
+    return FREQ_900_MIN + channel * (SWEEP_STEP_KHZ / 1000.0f);
+}
+
+// ============================================================================
+// Modulation Switching
+// ============================================================================
+
+/**
+ * Move a scanner to the next modulation it is assigned, at a frequency
+ */
+static ModulationType scannerSwitchModulation(DroneScanner* scanner, float frequency) {
+    // Cycle through modulation types: LoRa -> FSK -> OOK -> LoRa, skipping
+    // modulations not assigned to this scanner
+    ModulationType nextMod = scanner->modulation;
+    for (int i = 0; i < MOD_UNKNOWN; i++) {
+        nextMod = (ModulationType)((nextMod + 1) % MOD_UNKNOWN);
+        if (scanner->modulationMask & MOD_MASK(nextMod)) {
+            break;
+        }
+    }
+    if (nextMod == scanner->modulation) {
+        return nextMod;
+    }
+    
+    int state = scannerConfigure(scanner, nextMod, frequency);
+    
     if (state != RADIOLIB_ERR_NONE) {
         Serial.print(F("[DroneDetect] Failed to switch modulation, code: "));
         Serial.println(state);
         // Stay with current modulation on failure
-        return currentModulation;
+        return scanner->modulation;
     }
     
-    // Update module state with new modulation
-    currentModulation = nextMod;
-    
     return nextMod;
 }
 
+ModulationType getCurrentModulation() {
+    return defaultScanner.modulation;
+}
+
+ModulationType switchToNextModulation(SX1262* radio, float frequency) {
+    if (radio == NULL) {
+        return defaultScanner.modulation;
+    }
+    
+    return scannerSwitchModulation(&defaultScanner, frequency);
+}
+
 // ============================================================================
 // Drone Signal Analysis
 // ============================================================================
@@ -290,8 +458,12 @@ ModulationType switchToNextModulation(SX1262* radio, float frequency) {
 /**
  * Match signal against known drone signatures
  * Returns the matching signature index or -1 if no match
+ *
+ * The RSSI gate is the stricter of the signature's absolute sensitivity
+ * limit and the adaptive threshold above the local noise floor.
  */
-static int matchSignature(float rssi, float frequency, ModulationType modulation) {
+static int matchSignature(float rssi, float frequency, ModulationType modulation,
+                          float threshold) {
     for (size_t i = 0; i < NUM_SIGNATURES; i++) {
         const DroneSignature* sig = &knownSignatures[i];
         
@@ -306,7 +478,7 @@ static int matchSignature(float rssi, float frequency, ModulationType modulation
         }
         
         // Check RSSI is above minimum threshold
-        if (rssi < sig->minRSSI) {
+        if (rssi < sig->minRSSI || rssi < threshold) {
             continue;
         }
         
@@ -317,17 +489,42 @@ static int matchSignature(float rssi, float frequency, ModulationType modulation
     return -1;  // No match
 }
 
+/**
+ * Adjust confidence using the emitter's classified packet rate
+ * A rate the matched protocol is known to use is strong evidence; a rate it
+ * never uses is evidence against the match
+ */
+static int rateConfidenceAdjustment(int signatureIndex, PacketRateMode rateMode) {
+    if (rateMode == RATE_UNKNOWN) {
+        return 0;
+    }
+    
+    uint16_t rateBit = RATE_MASK(rateMode);
+    
+    if (signatureIndex >= 0 && knownSignatures[signatureIndex].packetRates != 0) {
+        return (knownSignatures[signatureIndex].packetRates & rateBit) ? 15 : -10;
+    }
+    
+    // No protocol-specific rates: any known drone link rate is still suggestive
+    for (size_t i = 0; i < NUM_SIGNATURES; i++) {
+        if (knownSignatures[i].packetRates & rateBit) {
+            return 10;
+        }
+    }
+    return 0;
+}
+
 /**
  * Calculate detection confidence based on signal characteristics
  * Returns confidence percentage (0-100)
  */
-static uint8_t calculateConfidence(float rssi, float snr, float freqError) {
+static uint8_t calculateConfidence(float rssi, float snr, float freqError, float noiseFloor) {
     uint8_t confidence = 0;
     
     // RSSI contribution (stronger signal = higher confidence)
-    // Scale: -120 dBm = 0%, -30 dBm = 50%
-    if (rssi > -120.0f) {
-        float rssiScore = (rssi + 120.0f) / 90.0f * 50.0f;
+    // Scale: noise floor = 0%, floor + NOISE_CONFIDENCE_SPAN_DB = 50%
+    if (rssi > noiseFloor) {
+        float rssiScore = (rssi - noiseFloor) / NOISE_CONFIDENCE_SPAN_DB * 50.0f;
         confidence += (uint8_t)min(rssiScore, 50.0f);
     }
     
@@ -349,15 +546,42 @@ static uint8_t calculateConfidence(float rssi, float snr, float freqError) {
     return min(confidence, (uint8_t)100);
 }
 
+/**
+ * Receiver bandwidth used for a modulation (kHz)
+ */
+static float getReceiverBandwidth(ModulationType modulation) {
+    switch (modulation) {
+        case MOD_FSK:
+            return RAW_CAPTURE_ENABLED ? FSK_CAPTURE_RX_BANDWIDTH : FSK_RX_BANDWIDTH;
+        case MOD_OOK:
+            return RAW_CAPTURE_ENABLED ? OOK_CAPTURE_RX_BANDWIDTH : OOK_RX_BANDWIDTH;
+        case MOD_LORA:
+        default:
+            // Every scanner runs the same LoRa parameters
+            return defaultScanner.loraBandwidth;
+    }
+}
+
 bool analyzeDroneSignal(float rssi, float snr, float freqError, 
-                        ModulationType currentMod, DroneSignal* signal) {
+                        ModulationType currentMod, const PacketCapture* capture,
+                        DroneSignal* signal) {
+    // Use current sweep frequency for proper signature matching during sweep scan
+    bool isDrone = analyzeDroneSignalAt(defaultScanner.sweepFrequency, rssi, snr, freqError,
+                                        currentMod, capture, signal);
+    printDroneAnalysis(signal, capture);
+    return isDrone;
+}
+
+bool analyzeDroneSignalAt(float frequency, float rssi, float snr, float freqError,
+                          ModulationType currentMod, const PacketCapture* capture,
+                          DroneSignal* signal) {
     if (signal == NULL) {
         return false;
     }
     
     // Initialize signal structure
-    // Use current sweep frequency for proper signature matching during sweep scan
-    signal->frequency = currentSweepFrequency;
+    // Frequency the receiving scanner was tuned to when the packet arrived
+    signal->frequency = frequency;
     signal->rssi = rssi;
     signal->snr = snr;
     signal->freqError = freqError;
@@ -365,101 +589,507 @@ bool analyzeDroneSignal(float rssi, float snr, float freqError,
     signal->isDroneSignature = false;
     signal->confidence = 0;
     signal->droneType = "Unknown";
+    signal->signatureIndex = -1;
+    signal->transmitterId = 0;
+    signal->trackId = 0;
+    signal->packetRateHz = 0;
+    signal->utcUs = (capture != NULL) ? capture->utcUs : 0;
+    signal->decodedProtocol = NULL;
+    signal->packetType = 0;
+    
+    // Thresholds are relative to the background on this channel/modulation
+    int channel = frequencyToSweepChannel(signal->frequency);
+    float noiseFloor = noiseFloorGet(channel, currentMod);
+    signal->noiseFloor = noiseFloor;
+    float threshold = noiseFloorThreshold(channel, currentMod);
     
     // Calculate confidence based on signal quality
-    signal->confidence = calculateConfidence(rssi, snr, freqError);
+    signal->confidence = calculateConfidence(rssi, snr, freqError, noiseFloor);
     
     // Try to match against known drone signatures
     // Uses current sweep frequency for accurate frequency-based matching
-    int matchIndex = matchSignature(rssi, signal->frequency, currentMod);
+    int matchIndex = matchSignature(rssi, signal->frequency, currentMod, threshold);
     
     if (matchIndex >= 0) {
         signal->isDroneSignature = true;
         signal->droneType = knownSignatures[matchIndex].name;
+        signal->signatureIndex = (int8_t)matchIndex;
         
         // Boost confidence for matched signatures
         signal->confidence = min((int)signal->confidence + 20, 100);
+    }
+    
+    // Demodulated packets with a decodable framing identify protocol and
+    // transmitter definitively
+    PacketRateMode decodedRate = RATE_UNKNOWN;
+    bool identified = false;
+    if (capture != NULL && !capture->isRawCapture && capture->data != NULL) {
+        DecodedPacket decoded;
+        if (decodePacket(capture->data, capture->length, currentMod, capture->timestampUs,
+                         &decoded)) {
+            int index = findSignature(decoded.signatureName);
+            signal->isDroneSignature = true;
+            signal->signatureIndex = (int8_t)index;
+            signal->droneType = getSignatureName(index);
+            signal->transmitterId = decoded.transmitterId;
+            signal->confidence = max((int)signal->confidence, 95);
+            signal->decodedProtocol = decoded.protocol;
+            signal->packetType = decoded.packetType;
+            decodedRate = decoded.rateMode;
+            identified = true;
+        }
+    }
+    
+    // Raw FSK/OOK captures can identify the protocol exactly
+    if (capture != NULL && capture->isRawCapture && capture->data != NULL) {
+        ProtocolFingerprint fingerprint;
+        bool known = fingerprintCapture(capture->data, capture->length,
+                                        capture->bitrateKbps, &fingerprint);
         
+        if (known) {
+            identified = true;
+            signal->droneType = fingerprint.name;
+            signal->isDroneSignature = fingerprint.isDrone;
+            signal->signatureIndex = fingerprint.signatureIndex;
+            if (fingerprint.isDrone) {
+                // Exact protocol identification outweighs signal quality
+                signal->confidence = max((int)signal->confidence, 90);
+            }
+        }
+    }
+    
+    // Without a decoded identity, LoRa emitters sharing a protocol are told
+    // apart by the crystal offset in their frequency error (the SX1262 only
+    // estimates frequency error in LoRa mode)
+    if (capture != NULL && signal->transmitterId == 0 && currentMod == MOD_LORA) {
+        signal->transmitterId = transmitterClusterAssign(signal);
+    }
+    
+    // Packet timing of the emitter's track (rate mode) refines confidence
+    EmitterTrack* track = NULL;
+    if (capture != NULL) {
+        track = trackObserve(trackKeyForSignal(signal), signal, capture->timestampUs);
+        if (track->rateMode == RATE_UNKNOWN && decodedRate != RATE_UNKNOWN) {
+            // Rate announced in a SYNC packet until timing confirms it
+            track->rateMode = decodedRate;
+        }
+        signal->trackId = track->id;
+        signal->packetRateHz = getPacketRateHz(track->rateMode);
+    }
+    
+    // Learned model score for signals without an exact protocol
+    // identification. It can only raise confidence: the rules stay in
+    // charge of what counts as a drone.
+    if (!identified) {
+        // Extraction also prints the FEAT trace with -DCLASSIFIER_TRACE
+        ClassifierFeatures features;
+        classifierExtractFeatures(signal, track, capture, noiseFloor,
+                                  getReceiverBandwidth(currentMod), &features);
+        if (CLASSIFIER_ENABLED) {
+            signal->confidence = max(signal->confidence, classifierConfidence(&features));
+        }
+    }
+    
+    if (track != NULL) {
+        int adjusted = (int)signal->confidence +
+                       rateConfidenceAdjustment(signal->signatureIndex, track->rateMode);
+        signal->confidence = (uint8_t)constrain(adjusted, 0, 100);
+    }
+    
+    return signal->isDroneSignature;
+}
+
+void printDroneAnalysis(const DroneSignal* signal, const PacketCapture* capture) {
+    if (signal == NULL) {
+        return;
+    }
+    
+    if (signal->decodedProtocol == NULL && signal->signatureIndex >= 0 &&
+        (capture == NULL || !capture->isRawCapture)) {
         Serial.print(F("[DroneDetect] Matched signature: "));
         Serial.println(signal->droneType);
     }
     
-    // Log detection details
+    if (signal->decodedProtocol != NULL) {
+        Serial.print(F("[DroneDetect] Decoded "));
+        Serial.print(signal->decodedProtocol);
+        Serial.print(F(" packet type "));
+        Serial.print(signal->packetType);
+        Serial.print(F(", transmitter 0x"));
+        Serial.println(signal->transmitterId, HEX);
+    }
+    
+    // Fingerprinting has no state, so it is repeated rather than kept
+    if (capture != NULL && capture->isRawCapture && capture->data != NULL) {
+        ProtocolFingerprint fingerprint;
+        bool known = fingerprintCapture(capture->data, capture->length,
+                                        capture->bitrateKbps, &fingerprint);
+        Serial.print(F("[DroneDetect] Fingerprint: header 0x"));
+        Serial.print(fingerprint.headerWord, HEX);
+        Serial.print(F(", ~"));
+        Serial.print(fingerprint.bitrateKbps);
+        Serial.print(F(" kbps -> "));
+        Serial.println(known ? fingerprint.name : "no match");
+    }
+    
+    if (signal->packetRateHz != 0) {
+        Serial.print(F("[DroneDetect] Track #"));
+        Serial.print(signal->trackId);
+        Serial.print(F(" packet rate: "));
+        Serial.print(signal->packetRateHz);
+        Serial.println(F(" Hz"));
+    }
+    
     Serial.println(F("[DroneDetect] Signal Analysis:"));
     Serial.print(F("  Modulation: "));
-    Serial.println(getModulationName(currentMod));
+    Serial.println(getModulationName(signal->modulation));
+    Serial.print(F("  Noise floor: "));
+    Serial.print(signal->noiseFloor);
+    Serial.println(F(" dBm"));
     Serial.print(F("  Confidence: "));
     Serial.print(signal->confidence);
     Serial.println(F("%"));
     Serial.print(F("  Drone Match: "));
     Serial.println(signal->isDroneSignature ? "Yes" : "No");
+}
+
+// ============================================================================
+// Noise Floor Sampling
+// ============================================================================
+
+void sampleNoiseFloor(SX1262* radio) {
+    float rssi;
     
-    return signal->isDroneSignature;
+    if (radio == NULL || !scannerSampleNoise(&defaultScanner, &rssi)) {
+        return;
+    }
+    noiseFloorUpdate(frequencyToSweepChannel(defaultScanner.sweepFrequency),
+                     defaultScanner.modulation, rssi);
 }
 
 // ============================================================================
 // Sweep Scanning Functions (for FHSS detection)
 // ============================================================================
 
-// Track sweep channel position
-static uint16_t currentSweepChannel = 0;
-
 float getCurrentSweepFrequency() {
-    return currentSweepFrequency;
+    return defaultScanner.sweepFrequency;
 }
 
 float sweepToNextFrequency(SX1262* radio) {
     if (radio == NULL) {
-        return currentSweepFrequency;
+        return defaultScanner.sweepFrequency;
+    }
+    
+    return scannerSweepNext(&defaultScanner);
+}
+
+int frequencyToSweepChannel(float frequency) {
+    int channel = (int)lroundf((frequency - FREQ_900_MIN) * 1000.0f / SWEEP_STEP_KHZ);
+    if (channel < 0 || channel >= (int)NUM_SWEEP_CHANNELS) {
+        return -1;
+    }
+    return channel;
+}
+
+void resetSweepScan() {
+    scannerResetSweep(&defaultScanner);
+}
+
+bool isSweepComplete() {
+    return defaultScanner.sweepComplete;
+}
+
+// ============================================================================
+// Scanner Functions
+// ============================================================================
+
+bool scannerInit(DroneScanner* scanner, SX1262* radio, uint8_t index,
+                 uint16_t firstChannel, uint16_t lastChannel, uint8_t modulationMask) {
+    if (scanner == NULL || radio == NULL || firstChannel > lastChannel ||
+        lastChannel >= (uint16_t)NUM_SWEEP_CHANNELS || (modulationMask & MOD_MASK_ALL) == 0) {
+        return false;
     }
     
-    // Step to next frequency
-    currentSweepFrequency += (SWEEP_STEP_KHZ / 1000.0f);  // Convert kHz to MHz
-    currentSweepChannel++;
+    memset(scanner, 0, sizeof(*scanner));
+    scanner->radio = radio;
+    scanner->index = index;
+    scanner->firstChannel = firstChannel;
+    scanner->lastChannel = lastChannel;
+    scanner->modulationMask = modulationMask & MOD_MASK_ALL;
+    scanner->channelStride = 1;
+    scanner->dwellMs = SWEEP_DWELL_MS;
+    scanner->modulationMs = SCANNER_MODULATION_MS;
+    scanner->loraSpreadingFactor = LORA_SPREADING_FACTOR;
+    scanner->loraBandwidth = LORA_BANDWIDTH;
+    scanner->sweepChannel = firstChannel;
+    scanner->sweepFrequency = sweepChannelFrequency(firstChannel);
     
-    // Check if we've reached end of band (using NUM_SWEEP_CHANNELS for validation)
-    if (currentSweepChannel >= (uint16_t)NUM_SWEEP_CHANNELS || 
-        currentSweepFrequency > FREQ_900_MAX) {
-        currentSweepFrequency = FREQ_900_MIN;
-        currentSweepChannel = 0;
-        sweepComplete = true;
-        Serial.print(F("[DroneDetect] Sweep scan complete ("));
-        Serial.print((uint16_t)NUM_SWEEP_CHANNELS);
-        Serial.println(F(" channels), restarting..."));
+    // Start with the first assigned modulation (LoRa unless excluded)
+    ModulationType mod = MOD_LORA;
+    while (!(scanner->modulationMask & MOD_MASK(mod))) {
+        mod = (ModulationType)(mod + 1);
     }
     
-    // Reconfigure radio at new frequency based on current modulation
-    int state;
-    switch (currentModulation) {
-        case MOD_LORA:
-            state = configureLoRaMode(radio, currentSweepFrequency);
-            break;
-        case MOD_FSK:
-            state = configureFSKMode(radio, currentSweepFrequency);
-            break;
-        case MOD_OOK:
-            state = configureOOKMode(radio, currentSweepFrequency);
-            break;
-        default:
-            state = configureLoRaMode(radio, currentSweepFrequency);
-            break;
+    int state = scannerConfigure(scanner, mod, scanner->sweepFrequency);
+    if (state != RADIOLIB_ERR_NONE) {
+        Serial.print(F("[DroneDetect] Scanner "));
+        Serial.print(index);
+        Serial.print(F(" init failed, code: "));
+        Serial.println(state);
+        return false;
     }
     
+    scanner->initialized = true;
+    return true;
+}
+
+DroneScanner* getDefaultScanner() {
+    return &defaultScanner;
+}
+
+void scannerSetSubBand(DroneScanner* scanner, uint16_t firstChannel, uint16_t lastChannel) {
+    if (scanner == NULL || firstChannel > lastChannel ||
+        lastChannel >= (uint16_t)NUM_SWEEP_CHANNELS) {
+        return;
+    }
+    
+    scanner->firstChannel = firstChannel;
+    scanner->lastChannel = lastChannel;
+    scanner->priorityCount = 0;
+    scannerResetSweep(scanner);
+}
+
+ModulationType scannerNextModulation(DroneScanner* scanner) {
+    if (scanner == NULL || !scanner->initialized) {
+        return MOD_UNKNOWN;
+    }
+    
+    return scannerSwitchModulation(scanner, scanner->sweepFrequency);
+}
+
+float scannerSweepNext(DroneScanner* scanner) {
+    if (scanner == NULL || !scanner->initialized) {
+        return FREQ_900_MIN;
+    }
+    
+    if (scanner->priorityCount > 0) {
+        // Queued channels first; the sweep continues where it was afterwards
+        uint16_t channel = scanner->priorityChannels[0];
+        scanner->priorityCount--;
+        memmove(&scanner->priorityChannels[0], &scanner->priorityChannels[1],
+                scanner->priorityCount * sizeof(scanner->priorityChannels[0]));
+        scanner->sweepFrequency = sweepChannelFrequency(channel);
+    } else {
+        // Step to next channel of the scanner's sub-band, passing over
+        // channels the coarse-to-fine sweep skips
+        do {
+            scanner->sweepChannel += scanner->channelStride;
+        } while (scanner->sweepChannel <= scanner->lastChannel &&
+                 (scanner->sweepSkipMask & (1ULL << scanner->sweepChannel)));
+        
+        if (scanner->sweepChannel > scanner->lastChannel) {
+            scanner->sweepSkipMask = 0;
+            scanner->captureBitrateIndex++;
+            // Staged settings take effect between sweeps
+            if (scanner->planPending && scannerApplyPlan(scanner)) {
+                return scanner->sweepFrequency;
+            }
+            scanner->sweepChannel = scanner->firstChannel;
+            scanner->sweepComplete = true;
+            scanner->sweepCount++;
+            Serial.print(F("[DroneDetect] Scanner "));
+            Serial.print(scanner->index);
+            Serial.print(F(" sweep complete ("));
+            Serial.print((scanner->lastChannel - scanner->firstChannel) / scanner->channelStride + 1);
+            Serial.println(F(" channels), restarting..."));
+        }
+        scanner->sweepFrequency = sweepChannelFrequency(scanner->sweepChannel);
+    }
+    
+    // Reconfigure radio at new frequency based on current modulation
+    int state = scannerConfigure(scanner, scanner->modulation, scanner->sweepFrequency);
+    
     if (state != RADIOLIB_ERR_NONE) {
         Serial.print(F("[DroneDetect] Sweep frequency change failed, code: "));
         Serial.println(state);
     }
     
-    return currentSweepFrequency;
+    return scanner->sweepFrequency;
 }
 
-void resetSweepScan() {
-    currentSweepFrequency = FREQ_900_MIN;
-    currentSweepChannel = 0;
-    sweepComplete = false;
+bool scannerResume(DroneScanner* scanner, uint16_t channel, ModulationType modulation) {
+    if (scanner == NULL || !scanner->initialized) {
+        return false;
+    }
+    
+    if (channel < scanner->firstChannel || channel > scanner->lastChannel ||
+        (channel - scanner->firstChannel) % scanner->channelStride != 0) {
+        channel = scanner->sweepChannel;
+    }
+    if (modulation >= MOD_UNKNOWN || !(scanner->modulationMask & MOD_MASK(modulation))) {
+        modulation = scanner->modulation;
+    }
+    
+    int state = scannerConfigure(scanner, modulation, sweepChannelFrequency(channel));
+    if (state != RADIOLIB_ERR_NONE) {
+        return false;
+    }
+    scanner->sweepChannel = channel;
+    scanner->sweepFrequency = sweepChannelFrequency(channel);
+    return true;
+}
+
+bool scannerQueueChannel(DroneScanner* scanner, uint16_t channel) {
+    if (scanner == NULL || channel < scanner->firstChannel || channel > scanner->lastChannel ||
+        scanner->priorityCount >= SCANNER_PRIORITY_CHANNELS) {
+        return false;
+    }
+    
+    scanner->priorityChannels[scanner->priorityCount++] = channel;
+    return true;
+}
+
+bool scannerSetPlan(DroneScanner* scanner, const ScanPlan* plan) {
+    if (scanner == NULL || plan == NULL || plan->firstChannel > plan->lastChannel ||
+        plan->lastChannel >= (uint16_t)NUM_SWEEP_CHANNELS || plan->channelStride == 0 ||
+        (plan->modulationMask & MOD_MASK_ALL) == 0 || plan->dwellMs == 0 ||
+        plan->loraSpreadingFactor < 5 || plan->loraSpreadingFactor > 12 ||
+        plan->loraBandwidth <= 0.0f) {
+        return false;
+    }
+    
+    portENTER_CRITICAL(&planLock);
+    scanner->pendingPlan = *plan;
+    scanner->pendingPlan.modulationMask &= MOD_MASK_ALL;
+    scanner->planPending = true;
+    portEXIT_CRITICAL(&planLock);
+    return true;
+}
+
+bool scannerApplyPlan(DroneScanner* scanner) {
+    if (scanner == NULL || !scanner->initialized || !scanner->planPending) {
+        return false;
+    }
+    
+    ScanPlan plan;
+    portENTER_CRITICAL(&planLock);
+    plan = scanner->pendingPlan;
+    scanner->planPending = false;
+    portEXIT_CRITICAL(&planLock);
+    
+    scanner->firstChannel = plan.firstChannel;
+    scanner->lastChannel = plan.lastChannel;
+    scanner->channelStride = plan.channelStride;
+    scanner->modulationMask = plan.modulationMask;
+    scanner->dwellMs = plan.dwellMs;
+    scanner->modulationMs = plan.modulationMs;
+    scanner->loraSpreadingFactor = plan.loraSpreadingFactor;
+    scanner->loraBandwidth = plan.loraBandwidth;
+    scanner->priorityCount = 0;
+    scanner->sweepSkipMask = 0;
+    scanner->sweepChannel = plan.firstChannel;
+    scanner->sweepFrequency = sweepChannelFrequency(plan.firstChannel);
+    scanner->sweepComplete = false;
+    
+    // Keep the current modulation if it is still assigned
+    ModulationType mod = scanner->modulation;
+    if (!(scanner->modulationMask & MOD_MASK(mod))) {
+        mod = MOD_LORA;
+        while (!(scanner->modulationMask & MOD_MASK(mod))) {
+            mod = (ModulationType)(mod + 1);
+        }
+    }
+    
+    int state = scannerConfigure(scanner, mod, scanner->sweepFrequency);
+    if (state != RADIOLIB_ERR_NONE) {
+        Serial.print(F("[DroneDetect] Scanner "));
+        Serial.print(scanner->index);
+        Serial.print(F(" retune for new plan failed, code: "));
+        Serial.println(state);
+    }
+    
+    Serial.print(F("[DroneDetect] Scanner "));
+    Serial.print(scanner->index);
+    Serial.print(F(" plan applied: channels "));
+    Serial.print(scanner->firstChannel);
+    Serial.print(F("-"));
+    Serial.print(scanner->lastChannel);
+    Serial.print(F(" step "));
+    Serial.print(scanner->channelStride);
+    Serial.print(F(", dwell "));
+    Serial.print(scanner->dwellMs);
+    Serial.println(F(" ms"));
+    return true;
+}
+
+void scannerGetPlan(const DroneScanner* scanner, ScanPlan* plan) {
+    if (scanner == NULL || plan == NULL) {
+        return;
+    }
+    plan->firstChannel = scanner->firstChannel;
+    plan->lastChannel = scanner->lastChannel;
+    plan->channelStride = scanner->channelStride;
+    plan->modulationMask = scanner->modulationMask;
+    plan->dwellMs = scanner->dwellMs;
+    plan->modulationMs = scanner->modulationMs;
+    plan->loraSpreadingFactor = scanner->loraSpreadingFactor;
+    plan->loraBandwidth = scanner->loraBandwidth;
+}
+
+void scannerResetSweep(DroneScanner* scanner) {
+    if (scanner == NULL) {
+        return;
+    }
+    
+    scanner->sweepChannel = scanner->firstChannel;
+    scanner->sweepFrequency = sweepChannelFrequency(scanner->firstChannel);
+    scanner->sweepComplete = false;
+    scanner->sweepSkipMask = 0;
     Serial.println(F("[DroneDetect] Sweep scan reset to start"));
 }
 
-bool isSweepComplete() {
-    return sweepComplete;
+bool scannerSetSweepSkip(DroneScanner* scanner, uint64_t skipMask) {
+    if (scanner == NULL || !scanner->initialized) {
+        return false;
+    }
+    
+    uint16_t channel = scanner->sweepChannel;
+    while (channel <= scanner->lastChannel && (skipMask & (1ULL << channel))) {
+        channel += scanner->channelStride;
+    }
+    if (channel > scanner->lastChannel) {
+        // Nothing left to visit: sweep everything
+        skipMask = 0;
+        channel = scanner->sweepChannel;
+    }
+    
+    int state = scannerConfigure(scanner, scanner->modulation, sweepChannelFrequency(channel));
+    if (state != RADIOLIB_ERR_NONE) {
+        Serial.print(F("[DroneDetect] Sweep frequency change failed, code: "));
+        Serial.println(state);
+        return false;
+    }
+    scanner->sweepSkipMask = skipMask;
+    scanner->sweepChannel = channel;
+    scanner->sweepFrequency = sweepChannelFrequency(channel);
+    return true;
+}
+
+bool scannerSampleNoise(DroneScanner* scanner, float* rssi) {
+    if (scanner == NULL || rssi == NULL || !scanner->initialized ||
+        millis() - scanner->lastNoiseSampleMs < NOISE_FLOOR_SAMPLE_MS) {
+        return false;
+    }
+    scanner->lastNoiseSampleMs = millis();
+    
+    // Instantaneous RSSI of the channel while listening (no packet)
+    *rssi = scanner->radio->getRSSI(false);
+    return true;
+}
+
+float scannerCaptureBitrate(const DroneScanner* scanner) {
+    if (scanner == NULL || scanner->modulation == MOD_LORA) {
+        return 0.0f;
+    }
+    return scanner->captureBitrate;
 }
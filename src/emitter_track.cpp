@@ -0,0 +1,146 @@
+/**
+ * Emitter Track Module Implementation
+ */
+
+#include "emitter_track.h"
+#include "detection_log.h"
+#include "packet_decoder.h"
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+static EmitterTrack tracks[MAX_EMITTER_TRACKS];
+static uint32_t nextTrackId = 1;
+
+#define TRACK_RSSI_ALPHA    0.1f
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void closeTrack(EmitterTrack* track) {
+    TrackLogRecord record;
+    record.trackId = track->id;
+    record.key = track->key;
+    record.firstSeenMs = track->firstSeenMs;
+    record.durationMs = track->lastSeenMs - track->firstSeenMs;
+    record.packets = track->timing.packets;
+    record.modulation = (uint8_t)track->modulation;
+    record.signatureIndex = track->signatureIndex;
+    record.rateHz = getPacketRateHz(track->rateMode);
+    record.peakRssiDeci = (int16_t)lroundf(track->peakRssi * 10.0f);
+
+    int channel = frequencyToSweepChannel(track->lastFrequency);
+    detectionLogAppend(DETLOG_RECORD_TRACK,
+                       channel >= 0 ? (uint8_t)channel : DETLOG_NO_CHANNEL,
+                       &record, sizeof(record));
+
+    Serial.print(F("[Track] Closed #"));
+    Serial.print(track->id);
+    Serial.print(F(" after "));
+    Serial.print(record.packets);
+    Serial.print(F(" packets, rate "));
+    Serial.print(record.rateHz);
+    Serial.println(F(" Hz"));
+
+    track->active = false;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+uint32_t trackKeyForSignal(const DroneSignal* signal) {
+    // Decoded transmitter identifiers separate emitters on the same protocol
+    if (signal->transmitterId != 0) {
+        return signal->transmitterId;
+    }
+
+    // Otherwise emitters are distinguished by modulation and identified protocol
+    return ((uint32_t)signal->modulation << 8) | (uint8_t)(signal->signatureIndex + 1);
+}
+
+uint32_t networkKeyForSignal(const DroneSignal* signal) {
+    if ((signal->transmitterId & 0xFF000000UL) == ELRS_ID_TAG) {
+        return signal->transmitterId;
+    }
+    return ((uint32_t)signal->modulation << 8) | (uint8_t)(signal->signatureIndex + 1);
+}
+
+EmitterTrack* trackObserve(uint32_t key, const DroneSignal* signal, uint32_t timestampUs) {
+    uint32_t now = millis();
+    EmitterTrack* track = NULL;
+    EmitterTrack* freeSlot = NULL;
+    EmitterTrack* oldest = NULL;
+
+    for (int i = 0; i < MAX_EMITTER_TRACKS; i++) {
+        EmitterTrack* t = &tracks[i];
+        if (!t->active) {
+            if (freeSlot == NULL) {
+                freeSlot = t;
+            }
+            continue;
+        }
+        if (t->key == key && now - t->lastSeenMs <= TRACK_TIMEOUT_MS) {
+            track = t;
+            break;
+        }
+        if (oldest == NULL || t->lastSeenMs < oldest->lastSeenMs) {
+            oldest = t;
+        }
+    }
+
+    if (track == NULL) {
+        // Reuse a free slot, otherwise evict the least recently seen track
+        if (freeSlot == NULL) {
+            closeTrack(oldest);
+            freeSlot = oldest;
+        }
+        track = freeSlot;
+        track->active = true;
+        track->key = key;
+        track->id = nextTrackId++;
+        track->modulation = signal->modulation;
+        track->signatureIndex = signal->signatureIndex;
+        track->firstSeenMs = now;
+        track->lastFrequency = signal->frequency;
+        track->hopSpacingKHz = 0;
+        track->peakRssi = signal->rssi;
+        track->meanRssi = signal->rssi;
+        track->rateMode = RATE_UNKNOWN;
+        interArrivalReset(&track->timing);
+    }
+
+    // Smallest hop approximates the emitter's channel spacing
+    uint32_t hopKHz = (uint32_t)lroundf(fabsf(signal->frequency - track->lastFrequency) * 1000.0f);
+    if (hopKHz > 0 && (track->hopSpacingKHz == 0 || hopKHz < track->hopSpacingKHz)) {
+        track->hopSpacingKHz = hopKHz;
+    }
+
+    track->lastSeenMs = now;
+    track->lastFrequency = signal->frequency;
+    track->peakRssi = max(track->peakRssi, signal->rssi);
+    track->meanRssi += TRACK_RSSI_ALPHA * (signal->rssi - track->meanRssi);
+
+    interArrivalUpdate(&track->timing, timestampUs);
+    track->rateMode = interArrivalClassify(&track->timing, NULL);
+
+    return track;
+}
+
+void trackService() {
+    uint32_t now = millis();
+    for (int i = 0; i < MAX_EMITTER_TRACKS; i++) {
+        if (tracks[i].active && now - tracks[i].lastSeenMs > TRACK_TIMEOUT_MS) {
+            closeTrack(&tracks[i]);
+        }
+    }
+}
+
+const EmitterTrack* getTrack(int index) {
+    if (index < 0 || index >= MAX_EMITTER_TRACKS || !tracks[index].active) {
+        return NULL;
+    }
+    return &tracks[index];
+}
@@ -0,0 +1,82 @@
+/**
+ * GPS Module Implementation
+ */
+
+#include "gps.h"
+#include <TinyGPSPlus.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+static TinyGPSPlus gps;
+static bool hadFix = false;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * Days since 1970-01-01 of a civil date (proleptic Gregorian)
+ */
+static int32_t daysFromCivil(int32_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t yoe = (uint32_t)(year - era * 400);
+    uint32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void gpsInit() {
+    Serial1.begin(GPS_BAUD, SERIAL_8N1, GPS_RX, GPS_TX);
+    Serial.print(F("[GPS] Listening at "));
+    Serial.print(GPS_BAUD);
+    Serial.println(F(" baud"));
+}
+
+void gpsService() {
+    while (Serial1.available() > 0) {
+        gps.encode((char)Serial1.read());
+    }
+
+    // Report fix acquisition and loss once
+    bool fix = gps.location.isValid() && gps.location.age() <= GPS_FIX_MAX_AGE_MS;
+    if (fix != hadFix) {
+        hadFix = fix;
+        Serial.println(fix ? F("[GPS] Fix acquired") : F("[GPS] Fix lost"));
+    }
+}
+
+bool gpsGetUtcMs(int64_t* utcMs) {
+    if (utcMs == NULL || !gps.date.isValid() || !gps.time.isValid() ||
+        gps.time.age() > GPS_FIX_MAX_AGE_MS || gps.date.year() < 2020) {
+        return false;
+    }
+
+    int64_t seconds = (int64_t)daysFromCivil(gps.date.year(), gps.date.month(), gps.date.day()) * 86400 +
+                      gps.time.hour() * 3600 + gps.time.minute() * 60 + gps.time.second();
+    *utcMs = seconds * 1000 + gps.time.centisecond() * 10 + gps.time.age();
+    return true;
+}
+
+bool gpsGetFix(GpsFix* fix) {
+    if (fix == NULL || !gps.location.isValid() || gps.location.age() > GPS_FIX_MAX_AGE_MS) {
+        return false;
+    }
+
+    fix->hdop = gps.hdop.isValid() ? (float)gps.hdop.hdop() : GPS_MAX_HDOP;
+    if (fix->hdop > GPS_MAX_HDOP) {
+        return false;
+    }
+
+    fix->latitude = gps.location.lat();
+    fix->longitude = gps.location.lng();
+    fix->satellites = gps.satellites.isValid() ? (uint8_t)min(gps.satellites.value(), 255U) : 0;
+    fix->ageMs = gps.location.age();
+    return true;
+}
@@ -0,0 +1,327 @@
+/**
+ * Hierarchical Sweep Module Implementation
+ *
+ * Probe floors and dwell times are kept per channel. Scanners sweep
+ * disjoint sub-bands, so each has a single writer; the statistics are shared and guarded by
+ * a spinlock.
+ */
+
+#include "hier_sweep.h"
+#include "low_power.h"
+#include "scanner_task.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+/**
+ * Sweep of a scanner being timed, reported when it completes
+ */
+typedef struct {
+    bool valid;                 // The sweep is being timed
+    bool hier;                  // A coarse pass restricted the sweep
+    ModulationType modulation;  // Modulation the sweep ran in
+    int64_t runStartUs;         // Start of the modulation period (revisit origin)
+    uint32_t revisitMaxMs;      // Longest revisit closed by a dwell of this sweep
+    int64_t startUs;            // Pass start
+    uint8_t channels;           // Sweep channels of the sub-band
+    uint8_t dwelt;              // Channels kept for dwells
+    uint32_t probes;            // RSSI samples of the pass
+    uint32_t passUs;            // Pass duration
+    uint8_t rover;              // Roving channel position of the next pass
+} HierScanner;
+
+/**
+ * Working state of one pass
+ */
+typedef struct {
+    DroneScanner* scanner;
+    uint8_t count;              // Sweep positions
+    uint64_t hits;              // Channels with energy (bit per channel)
+    uint64_t keep;              // Channels to dwell on
+    uint32_t probes;            // RSSI samples taken
+} HierPass;
+
+static bool enabled = HIER_SWEEP_ENABLED;
+static HierScanner scanners[MAX_SCANNERS];
+static float probeFloor[HIER_MAX_CHANNELS];
+static uint64_t probeFloorValid = 0;
+static int64_t lastDwellUs[HIER_MAX_CHANNELS];     // 0 = none this modulation period
+
+static portMUX_TYPE hierStatsLock = portMUX_INITIALIZER_UNLOCKED;
+static HierSweepStats stats;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint16_t positionChannel(const HierPass* pass, uint8_t position) {
+    return pass->scanner->firstChannel + position * pass->scanner->channelStride;
+}
+
+/**
+ * Peak RSSI of a channel over a number of samples (radio in probe mode)
+ */
+static float probeChannel(HierPass* pass, uint16_t channel, uint8_t samples) {
+    SX1262* radio = pass->scanner->radio;
+    radio->standby();
+    radio->setFrequency(FREQ_900_MIN + channel * (SWEEP_STEP_KHZ / 1000.0f));
+    radio->startReceive();
+    delayMicroseconds(HIER_SETTLE_US);
+
+    float peak = radio->getRSSI(false);
+    for (uint8_t i = 1; i < samples; i++) {
+        delayMicroseconds(HIER_SAMPLE_US);
+        peak = max(peak, radio->getRSSI(false));
+    }
+    pass->probes += samples;
+    return peak;
+}
+
+static bool probeHit(uint16_t channel, float peak) {
+    return (probeFloorValid & (1ULL << channel)) &&
+           peak > probeFloor[channel] + HIER_MARGIN_DB;
+}
+
+/**
+ * Track the channel's probe floor with the samples that are not hits
+ */
+static void updateFloor(uint16_t channel, float peak) {
+    uint64_t bit = 1ULL << channel;
+    if (!(probeFloorValid & bit)) {
+        probeFloor[channel] = peak;
+        probeFloorValid |= bit;
+    } else if (peak <= probeFloor[channel] + HIER_MARGIN_DB) {
+        probeFloor[channel] += HIER_FLOOR_ALPHA * (peak - probeFloor[channel]);
+    }
+}
+
+static bool blockHit(const HierPass* pass, uint8_t first, uint8_t last) {
+    for (uint8_t p = first; p <= last; p++) {
+        if (pass->hits & (1ULL << positionChannel(pass, p))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Narrow an active block of sweep positions down to the leaf blocks with
+ * energy
+ */
+static void refine(HierPass* pass, uint8_t first, uint8_t last, uint8_t samples) {
+    if (last - first + 1 <= HIER_MIN_BLOCK) {
+        for (uint8_t p = first; p <= last; p++) {
+            pass->keep |= 1ULL << positionChannel(pass, p);
+        }
+        return;
+    }
+
+    uint8_t middle = (first + last) / 2;
+    uint8_t halves[2][2] = { { first, middle }, { (uint8_t)(middle + 1), last } };
+    for (int h = 0; h < 2; h++) {
+        uint8_t a = halves[h][0];
+        uint8_t b = halves[h][1];
+        if (!blockHit(pass, a, b)) {
+            // Intermittent energy may sit here too: look again, longer
+            for (uint8_t p = a; p <= b; p++) {
+                uint16_t channel = positionChannel(pass, p);
+                if (probeHit(channel, probeChannel(pass, channel, samples))) {
+                    pass->hits |= 1ULL << channel;
+                }
+            }
+        }
+        if (blockHit(pass, a, b)) {
+            refine(pass, a, b, min(samples * 2, HIER_MAX_SAMPLES));
+        }
+    }
+}
+
+static uint16_t sweepPositions(const DroneScanner* scanner) {
+    return (uint16_t)((scanner->lastChannel - scanner->firstChannel) / scanner->channelStride + 1);
+}
+
+static uint32_t revisitMs(const HierScanner* state, uint16_t channel, int64_t nowUs) {
+    int64_t sinceUs = lastDwellUs[channel] != 0 ? lastDwellUs[channel] : state->runStartUs;
+    return (uint32_t)min(max((nowUs - sinceUs) / 1000, (int64_t)0), (int64_t)UINT32_MAX);
+}
+
+static void reportSweep(const DroneScanner* scanner, const HierScanner* last, int64_t nowUs) {
+    uint32_t sweepMs = (uint32_t)((nowUs - last->startUs) / 1000);
+
+    // Channels not dwelt on since still have their gap open
+    uint32_t revisitMaxMs = last->revisitMaxMs;
+    for (uint16_t p = 0; p < last->channels; p++) {
+        uint16_t channel = scanner->firstChannel + p * scanner->channelStride;
+        revisitMaxMs = max(revisitMaxMs, revisitMs(last, channel, nowUs));
+    }
+
+    portENTER_CRITICAL(&hierStatsLock);
+    if (last->hier) {
+        stats.dwellChannelsMean += SCANNER_TIMING_EWMA * ((float)last->dwelt - stats.dwellChannelsMean);
+        stats.sweepMeanMs += SCANNER_TIMING_EWMA * ((float)sweepMs - stats.sweepMeanMs);
+        stats.revisitMaxMs = max(stats.revisitMaxMs, revisitMaxMs);
+    } else {
+        stats.flatSweepMeanMs += SCANNER_TIMING_EWMA * ((float)sweepMs - stats.flatSweepMeanMs);
+        stats.flatRevisitMaxMs = max(stats.flatRevisitMaxMs, revisitMaxMs);
+    }
+    portEXIT_CRITICAL(&hierStatsLock);
+
+    // HSWEEP,<scanner>,<modulation>,<mode>,<channels>,<channels dwelt>,
+    // <probes>,<coarse pass us>,<sweep ms>,<max revisit ms>
+    Serial.print(F("HSWEEP,"));
+    Serial.print(scanner->index);
+    Serial.print(',');
+    Serial.print(getModulationName(last->modulation));
+    Serial.print(',');
+    Serial.print(last->hier ? F("hier") : F("flat"));
+    Serial.print(',');
+    Serial.print(last->channels);
+    Serial.print(',');
+    Serial.print(last->dwelt);
+    Serial.print(',');
+    Serial.print(last->probes);
+    Serial.print(',');
+    Serial.print(last->passUs);
+    Serial.print(',');
+    Serial.print(sweepMs);
+    Serial.print(',');
+    Serial.println(revisitMaxMs);
+}
+
+/**
+ * Start timing a sweep
+ */
+static void startSweep(HierScanner* state, const DroneScanner* scanner, int64_t startUs,
+                       bool hier, uint8_t dwelt, uint32_t probes, uint32_t passUs) {
+    state->valid = true;
+    state->hier = hier;
+    state->modulation = scanner->modulation;
+    state->startUs = startUs;
+    state->channels = (uint8_t)sweepPositions(scanner);
+    state->dwelt = dwelt;
+    state->probes = probes;
+    state->passUs = passUs;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void hierSweepEnable(bool enable) {
+    enabled = enable;
+}
+
+bool hierSweepEnabled() {
+    return enabled;
+}
+
+bool hierSweepPass(DroneScanner* scanner, bool previousComplete) {
+    if (scanner == NULL || !scanner->initialized || scanner->index >= MAX_SCANNERS) {
+        return false;
+    }
+    HierScanner* state = &scanners[scanner->index];
+    int64_t startUs = esp_timer_get_time();
+
+    bool sameRun = state->valid && previousComplete && state->modulation == scanner->modulation;
+    if (sameRun) {
+        reportSweep(scanner, state, startUs);
+    }
+    state->valid = false;
+    state->revisitMaxMs = 0;
+
+    if (scanner->lastChannel >= HIER_MAX_CHANNELS || scanner->channelStride == 0) {
+        return false;
+    }
+    uint16_t count = sweepPositions(scanner);
+    if (!sameRun) {
+        // Revisits are measured within one modulation period
+        for (uint16_t p = 0; p < count; p++) {
+            lastDwellUs[scanner->firstChannel + p * scanner->channelStride] = 0;
+        }
+        state->runStartUs = startUs;
+    }
+
+    if (!enabled || lowPowerEnabled()) {
+        startSweep(state, scanner, startUs, false, (uint8_t)count, 0, 0);
+        return false;
+    }
+
+    HierPass pass = {};
+    pass.scanner = scanner;
+    pass.count = (uint8_t)count;
+    if (configureEnergyProbeMode(scanner->radio, scanner->sweepFrequency) != RADIOLIB_ERR_NONE) {
+        // The sweep retune below restores the scan configuration
+        scannerSetSweepSkip(scanner, 0);
+        return false;
+    }
+
+    // Coarse pass: one probe per channel
+    for (uint8_t p = 0; p < pass.count; p++) {
+        uint16_t channel = positionChannel(&pass, p);
+        float peak = probeChannel(&pass, channel, 1);
+        if (probeHit(channel, peak)) {
+            pass.hits |= 1ULL << channel;
+        }
+        updateFloor(channel, peak);
+    }
+
+    // Fine pass: subdivide the active blocks
+    for (uint8_t first = 0; first < pass.count; first += HIER_BLOCK_CHANNELS) {
+        uint8_t last = min((int)first + HIER_BLOCK_CHANNELS - 1, (int)pass.count - 1);
+        if (blockHit(&pass, first, last)) {
+            refine(&pass, first, last, 2);
+        }
+    }
+
+    // The roving share keeps every channel visited within
+    // HIER_REVISIT_PASSES sweeps, whatever the probes saw
+    uint8_t share = (uint8_t)((pass.count + HIER_REVISIT_PASSES - 1) / HIER_REVISIT_PASSES);
+    for (uint8_t i = 0; i < share; i++) {
+        pass.keep |= 1ULL << positionChannel(&pass, (uint8_t)((state->rover + i) % pass.count));
+    }
+    state->rover = (uint8_t)((state->rover + share) % pass.count);
+
+    uint64_t sweepChannels = 0;
+    for (uint8_t p = 0; p < pass.count; p++) {
+        sweepChannels |= 1ULL << positionChannel(&pass, p);
+    }
+    bool retuned = scannerSetSweepSkip(scanner, sweepChannels & ~pass.keep);
+
+    uint32_t passUs = (uint32_t)(esp_timer_get_time() - startUs);
+    if (retuned) {
+        startSweep(state, scanner, startUs, true, (uint8_t)__builtin_popcountll(pass.keep),
+                   pass.probes, passUs);
+    }
+
+    portENTER_CRITICAL(&hierStatsLock);
+    stats.passes++;
+    stats.probes += pass.probes;
+    stats.coarseMeanUs += SCANNER_TIMING_EWMA * ((float)passUs - stats.coarseMeanUs);
+    stats.coarseMaxUs = max(stats.coarseMaxUs, passUs);
+    portEXIT_CRITICAL(&hierStatsLock);
+    return retuned;
+}
+
+void hierSweepNoteDwell(const DroneScanner* scanner, int64_t nowUs) {
+    if (scanner == NULL || scanner->index >= MAX_SCANNERS) {
+        return;
+    }
+    HierScanner* state = &scanners[scanner->index];
+    int channel = frequencyToSweepChannel(scanner->sweepFrequency);
+    if (!state->valid || channel < 0 || channel >= HIER_MAX_CHANNELS) {
+        return;
+    }
+    state->revisitMaxMs = max(state->revisitMaxMs, revisitMs(state, (uint16_t)channel, nowUs));
+    lastDwellUs[channel] = nowUs;
+}
+
+void hierSweepGetStats(HierSweepStats* out) {
+    if (out == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&hierStatsLock);
+    *out = stats;
+    portEXIT_CRITICAL(&hierStatsLock);
+}
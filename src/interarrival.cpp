@@ -0,0 +1,115 @@
+/**
+ * Inter-Arrival Analyzer Module Implementation
+ *
+ * An emitter at period T is also phase coherent at every candidate period
+ * that divides T (a 50 Hz link looks coherent at 100 Hz), but not at longer
+ * periods. The classifier therefore picks the lowest coherent rate.
+ */
+
+#include "interarrival.h"
+
+// ============================================================================
+// Rate Mode Table
+// ============================================================================
+
+typedef struct {
+    uint16_t rateHz;            // Packet rate
+    uint32_t periodUs;          // Packet period in microseconds
+} RateModeInfo;
+
+static const RateModeInfo rateModes[NUM_RATE_MODES] = {
+    { 25,   40000 },
+    { 50,   20000 },
+    { 100,  10000 },
+    { 150,  6667 },
+    { 200,  5000 },
+    { 250,  4000 },
+    { 333,  3000 },
+    { 500,  2000 },
+    { 1000, 1000 }
+};
+
+// Cosine table over one period; phase is quantised to PHASE_STEPS per period
+#define PHASE_STEPS 64
+static float cosTable[PHASE_STEPS];
+static bool cosTableReady = false;
+
+static void buildCosTable() {
+    for (int i = 0; i < PHASE_STEPS; i++) {
+        cosTable[i] = cosf(2.0f * (float)M_PI * i / PHASE_STEPS);
+    }
+    cosTableReady = true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void interArrivalReset(InterArrivalAnalyzer* analyzer) {
+    if (!cosTableReady) {
+        buildCosTable();
+    }
+    memset(analyzer, 0, sizeof(*analyzer));
+    analyzer->minDeltaUs = UINT32_MAX;
+}
+
+void interArrivalUpdate(InterArrivalAnalyzer* analyzer, uint32_t timestampUs) {
+    if (analyzer->packets == 0) {
+        analyzer->originUs = timestampUs;
+    } else {
+        uint32_t delta = timestampUs - analyzer->lastUs;
+        if (delta > 0 && delta < analyzer->minDeltaUs) {
+            analyzer->minDeltaUs = delta;
+        }
+    }
+    analyzer->lastUs = timestampUs;
+    analyzer->packets++;
+
+    // Relative time keeps the modulo stable across micros() wrap for tracks
+    // shorter than ~71 minutes
+    uint32_t t = timestampUs - analyzer->originUs;
+
+    analyzer->weight = analyzer->weight * INTERARRIVAL_DECAY + 1.0f;
+    for (int m = 0; m < NUM_RATE_MODES; m++) {
+        uint32_t period = rateModes[m].periodUs;
+        uint32_t phase = (uint32_t)(((uint64_t)(t % period) * PHASE_STEPS) / period);
+        analyzer->sumCos[m] = analyzer->sumCos[m] * INTERARRIVAL_DECAY + cosTable[phase];
+        analyzer->sumSin[m] = analyzer->sumSin[m] * INTERARRIVAL_DECAY +
+                              cosTable[(phase + PHASE_STEPS * 3 / 4) % PHASE_STEPS];
+    }
+}
+
+PacketRateMode interArrivalClassify(const InterArrivalAnalyzer* analyzer, float* coherence) {
+    if (coherence != NULL) {
+        *coherence = 0.0f;
+    }
+    if (analyzer->packets < INTERARRIVAL_MIN_PACKETS || analyzer->weight <= 0.0f) {
+        return RATE_UNKNOWN;
+    }
+
+    // Lowest coherent rate explains the arrivals; faster coherent rates are
+    // divisors of its period
+    for (int m = 0; m < NUM_RATE_MODES; m++) {
+        float c = sqrtf(analyzer->sumCos[m] * analyzer->sumCos[m] +
+                        analyzer->sumSin[m] * analyzer->sumSin[m]) / analyzer->weight;
+        if (c >= INTERARRIVAL_COHERENCE_MIN) {
+            // Arrivals closer together than the period rule this rate out
+            if (analyzer->minDeltaUs + rateModes[m].periodUs / 4 < rateModes[m].periodUs) {
+                continue;
+            }
+            if (coherence != NULL) {
+                *coherence = c;
+            }
+            return (PacketRateMode)m;
+        }
+    }
+
+    return RATE_UNKNOWN;
+}
+
+uint16_t getPacketRateHz(PacketRateMode mode) {
+    if (mode >= NUM_RATE_MODES) {
+        return 0;
+    }
+    return rateModes[mode].rateHz;
+}
@@ -0,0 +1,141 @@
+/**
+ * Localizer Module Implementation
+ *
+ * Slots of the emitters being localized, each with its position filter;
+ * the filter itself is in src/localizer_grid.cpp.
+ */
+
+#include "localizer.h"
+#include "arena.h"
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+typedef struct {
+    bool active;                    // Slot in use
+    bool updated;                   // Committed observation since last print
+    uint32_t key;                   // Emitter identity key
+    uint32_t lastUpdateMs;          // millis() of latest observation
+    LocalizerGrid grid;             // Position filter
+} LocalizedEmitter;
+
+// Grids are touched once per committed observation: PSRAM
+static LocalizedEmitter* emitters = NULL;
+static uint32_t lastPrintMs = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static LocalizedEmitter* findEmitter(uint32_t key) {
+    if (emitters == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < LOCALIZER_MAX_EMITTERS; i++) {
+        if (emitters[i].active && emitters[i].key == key) {
+            return &emitters[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Claim a slot for a new emitter: a free or timed out one, otherwise the
+ * least recently updated
+ */
+static LocalizedEmitter* allocateEmitter(uint32_t key, const GpsFix* fix) {
+    uint32_t now = millis();
+    LocalizedEmitter* slot = &emitters[0];
+    for (int i = 0; i < LOCALIZER_MAX_EMITTERS; i++) {
+        LocalizedEmitter* e = &emitters[i];
+        if (!e->active || now - e->lastUpdateMs > LOCALIZER_TIMEOUT_MS) {
+            slot = e;
+            break;
+        }
+        if (e->lastUpdateMs < slot->lastUpdateMs) {
+            slot = e;
+        }
+    }
+
+    memset(slot, 0, sizeof(*slot));
+    slot->active = true;
+    slot->key = key;
+    localizerGridInit(&slot->grid, fix->latitude, fix->longitude);
+    return slot;
+}
+
+static bool computeEstimate(const LocalizedEmitter* e, LocalizerEstimate* estimate) {
+    estimate->key = e->key;
+    estimate->observations = e->grid.observations;
+    return localizerGridEstimate(&e->grid, &estimate->latitude, &estimate->longitude,
+                                 &estimate->uncertaintyM);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void localizerInit() {
+    if (emitters == NULL) {
+        emitters = (LocalizedEmitter*)arenaAlloc(ARENA_PSRAM,
+                                                 LOCALIZER_MAX_EMITTERS * sizeof(LocalizedEmitter),
+                                                 "localizer");
+    } else {
+        memset(emitters, 0, LOCALIZER_MAX_EMITTERS * sizeof(LocalizedEmitter));
+    }
+    lastPrintMs = millis();
+}
+
+bool localizerObserve(uint32_t key, float rssi, const GpsFix* fix) {
+    if (!LOCALIZER_ENABLED || fix == NULL || emitters == NULL) {
+        return false;
+    }
+
+    LocalizedEmitter* e = findEmitter(key);
+    if (e == NULL) {
+        e = allocateEmitter(key, fix);
+    }
+    e->lastUpdateMs = millis();
+
+    if (!localizerGridObserve(&e->grid, rssi, fix->latitude, fix->longitude)) {
+        return false;
+    }
+    e->updated = true;
+    return true;
+}
+
+bool localizerGetEstimate(uint32_t key, LocalizerEstimate* estimate) {
+    const LocalizedEmitter* e = findEmitter(key);
+    if (estimate == NULL || e == NULL) {
+        return false;
+    }
+    return computeEstimate(e, estimate);
+}
+
+void localizerService() {
+    if (emitters == NULL || millis() - lastPrintMs < LOCALIZER_PRINT_MS) {
+        return;
+    }
+    lastPrintMs = millis();
+
+    for (int i = 0; i < LOCALIZER_MAX_EMITTERS; i++) {
+        LocalizedEmitter* e = &emitters[i];
+        LocalizerEstimate estimate;
+        if (!e->active || !e->updated || !computeEstimate(e, &estimate)) {
+            continue;
+        }
+        e->updated = false;
+
+        Serial.print(F("LOC,"));
+        Serial.print(estimate.key, HEX);
+        Serial.print(',');
+        Serial.print(estimate.latitude, 6);
+        Serial.print(',');
+        Serial.print(estimate.longitude, 6);
+        Serial.print(',');
+        Serial.print(estimate.uncertaintyM, 0);
+        Serial.print(',');
+        Serial.println(estimate.observations);
+    }
+}
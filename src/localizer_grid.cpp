@@ -0,0 +1,201 @@
+/**
+ * Localizer Grid Module Implementation
+ *
+ * Cell misfit uses Welford's running mean/deviation, which stays accurate
+ * in single precision over thousands of observations. Positions are kept
+ * in metres on a local east/north plane around the grid origin.
+ */
+
+#include "localizer_grid.h"
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+#define LOCALIZER_EDGE_M        ((LOCALIZER_GRID * 0.5f - LOCALIZER_RECENTRE_CELLS) * LOCALIZER_CELL_M)
+#define METRES_PER_DEG_LAT      110574.0
+#define METRES_PER_DEG_LON      111320.0
+#define RAD_PER_DEG             (M_PI / 180.0)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void toLocal(const LocalizerGrid* grid, double latitude, double longitude,
+                    float* x, float* y) {
+    *x = (float)((longitude - grid->originLon) * grid->metresPerDegLon);
+    *y = (float)((latitude - grid->originLat) * METRES_PER_DEG_LAT);
+}
+
+/**
+ * Centre of a grid cell in local metres
+ */
+static inline float cellCentre(int index) {
+    return ((float)index - (LOCALIZER_GRID - 1) * 0.5f) * LOCALIZER_CELL_M;
+}
+
+/**
+ * Fold one observation into every cell
+ */
+static void foldObservation(LocalizerGrid* grid, float x, float y, float rssi) {
+    float n = (float)(grid->observations + 1);
+    // 10 n log10(d) = 5 n log10(d^2)
+    const float pathLoss = 5.0f * LOCALIZER_PATH_LOSS_EXP;
+    const float floorSq = LOCALIZER_ANTENNA_M * LOCALIZER_ANTENNA_M;
+
+    for (int row = 0; row < LOCALIZER_GRID; row++) {
+        float dy = cellCentre(row) - y;
+        for (int col = 0; col < LOCALIZER_GRID; col++) {
+            float dx = cellCentre(col) - x;
+            int c = row * LOCALIZER_GRID + col;
+            float z = rssi + pathLoss * log10f(dx * dx + dy * dy + floorSq);
+            float delta = z - grid->mean[c];
+            grid->mean[c] += delta / n;
+            grid->m2[c] += delta * (z - grid->mean[c]);
+        }
+    }
+
+    grid->observations++;
+}
+
+/**
+ * Posterior mean (local m) and radial variance over the grid
+ */
+static void computePosterior(const LocalizerGrid* grid, float* meanX, float* meanY,
+                             float* variance) {
+    float best = grid->m2[0];
+    for (int c = 1; c < LOCALIZER_CELLS; c++) {
+        best = fminf(best, grid->m2[c]);
+    }
+
+    const float scale = 1.0f / (2.0f * LOCALIZER_RSSI_SIGMA_DB * LOCALIZER_RSSI_SIGMA_DB);
+    float sumW = 0.0f, sumX = 0.0f, sumY = 0.0f, sumXX = 0.0f, sumYY = 0.0f;
+    for (int row = 0; row < LOCALIZER_GRID; row++) {
+        float y = cellCentre(row);
+        for (int col = 0; col < LOCALIZER_GRID; col++) {
+            float x = cellCentre(col);
+            float w = expf(-(grid->m2[row * LOCALIZER_GRID + col] - best) * scale);
+            sumW += w;
+            sumX += w * x;
+            sumY += w * y;
+            sumXX += w * x * x;
+            sumYY += w * y * y;
+        }
+    }
+
+    *meanX = sumX / sumW;
+    *meanY = sumY / sumW;
+    // Posterior variance plus the quantisation of the grid itself
+    *variance = (sumXX / sumW - *meanX * *meanX) + (sumYY / sumW - *meanY * *meanY) +
+                LOCALIZER_CELL_M * LOCALIZER_CELL_M / 6.0f;
+}
+
+/**
+ * Move the grid centre to local (x, y) and rebuild it from the history
+ */
+static void recentre(LocalizerGrid* grid, float x, float y) {
+    grid->originLat += y / METRES_PER_DEG_LAT;
+    grid->originLon += x / grid->metresPerDegLon;
+    grid->pendingX -= x;
+    grid->pendingY -= y;
+
+    memset(grid->mean, 0, sizeof(grid->mean));
+    memset(grid->m2, 0, sizeof(grid->m2));
+    grid->observations = 0;
+
+    int first = (grid->historyNext + LOCALIZER_HISTORY - grid->historyCount) % LOCALIZER_HISTORY;
+    for (int i = 0; i < grid->historyCount; i++) {
+        LocalizerObservation* obs = &grid->history[(first + i) % LOCALIZER_HISTORY];
+        obs->x -= x;
+        obs->y -= y;
+        foldObservation(grid, obs->x, obs->y, obs->rssi);
+    }
+}
+
+/**
+ * Commit the averaged observation from the current spot, following the
+ * emitter if its estimate nears the edge of the grid
+ */
+static void commitPending(LocalizerGrid* grid) {
+    LocalizerObservation* obs = &grid->history[grid->historyNext];
+    obs->x = grid->pendingX;
+    obs->y = grid->pendingY;
+    obs->rssi = grid->pendingRssiSum / grid->pendingCount;
+    grid->historyNext = (grid->historyNext + 1) % LOCALIZER_HISTORY;
+    if (grid->historyCount < LOCALIZER_HISTORY) {
+        grid->historyCount++;
+    }
+
+    foldObservation(grid, obs->x, obs->y, obs->rssi);
+    grid->pendingCount = 0;
+    grid->pendingRssiSum = 0.0f;
+
+    if (grid->observations >= LOCALIZER_MIN_OBSERVATIONS) {
+        float x, y, variance;
+        computePosterior(grid, &x, &y, &variance);
+        if (fabsf(x) > LOCALIZER_EDGE_M || fabsf(y) > LOCALIZER_EDGE_M) {
+            recentre(grid, x, y);
+        }
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void localizerGridInit(LocalizerGrid* grid, double latitude, double longitude) {
+    if (grid == NULL) {
+        return;
+    }
+    memset(grid, 0, sizeof(*grid));
+    grid->originLat = latitude;
+    grid->originLon = longitude;
+    grid->metresPerDegLon = (float)(METRES_PER_DEG_LON * cos(latitude * RAD_PER_DEG));
+}
+
+bool localizerGridObserve(LocalizerGrid* grid, float rssi, double latitude, double longitude) {
+    if (grid == NULL) {
+        return false;
+    }
+
+    float x, y;
+    toLocal(grid, latitude, longitude, &x, &y);
+
+    // Still at the same spot: average into the pending observation
+    bool committed = false;
+    if (grid->pendingCount > 0) {
+        float dx = x - grid->pendingX;
+        float dy = y - grid->pendingY;
+        if (dx * dx + dy * dy < LOCALIZER_MIN_SPACING_M * LOCALIZER_MIN_SPACING_M) {
+            grid->pendingRssiSum += rssi;
+            if (grid->pendingCount < UINT16_MAX) {
+                grid->pendingCount++;
+            }
+            return false;
+        }
+        commitPending(grid);
+        committed = true;
+    }
+
+    grid->pendingX = x;
+    grid->pendingY = y;
+    grid->pendingRssiSum = rssi;
+    grid->pendingCount = 1;
+    return committed;
+}
+
+bool localizerGridEstimate(const LocalizerGrid* grid, double* latitude, double* longitude,
+                           float* uncertaintyM) {
+    if (grid == NULL || grid->observations < LOCALIZER_MIN_OBSERVATIONS) {
+        return false;
+    }
+
+    float x, y, variance;
+    computePosterior(grid, &x, &y, &variance);
+    *latitude = grid->originLat + y / METRES_PER_DEG_LAT;
+    *longitude = grid->originLon + x / grid->metresPerDegLon;
+    *uncertaintyM = sqrtf(fmaxf(variance, 0.0f));
+    return true;
+}
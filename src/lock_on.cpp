@@ -0,0 +1,468 @@
+/**
+ * Lock-On Module Implementation
+ *
+ * Sessions run entirely in the scanner task that started them; each
+ * scanner has its own session slot. The candidate order scores and the
+ * statistics are shared between scanners and the main loop and guarded by
+ * a spinlock. Scores halve when one reaches LOCK_SCORE_MAX, so the order
+ * follows what has been on the air recently.
+ */
+
+#include "lock_on.h"
+#include "noise_floor.h"
+#include "low_power.h"
+#include "packet_decoder.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+#define LOCK_SIGNATURES_MAX     16        // Signature database entries scored
+
+/**
+ * One parameter set tried during the search
+ */
+typedef struct {
+    ModulationType modulation;
+    float bandwidthKhz;         // LoRa bandwidth, or FSK/OOK RX bandwidth (kHz)
+    uint8_t spreadingFactor;    // LoRa spreading factor (0 for FSK/OOK)
+    float bitrateKbps;          // FSK/OOK bit rate (0 for LoRa)
+    float deviationKhz;         // FSK deviation (0 for LoRa/OOK)
+    uint8_t implicitLength;     // LoRa implicit header payload length (0 for explicit)
+    uint8_t codingRate;         // LoRa implicit header coding rate (4/x)
+    bool invertIq;              // LoRa inverted IQ
+    uint16_t windowMs;          // Listen time: a few packets at the link's rates
+    const char* signature;      // Signature database entry it belongs to
+} LockCandidate;
+
+// Air parameters of the database's links, in database order. LoRa
+// bandwidths are SX126x steps (ELRS narrow mode and R9 on the nearest).
+// ELRS sends fixed-length packets with an implicit header and no LoRa CRC,
+// and inverts IQ depending on the binding UID, so each of its rates is
+// tried with both polarities; an explicit header receiver never hears it.
+static const LockCandidate candidates[] = {
+    { MOD_LORA, 500.0f, 6, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, false, 30, "ExpressLRS 900" }, // 200 Hz
+    { MOD_LORA, 500.0f, 6, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, true, 30, "ExpressLRS 900" },
+    { MOD_LORA, 500.0f, 6, 0.0f, 0.0f, ELRS_OTA8_PACKET_SIZE, 8, false, 40, "ExpressLRS 900" }, // 100 Hz Full
+    { MOD_LORA, 500.0f, 6, 0.0f, 0.0f, ELRS_OTA8_PACKET_SIZE, 8, true, 40, "ExpressLRS 900" },
+    { MOD_LORA, 500.0f, 7, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, false, 40, "ExpressLRS 900" }, // 100 Hz
+    { MOD_LORA, 500.0f, 7, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, true, 40, "ExpressLRS 900" },
+    { MOD_LORA, 500.0f, 8, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, false, 60, "ExpressLRS 900" }, // 50 Hz
+    { MOD_LORA, 500.0f, 8, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, true, 60, "ExpressLRS 900" },
+    { MOD_LORA, 500.0f, 9, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, false, 100, "ExpressLRS 900" }, // 25 Hz
+    { MOD_LORA, 500.0f, 9, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, true, 100, "ExpressLRS 900" },
+    { MOD_LORA, 125.0f, 6, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, false, 30, "ELRS 900 Narrow" },
+    { MOD_LORA, 125.0f, 6, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, true, 30, "ELRS 900 Narrow" },
+    { MOD_LORA, 125.0f, 7, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, false, 40, "ELRS 900 Narrow" },
+    { MOD_LORA, 125.0f, 7, 0.0f, 0.0f, ELRS_OTA4_PACKET_SIZE, 7, true, 40, "ELRS 900 Narrow" },
+    { MOD_LORA, 250.0f, 7, 0.0f, 0.0f, 0, 0, false, 60, "FrSky R9" },
+    { MOD_LORA, 250.0f, 8, 0.0f, 0.0f, 0, 0, false, 80, "FrSky R9" },
+    { MOD_FSK, 234.3f, 0, 100.0f, 50.0f, 0, 0, false, 40, "TBS Crossfire" },
+    { MOD_FSK, 156.2f, 0, 64.0f, 32.0f, 0, 0, false, 40, "RFD900/SiK" },
+    { MOD_FSK, 93.8f, 0, 38.4f, 20.0f, 0, 0, false, 50, "FSK Telemetry" },
+    { MOD_FSK, 46.9f, 0, 19.2f, 10.0f, 0, 0, false, 60, "FSK Telemetry" },
+    { MOD_OOK, 58.6f, 0, 4.8f, 0.0f, 0, 0, false, 80, "OOK Remote" },
+    { MOD_OOK, 58.6f, 0, 2.4f, 0.0f, 0, 0, false, 120, "OOK Remote" },
+};
+
+#define LOCK_CANDIDATES     (sizeof(candidates) / sizeof(candidates[0]))
+
+typedef struct {
+    bool active;
+    bool following;             // Demodulated: staying on the channel
+    bool implicitHeader;        // Radio left in implicit header/IQ settings
+    float frequency;            // Channel frequency (MHz)
+    ModulationType sweepModulation;     // Restored when the session ends
+    float sweepCaptureBitrate;
+    uint8_t order[LOCK_CANDIDATES];     // Candidates in search order
+    uint8_t orderCount;
+    uint8_t position;           // Current candidate in order
+    uint8_t tried;              // Candidates configured
+    int64_t startUs;            // Trigger time
+    int64_t searchEndUs;        // End of the search budget
+    int64_t maxEndUs;           // End of the away budget
+    int64_t windowEndUs;        // End of the current listen window
+    int64_t demodUs;            // First packet (0 if none)
+    int64_t lastEndUs;          // End of the previous session (cooldown)
+} LockSession;
+
+static LockSession sessions[MAX_SCANNERS];
+static bool enabled = LOCK_ON_ENABLED;
+
+// Candidate order scores and statistics (scanner tasks and main loop)
+static portMUX_TYPE lockStatsLock = portMUX_INITIALIZER_UNLOCKED;
+static uint16_t hitScore[LOCK_CANDIDATES];
+static uint16_t signatureScore[LOCK_SIGNATURES_MAX];
+static int8_t candidateSignature[LOCK_CANDIDATES];
+static bool signaturesResolved = false;
+static LockOnStats stats;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void resolveSignatures() {
+    if (signaturesResolved) {
+        return;
+    }
+    for (size_t i = 0; i < LOCK_CANDIDATES; i++) {
+        int index = findSignature(candidates[i].signature);
+        candidateSignature[i] = (int8_t)(index < LOCK_SIGNATURES_MAX ? index : -1);
+    }
+    signaturesResolved = true;
+}
+
+/**
+ * Halve every score once one saturates (lock held)
+ */
+static void decayScores(uint16_t score) {
+    if (score < LOCK_SCORE_MAX) {
+        return;
+    }
+    for (size_t i = 0; i < LOCK_CANDIDATES; i++) {
+        hitScore[i] /= 2;
+    }
+    for (int i = 0; i < LOCK_SIGNATURES_MAX; i++) {
+        signatureScore[i] /= 2;
+    }
+}
+
+static uint32_t candidateScore(size_t index) {
+    int signature = candidateSignature[index];
+    uint32_t score = (uint32_t)hitScore[index] * LOCK_HIT_WEIGHT;
+    if (signature >= 0) {
+        score += (uint32_t)signatureScore[signature] * LOCK_SIGNATURE_WEIGHT;
+    }
+    return score;
+}
+
+/**
+ * Build the search order: assigned modulations only, minus what the sweep
+ * already listens with, highest score first (stable, so ties keep the
+ * database order)
+ */
+static void buildOrder(const DroneScanner* scanner, LockSession* session) {
+    uint32_t scores[LOCK_CANDIDATES];
+    session->orderCount = 0;
+
+    portENTER_CRITICAL(&lockStatsLock);
+    for (size_t i = 0; i < LOCK_CANDIDATES; i++) {
+        scores[i] = candidateScore(i);
+    }
+    portEXIT_CRITICAL(&lockStatsLock);
+
+    for (size_t i = 0; i < LOCK_CANDIDATES; i++) {
+        const LockCandidate* candidate = &candidates[i];
+        if (!(scanner->modulationMask & MOD_MASK(candidate->modulation))) {
+            continue;
+        }
+        if (candidate->modulation == MOD_LORA && candidate->implicitLength == 0 &&
+            candidate->spreadingFactor == scanner->loraSpreadingFactor &&
+            fabsf(candidate->bandwidthKhz - scanner->loraBandwidth) < 1.0f) {
+            continue;
+        }
+        int position = session->orderCount++;
+        while (position > 0 && scores[session->order[position - 1]] < scores[i]) {
+            session->order[position] = session->order[position - 1];
+            position--;
+        }
+        session->order[position] = (uint8_t)i;
+    }
+}
+
+static int configureCandidate(DroneScanner* scanner, const LockCandidate* candidate,
+                              float frequency) {
+    int state;
+    switch (candidate->modulation) {
+        case MOD_FSK:
+            state = configureFSKCaptureModeWith(scanner->radio, frequency, candidate->bitrateKbps,
+                                                candidate->deviationKhz, candidate->bandwidthKhz);
+            break;
+        case MOD_OOK:
+            state = configureOOKCaptureMode(scanner->radio, frequency, candidate->bitrateKbps);
+            break;
+        case MOD_LORA:
+        default:
+            state = configureLoRaModeWith(scanner->radio, frequency, candidate->bandwidthKhz,
+                                          candidate->spreadingFactor);
+            if (state == RADIOLIB_ERR_NONE && candidate->implicitLength != 0) {
+                // The header carries neither length nor coding rate
+                state = scanner->radio->implicitHeader(candidate->implicitLength);
+                if (state == RADIOLIB_ERR_NONE) {
+                    state = scanner->radio->setCodingRate(candidate->codingRate);
+                }
+                if (state == RADIOLIB_ERR_NONE) {
+                    state = scanner->radio->setCRC(0);
+                }
+            }
+            if (state == RADIOLIB_ERR_NONE) {
+                state = scanner->radio->invertIQ(candidate->invertIq);
+            }
+            break;
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        // Packet events report the mode they were received in
+        scanner->modulation = candidate->modulation;
+        scanner->captureBitrate = candidate->bitrateKbps;
+    }
+    return state;
+}
+
+/**
+ * Configure the next candidate that fits the remaining budget
+ * @return true if one is listening
+ */
+static bool nextCandidate(DroneScanner* scanner, LockSession* session, int64_t nowUs) {
+    int64_t endUs = min(session->searchEndUs, session->maxEndUs);
+    for (; session->position < session->orderCount && nowUs < endUs; session->position++) {
+        const LockCandidate* candidate = &candidates[session->order[session->position]];
+        session->implicitHeader = session->implicitHeader || candidate->implicitLength != 0;
+        if (configureCandidate(scanner, candidate, session->frequency) == RADIOLIB_ERR_NONE) {
+            session->tried++;
+            session->windowEndUs = min(nowUs + (int64_t)candidate->windowMs * 1000, endUs);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void recordTiming(float* mean, uint32_t* worst, int64_t sampleUs) {
+    uint32_t value = (uint32_t)min(max(sampleUs, (int64_t)0), (int64_t)UINT32_MAX);
+    *mean += SCANNER_TIMING_EWMA * ((float)value - *mean);
+    *worst = max(*worst, value);
+}
+
+static void printParameters(const LockCandidate* candidate) {
+    if (candidate->modulation == MOD_LORA) {
+        Serial.print(F("LoRa SF"));
+        Serial.print(candidate->spreadingFactor);
+        Serial.print(F(" BW"));
+        Serial.print(candidate->bandwidthKhz, 0);
+        if (candidate->implicitLength != 0) {
+            Serial.print(F(" implicit "));
+            Serial.print(candidate->implicitLength);
+        }
+        if (candidate->invertIq) {
+            Serial.print(F(" IQ inv"));
+        }
+    } else {
+        Serial.print(getModulationName(candidate->modulation));
+        Serial.print(' ');
+        Serial.print(candidate->bitrateKbps, 1);
+        Serial.print(F(" kbps"));
+        if (candidate->deviationKhz > 0.0f) {
+            Serial.print(F(" dev "));
+            Serial.print(candidate->deviationKhz, 1);
+        }
+    }
+}
+
+/**
+ * Close a session and restore the sweep modulation
+ */
+static void endSession(DroneScanner* scanner, LockSession* session, int64_t nowUs) {
+    if (session->implicitHeader && scanner->modulation == MOD_LORA) {
+        // The sweep's retune keeps the packet settings of the last candidate
+        scanner->radio->explicitHeader();
+        scanner->radio->setCodingRate(LORA_CODING_RATE);
+        scanner->radio->setCRC(2);
+        scanner->radio->invertIQ(false);
+    }
+    scanner->modulation = session->sweepModulation;
+    scanner->captureBitrate = session->sweepCaptureBitrate;
+    session->active = false;
+    session->lastEndUs = nowUs;
+
+    int64_t awayUs = nowUs - session->startUs;
+    int64_t demodAfterUs = session->demodUs != 0 ? session->demodUs - session->startUs : -1;
+    portENTER_CRITICAL(&lockStatsLock);
+    recordTiming(&stats.awayMeanUs, &stats.awayMaxUs, awayUs);
+    stats.awayTotalMs += (uint32_t)(awayUs / 1000);
+    if (demodAfterUs >= 0) {
+        stats.demodulated++;
+        recordTiming(&stats.timeToDemodMeanUs, &stats.timeToDemodMaxUs, demodAfterUs);
+    }
+    portEXIT_CRITICAL(&lockStatsLock);
+
+    // LOCK,<scanner>,<MHz>,<result>,<parameters>,<tried>,<demod us>,<away us>
+    Serial.print(F("LOCK,"));
+    Serial.print(scanner->index);
+    Serial.print(',');
+    Serial.print(session->frequency, 3);
+    Serial.print(',');
+    Serial.print(demodAfterUs >= 0 ? F("demod") : F("none"));
+    Serial.print(',');
+    if (demodAfterUs >= 0) {
+        printParameters(&candidates[session->order[session->position]]);
+    }
+    Serial.print(',');
+    Serial.print(session->tried);
+    Serial.print(',');
+    if (demodAfterUs >= 0) {
+        Serial.print((uint32_t)demodAfterUs);
+    }
+    Serial.print(',');
+    Serial.println((uint32_t)awayUs);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void lockOnEnable(bool enable) {
+    enabled = enable;
+}
+
+bool lockOnEnabled() {
+    return enabled;
+}
+
+bool lockOnEnergyTrigger(const DroneScanner* scanner, float rssi) {
+    // Wait for a first full sweep, so the noise floors mean something
+    if (!enabled || scanner == NULL || scanner->index >= MAX_SCANNERS ||
+        !scanner->sweepComplete || sessions[scanner->index].active) {
+        return false;
+    }
+    const LockSession* session = &sessions[scanner->index];
+    if (session->lastEndUs != 0 &&
+        esp_timer_get_time() - session->lastEndUs < (int64_t)LOCK_COOLDOWN_MS * 1000) {
+        return false;
+    }
+    int channel = frequencyToSweepChannel(scanner->sweepFrequency);
+    return channel >= 0 &&
+           rssi > noiseFloorThreshold(channel, scanner->modulation) + LOCK_TRIGGER_MARGIN_DB;
+}
+
+bool lockOnStart(DroneScanner* scanner, int64_t triggerUs) {
+    if (!enabled || lowPowerEnabled() || scanner == NULL || !scanner->initialized ||
+        scanner->index >= MAX_SCANNERS) {
+        return false;
+    }
+    LockSession* session = &sessions[scanner->index];
+    if (session->active || (session->lastEndUs != 0 &&
+                            triggerUs - session->lastEndUs < (int64_t)LOCK_COOLDOWN_MS * 1000)) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&lockStatsLock);
+    resolveSignatures();
+    portEXIT_CRITICAL(&lockStatsLock);
+    buildOrder(scanner, session);
+    if (session->orderCount == 0) {
+        return false;
+    }
+
+    session->following = false;
+    session->implicitHeader = false;
+    session->frequency = scanner->sweepFrequency;
+    session->sweepModulation = scanner->modulation;
+    session->sweepCaptureBitrate = scanner->captureBitrate;
+    session->position = 0;
+    session->tried = 0;
+    session->startUs = triggerUs;
+    session->searchEndUs = triggerUs + (int64_t)LOCK_SEARCH_MS * 1000;
+    session->maxEndUs = triggerUs + (int64_t)LOCK_MAX_AWAY_MS * 1000;
+    session->demodUs = 0;
+    session->active = true;
+
+    portENTER_CRITICAL(&lockStatsLock);
+    stats.sessions++;
+    portEXIT_CRITICAL(&lockStatsLock);
+
+    if (!nextCandidate(scanner, session, esp_timer_get_time())) {
+        // No candidate configured: the first step ends the session and the
+        // sweep retunes the radio
+        session->windowEndUs = esp_timer_get_time();
+    }
+    return true;
+}
+
+bool lockOnActive(uint8_t index) {
+    return index < MAX_SCANNERS && sessions[index].active;
+}
+
+uint32_t lockOnWindowUs(uint8_t index, int64_t nowUs) {
+    if (index >= MAX_SCANNERS) {
+        return 1000;
+    }
+    int64_t remainingUs = sessions[index].windowEndUs - nowUs;
+    return (uint32_t)constrain(remainingUs, (int64_t)1000, (int64_t)LOCK_MAX_AWAY_MS * 1000);
+}
+
+void lockOnPacket(DroneScanner* scanner, int64_t irqUs) {
+    if (scanner == NULL || !lockOnActive(scanner->index)) {
+        return;
+    }
+    LockSession* session = &sessions[scanner->index];
+
+    portENTER_CRITICAL(&lockStatsLock);
+    stats.packets++;
+    if (session->demodUs == 0 && session->position < session->orderCount) {
+        size_t candidate = session->order[session->position];
+        hitScore[candidate]++;
+        decayScores(hitScore[candidate]);
+    }
+    portEXIT_CRITICAL(&lockStatsLock);
+
+    if (session->demodUs == 0) {
+        session->demodUs = irqUs;
+        session->following = true;
+    }
+    session->windowEndUs = min(irqUs + (int64_t)LOCK_FOLLOW_MS * 1000, session->maxEndUs);
+}
+
+void lockOnAnnotate(uint8_t index, ScanEvent* event) {
+    if (event == NULL || !lockOnActive(index)) {
+        return;
+    }
+    const LockSession* session = &sessions[index];
+    if (session->position >= session->orderCount) {
+        return;
+    }
+    const LockCandidate* candidate = &candidates[session->order[session->position]];
+    if (candidate->modulation == MOD_LORA) {
+        event->bandwidthKhz = candidate->bandwidthKhz;
+        event->spreadingFactor = candidate->spreadingFactor;
+    }
+}
+
+bool lockOnStep(DroneScanner* scanner, int64_t nowUs) {
+    if (scanner == NULL || !lockOnActive(scanner->index)) {
+        return false;
+    }
+    LockSession* session = &sessions[scanner->index];
+
+    // Early wake-up (stale timer notification), or a packet since the
+    // window was armed moved its end
+    if (nowUs + 1000 < session->windowEndUs) {
+        return true;
+    }
+    if (!session->following) {
+        session->position++;
+        if (nextCandidate(scanner, session, nowUs)) {
+            return true;
+        }
+    }
+    endSession(scanner, session, nowUs);
+    return false;
+}
+
+void lockOnNoteSignature(int signatureIndex) {
+    if (signatureIndex < 0 || signatureIndex >= LOCK_SIGNATURES_MAX) {
+        return;
+    }
+    portENTER_CRITICAL(&lockStatsLock);
+    signatureScore[signatureIndex]++;
+    decayScores(signatureScore[signatureIndex]);
+    portEXIT_CRITICAL(&lockStatsLock);
+}
+
+void lockOnGetStats(LockOnStats* out) {
+    if (out == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&lockStatsLock);
+    *out = stats;
+    portEXIT_CRITICAL(&lockStatsLock);
+}
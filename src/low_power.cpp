@@ -0,0 +1,355 @@
+/**
+ * Low Power Module Implementation
+ *
+ * Light sleep is entered explicitly from the main loop, not through
+ * automatic (tickless idle) light sleep. This keeps the wakeup sources and
+ * the handling of a DIO1 edge during sleep under our control: the GPIO
+ * edge interrupt does not latch while the peripheral clock is gated, so
+ * scanners whose DIO1 is high on wakeup are notified directly.
+ */
+
+#include "low_power.h"
+#include "scanner_task.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+// Sleep between RX windows as a multiple of the window, per setting
+static const uint8_t sleepRatios[LOW_POWER_SETTINGS] = { 0, 1, 2, 4, 8, 16 };
+
+static bool enabled = LOW_POWER_ENABLED;
+static uint8_t setting = LOW_POWER_SETTING;
+
+static int wakePins[MAX_SCANNERS] = { -1, -1, -1, -1 };
+static uint8_t radioCount = 1;
+static const DroneScanner* modelScanner = NULL;
+
+static LowPowerStats stats;
+static int64_t lastReportUs = 0;
+static uint64_t lastReportAsleepUs = 0;
+
+// ============================================================================
+// Power Model
+// ============================================================================
+
+/**
+ * Dwell of the modelled scanner (us)
+ */
+static float modelDwellUs() {
+    return (modelScanner != NULL ? modelScanner->dwellMs : SWEEP_DWELL_MS) * 1000.0f;
+}
+
+static void computeWindow(uint8_t index, const DroneScanner* scanner, ModulationType modulation,
+                          float bitrateKbps, LowPowerWindow* window) {
+    if (modulation == MOD_LORA) {
+        uint8_t sf = scanner != NULL ? scanner->loraSpreadingFactor : LORA_SPREADING_FACTOR;
+        float bandwidth = scanner != NULL ? scanner->loraBandwidth : LORA_BANDWIDTH;
+        float symbolUs = (float)(1UL << sf) * 1000.0f / bandwidth;
+        // Preamble plus sync word and the 4.25 symbol start frame delimiter
+        window->preambleUs = (LOW_POWER_LORA_PREAMBLE + 4.25f) * symbolUs;
+        window->detectUs = LOW_POWER_LORA_DETECT_SYMBOLS * symbolUs;
+    } else {
+        if (bitrateKbps <= 0.0f) {
+            bitrateKbps = (modulation == MOD_OOK) ? OOK_BITRATE : FSK_BITRATE;
+        }
+        float bitUs = 1000.0f / bitrateKbps;
+        window->preambleUs = FSK_PREAMBLE_LEN * bitUs;
+        window->detectUs = LOW_POWER_FSK_DETECT_BITS * bitUs;
+    }
+
+    // Two detection times, so a preamble starting mid-window is still caught
+    window->rxUs = (uint32_t)ceilf(2.0f * window->detectUs);
+    window->sleepUs = sleepRatios[index] * window->rxUs;
+
+    // Sleeping for less than the radio takes to wake up saves nothing
+    if (window->sleepUs <= LOW_POWER_RADIO_WAKE_US) {
+        window->sleepUs = 0;
+    }
+}
+
+/**
+ * Fraction of time the radio is powered (RX or waking). Every retune
+ * restarts the duty cycle with an RX window, so windows repeat per dwell.
+ */
+static float radioOnFraction(const LowPowerWindow* window) {
+    if (window->sleepUs == 0) {
+        return 1.0f;
+    }
+    const float dwellUs = modelDwellUs();
+    float period = (float)(window->rxUs + window->sleepUs);
+    float on = 0.0f;
+    for (float start = 0.0f; start < dwellUs; start += period) {
+        on += min((float)window->rxUs, dwellUs - start) + (start > 0.0f ? LOW_POWER_RADIO_WAKE_US : 0);
+    }
+    return min(1.0f, on / dwellUs);
+}
+
+/**
+ * Probability that one packet's preamble is detected: the share of
+ * preamble start times for which some RX window overlaps the preamble by
+ * the detection time. Windows of the neighbouring dwells count too, as a
+ * preamble can span a retune.
+ */
+static float packetProbability(const LowPowerWindow* window) {
+    if (window->preambleUs < window->detectUs) {
+        return 0.0f;
+    }
+    const float dwellUs = modelDwellUs();
+    float period = window->sleepUs > 0 ? (float)(window->rxUs + window->sleepUs) : dwellUs;
+    float rx = window->sleepUs > 0 ? (float)window->rxUs : dwellUs;
+
+    // Caught start times form one interval per window, in increasing
+    // order, so overlaps merge in a single pass
+    float caught = 0.0f;
+    float covered = 0.0f;
+    for (int dwell = -1; dwell <= 1; dwell++) {
+        for (float start = 0.0f; start < dwellUs; start += period) {
+            float windowStart = dwell * dwellUs + start;
+            float lo = max(windowStart - window->preambleUs + window->detectUs, covered);
+            float hi = min(windowStart + min(rx, dwellUs - start) - window->detectUs, dwellUs);
+            if (hi > lo) {
+                caught += hi - lo;
+                covered = hi;
+            }
+        }
+    }
+    return min(caught / dwellUs, 1.0f);
+}
+
+/**
+ * Probability that a dwell on the emitter's channel detects it
+ */
+static float dwellProbability(float packetP) {
+    float packets = modelDwellUs() / 1000.0f / LOW_POWER_TARGET_INTERVAL_MS;
+    if (packets < 1.0f) {
+        // At most one packet falls into the dwell
+        return packets * packetP;
+    }
+    return 1.0f - powf(1.0f - packetP, packets);
+}
+
+/**
+ * Radio current of one radio under a setting (mA), averaged over the
+ * modulations it cycles through
+ */
+static float radioCurrent(uint8_t index, uint8_t modulationMask) {
+    float sum = 0.0f;
+    int count = 0;
+    for (int m = MOD_LORA; m < MOD_UNKNOWN; m++) {
+        if (!(modulationMask & MOD_MASK(m))) {
+            continue;
+        }
+        LowPowerWindow window;
+        computeWindow(index, modelScanner, (ModulationType)m, 0.0f, &window);
+        float on = radioOnFraction(&window);
+        if (window.sleepUs > 0) {
+            // One continuous noise sample per dwell
+            on = min(1.0f, on + (float)LOW_POWER_NOISE_SETTLE_US / modelDwellUs());
+        }
+        sum += on * LOW_POWER_RX_MA + (1.0f - on) * LOW_POWER_RADIO_SLEEP_MA;
+        count++;
+    }
+    return count > 0 ? sum / count : LOW_POWER_RX_MA;
+}
+
+/**
+ * Total board current (mA) with the given CPU awake fraction
+ */
+static float systemCurrent(float radioMa, float cpuAwake) {
+    return radioMa * radioCount + cpuAwake * LOW_POWER_CPU_ACTIVE_MA +
+           (1.0f - cpuAwake) * LOW_POWER_CPU_SLEEP_MA + LOW_POWER_BOARD_MA;
+}
+
+static float cpuAwakeFraction() {
+    return stats.sleeps > 0 ? 1.0f - stats.cpuAsleep : LOW_POWER_CPU_AWAKE_EST;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void lowPowerInit(const DroneScanner* scanner, uint8_t radios) {
+    memset(&stats, 0, sizeof(stats));
+    lastReportUs = esp_timer_get_time();
+    lastReportAsleepUs = 0;
+    modelScanner = scanner;
+    radioCount = max(radios, (uint8_t)1);
+    if (scanner == NULL) {
+        return;
+    }
+
+    uint16_t channels = (scanner->lastChannel - scanner->firstChannel) / scanner->channelStride + 1;
+    int modulations = 0;
+    for (int m = MOD_LORA; m < MOD_UNKNOWN; m++) {
+        modulations += (scanner->modulationMask & MOD_MASK(m)) ? 1 : 0;
+    }
+    float revisitS = channels * modelDwellUs() / 1000000.0f;
+
+    float baseline = systemCurrent(LOW_POWER_RX_MA, 1.0f);
+    Serial.print(F("[LowPower] Mode "));
+    Serial.print(enabled ? F("on, setting ") : F("off, would use setting "));
+    Serial.print(setting);
+    Serial.print(F("; continuous scanning draws "));
+    Serial.print(baseline, 1);
+    Serial.print(F(" mA ("));
+    Serial.print(LOW_POWER_BATTERY_MAH / baseline, 1);
+    Serial.println(F(" h)"));
+
+    // DUTY,<setting>,<modulation>,<rx us>,<sleep us>,<radio on %>,<P packet>,
+    // <P dwell>,<mean latency s>,<current mA>,<battery h>
+    for (uint8_t s = 0; s < LOW_POWER_SETTINGS; s++) {
+        float current = systemCurrent(radioCurrent(s, scanner->modulationMask), cpuAwakeFraction());
+        for (int m = MOD_LORA; m < MOD_UNKNOWN; m++) {
+            if (!(scanner->modulationMask & MOD_MASK(m))) {
+                continue;
+            }
+            LowPowerWindow window;
+            computeWindow(s, scanner, (ModulationType)m, 0.0f, &window);
+            float packetP = packetProbability(&window);
+            float dwellP = dwellProbability(packetP);
+
+            Serial.print(F("DUTY,"));
+            Serial.print(s);
+            Serial.print(',');
+            Serial.print(getModulationName((ModulationType)m));
+            Serial.print(',');
+            Serial.print(window.rxUs);
+            Serial.print(',');
+            Serial.print(window.sleepUs);
+            Serial.print(',');
+            Serial.print(radioOnFraction(&window) * 100.0f, 1);
+            Serial.print(',');
+            Serial.print(packetP, 3);
+            Serial.print(',');
+            Serial.print(dwellP, 3);
+            Serial.print(',');
+            if (dwellP > 0.0f) {
+                Serial.print(modulations * revisitS * (1.0f / dwellP - 0.5f), 1);
+            } else {
+                Serial.print(F("inf"));
+            }
+            Serial.print(',');
+            Serial.print(current, 1);
+            Serial.print(',');
+            Serial.println(LOW_POWER_BATTERY_MAH / current, 1);
+        }
+    }
+}
+
+bool lowPowerEnabled() {
+    return enabled;
+}
+
+bool lowPowerGetWindow(const DroneScanner* scanner, LowPowerWindow* window) {
+    if (scanner == NULL || window == NULL) {
+        return false;
+    }
+    computeWindow(setting, scanner, scanner->modulation, scannerCaptureBitrate(scanner), window);
+    return enabled && window->sleepUs > 0;
+}
+
+void lowPowerAddWakePin(uint8_t scanner, int pin) {
+    if (scanner < MAX_SCANNERS) {
+        wakePins[scanner] = pin;
+    }
+}
+
+bool lowPowerSleep(uint32_t maxUs) {
+    if (!enabled || !scannerTasksIdle()) {
+        return false;
+    }
+
+    // A pending radio interrupt is serviced first
+    for (int i = 0; i < MAX_SCANNERS; i++) {
+        if (wakePins[i] >= 0 && digitalRead(wakePins[i]) == HIGH) {
+            return false;
+        }
+    }
+
+    int64_t now = esp_timer_get_time();
+    int64_t sleepUs = maxUs;
+    int64_t nextAlarm = esp_timer_get_next_alarm();
+    if (nextAlarm > now) {
+        sleepUs = min(sleepUs, nextAlarm - now - LOW_POWER_WAKE_MARGIN_US);
+    }
+    if (sleepUs < LOW_POWER_MIN_SLEEP_US) {
+        return false;
+    }
+
+    // Level wakeup replaces the edge interrupt type while asleep; keep the
+    // interrupt itself masked so the level cannot retrigger it
+    for (int i = 0; i < MAX_SCANNERS; i++) {
+        if (wakePins[i] >= 0) {
+            gpio_intr_disable((gpio_num_t)wakePins[i]);
+            gpio_wakeup_enable((gpio_num_t)wakePins[i], GPIO_INTR_HIGH_LEVEL);
+        }
+    }
+    esp_sleep_enable_gpio_wakeup();
+    esp_sleep_enable_timer_wakeup((uint64_t)sleepUs);
+
+    esp_light_sleep_start();
+
+    int64_t woke = esp_timer_get_time();
+    bool radioWake = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO;
+    for (int i = 0; i < MAX_SCANNERS; i++) {
+        if (wakePins[i] < 0) {
+            continue;
+        }
+        gpio_wakeup_disable((gpio_num_t)wakePins[i]);
+        gpio_set_intr_type((gpio_num_t)wakePins[i], GPIO_INTR_POSEDGE);
+        gpio_intr_enable((gpio_num_t)wakePins[i]);
+        // The edge arrived while the GPIO clock was gated
+        if (digitalRead(wakePins[i]) == HIGH) {
+            scannerTaskKick((uint8_t)i, now);
+        }
+    }
+
+    stats.sleeps++;
+    stats.asleepUs += (uint64_t)(woke - now);
+    if (radioWake) {
+        stats.radioWakeups++;
+    } else {
+        stats.timerWakeups++;
+    }
+    return true;
+}
+
+void lowPowerReport() {
+    if (!enabled) {
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+    if (now > lastReportUs) {
+        stats.cpuAsleep = (float)(stats.asleepUs - lastReportAsleepUs) / (float)(now - lastReportUs);
+    }
+    lastReportUs = now;
+    lastReportAsleepUs = stats.asleepUs;
+
+    uint8_t mask = modelScanner != NULL ? modelScanner->modulationMask : MOD_MASK_ALL;
+    float current = systemCurrent(radioCurrent(setting, mask), cpuAwakeFraction());
+
+    Serial.print(F("[LowPower] CPU asleep "));
+    Serial.print(stats.cpuAsleep * 100.0f, 1);
+    Serial.print(F("%, "));
+    Serial.print(stats.sleeps);
+    Serial.print(F(" sleeps ("));
+    Serial.print(stats.timerWakeups);
+    Serial.print(F(" timer, "));
+    Serial.print(stats.radioWakeups);
+    Serial.print(F(" radio), est. "));
+    Serial.print(current, 1);
+    Serial.print(F(" mA, "));
+    Serial.print(LOW_POWER_BATTERY_MAH / current, 1);
+    Serial.println(F(" h"));
+}
+
+void lowPowerGetStats(LowPowerStats* out) {
+    if (out != NULL) {
+        *out = stats;
+    }
+}
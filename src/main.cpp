@@ -17,204 +17,492 @@
 #include <RadioLib.h>
 #include "display.h"
 #include "drone_detection.h"
+#include "detection_log.h"
+#include "noise_floor.h"
+#include "emitter_track.h"
+#include "scanner_task.h"
+#include "mesh_report.h"
+#include "gps.h"
+#include "localizer.h"
+#include "timebase.h"
+#include "boot.h"
+#include "low_power.h"
+#include "scan_config.h"
+#include "console.h"
+#include "arena.h"
+#include "coverage.h"
+#include "pcap_export.h"
+#include "occupancy.h"
+#include "alert.h"
+#include "sketch.h"
+#include "lock_on.h"
+#include "spectrum_report.h"
+#include "change_detect.h"
 
 // SX1262 radio module configuration
 // Pin definitions from platformio.ini build flags
 SX1262 radio = new Module(RADIO_CS, RADIO_DIO1, RADIO_RST, RADIO_BUSY);
 
-// Default scanning frequency (MHz) - Start at 900MHz band minimum for sweep
-float currentScanFrequency = FREQ_900_MIN;
-
-// Detection state
-volatile bool receivedFlag = false;
+// Optional second SX1262 on the same SPI bus (define RADIO2_* build flags).
+// The band is split between the radios so each sweeps half the channels.
+#if defined(RADIO2_CS)
+SX1262 radio2 = new Module(RADIO2_CS, RADIO2_DIO1, RADIO2_RST, RADIO2_BUSY);
+DroneScanner scanner2;
+#endif
 
 // Timing for display updates
 unsigned long lastDisplayUpdate = 0;
 const unsigned long DISPLAY_UPDATE_INTERVAL = 3000; // 3 seconds
 
-// Timing for modulation switching
-unsigned long lastModulationSwitch = 0;
-const unsigned long MODULATION_SWITCH_INTERVAL = 10000; // 10 seconds per modulation
+// Longest the loop sleeps waiting for scanner events
+const unsigned long LOOP_SERVICE_MS = 50;
 
-// Timing for frequency sweep (for FHSS detection)
-unsigned long lastFrequencySweep = 0;
-const unsigned long FREQUENCY_SWEEP_INTERVAL = SWEEP_DWELL_MS; // Dwell time per channel
+// Timing for scanner latency/jitter reports
+unsigned long lastTimingReport = 0;
+const unsigned long TIMING_REPORT_INTERVAL = 60000; // 1 minute
 
-// ISR callback for radio receive
-#if defined(ESP32) || defined(ESP8266)
-ICACHE_RAM_ATTR
-#endif
-void receiveCallback() {
-    receivedFlag = true;
+// Initialisation deferred until the radios are receiving, one step per loop pass
+typedef enum {
+    DEFERRED_DISPLAY,
+    DEFERRED_LOG,
+    DEFERRED_GPS,
+    DEFERRED_DONE
+} DeferredStep;
+
+DeferredStep deferredStep = DEFERRED_DISPLAY;
+bool displayReady = false;
+bool scanningStarted = false;
+
+/**
+ * Verdict on one packet of the event batch
+ */
+typedef struct {
+    bool report;                // A mesh report frame: forwarded, not analyzed
+    bool isDrone;
+    DroneSignal signal;
+} PacketVerdict;
+
+// Events drained in one loop pass (static: touched for every packet)
+ScanEvent eventBatch[SCAN_EVENT_QUEUE_DEPTH];
+PacketVerdict verdicts[SCAN_EVENT_QUEUE_DEPTH];
+
+/**
+ * Packet bytes of an event as the analysis takes them
+ */
+void captureOf(const ScanEvent* event, PacketCapture* capture) {
+    // Raw FSK/OOK captures carry bytes for protocol fingerprinting
+    capture->data = event->data;
+    capture->length = event->length;
+    capture->isRawCapture = (event->bitrateKbps > 0.0f);
+    capture->bitrateKbps = event->bitrateKbps;
+    capture->timestampUs = event->timestampUs;
+    capture->utcUs = event->utcUs;
+}
+
+/**
+ * Analyze one packet and switch the alert outputs (first pass over the
+ * batch: nothing is printed or drawn)
+ */
+void assessPacket(const ScanEvent* event, PacketVerdict* verdict) {
+    // Reports from other detector nodes are forwarded, not analyzed
+    verdict->report = (event->modulation == MOD_LORA &&
+                       meshReportReceive(event->data, event->length));
+    if (verdict->report) {
+        return;
+    }
+    
+    PacketCapture capture;
+    captureOf(event, &capture);
+    verdict->isDrone = analyzeDroneSignalAt(event->frequency, event->rssi, event->snr,
+                                            event->freqError, event->modulation,
+                                            &capture, &verdict->signal);
+    alertObserve(&verdict->signal, trackKeyForSignal(&verdict->signal), verdict->isDrone,
+                 event->timestampUs);
+}
+
+/**
+ * Log and print one analyzed packet (second pass over the batch)
+ */
+void handlePacket(const ScanEvent* event, const PacketVerdict* verdict) {
+    // Every received packet goes to an active capture, reports included
+    pcapExportPacket(event, noiseFloorGet(frequencyToSweepChannel(event->frequency),
+                                          event->modulation));
+    if (verdict->report) {
+        return;
+    }
+    
+    // Busy channels are revisited first after a reboot
+    bootNotePacket(frequencyToSweepChannel(event->frequency));
+    occupancyNote(frequencyToSweepChannel(event->frequency), event->rssi, true);
+    spectrumReportNote(event->scanner, frequencyToSweepChannel(event->frequency), event->rssi, true);
+    changeDetectNote(frequencyToSweepChannel(event->frequency),
+                     event->rssi - noiseFloorGet(frequencyToSweepChannel(event->frequency),
+                                                 event->modulation), true);
+    consoleNotePacket(event);
+    
+    const DroneSignal* droneSignal = &verdict->signal;
+    bool isDrone = verdict->isDrone;
+    PacketCapture capture;
+    captureOf(event, &capture);
+    printDroneAnalysis(droneSignal, &capture);
+    
+    // Protocols on the air order the lock-on parameter search
+    if (isDrone && droneSignal->signatureIndex >= 0) {
+        lockOnNoteSignature(droneSignal->signatureIndex);
+        changeDetectNoteSignature(frequencyToSweepChannel(event->frequency));
+    }
+    
+    // Distinct transmitter, payload and header counts in fixed memory
+    sketchNotePacket(networkKeyForSignal(droneSignal), event->modulation,
+                     event->data, event->length);
+    
+    // Persist detection (queued, written by the log task)
+    detectionLogAppendDetection(droneSignal);
+    
+    // Geotagged RSSI of drone emitters feeds their position estimate
+    GpsFix fix;
+    if (isDrone && gpsGetFix(&fix)) {
+        localizerObserve(trackKeyForSignal(droneSignal), event->rssi, &fix);
+    }
+    
+    // Signal detected - log to Serial
+    Serial.println(F("--- RF Signal Detected ---"));
+    Serial.print(F("Scanner: "));
+    Serial.println(event->scanner);
+    Serial.print(F("Modulation: "));
+    Serial.println(getModulationName(event->modulation));
+    Serial.print(F("RSSI: "));
+    Serial.print(event->rssi);
+    Serial.println(F(" dBm"));
+    Serial.print(F("SNR: "));
+    Serial.print(event->snr);
+    Serial.println(F(" dB"));
+    Serial.print(F("Frequency error: "));
+    Serial.print(event->freqError);
+    Serial.println(F(" Hz"));
+    Serial.print(F("Drone detected: "));
+    Serial.println(isDrone ? "YES" : "No");
+    if (isDrone) {
+        Serial.print(F("Drone type: "));
+        Serial.println(droneSignal->droneType);
+        Serial.print(F("Confidence: "));
+        Serial.print(droneSignal->confidence);
+        Serial.println(F("%"));
+    }
+    Serial.println(F("--------------------------"));
+}
+
+/**
+ * Show a packet on the TFT display with its detection info
+ */
+void displayPacket(const ScanEvent* event, const PacketVerdict* verdict) {
+    if (!displayReady) {
+        return;
+    }
+    displayDroneDetection(event->rssi, event->snr, event->freqError,
+                          getModulationName(event->modulation),
+                          verdict->isDrone ? verdict->signal.droneType : NULL,
+                          verdict->signal.confidence);
+    lastDisplayUpdate = millis();
+}
+
+/**
+ * Dispatch one event from the merged scanner stream
+ */
+void handleEvent(const ScanEvent* event, const PacketVerdict* verdict) {
+    if (event->type == SCAN_EVENT_PACKET) {
+        handlePacket(event, verdict);
+    } else if (event->type == SCAN_EVENT_SWEEP) {
+        // The scanner's spectrum row is complete
+        spectrumReportSweepEnd(event->scanner, event->modulation, event->firstChannel,
+                               event->lastChannel);
+        changeDetectSweepEnd(event->firstChannel, event->lastChannel);
+    } else {
+        // Background sample for the noise floor; energy above the detection
+        // threshold marks the channel busy in the occupancy history
+        int channel = frequencyToSweepChannel(event->frequency);
+        bool busy = event->rssi > noiseFloorThreshold(channel, event->modulation);
+        occupancyNote(channel, event->rssi, busy);
+        spectrumReportNote(event->scanner, channel, event->rssi, busy);
+        changeDetectNote(channel, event->rssi - noiseFloorGet(channel, event->modulation), busy);
+        noiseFloorUpdate(channel, event->modulation, event->rssi);
+    }
+}
+
+/**
+ * Print interrupt service latency and dwell timing jitter of each scanner
+ */
+void reportScannerTiming() {
+    for (uint8_t i = 0; i < MAX_SCANNERS; i++) {
+        ScannerTaskStats stats;
+        scannerTaskGetStats(i, &stats);
+        if (stats.dwells == 0) {
+            continue;
+        }
+        Serial.print(F("[Scanner] Scanner "));
+        Serial.print(i);
+        Serial.print(F(": ISR latency mean "));
+        Serial.print(stats.latencyMeanUs, 0);
+        Serial.print(F(" us, max "));
+        Serial.print(stats.latencyMaxUs);
+        Serial.print(F(" us; dwell jitter mean "));
+        Serial.print(stats.dwellJitterMeanUs, 0);
+        Serial.print(F(" us, max "));
+        Serial.print(stats.dwellJitterMaxUs);
+        Serial.println(F(" us"));
+    }
+}
+
+/**
+ * Bring up the next deferred peripheral
+ */
+void serviceDeferredInit() {
+    switch (deferredStep) {
+        case DEFERRED_DISPLAY:
+            Serial.print(F("[Display] Initializing TFT ... "));
+            displayInit();
+            displayReady = true;
+            Serial.println(F("success!"));
+            if (scanningStarted) {
+                displayScanningWithModulation(getCurrentSweepFrequency(),
+                                              getModulationName(getCurrentModulation()));
+            } else {
+                displayError("Receive mode failed!");
+            }
+            lastDisplayUpdate = millis();
+            bootMark(BOOT_PHASE_DISPLAY);
+            break;
+        case DEFERRED_LOG:
+            // Mount the on-flash detection log (non-fatal if the partition is missing)
+            detectionLogInit();
+            bootMark(BOOT_PHASE_LOG);
+            break;
+        case DEFERRED_GPS:
+            // Node position for geotagging and emitter localisation
+            gpsInit();
+            bootMark(BOOT_PHASE_GPS);
+            bootMark(BOOT_PHASE_READY);
+            bootReport();
+            // Everything long-lived now exists: arm the heap guard
+            arenaSeal();
+            break;
+        default:
+            return;
+    }
+    deferredStep = (DeferredStep)(deferredStep + 1);
 }
 
 void setup() {
-    // Initialize serial communication
+    // Never block on the USB host: on battery there is none
     Serial.begin(115200);
-    while (!Serial) {
+#if ARDUINO_USB_CDC_ON_BOOT
+    Serial.setTxTimeoutMs(0);
+#endif
+#if BOOT_SERIAL_WAIT_MS > 0
+    unsigned long serialWaitStart = millis();
+    while (!Serial && millis() - serialWaitStart < BOOT_SERIAL_WAIT_MS) {
         delay(10);
     }
+#endif
+    
+    // Reserve the arenas before anything else allocates
+    arenaInit();
+    
+    // Alert outputs off from the start
+    alertInit();
     
     Serial.println(F("=============================="));
     Serial.println(F("Drone Detector - T-Beam Supreme"));
     Serial.println(F("900MHz Multi-Modulation Scanner"));
     Serial.println(F("=============================="));
     
-    // Initialize TFT display
-    Serial.print(F("[Display] Initializing TFT ... "));
-    displayInit();
-    displaySplash();
-    Serial.println(F("success!"));
-    delay(2000);  // Show splash screen
-    
-    // Initialize drone detection module with SX1262 radio
+    // Radio first: the node listens before the display, log and GPS are up
     Serial.print(F("[DroneDetect] Initializing 900MHz detection ... "));
-    displayStatus("Initializing radio...");
     
     // Initialize drone detection (starts in LoRa mode at band start)
     if (droneDetectionInit(&radio)) {
         Serial.println(F("success!"));
-        Serial.print(F("[DroneDetect] Starting sweep scan from "));
-        Serial.print(FREQ_900_MIN);
-        Serial.print(F(" to "));
-        Serial.print(FREQ_900_MAX);
-        Serial.println(F(" MHz"));
-        currentScanFrequency = getCurrentSweepFrequency();
     } else {
         Serial.println(F("failed!"));
+        displayInit();
         displayError("Radio init failed!");
         while (true) {
             delay(1000);
         }
     }
+    bootMark(BOOT_PHASE_RADIO);
+    
+    // Band plan, dwell, modulations and thresholds set from the console
+    scanConfigInit();
     
-    // Set receive callback
-    radio.setDio1Action(receiveCallback);
+    // Resume the sweep where the previous run left off
+    bootRestore();
     
-    // Start receiving
+    // Node identity and time slot for detection reports
+    meshReportInit();
+    
+    // Discipline packet timestamps to GPS PPS
+    timebaseInit();
+    
+    // Listen, retune and blind time per channel and modulation
+    coverageInit();
+    
+    // Start one scanning task per radio; results merge into one event stream.
+    // Scanner tasks outrank loop(), so each is receiving once started.
     Serial.println(F("[DroneDetect] Starting continuous receive mode..."));
-    int state = radio.startReceive();
+    bool started;
+    uint8_t radios = 1;
+    DroneScanner* scanners[MAX_SCANNERS] = { getDefaultScanner() };
+    lowPowerAddWakePin(0, RADIO_DIO1);
+#if defined(RADIO2_CS)
+    // Both radios share the SPI bus: the band plan is split between them
+    // and a bus lock arbitrates access
+    if (scannerInit(&scanner2, &radio2, 1, 0, (uint16_t)NUM_SWEEP_CHANNELS - 1, MOD_MASK_ALL)) {
+        scanners[radios++] = &scanner2;
+        lowPowerAddWakePin(1, RADIO2_DIO1);
+    } else {
+        Serial.println(F("[DroneDetect] Second radio init failed, scanning with one radio"));
+    }
+#endif
+    // Each scanner takes its share of the band plan before resuming
+    scanConfigAttach(scanners, radios);
+    scanConfigPrint();
+    SemaphoreHandle_t busLock = radios > 1 ? scannerCreateBusLock() : NULL;
+    started = true;
+    for (uint8_t i = 0; i < radios; i++) {
+        bootResumeScanner(scanners[i]);
+        // Scanner 0 keeps core 1, further scanners run on core 0
+        started = scannerTaskStart(scanners[i], busLock, i == 0 ? 1 : 0) && started;
+    }
+    scanningStarted = started;
     
-    if (state == RADIOLIB_ERR_NONE) {
+    if (started) {
+        bootMark(BOOT_PHASE_RX);
         Serial.println(F("[DroneDetect] Listening for RF signals..."));
         Serial.print(F("[DroneDetect] Modulation: "));
         Serial.println(getModulationName(getCurrentModulation()));
-        displayScanningWithModulation(currentScanFrequency, getModulationName(getCurrentModulation()));
-        lastDisplayUpdate = millis();
-        lastModulationSwitch = millis();
-        lastFrequencySweep = millis();
     } else {
-        Serial.print(F("[DroneDetect] Receive failed, code "));
-        Serial.println(state);
-        displayError("Receive mode failed!");
+        Serial.println(F("[DroneDetect] Failed to start scanning"));
     }
+    
+    // Detection latency and battery life of each RX duty-cycle setting
+    lowPowerInit(getDefaultScanner(), radios);
+    
+    // Restore per-channel noise floor estimates (RTC memory or NVS) before
+    // loop() processes the first samples
+    noiseFloorInit();
+    localizerInit();
+    occupancyInit();
+    sketchInit();
+    pcapExportInit();
+    consoleInit();
+    bootMark(BOOT_PHASE_STATE);
+    
+    // Display, detection log and GPS come up from loop()
 }
 
 void loop() {
-    // Check if a signal was received
-    if (receivedFlag) {
-        receivedFlag = false;
-        
-        // Read received data
-        String str;
-        int state = radio.readData(str);
-        
-        if (state == RADIOLIB_ERR_NONE) {
-            // Get signal parameters
-            float rssi = radio.getRSSI();
-            float snr = radio.getSNR();
-            float freqError = radio.getFrequencyError();
-            
-            // Analyze signal for drone signatures
-            DroneSignal droneSignal;
-            bool isDrone = analyzeDroneSignal(rssi, snr, freqError, 
-                                              getCurrentModulation(), &droneSignal);
-            
-            // Signal detected - log to Serial
-            Serial.println(F("--- RF Signal Detected ---"));
-            Serial.print(F("Modulation: "));
-            Serial.println(getModulationName(getCurrentModulation()));
-            Serial.print(F("RSSI: "));
-            Serial.print(rssi);
-            Serial.println(F(" dBm"));
-            Serial.print(F("SNR: "));
-            Serial.print(snr);
-            Serial.println(F(" dB"));
-            Serial.print(F("Frequency error: "));
-            Serial.print(freqError);
-            Serial.println(F(" Hz"));
-            Serial.print(F("Drone detected: "));
-            Serial.println(isDrone ? "YES" : "No");
-            if (isDrone) {
-                Serial.print(F("Drone type: "));
-                Serial.println(droneSignal.droneType);
-                Serial.print(F("Confidence: "));
-                Serial.print(droneSignal.confidence);
-                Serial.println(F("%"));
-            }
-            Serial.println(F("--------------------------"));
-            
-            // Update TFT display with detection info including modulation
-            displayDroneDetection(rssi, snr, freqError,
-                                  getModulationName(getCurrentModulation()),
-                                  isDrone ? droneSignal.droneType : NULL,
-                                  droneSignal.confidence);
-            lastDisplayUpdate = millis();
-        }
-        
-        // Restart receive mode
-        radio.startReceive();
-    }
-    
-    // Periodically switch modulation type to scan for different drone protocols
-    if (millis() - lastModulationSwitch > MODULATION_SWITCH_INTERVAL) {
-        Serial.println(F("[DroneDetect] Switching modulation mode..."));
-        
-        // Switch to next modulation type (uses current sweep frequency)
-        ModulationType newMod = switchToNextModulation(&radio, currentScanFrequency);
-        
-        // Reset sweep scan when changing modulation
-        resetSweepScan();
-        currentScanFrequency = getCurrentSweepFrequency();
-        
-        Serial.print(F("[DroneDetect] Now scanning with: "));
-        Serial.println(getModulationName(newMod));
-        
-        // Restart receive mode with new modulation
-        int state = radio.startReceive();
-        if (state != RADIOLIB_ERR_NONE) {
-            Serial.print(F("[DroneDetect] Failed to restart receive, code: "));
-            Serial.println(state);
+    // Sleep until the next scanner event, then drain the merged stream.
+    // The timeout only bounds how late the services below run on a quiet band.
+    // In the low-power mode the CPU light-sleeps instead, until a radio
+    // interrupt or the next dwell timer.
+    TickType_t wait = pdMS_TO_TICKS(LOOP_SERVICE_MS);
+    if (lowPowerEnabled()) {
+        lowPowerSleep(LOOP_SERVICE_MS * 1000UL);
+        wait = 1;
+    } else if (pcapExportPending()) {
+        // Keep a capture export draining at serial speed
+        wait = 1;
+    }
+    uint8_t count = 0;
+    if (scannerNextEvent(&eventBatch[0], wait)) {
+        count = 1;
+        while (count < SCAN_EVENT_QUEUE_DEPTH && scannerNextEvent(&eventBatch[count], 0)) {
+            count++;
         }
-        
-        // Update display with new modulation
-        displayScanningWithModulation(currentScanFrequency, getModulationName(newMod));
-        
-        lastModulationSwitch = millis();
-        lastDisplayUpdate = millis();
     }
     
-    // Sweep frequency scanning for FHSS detection
-    // This catches drones that frequency hop across the band
-    if (millis() - lastFrequencySweep > FREQUENCY_SWEEP_INTERVAL) {
-        // Move to next frequency in sweep
-        currentScanFrequency = sweepToNextFrequency(&radio);
-        
-        // Restart receive at new frequency
-        int state = radio.startReceive();
-        if (state != RADIOLIB_ERR_NONE) {
-            Serial.print(F("[DroneDetect] Sweep receive failed, code: "));
-            Serial.println(state);
+    // Alert outputs switch first: every packet waiting in the stream is
+    // analyzed and its alert evaluated before any event is logged, printed
+    // or drawn. The batch's noise samples update the floors afterwards.
+    for (uint8_t i = 0; i < count; i++) {
+        if (eventBatch[i].type == SCAN_EVENT_PACKET) {
+            assessPacket(&eventBatch[i], &verdicts[i]);
+        }
+    }
+    int shown = -1;
+    for (uint8_t i = 0; i < count; i++) {
+        handleEvent(&eventBatch[i], &verdicts[i]);
+        if (eventBatch[i].type == SCAN_EVENT_PACKET && !verdicts[i].report) {
+            shown = i;
         }
-        
-        lastFrequencySweep = millis();
     }
     
+    // One repaint per pass, with the latest packet
+    if (shown >= 0) {
+        displayPacket(&eventBatch[shown], &verdicts[shown]);
+    }
+    
+    // Bring up the display, log and GPS once scanning runs
+    serviceDeferredInit();
+    
+    // Run serial commands; settings changes finish at sweep boundaries
+    consoleService();
+    scanConfigService();
+    
+    // Parse pending GPS sentences
+    gpsService();
+    
+    // Servo the timebase on new PPS pulses
+    timebaseService();
+    
+    // Close idle emitter tracks
+    trackService();
+    
+    // End quiet alerts and the buzzer pulse
+    alertService();
+    
+    // Persist noise floor estimates periodically
+    noiseFloorService(false);
+    
+    // Snapshot scan state for a warm start
+    bootService(false);
+    
+    // Share track summaries with other nodes in this node's slot
+    meshReportService();
+    
+    // Print updated emitter position estimates
+    localizerService();
+    
+    // Flag heap allocations after boot
+    arenaService();
+    
+    // Roll the coverage window and print sweep summaries
+    coverageService();
+    
+    // Send buffered capture blocks
+    pcapExportService();
+    
+    // Open new occupancy history rows
+    occupancyService();
+    
+    // Start new sketch slices
+    sketchService();
+    
     // Return to scanning display after detection timeout
-    if (millis() - lastDisplayUpdate > DISPLAY_UPDATE_INTERVAL) {
-        displayScanningWithModulation(currentScanFrequency, getModulationName(getCurrentModulation()));
+    if (displayReady && scanningStarted &&
+        millis() - lastDisplayUpdate > DISPLAY_UPDATE_INTERVAL) {
+        displayScanningWithModulation(getCurrentSweepFrequency(),
+                                      getModulationName(getCurrentModulation()));
         lastDisplayUpdate = millis();
     }
     
-    delay(10);
+    if (millis() - lastTimingReport > TIMING_REPORT_INTERVAL) {
+        reportScannerTiming();
+        lowPowerReport();
+        arenaReport();
+        coverageReport();
+        sketchReport(SKETCH_REPORT_WINDOW_MS);
+        lastTimingReport = millis();
+    }
 }
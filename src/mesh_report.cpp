@@ -0,0 +1,312 @@
+/**
+ * Mesh Report Module Implementation
+ */
+
+#include "mesh_report.h"
+#include "emitter_track.h"
+#include "detection_log.h"
+#include "gps.h"
+#include "timebase.h"
+#include "arena.h"
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+typedef struct {
+    uint16_t length;                    // Frame bytes
+    bool relay;                         // Frame originates from another node
+    uint8_t data[REPORT_MAX_FRAME];     // Encoded frame
+} ReportFrame;
+
+#define REPORT_FRAME_QUEUE      2         // Frames waiting for the scanner task
+#define REPORT_CREDIT_MAX_US    2000000   // Airtime credit that can accumulate
+
+static uint16_t nodeId = 0;
+static uint16_t nextSequence = 0;
+static uint32_t lastReportPeriod = UINT32_MAX;
+static QueueHandle_t frameQueue = NULL;
+static StaticQueue_t frameQueueBuffer;
+
+static uint64_t lastListenSlot = UINT64_MAX;   // Scanner task only
+
+static ReportSeenCache seen;
+
+// Airtime token bucket (touched only by the scanner task)
+static int32_t airtimeCreditUs = REPORT_CREDIT_MAX_US;
+static uint32_t lastCreditUpdateMs = 0;
+
+static ReportStats reportStats;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * Report schedule clock (ms): UTC once locked to PPS, otherwise log time
+ */
+static uint64_t reportClockMs() {
+    if (timebaseLocked()) {
+        return (uint64_t)(timebaseUtcUs() / 1000);
+    }
+    return (uint64_t)detectionLogTime() * 1000 + millis() % 1000;
+}
+
+static bool ownSlot(uint64_t slot) {
+    return slot % REPORT_SLOTS == nodeId % REPORT_SLOTS;
+}
+
+/**
+ * Forward a frame to the serial port for the host aggregator
+ */
+static void printFrame(const uint8_t* data, size_t length) {
+    Serial.print(F("RPT,"));
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] < 0x10) {
+            Serial.print('0');
+        }
+        Serial.print(data[i], HEX);
+    }
+    Serial.println();
+}
+
+static void encodeTrack(const EmitterTrack* track, uint32_t now, ReportEntry* entry) {
+    long frequencyKHz = lroundf((track->lastFrequency - FREQ_900_MIN) * 1000.0f);
+    uint8_t rate = (track->rateMode == RATE_UNKNOWN) ? 0x0F : (uint8_t)track->rateMode;
+
+    entry->key = track->key;
+    entry->frequencyKHz = (uint16_t)constrain(frequencyKHz, 0L, 65535L);
+    entry->signatureIndex = track->signatureIndex;
+    entry->modulationRate = (uint8_t)(((uint8_t)track->modulation << 4) | rate);
+    entry->peakRssi = (int8_t)constrain(lroundf(track->peakRssi), -128L, 127L);
+    entry->meanRssi = (int8_t)constrain(lroundf(track->meanRssi), -128L, 127L);
+    entry->packets = (uint16_t)min(track->timing.packets, (uint32_t)UINT16_MAX);
+    entry->durationS = (uint16_t)min((track->lastSeenMs - track->firstSeenMs) / 1000,
+                                     (uint32_t)UINT16_MAX);
+    entry->ageS = (uint8_t)min((now - track->lastSeenMs) / 1000, (uint32_t)UINT8_MAX);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void meshReportInit() {
+    // Low bits of the factory MAC identify the node
+    uint64_t mac = ESP.getEfuseMac();
+    nodeId = (uint16_t)((mac >> 32) ^ (mac >> 16) ^ mac);
+
+    reportSeenReset(&seen);
+    memset(&reportStats, 0, sizeof(reportStats));
+    lastCreditUpdateMs = millis();
+
+    // Frames are queued a few times a minute: PSRAM
+    uint8_t* storage = (uint8_t*)arenaAlloc(ARENA_PSRAM, REPORT_FRAME_QUEUE * sizeof(ReportFrame),
+                                            "report queue");
+    if (storage != NULL) {
+        frameQueue = xQueueCreateStatic(REPORT_FRAME_QUEUE, sizeof(ReportFrame), storage,
+                                        &frameQueueBuffer);
+    }
+    if (frameQueue == NULL) {
+        Serial.println(F("[Report] Failed to create frame queue"));
+        return;
+    }
+
+    Serial.print(F("[Report] Node 0x"));
+    Serial.print(nodeId, HEX);
+    Serial.print(F(", slot "));
+    Serial.print(nodeId % REPORT_SLOTS);
+    Serial.print(F(" of "));
+    Serial.println(REPORT_SLOTS);
+}
+
+void meshReportService() {
+    if (!REPORT_ENABLED || frameQueue == NULL) {
+        return;
+    }
+
+    // Only report inside this node's slot, once per period, early enough
+    // for the frame to go out while the other nodes listen. Slots line up
+    // across nodes once their timebases are locked to PPS.
+    uint64_t clockMs = reportClockMs();
+    uint32_t t = (uint32_t)(clockMs / 1000);
+    uint32_t period = t / REPORT_PERIOD_S;
+    if (!ownSlot(clockMs / REPORT_SLOT_MS) || clockMs % REPORT_SLOT_MS >= REPORT_TX_WINDOW_MS ||
+        period == lastReportPeriod) {
+        return;
+    }
+    lastReportPeriod = period;
+
+    // Pick the most recently active tracks
+    const EmitterTrack* selected[REPORT_MAX_ENTRIES];
+    int count = 0;
+    for (int i = 0; i < MAX_EMITTER_TRACKS; i++) {
+        const EmitterTrack* track = getTrack(i);
+        if (track == NULL) {
+            continue;
+        }
+        if (count < REPORT_MAX_ENTRIES) {
+            selected[count++] = track;
+            continue;
+        }
+        int stalest = 0;
+        for (int j = 1; j < count; j++) {
+            if (selected[j]->lastSeenMs < selected[stalest]->lastSeenMs) {
+                stalest = j;
+            }
+        }
+        if (track->lastSeenMs > selected[stalest]->lastSeenMs) {
+            selected[stalest] = track;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+
+    ReportFrame frame;
+    ReportHeader header;
+    header.nodeId = nodeId;
+    header.sequence = nextSequence++;
+    header.timeS = t;
+    GpsFix fix;
+    if (gpsGetFix(&fix)) {
+        header.latitudeE7 = (int32_t)lround(fix.latitude * 1e7);
+        header.longitudeE7 = (int32_t)lround(fix.longitude * 1e7);
+    } else {
+        header.latitudeE7 = REPORT_NO_POSITION;
+        header.longitudeE7 = REPORT_NO_POSITION;
+    }
+    header.count = (uint8_t)count;
+
+    ReportEntry entries[REPORT_MAX_ENTRIES];
+    uint32_t now = millis();
+    for (int i = 0; i < count; i++) {
+        encodeTrack(selected[i], now, &entries[i]);
+    }
+    frame.length = (uint16_t)reportEncode(&header, entries, frame.data);
+    frame.relay = false;
+
+    reportMarkSeen(&seen, nodeId, header.sequence);
+    printFrame(frame.data, frame.length);
+
+    if (xQueueSend(frameQueue, &frame, 0) != pdTRUE) {
+        reportStats.throttled++;
+    }
+}
+
+bool meshReportTransmit(SX1262* radio) {
+    ReportFrame frame;
+
+    if (!REPORT_ENABLED || radio == NULL || frameQueue == NULL) {
+        return false;
+    }
+
+    // Refill the airtime budget; a frame may overdraw it, which then
+    // holds off later frames until the duty cycle is restored
+    // (1 ms elapsed earns REPORT_DUTY_PERMILLE us of airtime)
+    uint32_t now = millis();
+    airtimeCreditUs += (int32_t)min((now - lastCreditUpdateMs) * REPORT_DUTY_PERMILLE,
+                                    (uint32_t)REPORT_CREDIT_MAX_US);
+    airtimeCreditUs = min(airtimeCreditUs, (int32_t)REPORT_CREDIT_MAX_US);
+    lastCreditUpdateMs = now;
+
+    // Listeners open their window at their first dwell boundary in the
+    // slot, so frames start after the guard and end inside the window
+    uint64_t clockMs = reportClockMs();
+    uint32_t phaseMs = (uint32_t)(clockMs % REPORT_SLOT_MS);
+    if (!ownSlot(clockMs / REPORT_SLOT_MS) ||
+        phaseMs < REPORT_TX_GUARD_MS || phaseMs >= REPORT_TX_WINDOW_MS) {
+        return false;
+    }
+
+    if (airtimeCreditUs <= 0 || xQueueReceive(frameQueue, &frame, 0) != pdTRUE) {
+        return false;
+    }
+
+    int state = radio->begin(REPORT_FREQUENCY, REPORT_BANDWIDTH, REPORT_SPREADING_FACTOR,
+                             REPORT_CODING_RATE, REPORT_SYNC_WORD, REPORT_TX_POWER);
+    if (state == RADIOLIB_ERR_NONE) {
+        uint32_t start = millis();
+        state = radio->transmit(frame.data, frame.length);
+        uint32_t airtime = millis() - start;
+
+        airtimeCreditUs -= (int32_t)(airtime * 1000);
+        reportStats.airtimeMs += airtime;
+        if (frame.relay) {
+            reportStats.relayed++;
+        } else {
+            reportStats.sent++;
+        }
+    }
+
+    if (state != RADIOLIB_ERR_NONE) {
+        Serial.print(F("[Report] Transmit failed, code: "));
+        Serial.println(state);
+    }
+
+    return true;
+}
+
+bool meshReportListen(SX1262* radio, uint32_t* windowUs) {
+    if (!REPORT_ENABLED || radio == NULL || windowUs == NULL || !timebaseLocked()) {
+        return false;
+    }
+
+    // Once per slot of another node, for what is left of the window
+    uint64_t clockMs = reportClockMs();
+    uint64_t slot = clockMs / REPORT_SLOT_MS;
+    uint32_t phaseMs = (uint32_t)(clockMs % REPORT_SLOT_MS);
+    if (ownSlot(slot) || slot == lastListenSlot || phaseMs >= REPORT_LISTEN_MS) {
+        return false;
+    }
+    lastListenSlot = slot;
+
+    int state = radio->begin(REPORT_FREQUENCY, REPORT_BANDWIDTH, REPORT_SPREADING_FACTOR,
+                             REPORT_CODING_RATE, REPORT_SYNC_WORD, REPORT_TX_POWER);
+    if (state == RADIOLIB_ERR_NONE) {
+        state = radio->startReceive();
+    }
+    if (state != RADIOLIB_ERR_NONE) {
+        Serial.print(F("[Report] Listen failed, code: "));
+        Serial.println(state);
+        return false;
+    }
+
+    *windowUs = (REPORT_LISTEN_MS - phaseMs) * 1000;
+    reportStats.listenMs += REPORT_LISTEN_MS - phaseMs;
+    return true;
+}
+
+bool meshReportReceive(const uint8_t* data, size_t length) {
+    ReportFrame frame;
+
+    ReportRxResult result = reportReceive(&seen, data, length, frame.data);
+    if (result == REPORT_RX_INVALID) {
+        return false;
+    }
+    if (result == REPORT_RX_DUPLICATE) {
+        reportStats.duplicates++;
+        return true;
+    }
+    reportStats.received++;
+    printFrame(data, length);
+
+    if (result == REPORT_RX_RELAY && frameQueue != NULL) {
+        frame.length = (uint16_t)length;
+        frame.relay = true;
+        if (xQueueSend(frameQueue, &frame, 0) != pdTRUE) {
+            reportStats.throttled++;
+        }
+    }
+
+    return true;
+}
+
+uint16_t meshReportNodeId() {
+    return nodeId;
+}
+
+void meshReportGetStats(ReportStats* stats) {
+    if (stats != NULL) {
+        *stats = reportStats;
+    }
+}
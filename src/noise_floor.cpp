@@ -0,0 +1,249 @@
+/**
+ * Noise Floor Module Implementation
+ *
+ * The percentile estimate uses the frugal streaming algorithm: each sample
+ * nudges the estimate up with probability q or down with probability 1 - q,
+ * with an adaptive step, so it converges on the q-quantile using O(1) state.
+ * Only samples near or below that quantile update the EWMA floor, which keeps
+ * bursts of real traffic from dragging the floor upwards.
+ */
+
+#include "noise_floor.h"
+#include <Preferences.h>
+#include <esp_rom_crc.h>
+
+// ============================================================================
+// Estimator State
+// ============================================================================
+
+typedef struct {
+    float floor;                // EWMA of gated samples (dBm)
+    float spread;               // EWMA of absolute deviation (dB)
+    float quantile;             // Frugal quantile estimate (dBm)
+    float step;                 // Frugal adaptive step (dB)
+    uint16_t samples;           // Samples seen (saturating)
+} NoiseCell;
+
+// Packed form stored in NVS and RTC memory
+typedef struct __attribute__((packed)) {
+    int16_t floorDeci;
+    int16_t spreadDeci;
+    int16_t quantileDeci;
+    uint16_t samples;
+} SavedCell;
+
+#define NVS_NAMESPACE   "noisefloor"
+#define NVS_KEY_CELLS   "cells"
+
+static NoiseCell cells[NOISE_FLOOR_CHANNELS][NOISE_FLOOR_MODULATIONS];
+static unsigned long lastSave = 0;
+static unsigned long lastRtcSave = 0;
+static bool dirty = false;
+static bool rtcDirty = false;
+
+// Detection threshold relative to the floor (runtime adjustable)
+static float detectMarginDb = NOISE_DETECT_MARGIN_DB;
+static float detectSpreadK = NOISE_DETECT_SPREAD_K;
+
+// Copy in RTC memory: survives software resets, panics and deep sleep,
+// and is far more recent than the NVS copy after a warm reboot
+RTC_NOINIT_ATTR static SavedCell rtcCells[NOISE_FLOOR_CHANNELS][NOISE_FLOOR_MODULATIONS];
+RTC_NOINIT_ATTR static uint32_t rtcCellsCrc;
+
+// Simple xorshift generator for the frugal coin flip
+static uint32_t rngState = 0x9E3779B9UL;
+
+static float nextUniform() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+static NoiseCell* getCell(int channel, ModulationType modulation) {
+    if (channel < 0 || channel >= NOISE_FLOOR_CHANNELS ||
+        (int)modulation >= NOISE_FLOOR_MODULATIONS) {
+        return NULL;
+    }
+    return &cells[channel][modulation];
+}
+
+static void packCells(SavedCell saved[NOISE_FLOOR_CHANNELS][NOISE_FLOOR_MODULATIONS]) {
+    for (int ch = 0; ch < NOISE_FLOOR_CHANNELS; ch++) {
+        for (int m = 0; m < NOISE_FLOOR_MODULATIONS; m++) {
+            const NoiseCell* cell = &cells[ch][m];
+            saved[ch][m].floorDeci = (int16_t)lroundf(cell->floor * 10.0f);
+            saved[ch][m].spreadDeci = (int16_t)lroundf(cell->spread * 10.0f);
+            saved[ch][m].quantileDeci = (int16_t)lroundf(cell->quantile * 10.0f);
+            saved[ch][m].samples = cell->samples;
+        }
+    }
+}
+
+static void unpackCells(const SavedCell saved[NOISE_FLOOR_CHANNELS][NOISE_FLOOR_MODULATIONS]) {
+    for (int ch = 0; ch < NOISE_FLOOR_CHANNELS; ch++) {
+        for (int m = 0; m < NOISE_FLOOR_MODULATIONS; m++) {
+            NoiseCell* cell = &cells[ch][m];
+            cell->floor = saved[ch][m].floorDeci / 10.0f;
+            cell->spread = saved[ch][m].spreadDeci / 10.0f;
+            cell->quantile = saved[ch][m].quantileDeci / 10.0f;
+            // Restored cells count as calibrated but still adapt quickly
+            cell->samples = min(saved[ch][m].samples, (uint16_t)NOISE_FLOOR_MIN_SAMPLES);
+        }
+    }
+}
+
+static uint32_t rtcChecksum() {
+    return esp_rom_crc32_le(0, (const uint8_t*)rtcCells, sizeof(rtcCells));
+}
+
+static void resetCell(NoiseCell* cell) {
+    cell->floor = NOISE_FLOOR_DEFAULT_DBM;
+    cell->spread = 0.0f;
+    cell->quantile = NOISE_FLOOR_DEFAULT_DBM;
+    cell->step = 1.0f;
+    cell->samples = 0;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool noiseFloorInit() {
+    for (int ch = 0; ch < NOISE_FLOOR_CHANNELS; ch++) {
+        for (int m = 0; m < NOISE_FLOOR_MODULATIONS; m++) {
+            resetCell(&cells[ch][m]);
+        }
+    }
+    lastSave = millis();
+    lastRtcSave = millis();
+
+    // RTC memory holds the latest estimates unless power was removed
+    if (rtcChecksum() == rtcCellsCrc) {
+        unpackCells(rtcCells);
+        Serial.println(F("[NoiseFloor] Restored noise floor estimates from RTC memory"));
+        return true;
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, true)) {
+        return false;
+    }
+
+    static SavedCell saved[NOISE_FLOOR_CHANNELS][NOISE_FLOOR_MODULATIONS];
+    bool restored = false;
+    if (prefs.getBytesLength(NVS_KEY_CELLS) == sizeof(saved) &&
+        prefs.getBytes(NVS_KEY_CELLS, saved, sizeof(saved)) == sizeof(saved)) {
+        unpackCells(saved);
+        restored = true;
+        Serial.println(F("[NoiseFloor] Restored saved noise floor estimates"));
+    }
+    prefs.end();
+
+    return restored;
+}
+
+void noiseFloorUpdate(int channel, ModulationType modulation, float rssi) {
+    NoiseCell* cell = getCell(channel, modulation);
+    if (cell == NULL) {
+        return;
+    }
+
+    if (cell->samples == 0) {
+        // First sample seeds the estimates directly
+        cell->floor = rssi;
+        cell->quantile = rssi;
+        cell->spread = 1.0f;
+    }
+
+    // Frugal quantile update with adaptive step
+    float coin = nextUniform();
+    if (rssi > cell->quantile && coin > 1.0f - NOISE_FLOOR_QUANTILE) {
+        cell->quantile += cell->step;
+        cell->step = min(cell->step * 1.5f, 4.0f);
+    } else if (rssi < cell->quantile && coin > NOISE_FLOOR_QUANTILE) {
+        cell->quantile -= cell->step;
+        cell->step = min(cell->step * 1.5f, 4.0f);
+    } else {
+        cell->step = max(cell->step * 0.5f, 0.1f);
+    }
+
+    // Only samples close to the background feed the floor estimate
+    if (rssi <= cell->quantile + NOISE_FLOOR_GATE_DB) {
+        float deviation = fabsf(rssi - cell->floor);
+        cell->floor += NOISE_FLOOR_EWMA_ALPHA * (rssi - cell->floor);
+        cell->spread += NOISE_FLOOR_EWMA_ALPHA * (deviation - cell->spread);
+    }
+
+    if (cell->samples < UINT16_MAX) {
+        cell->samples++;
+    }
+    dirty = true;
+    rtcDirty = true;
+}
+
+float noiseFloorGet(int channel, ModulationType modulation) {
+    if (channel < 0) {
+        // Band-wide estimate: mean over calibrated channels
+        float sum = 0.0f;
+        int count = 0;
+        for (int ch = 0; ch < NOISE_FLOOR_CHANNELS; ch++) {
+            const NoiseCell* cell = getCell(ch, modulation);
+            if (cell != NULL && cell->samples >= NOISE_FLOOR_MIN_SAMPLES) {
+                sum += cell->floor;
+                count++;
+            }
+        }
+        return count > 0 ? sum / count : NOISE_FLOOR_DEFAULT_DBM;
+    }
+
+    const NoiseCell* cell = getCell(channel, modulation);
+    if (cell == NULL || cell->samples < NOISE_FLOOR_MIN_SAMPLES) {
+        return NOISE_FLOOR_DEFAULT_DBM;
+    }
+    return cell->floor;
+}
+
+float noiseFloorThreshold(int channel, ModulationType modulation) {
+    float spread = 0.0f;
+    const NoiseCell* cell = getCell(channel, modulation);
+    if (cell != NULL && cell->samples >= NOISE_FLOOR_MIN_SAMPLES) {
+        spread = cell->spread;
+    }
+    return noiseFloorGet(channel, modulation) +
+           max(detectMarginDb, detectSpreadK * spread);
+}
+
+void noiseFloorSetThresholds(float marginDb, float spreadK) {
+    detectMarginDb = marginDb;
+    detectSpreadK = spreadK;
+}
+
+void noiseFloorService(bool force) {
+    // RTC copy is a plain memory write, so it is kept nearly current
+    if (rtcDirty && (force || millis() - lastRtcSave >= NOISE_FLOOR_RTC_SAVE_MS)) {
+        packCells(rtcCells);
+        rtcCellsCrc = rtcChecksum();
+        lastRtcSave = millis();
+        rtcDirty = false;
+    }
+
+    if (!dirty) {
+        return;
+    }
+    if (!force && millis() - lastSave < NOISE_FLOOR_SAVE_MS) {
+        return;
+    }
+
+    static SavedCell saved[NOISE_FLOOR_CHANNELS][NOISE_FLOOR_MODULATIONS];
+    packCells(saved);
+
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, false)) {
+        prefs.putBytes(NVS_KEY_CELLS, saved, sizeof(saved));
+        prefs.end();
+    }
+
+    lastSave = millis();
+    dirty = false;
+}
@@ -0,0 +1,262 @@
+/**
+ * Occupancy Module Implementation
+ *
+ * Rows are numbered from boot; row r lives in slot r % OCC_ROWS. For each
+ * channel, activeBefore[slot] holds the number of active rows before that
+ * row, modulo 2^16. Since a window never exceeds OCC_ROWS rows, the
+ * difference of two entries is exact despite the wrap. Everything runs
+ * in the main loop.
+ */
+
+#include "occupancy.h"
+#include "arena.h"
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+#define ACTIVITY_WORDS      ((OCC_ROWS + 31) / 32)
+
+// History of one channel (a column of the row ring)
+typedef struct {
+    uint8_t rssi[OCC_ROWS];                 // Peak quantised RSSI per row
+    uint16_t activeBefore[OCC_ROWS];        // Active rows before each row
+    uint32_t activity[ACTIVITY_WORDS];      // Activity bit per row
+    uint32_t lastActiveRow;                 // Last active row + 1 (0 = never)
+} ChannelHistory;
+
+static ChannelHistory* history = NULL;      // OCC_CHANNELS columns (PSRAM)
+static uint32_t currentRow = 0;
+static uint32_t rowStartMs = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline uint16_t slotOf(uint32_t row) {
+    return (uint16_t)(row % OCC_ROWS);
+}
+
+static inline bool rowActive(const ChannelHistory* column, uint32_t row) {
+    uint16_t slot = slotOf(row);
+    return (column->activity[slot / 32] >> (slot % 32)) & 1;
+}
+
+static inline int trackedChannels() {
+    return min((int)NUM_SWEEP_CHANNELS, OCC_CHANNELS);
+}
+
+static uint16_t validRows() {
+    return (uint16_t)min(currentRow + 1, (uint32_t)OCC_ROWS);
+}
+
+/**
+ * Rows in a window ending now, at least the current row
+ */
+static uint16_t windowRows(uint32_t windowMs) {
+    uint32_t rows = (windowMs + OCC_ROW_MS - 1) / OCC_ROW_MS;
+    return (uint16_t)constrain(rows, (uint32_t)1, (uint32_t)validRows());
+}
+
+/**
+ * Active rows of a channel among the last rows rows: O(1)
+ */
+static uint16_t activeRows(const ChannelHistory* column, uint16_t rows) {
+    uint32_t first = currentRow + 1 - rows;
+    uint16_t closed = (uint16_t)(column->activeBefore[slotOf(currentRow)] -
+                                 column->activeBefore[slotOf(first)]);
+    return closed + (rowActive(column, currentRow) ? 1 : 0);
+}
+
+static uint32_t lastActiveAgoMs(const ChannelHistory* column) {
+    if (column->lastActiveRow == 0) {
+        return UINT32_MAX;
+    }
+    uint32_t rowsAgo = currentRow - (column->lastActiveRow - 1);
+    return rowsAgo * OCC_ROW_MS + (millis() - rowStartMs);
+}
+
+static void openRow(uint32_t row) {
+    uint16_t slot = slotOf(row);
+    uint16_t previous = slotOf(row - 1);
+    for (int ch = 0; ch < OCC_CHANNELS; ch++) {
+        ChannelHistory* column = &history[ch];
+        column->activeBefore[slot] = column->activeBefore[previous] +
+                                     (rowActive(column, row - 1) ? 1 : 0);
+        column->rssi[slot] = 0;
+        column->activity[slot / 32] &= ~(1UL << (slot % 32));
+    }
+}
+
+static void fillChannel(OccupancyChannel* entry, int channel, uint16_t active, uint16_t rows) {
+    entry->channel = (uint16_t)channel;
+    entry->activeRows = active;
+    entry->occupancy = (float)active / rows;
+    entry->lastActiveAgoMs = lastActiveAgoMs(&history[channel]);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void occupancyInit() {
+    if (history == NULL) {
+        history = (ChannelHistory*)arenaAlloc(ARENA_PSRAM, OCC_CHANNELS * sizeof(ChannelHistory),
+                                              "occupancy");
+    } else {
+        memset(history, 0, OCC_CHANNELS * sizeof(ChannelHistory));
+    }
+    currentRow = 0;
+    rowStartMs = millis();
+}
+
+void occupancyNote(int channel, float rssi, bool active) {
+    if (history == NULL || channel < 0 || channel >= OCC_CHANNELS) {
+        return;
+    }
+    if (millis() - rowStartMs >= OCC_ROW_MS) {
+        occupancyService();
+    }
+
+    ChannelHistory* column = &history[channel];
+    uint16_t slot = slotOf(currentRow);
+    column->rssi[slot] = max(column->rssi[slot], occupancyQuantize(rssi));
+    if (active) {
+        column->activity[slot / 32] |= 1UL << (slot % 32);
+        column->lastActiveRow = currentRow + 1;
+    }
+}
+
+void occupancyService() {
+    if (history == NULL) {
+        return;
+    }
+    uint32_t behind = (millis() - rowStartMs) / OCC_ROW_MS;
+    if (behind == 0) {
+        return;
+    }
+    // After a long stall only the last OCC_ROWS rows need opening
+    if (behind > OCC_ROWS) {
+        currentRow += behind - OCC_ROWS;
+        rowStartMs += (behind - OCC_ROWS) * OCC_ROW_MS;
+        behind = OCC_ROWS;
+    }
+    while (behind-- > 0) {
+        currentRow++;
+        rowStartMs += OCC_ROW_MS;
+        openRow(currentRow);
+    }
+}
+
+bool occupancyQueryRange(int firstChannel, int lastChannel, uint32_t windowMs,
+                         OccupancyRange* result) {
+    if (history == NULL || result == NULL || firstChannel < 0 || firstChannel > lastChannel ||
+        lastChannel >= trackedChannels()) {
+        return false;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->rows = windowRows(windowMs);
+    result->channels = (uint16_t)(lastChannel - firstChannel + 1);
+    result->busiestChannel = -1;
+    for (int ch = firstChannel; ch <= lastChannel; ch++) {
+        uint16_t active = activeRows(&history[ch], result->rows);
+        result->activeCells += active;
+        if (active > result->busiestRows) {
+            result->busiestRows = active;
+            result->busiestChannel = (int16_t)ch;
+        }
+    }
+    result->occupancy = (float)result->activeCells / ((float)result->rows * result->channels);
+    return true;
+}
+
+uint8_t occupancyTopK(uint32_t windowMs, uint8_t k, OccupancyChannel* out) {
+    if (history == NULL || out == NULL) {
+        return 0;
+    }
+    k = min(k, (uint8_t)OCC_TOP_MAX);
+    uint16_t rows = windowRows(windowMs);
+
+    // Insertion into a sorted list of at most k entries
+    uint8_t count = 0;
+    for (int ch = 0; ch < trackedChannels(); ch++) {
+        uint16_t active = activeRows(&history[ch], rows);
+        if (active == 0 || (count == k && active <= out[count - 1].activeRows)) {
+            continue;
+        }
+        int position = count < k ? count++ : k - 1;
+        while (position > 0 && out[position - 1].activeRows < active) {
+            out[position] = out[position - 1];
+            position--;
+        }
+        fillChannel(&out[position], ch, active, rows);
+    }
+    return count;
+}
+
+uint8_t occupancyNewSince(uint32_t sinceMs, OccupancyChannel* out, uint8_t maxCount) {
+    if (history == NULL || out == NULL) {
+        return 0;
+    }
+    uint16_t total = validRows();
+    uint16_t rows = windowRows(sinceMs);
+    if (rows >= total) {
+        // No history before the period to compare with
+        return 0;
+    }
+
+    uint8_t count = 0;
+    for (int ch = 0; ch < trackedChannels() && count < maxCount; ch++) {
+        uint16_t recent = activeRows(&history[ch], rows);
+        if (recent > 0 && activeRows(&history[ch], total) == recent) {
+            fillChannel(&out[count++], ch, recent, rows);
+        }
+    }
+    return count;
+}
+
+uint16_t occupancyColumn(int channel, uint16_t rows, uint8_t* rssi) {
+    if (history == NULL || rssi == NULL || channel < 0 || channel >= OCC_CHANNELS) {
+        return 0;
+    }
+    rows = min(rows, validRows());
+    const ChannelHistory* column = &history[channel];
+    for (uint16_t i = 0; i < rows; i++) {
+        rssi[i] = column->rssi[slotOf(currentRow + 1 - rows + i)];
+    }
+    return rows;
+}
+
+bool occupancyRow(uint16_t rowsAgo, uint8_t* rssi) {
+    if (history == NULL || rssi == NULL || rowsAgo >= validRows()) {
+        return false;
+    }
+    uint16_t slot = slotOf(currentRow - rowsAgo);
+    for (int ch = 0; ch < OCC_CHANNELS; ch++) {
+        rssi[ch] = history[ch].rssi[slot];
+    }
+    return true;
+}
+
+bool occupancyRowActive(int channel, uint16_t rowsAgo) {
+    if (history == NULL || channel < 0 || channel >= OCC_CHANNELS || rowsAgo >= validRows()) {
+        return false;
+    }
+    return rowActive(&history[channel], currentRow - rowsAgo);
+}
+
+uint8_t occupancyQuantize(float rssi) {
+    if (isnan(rssi)) {
+        return 0;
+    }
+    long value = lroundf((rssi - OCC_RSSI_MIN_DBM) / OCC_RSSI_STEP_DB) + 1;
+    return (uint8_t)constrain(value, 1L, 255L);
+}
+
+float occupancyRssiDbm(uint8_t value) {
+    if (value == 0) {
+        return NAN;
+    }
+    return OCC_RSSI_MIN_DBM + (value - 1) * OCC_RSSI_STEP_DB;
+}
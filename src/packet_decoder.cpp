@@ -0,0 +1,328 @@
+/**
+ * Packet Decoder Module Implementation
+ *
+ * CRCs use the same MSB-first table algorithm as the ELRS firmware so the
+ * polynomials and seeds match bit for bit. The ESP32 ROM CRC routines only
+ * cover the standard reflected polynomials, hence the precomputed tables.
+ */
+
+#include "packet_decoder.h"
+
+// ============================================================================
+// Table-Driven CRC With Seed Solver
+// ============================================================================
+
+typedef struct {
+    uint16_t table[256];        // MSB-first CRC table
+    uint16_t inverse[16];       // Seed contribution inverse, per CRC bit
+    uint16_t mask;              // Mask of CRC width
+    uint8_t bits;               // CRC width
+    uint8_t calcLength;         // Bytes covered by the CRC
+    bool solvable;              // Seed map is invertible
+} CrcModel;
+
+static CrcModel crc14;          // ELRS OTA4
+static CrcModel crc16;          // ELRS OTA8
+
+static uint16_t crcCalc(const CrcModel* model, const uint8_t* data, size_t length, uint16_t crc) {
+    while (length--) {
+        crc = (uint16_t)((crc << 8) ^ model->table[((crc >> (model->bits - 8)) ^ *data++) & 0xFF]);
+    }
+    return crc & model->mask;
+}
+
+/**
+ * CRC of an all-zero message of calcLength bytes with the given seed.
+ * The CRC is linear, so CRC(seed, msg) = CRC(0, msg) ^ seedTerm(seed).
+ */
+static uint16_t seedTerm(const CrcModel* model, uint16_t seed) {
+    static const uint8_t zeros[16] = { 0 };
+    return crcCalc(model, zeros, model->calcLength, seed);
+}
+
+static void crcModelInit(CrcModel* model, uint8_t bits, uint16_t poly, uint8_t calcLength) {
+    model->bits = bits;
+    model->mask = (uint16_t)((1UL << bits) - 1);
+    model->calcLength = calcLength;
+
+    uint16_t highBit = (uint16_t)(1U << (bits - 1));
+    for (int i = 0; i < 256; i++) {
+        uint16_t crc = (uint16_t)(i << (bits - 8));
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & highBit) ? (uint16_t)((crc << 1) ^ poly) : (uint16_t)(crc << 1);
+        }
+        model->table[i] = crc & model->mask;
+    }
+
+    // Gauss-Jordan elimination over GF(2): find, for every CRC bit, the seed
+    // that contributes exactly that bit
+    uint16_t value[16];
+    uint16_t preimage[16];
+    for (int k = 0; k < bits; k++) {
+        value[k] = seedTerm(model, (uint16_t)(1U << k));
+        preimage[k] = (uint16_t)(1U << k);
+    }
+
+    model->solvable = true;
+    int row = 0;
+    for (int b = bits - 1; b >= 0; b--) {
+        int pivot = -1;
+        for (int r = row; r < bits; r++) {
+            if (value[r] & (1U << b)) {
+                pivot = r;
+                break;
+            }
+        }
+        if (pivot < 0) {
+            model->solvable = false;
+            continue;
+        }
+
+        uint16_t v = value[pivot];
+        uint16_t p = preimage[pivot];
+        value[pivot] = value[row];
+        preimage[pivot] = preimage[row];
+        value[row] = v;
+        preimage[row] = p;
+
+        for (int r = 0; r < bits; r++) {
+            if (r != row && (value[r] & (1U << b))) {
+                value[r] ^= v;
+                preimage[r] ^= p;
+            }
+        }
+        row++;
+    }
+
+    for (int r = 0; r < bits; r++) {
+        for (int b = 0; b < bits; b++) {
+            if (value[r] == (1U << b)) {
+                model->inverse[b] = preimage[r];
+            }
+        }
+    }
+}
+
+static uint16_t solveSeed(const CrcModel* model, uint16_t target) {
+    uint16_t seed = 0;
+    for (int b = 0; b < model->bits; b++) {
+        if (target & (1U << b)) {
+            seed ^= model->inverse[b];
+        }
+    }
+    return seed;
+}
+
+// ============================================================================
+// Transmitter Seed Tracking
+// ============================================================================
+
+typedef struct {
+    uint16_t seed;
+    uint8_t hits;               // Consecutive timing-consistent sightings
+    uint32_t lastUs;            // Arrival of the latest sighting (micros)
+    uint32_t lastSeenMs;
+} SeedSlot;
+
+static SeedSlot seedSlots[DECODER_ID_SLOTS];
+
+/**
+ * Whether two packets of one transmitter can be this far apart: a whole
+ * number of packet periods, within the drift allowance
+ */
+static bool elrsIntervalConsistent(uint32_t gapUs) {
+    if (gapUs < ELRS_PACKET_GRID_US - ELRS_TIMING_TOLERANCE_US ||
+        gapUs > (uint32_t)DECODER_ID_MAX_GAP_MS * 1000) {
+        return false;
+    }
+    uint32_t offset = (gapUs + ELRS_TIMING_TOLERANCE_US) % ELRS_PACKET_GRID_US;
+    return offset <= 2 * ELRS_TIMING_TOLERANCE_US;
+}
+
+/**
+ * Record a candidate seed; returns true once it is confirmed. A SYNC
+ * packet that verified the seed confirms it at once.
+ */
+static bool observeSeed(uint16_t seed, bool verified, uint32_t timestampUs) {
+    SeedSlot* slot = NULL;
+    SeedSlot* oldest = &seedSlots[0];
+
+    for (int i = 0; i < DECODER_ID_SLOTS; i++) {
+        if (seedSlots[i].hits > 0 && seedSlots[i].seed == seed) {
+            slot = &seedSlots[i];
+            break;
+        }
+        if (seedSlots[i].lastSeenMs < oldest->lastSeenMs) {
+            oldest = &seedSlots[i];
+        }
+    }
+
+    if (slot == NULL) {
+        slot = oldest;
+        slot->seed = seed;
+        slot->hits = 0;
+    }
+
+    if (verified) {
+        slot->hits = max(slot->hits, (uint8_t)DECODER_ID_CONFIRM);
+    } else if (slot->hits > 0 && !elrsIntervalConsistent(timestampUs - slot->lastUs)) {
+        // Off the packet grid: a chance seed match, start over from here
+        slot->hits = 1;
+    } else if (slot->hits < UINT8_MAX) {
+        slot->hits++;
+    }
+    slot->lastUs = timestampUs;
+    slot->lastSeenMs = millis();
+
+    return slot->hits >= DECODER_ID_CONFIRM;
+}
+
+// ELRS v3 900 MHz air rate table, indexed by the SYNC packet rate index
+static const PacketRateMode elrsRateIndex[] = {
+    RATE_200HZ,     // 200 Hz
+    RATE_100HZ,     // 100 Hz Full (OTA8)
+    RATE_100HZ,     // 100 Hz
+    RATE_50HZ,      // 50 Hz
+    RATE_25HZ       // 25 Hz
+};
+
+static uint32_t elrsTransmitterId(uint16_t seed) {
+    // 'E' tag plus the 14 seed bits shared by OTA4 and OTA8 packets
+    return ELRS_ID_TAG | (seed & 0x3FFF);
+}
+
+static uint16_t elrsSyncSeed(const uint8_t* sync) {
+    // OTA_Sync_s: fhssIndex, nonce, flags, UID3, UID4, UID5
+    return (uint16_t)(((sync[4] << 8) | sync[5]) ^ (ELRS_OTA_VERSION_ID << 8));
+}
+
+static void decodeElrsSync(const uint8_t* sync, DecodedPacket* decoded) {
+    uint8_t rateIndex = sync[2] >> 4;
+    if (rateIndex < sizeof(elrsRateIndex) / sizeof(elrsRateIndex[0])) {
+        decoded->rateMode = elrsRateIndex[rateIndex];
+    }
+}
+
+// ============================================================================
+// Protocol Decoders
+// ============================================================================
+
+static bool decodeElrsOta4(const uint8_t* data, size_t length, uint32_t timestampUs,
+                           DecodedPacket* decoded) {
+    // Header byte: type in bits 0-1, CRC high bits in bits 2-7
+    uint16_t received = (uint16_t)(((data[0] >> 2) << 8) | data[ELRS_OTA4_PACKET_SIZE - 1]);
+    uint8_t header = data[0] & 0x03;
+
+    // CRC is computed with the CRC bits of the header zeroed
+    uint16_t crc = crcCalc(&crc14, &header, 1, 0);
+    crc = crcCalc(&crc14, data + 1, crc14.calcLength - 1, crc);
+
+    decoded->protocol = "ELRS OTA4";
+    decoded->packetType = header;
+
+    // A SYNC packet carries the UID bytes of the seed; otherwise (or if
+    // they do not check out) the seed is solved from the CRC
+    bool verified = false;
+    uint16_t seed = solveSeed(&crc14, received ^ crc);
+    if (header == ELRS_PACKET_SYNC) {
+        uint16_t announced = elrsSyncSeed(data + 1) & crc14.mask;
+        verified = (announced == seed);
+        if (verified) {
+            decodeElrsSync(data + 1, decoded);
+        }
+    }
+
+    if (!observeSeed(seed, verified, timestampUs)) {
+        return false;
+    }
+
+    decoded->crcValid = true;
+    decoded->transmitterId = elrsTransmitterId(seed);
+    return true;
+}
+
+static bool decodeElrsOta8(const uint8_t* data, size_t length, uint32_t timestampUs,
+                           DecodedPacket* decoded) {
+    uint16_t received = (uint16_t)(data[ELRS_OTA8_PACKET_SIZE - 2] |
+                                   (data[ELRS_OTA8_PACKET_SIZE - 1] << 8));
+    uint8_t type = data[0] & 0x03;
+
+    decoded->protocol = "ELRS OTA8";
+    decoded->packetType = type;
+
+    bool verified = false;
+    uint16_t seed = solveSeed(&crc16, received ^ crcCalc(&crc16, data, crc16.calcLength, 0));
+    if (type == ELRS_PACKET_SYNC) {
+        verified = (elrsSyncSeed(data + 1) == seed);
+        if (verified) {
+            decodeElrsSync(data + 1, decoded);
+        }
+    }
+
+    // Identity uses the seed bits shared with OTA4 so both framings of one
+    // transmitter map to the same identifier
+    if (!observeSeed(seed & crc14.mask, verified, timestampUs)) {
+        return false;
+    }
+
+    decoded->crcValid = true;
+    decoded->transmitterId = elrsTransmitterId(seed);
+    if (decoded->rateMode == RATE_UNKNOWN) {
+        decoded->rateMode = RATE_100HZ;     // OTA8 is only used by 100 Hz Full
+    }
+    return true;
+}
+
+typedef bool (*PacketDecoderFn)(const uint8_t* data, size_t length, uint32_t timestampUs,
+                                DecodedPacket* decoded);
+
+typedef struct {
+    ModulationType modulation;  // Modulation the framing is carried on
+    size_t length;              // Exact packet length
+    const char* signatureName;  // Related signature database entry
+    PacketDecoderFn decode;     // Decoder function
+} PacketDecoderEntry;
+
+static const PacketDecoderEntry decoders[] = {
+    { MOD_LORA, ELRS_OTA4_PACKET_SIZE, "ExpressLRS 900", decodeElrsOta4 },
+    { MOD_LORA, ELRS_OTA8_PACKET_SIZE, "ExpressLRS 900", decodeElrsOta8 }
+};
+
+static const size_t NUM_DECODERS = sizeof(decoders) / sizeof(decoders[0]);
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void packetDecoderInit() {
+    crcModelInit(&crc14, 14, ELRS_CRC14_POLY, ELRS_OTA4_PACKET_SIZE - 1);
+    crcModelInit(&crc16, 16, ELRS_CRC16_POLY, ELRS_OTA8_PACKET_SIZE - 2);
+    memset(seedSlots, 0, sizeof(seedSlots));
+
+    if (!crc14.solvable || !crc16.solvable) {
+        Serial.println(F("[Decoder] Warning: CRC seed map not invertible"));
+    }
+}
+
+bool decodePacket(const uint8_t* data, size_t length, ModulationType modulation,
+                  uint32_t timestampUs, DecodedPacket* decoded) {
+    if (data == NULL || decoded == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i < NUM_DECODERS; i++) {
+        const PacketDecoderEntry* entry = &decoders[i];
+        if (entry->modulation != modulation || entry->length != length) {
+            continue;
+        }
+
+        memset(decoded, 0, sizeof(*decoded));
+        decoded->rateMode = RATE_UNKNOWN;
+        decoded->signatureName = entry->signatureName;
+        if (entry->decode(data, length, timestampUs, decoded)) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,379 @@
+/**
+ * Packet Capture Export Module Implementation
+ *
+ * pcapng is written little-endian (the byte-order magic tells readers);
+ * the LoRaTap header is big-endian by definition. Everything runs in the
+ * main loop, so there is no locking.
+ */
+
+#include "pcap_export.h"
+#include "arena.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+// pcapng block types and options
+#define PCAPNG_SHB              0x0A0D0D0AUL
+#define PCAPNG_IDB              0x00000001UL
+#define PCAPNG_EPB              0x00000006UL
+#define PCAPNG_BYTE_ORDER       0x1A2B3C4DUL
+#define PCAPNG_OPT_END          0
+#define PCAPNG_OPT_COMMENT      1
+#define PCAPNG_IF_TSRESOL       9
+#define LINKTYPE_LORATAP        270
+
+// LoRaTap v1
+#define LORATAP_VERSION         1
+#define LORATAP_LENGTH          35
+#define LORATAP_RSSI_OFFSET     139       // dBm = value - 139
+#define LORATAP_FLAG_FSK        0x01
+#define LORATAP_FLAG_NO_CRC     0x20
+
+#define PCAP_HEADER_BYTES       60        // Section header and interface description
+#define EPB_FIXED_BYTES         32        // Header, fields and trailing length
+#define COMMENT_MAX             80        // Packet comment text
+
+static uint8_t* blocks[PCAP_BLOCKS];
+static uint16_t blockLength[PCAP_BLOCKS];
+static uint32_t blockSequence[PCAP_BLOCKS];
+static uint8_t fillIndex = 0;            // Block packets are added to
+static uint32_t fillStartMs = 0;         // First bytes of the fill block
+static uint8_t drainIndex = 0;           // Oldest block being sent
+static uint8_t readyCount = 0;           // Closed blocks not yet sent
+static uint16_t drainOffset = 0;
+static uint32_t nextSequence = 0;
+static bool running = false;
+static PcapExportStats stats;
+
+static char line[PCAP_LINE_BYTES * 2 + 48];
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+static inline uint32_t padded(uint32_t length) {
+    return (length + 3) & ~3UL;
+}
+
+static uint8_t* put16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t* put32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return p + 4;
+}
+
+static uint8_t* putBe16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+    return p + 2;
+}
+
+static uint8_t* putBe32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+    return p + 4;
+}
+
+static uint8_t encodeRssi(float dbm) {
+    if (isnan(dbm)) {
+        return 0;
+    }
+    return (uint8_t)constrain(lroundf(dbm + LORATAP_RSSI_OFFSET), 0L, 255L);
+}
+
+/**
+ * Section header and LoRaTap interface description (PCAP_HEADER_BYTES)
+ */
+static size_t encodeHeader(uint8_t* out) {
+    uint8_t* p = out;
+    p = put32(p, PCAPNG_SHB);
+    p = put32(p, 28);
+    p = put32(p, PCAPNG_BYTE_ORDER);
+    p = put16(p, 1);                        // Version 1.0
+    p = put16(p, 0);
+    p = put32(p, 0xFFFFFFFFUL);             // Section length unknown
+    p = put32(p, 0xFFFFFFFFUL);
+    p = put32(p, 28);
+
+    p = put32(p, PCAPNG_IDB);
+    p = put32(p, 32);
+    p = put16(p, LINKTYPE_LORATAP);
+    p = put16(p, 0);
+    p = put32(p, PCAP_SNAPLEN);
+    p = put16(p, PCAPNG_IF_TSRESOL);        // Microsecond timestamps
+    p = put16(p, 1);
+    *p++ = 6;
+    *p++ = 0;
+    *p++ = 0;
+    *p++ = 0;
+    p = put16(p, PCAPNG_OPT_END);
+    p = put16(p, 0);
+    p = put32(p, 32);
+    return p - out;
+}
+
+/**
+ * LoRaTap v1 header for a packet event
+ */
+static uint8_t* encodeLoRaTap(uint8_t* p, const ScanEvent* event, float noiseFloor) {
+    bool lora = event->modulation == MOD_LORA;
+    float bitrateKbps = event->bitrateKbps > 0.0f ? event->bitrateKbps :
+                        event->modulation == MOD_OOK ? OOK_BITRATE : FSK_BITRATE;
+
+    *p++ = LORATAP_VERSION;
+    *p++ = 0;
+    p = putBe16(p, LORATAP_LENGTH);
+    p = putBe32(p, (uint32_t)lround(event->frequency * 1000000.0));
+    // Bandwidth in 125 kHz steps; narrower LoRa bandwidths have no code
+    *p++ = lora && event->bandwidthKhz >= 125.0f ? (uint8_t)lroundf(event->bandwidthKhz / 125.0f) : 0;
+    *p++ = lora ? event->spreadingFactor : 0;
+    *p++ = encodeRssi(event->rssi);         // Packet RSSI
+    *p++ = encodeRssi(event->rssi);         // Max RSSI
+    *p++ = encodeRssi(noiseFloor);          // Current RSSI: channel background
+    *p++ = lora ? (uint8_t)(int8_t)constrain(lroundf(event->snr * 4.0f), -128L, 127L) : 0;
+    *p++ = lora ? PCAP_LORA_SYNC_WORD : 0;
+    memset(p, 0, 8);                        // Source gateway
+    p += 8;
+    p = putBe32(p, event->timestampUs);
+    *p++ = lora ? 0 : (uint8_t)(LORATAP_FLAG_FSK | (event->bitrateKbps > 0.0f ? LORATAP_FLAG_NO_CRC : 0));
+    *p++ = lora ? LORA_CODING_RATE : 0;
+    p = putBe16(p, lora ? 0 : (uint16_t)min(lroundf(bitrateKbps * 1000.0f), 65535L));
+    *p++ = event->scanner;                  // IF channel: scanner index
+    *p++ = 0;                               // RF chain
+    p = putBe16(p, 0);                      // Tag
+    return p;
+}
+
+/**
+ * Enhanced Packet Block for a packet event, written in place
+ * @return Bytes written, 0 if it does not fit
+ */
+static size_t encodePacket(uint8_t* out, size_t room, const ScanEvent* event, float noiseFloor) {
+    uint32_t captured = LORATAP_LENGTH + event->length;
+    if (room < EPB_FIXED_BYTES + padded(captured) + 4 + COMMENT_MAX + 4) {
+        return 0;
+    }
+
+    // UTC when disciplined, else the DIO1 counter widened to 64 bits
+    uint64_t timeUs = (uint64_t)event->utcUs;
+    if (event->utcUs <= 0) {
+        int64_t now = esp_timer_get_time();
+        timeUs = (uint64_t)(now - (int64_t)(uint32_t)((uint32_t)now - event->timestampUs));
+    }
+
+    uint8_t* p = out + 8;                   // Type and length written last
+    p = put32(p, 0);                        // Interface
+    p = put32(p, (uint32_t)(timeUs >> 32));
+    p = put32(p, (uint32_t)timeUs);
+    p = put32(p, captured);
+    p = put32(p, captured);
+    p = encodeLoRaTap(p, event, noiseFloor);
+    memcpy(p, event->data, event->length);
+    p += event->length;
+    while ((p - out) & 3) {
+        *p++ = 0;
+    }
+
+    // Comment: what LoRaTap cannot carry
+    char* text = (char*)p + 4;
+    int length = snprintf(text, COMMENT_MAX, "scanner=%u mod=%s fe_hz=%.0f", event->scanner,
+                          getModulationName(event->modulation), event->freqError);
+    if (event->modulation != MOD_LORA && length > 0 && length < COMMENT_MAX) {
+        length += snprintf(text + length, COMMENT_MAX - length, " bitrate_kbps=%.2f",
+                           event->bitrateKbps > 0.0f ? event->bitrateKbps :
+                           event->modulation == MOD_OOK ? OOK_BITRATE : FSK_BITRATE);
+    }
+    length = constrain(length, 0, COMMENT_MAX - 1);
+    p = put16(p, PCAPNG_OPT_COMMENT);
+    p = put16(p, (uint16_t)length);
+    p += length;
+    while ((p - out) & 3) {
+        *p++ = 0;
+    }
+    p = put16(p, PCAPNG_OPT_END);
+    p = put16(p, 0);
+
+    uint32_t total = (uint32_t)(p - out) + 4;
+    put32(p, total);
+    put32(out, PCAPNG_EPB);
+    put32(out + 4, total);
+    return total;
+}
+
+// ============================================================================
+// Blocks
+// ============================================================================
+
+/**
+ * Queue the fill block for sending and start the next one
+ * @return false if every other block is still being sent
+ */
+static bool closeFillBlock() {
+    if (blockLength[fillIndex] == 0) {
+        return true;
+    }
+    if (readyCount >= PCAP_BLOCKS - 1) {
+        return false;
+    }
+    blockSequence[fillIndex] = nextSequence++;
+    readyCount++;
+    fillIndex = (uint8_t)((fillIndex + 1) % PCAP_BLOCKS);
+    blockLength[fillIndex] = 0;
+    return true;
+}
+
+static void noteFill() {
+    if (blockLength[fillIndex] == 0) {
+        fillStartMs = millis();
+    }
+}
+
+/**
+ * Send one line of the oldest ready block
+ * @return false if the serial port has no room
+ */
+static bool sendLine() {
+    static const char hexDigits[] = "0123456789ABCDEF";
+    const uint8_t* block = blocks[drainIndex];
+    uint16_t length = blockLength[drainIndex];
+    uint16_t count = (uint16_t)min((int)PCAP_LINE_BYTES, length - drainOffset);
+
+    int n = snprintf(line, sizeof(line), "PCAP,%lu,%u,%u,", (unsigned long)blockSequence[drainIndex],
+                     drainOffset, length);
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t byte = block[drainOffset + i];
+        line[n++] = hexDigits[byte >> 4];
+        line[n++] = hexDigits[byte & 0x0F];
+    }
+    line[n++] = '\r';
+    line[n++] = '\n';
+
+    // Whole lines only, so log output never lands inside one
+    if (Serial.availableForWrite() < n) {
+        return false;
+    }
+    Serial.write((const uint8_t*)line, n);
+
+    stats.bytes += count;
+    drainOffset += count;
+    if (drainOffset >= length) {
+        stats.blocks++;
+        drainOffset = 0;
+        drainIndex = (uint8_t)((drainIndex + 1) % PCAP_BLOCKS);
+        readyCount--;
+    }
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void pcapExportInit() {
+    for (int i = 0; i < PCAP_BLOCKS; i++) {
+        if (blocks[i] == NULL) {
+            // Touched once per packet and line: PSRAM
+            blocks[i] = (uint8_t*)arenaAlloc(ARENA_PSRAM, PCAP_BLOCK_BYTES, "pcap");
+        }
+        blockLength[i] = 0;
+    }
+    fillIndex = 0;
+    drainIndex = 0;
+    readyCount = 0;
+    drainOffset = 0;
+    running = false;
+    memset(&stats, 0, sizeof(stats));
+
+    if (PCAP_AUTOSTART) {
+        pcapExportStart();
+    }
+}
+
+void pcapExportStart() {
+    for (int i = 0; i < PCAP_BLOCKS; i++) {
+        if (blocks[i] == NULL) {
+            Serial.println(F("[Pcap] No buffers"));
+            return;
+        }
+    }
+    // A new section begins every session; close the old data first so the
+    // header leads a block whenever possible
+    if (!closeFillBlock() && PCAP_BLOCK_BYTES - blockLength[fillIndex] < PCAP_HEADER_BYTES) {
+        Serial.println(F("[Pcap] Busy sending, try again"));
+        return;
+    }
+    noteFill();
+    blockLength[fillIndex] += (uint16_t)encodeHeader(blocks[fillIndex] + blockLength[fillIndex]);
+    running = true;
+    stats.running = true;
+    Serial.println(F("[Pcap] Export started (LoRaTap pcapng as PCAP lines)"));
+}
+
+void pcapExportStop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    stats.running = false;
+    closeFillBlock();
+    Serial.print(F("[Pcap] Export stopped: "));
+    Serial.print(stats.packets);
+    Serial.print(F(" packets, "));
+    Serial.print(stats.dropped);
+    Serial.println(F(" dropped"));
+}
+
+void pcapExportPacket(const ScanEvent* event, float noiseFloor) {
+    if (!running || event == NULL || event->type != SCAN_EVENT_PACKET) {
+        return;
+    }
+
+    noteFill();
+    size_t written = encodePacket(blocks[fillIndex] + blockLength[fillIndex],
+                                  PCAP_BLOCK_BYTES - blockLength[fillIndex], event, noiseFloor);
+    if (written == 0 && closeFillBlock()) {
+        noteFill();
+        written = encodePacket(blocks[fillIndex], PCAP_BLOCK_BYTES, event, noiseFloor);
+    }
+    if (written == 0) {
+        stats.dropped++;
+        return;
+    }
+    blockLength[fillIndex] += (uint16_t)written;
+    stats.packets++;
+}
+
+void pcapExportService() {
+    // A quiet capture still reaches the host within PCAP_FLUSH_MS
+    if (blockLength[fillIndex] > 0 && millis() - fillStartMs >= PCAP_FLUSH_MS) {
+        closeFillBlock();
+    }
+
+    for (int i = 0; i < PCAP_LINES_PER_PASS && readyCount > 0; i++) {
+        if (!sendLine()) {
+            break;
+        }
+    }
+}
+
+bool pcapExportPending() {
+    return readyCount > 0;
+}
+
+void pcapExportGetStats(PcapExportStats* out) {
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
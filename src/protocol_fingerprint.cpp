@@ -0,0 +1,264 @@
+/**
+ * Protocol Fingerprint Module Implementation
+ *
+ * Raw captures start shortly after the radio's preamble detector fires, so
+ * the first bits are the tail of the preamble (alternating 1010...). The bit
+ * stream is decimated to the estimated emitter rate, the end of the preamble
+ * is located, and the following 16 bits form the header word (usually the
+ * protocol's sync word). The exact bit where the preamble ends is ambiguous
+ * by one bit, so both alignments are tried during lookup.
+ */
+
+#include "protocol_fingerprint.h"
+#include "drone_detection.h"
+
+// ============================================================================
+// Known Protocol Fingerprints
+// ============================================================================
+
+typedef struct {
+    const char* name;           // Protocol name
+    uint16_t headerWord;        // Expected header word after preamble
+    uint16_t headerMask;        // Bits of headerWord that must match
+    uint8_t bitrateClass;       // Expected bit rate class or FINGERPRINT_ANY_RATE
+    uint8_t lengthMin;          // Length hint range (0-255 = any)
+    uint8_t lengthMax;
+    bool isDrone;               // Drone control/telemetry link
+    const char* signatureName;  // Related signature database entry (NULL if none)
+} KnownFingerprint;
+
+static const KnownFingerprint knownFingerprints[] = {
+    // SiK firmware (RFD900, 3DR radios): Si1000 packet handler, sync 0x2DD4
+    // Air rates 4-250 kbps, so any bit rate class is accepted
+    {
+        .name = "RFD900/SiK",
+        .headerWord = 0x2DD4,
+        .headerMask = 0xFFFF,
+        .bitrateClass = FINGERPRINT_ANY_RATE,
+        .lengthMin = 0,
+        .lengthMax = 255,
+        .isDrone = true,
+        .signatureName = "RFD900/SiK"
+    },
+    // SX12xx FSK left at the RadioLib default sync word (DIY telemetry)
+    {
+        .name = "SX12xx FSK",
+        .headerWord = 0x12AD,
+        .headerMask = 0xFFFF,
+        .bitrateClass = FINGERPRINT_ANY_RATE,
+        .lengthMin = 0,
+        .lengthMax = 255,
+        .isDrone = true,
+        .signatureName = "FSK Telemetry"
+    },
+    // TI CC1101 default sync word (DIY remotes and sensors)
+    {
+        .name = "CC1101 Link",
+        .headerWord = 0xD391,
+        .headerMask = 0xFFFF,
+        .bitrateClass = FINGERPRINT_ANY_RATE,
+        .lengthMin = 0,
+        .lengthMax = 255,
+        .isDrone = false,
+        .signatureName = NULL
+    },
+    // Z-Wave (908.4/916 MHz): SOF 0xF0 followed by the home ID
+    // Common 900 MHz emitter that must not be reported as a drone
+    {
+        .name = "Z-Wave",
+        .headerWord = 0xF000,
+        .headerMask = 0xFF00,
+        .bitrateClass = FINGERPRINT_ANY_RATE,
+        .lengthMin = 0,
+        .lengthMax = 255,
+        .isDrone = false,
+        .signatureName = NULL
+    }
+};
+
+static const size_t NUM_FINGERPRINTS = sizeof(knownFingerprints) / sizeof(knownFingerprints[0]);
+
+// Slot holds index + 1 into knownFingerprints, 0 = empty
+static uint8_t fingerprintTable[FINGERPRINT_TABLE_SIZE];
+static int8_t fingerprintSignature[sizeof(knownFingerprints) / sizeof(knownFingerprints[0])];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline uint8_t getBit(const uint8_t* data, size_t bit) {
+    return (data[bit >> 3] >> (7 - (bit & 7))) & 0x01;
+}
+
+static inline uint32_t tableSlot(uint16_t headerWord) {
+    // Keyed on the high byte, which every table mask covers
+    uint8_t key = (uint8_t)(headerWord >> 8);
+    return (((uint32_t)key * 0x9E3779B1UL) >> 24) & (FINGERPRINT_TABLE_SIZE - 1);
+}
+
+static uint32_t fnv1a(const uint8_t* data, size_t length) {
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static uint16_t readBits(const uint8_t* bits, size_t start, size_t count) {
+    uint16_t value = 0;
+    for (size_t i = 0; i < count; i++) {
+        value = (uint16_t)((value << 1) | bits[start + i]);
+    }
+    return value;
+}
+
+static const KnownFingerprint* lookup(uint16_t headerWord, uint8_t bitrateClass,
+                                      uint8_t length, size_t* index) {
+    uint32_t slot = tableSlot(headerWord);
+
+    for (size_t probe = 0; probe < FINGERPRINT_TABLE_SIZE; probe++) {
+        uint8_t entry = fingerprintTable[(slot + probe) & (FINGERPRINT_TABLE_SIZE - 1)];
+        if (entry == 0) {
+            break;
+        }
+
+        const KnownFingerprint* known = &knownFingerprints[entry - 1];
+        if ((headerWord & known->headerMask) != known->headerWord) {
+            continue;
+        }
+        if (known->bitrateClass != FINGERPRINT_ANY_RATE &&
+            abs((int)known->bitrateClass - (int)bitrateClass) > 1) {
+            continue;
+        }
+        if (length < known->lengthMin || length > known->lengthMax) {
+            continue;
+        }
+
+        *index = entry - 1;
+        return known;
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void fingerprintInit() {
+    memset(fingerprintTable, 0, sizeof(fingerprintTable));
+
+    for (size_t i = 0; i < NUM_FINGERPRINTS; i++) {
+        uint32_t slot = tableSlot(knownFingerprints[i].headerWord);
+        while (fingerprintTable[slot] != 0) {
+            slot = (slot + 1) & (FINGERPRINT_TABLE_SIZE - 1);
+        }
+        fingerprintTable[slot] = (uint8_t)(i + 1);
+
+        fingerprintSignature[i] = knownFingerprints[i].signatureName != NULL
+                                      ? (int8_t)findSignature(knownFingerprints[i].signatureName)
+                                      : -1;
+    }
+}
+
+uint8_t fingerprintBitrateClass(float bitrateKbps) {
+    if (bitrateKbps <= 1.2f) {
+        return 0;
+    }
+    return (uint8_t)lroundf(2.0f * log2f(bitrateKbps / 1.2f));
+}
+
+bool fingerprintCapture(const uint8_t* data, size_t length, float captureBitrate,
+                        ProtocolFingerprint* fingerprint) {
+    if (data == NULL || fingerprint == NULL || length == 0) {
+        return false;
+    }
+
+    memset(fingerprint, 0, sizeof(*fingerprint));
+    fingerprint->signatureIndex = -1;
+
+    size_t totalBits = min(length, (size_t)RAW_CAPTURE_LENGTH) * 8;
+
+    // Run lengths over the leading preamble: the modal run is the number of
+    // capture samples per emitter bit
+    uint8_t runHistogram[9] = {0};
+    size_t bit = 0;
+    while (bit < min(totalBits, (size_t)64)) {
+        uint8_t value = getBit(data, bit);
+        size_t run = 1;
+        while (bit + run < totalBits && getBit(data, bit + run) == value) {
+            run++;
+        }
+        runHistogram[min(run, (size_t)8)]++;
+        bit += run;
+    }
+    uint8_t samplesPerBit = 1;
+    for (uint8_t r = 2; r < 8; r++) {
+        if (runHistogram[r] > runHistogram[samplesPerBit]) {
+            samplesPerBit = r;
+        }
+    }
+
+    fingerprint->bitrateKbps = captureBitrate / samplesPerBit;
+    fingerprint->bitrateClass = fingerprintBitrateClass(fingerprint->bitrateKbps);
+
+    // Decimate to one value per emitter bit
+    uint8_t bits[RAW_CAPTURE_LENGTH * 8];
+    size_t numBits = 0;
+    bit = 0;
+    while (bit < totalBits) {
+        uint8_t value = getBit(data, bit);
+        size_t run = 1;
+        while (bit + run < totalBits && getBit(data, bit + run) == value) {
+            run++;
+        }
+        size_t emitted = max((size_t)1, (run + samplesPerBit / 2) / samplesPerBit);
+        for (size_t i = 0; i < emitted && numBits < sizeof(bits); i++) {
+            bits[numBits++] = value;
+        }
+        bit += run;
+    }
+
+    // Preamble ends at the first repeated bit
+    size_t preambleEnd = 1;
+    while (preambleEnd < numBits && bits[preambleEnd] != bits[preambleEnd - 1]) {
+        preambleEnd++;
+    }
+    if (preambleEnd < FINGERPRINT_MIN_PREAMBLE || preambleEnd + 24 > numBits) {
+        return false;
+    }
+
+    // The header starts either at or one bit before the repeated bit
+    for (size_t candidate = 0; candidate < 2; candidate++) {
+        size_t start = preambleEnd - 1 + candidate;
+        uint16_t headerWord = readBits(bits, start, 16);
+        uint8_t lengthHint = (uint8_t)readBits(bits, start + 16, 8);
+
+        if (candidate == 0) {
+            // Report the first alignment when nothing matches
+            fingerprint->headerWord = headerWord;
+            fingerprint->length = lengthHint;
+        }
+
+        size_t index;
+        const KnownFingerprint* known = lookup(headerWord, fingerprint->bitrateClass,
+                                               lengthHint, &index);
+        if (known != NULL) {
+            fingerprint->headerWord = headerWord;
+            fingerprint->length = lengthHint;
+            fingerprint->name = known->name;
+            fingerprint->isDrone = known->isDrone;
+            fingerprint->signatureIndex = fingerprintSignature[index];
+            break;
+        }
+    }
+
+    uint8_t headerBytes[2] = {
+        (uint8_t)(fingerprint->headerWord >> 8),
+        (uint8_t)(fingerprint->headerWord & 0xFF)
+    };
+    fingerprint->headerHash = fnv1a(headerBytes, sizeof(headerBytes));
+
+    return fingerprint->name != NULL;
+}
@@ -0,0 +1,123 @@
+/**
+ * Report Codec Module Implementation
+ */
+
+#include "report_codec.h"
+#include <string.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void sealFrame(uint8_t* data, size_t payloadLength) {
+    uint32_t crc = reportCrc32(data, payloadLength);
+    memcpy(data + payloadLength, &crc, sizeof(crc));
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+uint32_t reportCrc32(const uint8_t* data, size_t length) {
+    // Bitwise: a few frames a minute do not justify a table
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+size_t reportEncode(const ReportHeader* header, const ReportEntry* entries, uint8_t* frame) {
+    if (header->count > REPORT_MAX_ENTRIES) {
+        return 0;
+    }
+
+    ReportHeader out = *header;
+    out.magic = REPORT_MAGIC;
+    out.versionHops = (REPORT_VERSION << 4) | REPORT_HOP_LIMIT;
+    memcpy(frame, &out, sizeof(out));
+
+    size_t offset = sizeof(out);
+    memcpy(frame + offset, entries, out.count * sizeof(ReportEntry));
+    offset += out.count * sizeof(ReportEntry);
+    sealFrame(frame, offset);
+    return offset + sizeof(uint32_t);
+}
+
+bool reportDecode(const uint8_t* data, size_t length, ReportHeader* header) {
+    ReportHeader decoded;
+
+    if (data == NULL || length < sizeof(decoded) + sizeof(uint32_t) || data[0] != REPORT_MAGIC) {
+        return false;
+    }
+
+    memcpy(&decoded, data, sizeof(decoded));
+    size_t payloadLength = sizeof(decoded) + decoded.count * sizeof(ReportEntry);
+    if ((decoded.versionHops >> 4) != REPORT_VERSION ||
+        decoded.count > REPORT_MAX_ENTRIES ||
+        length != payloadLength + sizeof(uint32_t)) {
+        return false;
+    }
+
+    uint32_t crc;
+    memcpy(&crc, data + payloadLength, sizeof(crc));
+    if (reportCrc32(data, payloadLength) != crc) {
+        return false;
+    }
+
+    if (header != NULL) {
+        *header = decoded;
+    }
+    return true;
+}
+
+void reportGetEntry(const uint8_t* data, uint8_t index, ReportEntry* entry) {
+    memcpy(entry, data + sizeof(ReportHeader) + index * sizeof(ReportEntry), sizeof(*entry));
+}
+
+void reportSeenReset(ReportSeenCache* cache) {
+    // Node 0xFFFF never reports sequence 0xFFFF in a cache's lifetime
+    memset(cache, 0xFF, sizeof(*cache));
+    cache->next = 0;
+}
+
+bool reportMarkSeen(ReportSeenCache* cache, uint16_t nodeId, uint16_t sequence) {
+    for (int i = 0; i < REPORT_SEEN_CACHE; i++) {
+        if (cache->nodeId[i] == nodeId && cache->sequence[i] == sequence) {
+            return false;
+        }
+    }
+    cache->nodeId[cache->next] = nodeId;
+    cache->sequence[cache->next] = sequence;
+    cache->next = (cache->next + 1) % REPORT_SEEN_CACHE;
+    return true;
+}
+
+ReportRxResult reportReceive(ReportSeenCache* cache, const uint8_t* data, size_t length,
+                             uint8_t* relay) {
+    ReportHeader header;
+
+    if (!reportDecode(data, length, &header)) {
+        return REPORT_RX_INVALID;
+    }
+
+    // A valid report is never treated as a detection, even if already seen
+    if (!reportMarkSeen(cache, header.nodeId, header.sequence)) {
+        return REPORT_RX_DUPLICATE;
+    }
+
+    uint8_t hops = header.versionHops & 0x0F;
+    if (hops == 0) {
+        return REPORT_RX_NEW;
+    }
+
+    // Relay with one hop fewer remaining
+    size_t payloadLength = length - sizeof(uint32_t);
+    memcpy(relay, data, payloadLength);
+    relay[1] = (uint8_t)((REPORT_VERSION << 4) | (hops - 1));
+    sealFrame(relay, payloadLength);
+    return REPORT_RX_RELAY;
+}
@@ -0,0 +1,283 @@
+/**
+ * Scan Configuration Module Implementation
+ *
+ * Settings are written by the main loop only. Scanner tasks never read
+ * them: each gets its own ScanPlan through scannerSetPlan(), which is
+ * copied under a lock and applied by the task itself.
+ */
+
+#include "scan_config.h"
+#include "noise_floor.h"
+#include <Preferences.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+#define CONFIG_MAGIC    0x53434631UL    // "SCF1"
+#define NVS_NAMESPACE   "scancfg"
+#define NVS_KEY_CONFIG  "cfg"
+
+// Saved settings
+typedef struct {
+    uint32_t magic;
+    ScanConfig config;
+} SavedConfig;
+
+// LoRa bandwidths the SX126x supports (kHz)
+static const float loraBandwidths[] = {
+    7.8f, 10.4f, 15.6f, 20.8f, 31.25f, 41.7f, 62.5f, 125.0f, 250.0f, 500.0f
+};
+
+static ScanConfig current;
+static DroneScanner* scanners[MAX_SCANNERS];
+static uint8_t scannerCount = 0;
+static bool thresholdPending = false;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static float channelFrequency(uint16_t channel) {
+    return FREQ_900_MIN + channel * (SWEEP_STEP_KHZ / 1000.0f);
+}
+
+/**
+ * Scanner's share of the band plan: an even split of the swept channels
+ */
+static void planFor(const ScanConfig* config, uint8_t index, uint8_t count, ScanPlan* plan) {
+    uint16_t steps = (config->lastChannel - config->firstChannel) / config->channelStride + 1;
+    uint16_t startStep = (uint16_t)((uint32_t)index * steps / count);
+    uint16_t endStep = (uint16_t)((uint32_t)(index + 1) * steps / count) - 1;
+
+    plan->firstChannel = config->firstChannel + startStep * config->channelStride;
+    plan->lastChannel = config->firstChannel + endStep * config->channelStride;
+    plan->channelStride = config->channelStride;
+    plan->modulationMask = config->modulationMask;
+    plan->dwellMs = config->dwellMs;
+    plan->modulationMs = config->modulationMs;
+    plan->loraSpreadingFactor = config->loraSpreadingFactor;
+    plan->loraBandwidth = config->loraBandwidth;
+}
+
+static void stagePlans() {
+    for (uint8_t i = 0; i < scannerCount; i++) {
+        ScanPlan plan;
+        planFor(&current, i, scannerCount, &plan);
+        scannerSetPlan(scanners[i], &plan);
+    }
+}
+
+static void printModulations(uint8_t mask) {
+    bool first = true;
+    for (int m = MOD_LORA; m < MOD_UNKNOWN; m++) {
+        if (mask & MOD_MASK(m)) {
+            if (!first) {
+                Serial.print(',');
+            }
+            Serial.print(getModulationName((ModulationType)m));
+            first = false;
+        }
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void scanConfigDefaults(ScanConfig* config) {
+    if (config == NULL) {
+        return;
+    }
+    memset(config, 0, sizeof(*config));
+    config->firstChannel = 0;
+    config->lastChannel = (uint16_t)NUM_SWEEP_CHANNELS - 1;
+    config->channelStride = 1;
+    config->modulationMask = MOD_MASK_ALL;
+    config->dwellMs = SWEEP_DWELL_MS;
+    config->modulationMs = SCANNER_MODULATION_MS;
+    config->loraSpreadingFactor = LORA_SPREADING_FACTOR;
+    config->loraBandwidth = LORA_BANDWIDTH;
+    config->detectMarginDb = NOISE_DETECT_MARGIN_DB;
+    config->detectSpreadK = NOISE_DETECT_SPREAD_K;
+}
+
+const char* scanConfigCheck(const ScanConfig* config) {
+    if (config == NULL) {
+        return "no settings";
+    }
+    if (config->firstChannel > config->lastChannel ||
+        config->lastChannel >= (uint16_t)NUM_SWEEP_CHANNELS) {
+        return "band outside the sweep range";
+    }
+    if (config->channelStride == 0) {
+        return "step must be a multiple of the channel grid";
+    }
+    uint16_t steps = (config->lastChannel - config->firstChannel) / config->channelStride + 1;
+    if (steps < max(scannerCount, (uint8_t)1)) {
+        return "fewer channels than scanners";
+    }
+    if ((config->modulationMask & MOD_MASK_ALL) == 0 || (config->modulationMask & ~MOD_MASK_ALL) != 0) {
+        return "no valid modulation";
+    }
+    if (config->dwellMs < SCAN_CONFIG_MIN_DWELL_MS || config->dwellMs > SCAN_CONFIG_MAX_DWELL_MS) {
+        return "dwell out of range";
+    }
+    if (config->modulationMs < SCAN_CONFIG_MIN_MODULATION_MS ||
+        config->modulationMs > SCAN_CONFIG_MAX_MODULATION_MS) {
+        return "modulation time out of range";
+    }
+    if (config->loraSpreadingFactor < 5 || config->loraSpreadingFactor > 12) {
+        return "spreading factor must be 5-12";
+    }
+    bool bandwidthValid = false;
+    for (size_t i = 0; i < sizeof(loraBandwidths) / sizeof(loraBandwidths[0]); i++) {
+        bandwidthValid |= fabsf(config->loraBandwidth - loraBandwidths[i]) < 0.01f;
+    }
+    if (!bandwidthValid) {
+        return "unsupported LoRa bandwidth";
+    }
+    if (!(config->detectMarginDb >= 0.0f && config->detectMarginDb <= SCAN_CONFIG_MAX_MARGIN_DB) ||
+        !(config->detectSpreadK >= 0.0f && config->detectSpreadK <= SCAN_CONFIG_MAX_SPREAD_K)) {
+        return "threshold out of range";
+    }
+    return NULL;
+}
+
+bool scanConfigInit() {
+    scanConfigDefaults(&current);
+
+    bool restored = false;
+    SavedConfig saved;
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, true)) {
+        if (prefs.getBytesLength(NVS_KEY_CONFIG) == sizeof(saved) &&
+            prefs.getBytes(NVS_KEY_CONFIG, &saved, sizeof(saved)) == sizeof(saved) &&
+            saved.magic == CONFIG_MAGIC && scanConfigCheck(&saved.config) == NULL) {
+            current = saved.config;
+            restored = true;
+        }
+        prefs.end();
+    }
+
+    noiseFloorSetThresholds(current.detectMarginDb, current.detectSpreadK);
+    if (restored) {
+        Serial.println(F("[Config] Restored scan settings from NVS"));
+    }
+    return restored;
+}
+
+const ScanConfig* scanConfigGet() {
+    return &current;
+}
+
+bool scanConfigSet(const ScanConfig* config) {
+    if (scanConfigCheck(config) != NULL) {
+        return false;
+    }
+    current = *config;
+    stagePlans();
+    thresholdPending = true;
+
+    SavedConfig saved;
+    memset(&saved, 0, sizeof(saved));
+    saved.magic = CONFIG_MAGIC;
+    saved.config = current;
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, false)) {
+        prefs.putBytes(NVS_KEY_CONFIG, &saved, sizeof(saved));
+        prefs.end();
+    }
+    return true;
+}
+
+void scanConfigAttach(DroneScanner* const* list, uint8_t count) {
+    scannerCount = 0;
+    for (uint8_t i = 0; i < count && scannerCount < MAX_SCANNERS; i++) {
+        if (list[i] != NULL && list[i]->initialized) {
+            scanners[scannerCount++] = list[i];
+        }
+    }
+
+    // Settings saved with more scanners attached may not split any more
+    if (scanConfigCheck(&current) != NULL) {
+        Serial.println(F("[Config] Saved band plan does not fit the scanners, using defaults"));
+        scanConfigDefaults(&current);
+        noiseFloorSetThresholds(current.detectMarginDb, current.detectSpreadK);
+    }
+
+    stagePlans();
+    for (uint8_t i = 0; i < scannerCount; i++) {
+        scannerApplyPlan(scanners[i]);
+    }
+}
+
+bool scanConfigPending() {
+    for (uint8_t i = 0; i < scannerCount; i++) {
+        if (scanners[i]->planPending) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void scanConfigService() {
+    if (!thresholdPending || scanConfigPending()) {
+        return;
+    }
+    noiseFloorSetThresholds(current.detectMarginDb, current.detectSpreadK);
+    thresholdPending = false;
+    Serial.println(F("[Config] New scan settings active on all scanners"));
+}
+
+void scanConfigPrint() {
+    Serial.print(F("[Config] Band "));
+    Serial.print(channelFrequency(current.firstChannel), 3);
+    Serial.print(F("-"));
+    Serial.print(channelFrequency(current.lastChannel), 3);
+    Serial.print(F(" MHz (channels "));
+    Serial.print(current.firstChannel);
+    Serial.print(F("-"));
+    Serial.print(current.lastChannel);
+    Serial.print(F("), step "));
+    Serial.print(current.channelStride * SWEEP_STEP_KHZ, 0);
+    Serial.print(F(" kHz, dwell "));
+    Serial.print(current.dwellMs);
+    Serial.println(F(" ms"));
+
+    Serial.print(F("[Config] Modulations "));
+    printModulations(current.modulationMask);
+    Serial.print(F(", "));
+    Serial.print(current.modulationMs);
+    Serial.print(F(" ms each; LoRa SF"));
+    Serial.print(current.loraSpreadingFactor);
+    Serial.print(F(" BW "));
+    Serial.print(current.loraBandwidth, 2);
+    Serial.println(F(" kHz"));
+
+    Serial.print(F("[Config] Threshold floor + max("));
+    Serial.print(current.detectMarginDb, 1);
+    Serial.print(F(" dB, "));
+    Serial.print(current.detectSpreadK, 1);
+    Serial.println(thresholdPending ? F(" x spread) (pending)") : F(" x spread)"));
+
+    for (uint8_t i = 0; i < scannerCount; i++) {
+        ScanPlan plan;
+        scannerGetPlan(scanners[i], &plan);
+        Serial.print(F("[Config] Scanner "));
+        Serial.print(scanners[i]->index);
+        Serial.print(F(": channels "));
+        Serial.print(plan.firstChannel);
+        Serial.print(F("-"));
+        Serial.print(plan.lastChannel);
+        Serial.print(F(" step "));
+        Serial.print(plan.channelStride);
+        Serial.print(F(", dwell "));
+        Serial.print(plan.dwellMs);
+        Serial.print(F(" ms, "));
+        printModulations(plan.modulationMask);
+        Serial.print(F(", SF"));
+        Serial.print(plan.loraSpreadingFactor);
+        Serial.println(scanners[i]->planPending ? F(" (change pending)") : F(""));
+    }
+}
@@ -0,0 +1,552 @@
+/**
+ * Scanner Task Module Implementation
+ */
+
+#include "scanner_task.h"
+#include "noise_floor.h"
+#include "mesh_report.h"
+#include "timebase.h"
+#include "low_power.h"
+#include "arena.h"
+#include "coverage.h"
+#include "lock_on.h"
+#include "hier_sweep.h"
+#include "detection_log.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+// Task notification bits
+#define NOTIFY_DIO1             (1UL << 0)    // Radio interrupt
+#define NOTIFY_DWELL            (1UL << 1)    // Dwell timer expired
+
+typedef struct {
+    DroneScanner* scanner;          // Scanner driven by the task
+    SemaphoreHandle_t busLock;      // Shared SPI bus lock (NULL if dedicated)
+    TaskHandle_t task;              // Scanner task
+    esp_timer_handle_t dwellTimer;  // One-shot dwell expiry timer
+    int64_t dwellStartUs;           // Counter value when the current dwell began
+    uint32_t dwellUs;               // Length the current dwell was armed for
+    volatile int64_t irqCounterUs;  // DIO1 interrupt time (esp_timer counter)
+    volatile int64_t irqUtcUs;      // DIO1 interrupt time as UTC
+    volatile bool waiting;          // Blocked waiting for a notification
+    bool reportWindow;              // Listening on the report channel
+    ScannerTaskStats stats;         // Task statistics
+    StaticTask_t taskBuffer;        // Task control block
+} ScannerContext;
+
+static ScannerContext contexts[MAX_SCANNERS];
+static QueueHandle_t eventQueue = NULL;
+static StaticQueue_t eventQueueBuffer;
+
+// ============================================================================
+// Interrupt Handling
+// ============================================================================
+
+// RadioLib DIO1 callbacks take no argument, so each scanner slot has its
+// own entry point
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+static void scannerIsr(int index) {
+    ScannerContext* ctx = &contexts[index];
+    BaseType_t woken = pdFALSE;
+
+    // Timestamp in the ISR so packet timing is free of task latency
+    int64_t counter = esp_timer_get_time();
+    ctx->irqCounterUs = counter;
+    ctx->irqUtcUs = timebaseToUtcUs(counter);
+    if (ctx->task != NULL) {
+        xTaskNotifyFromISR(ctx->task, NOTIFY_DIO1, eSetBits, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+static void scannerIsr0() { scannerIsr(0); }
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+static void scannerIsr1() { scannerIsr(1); }
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+static void scannerIsr2() { scannerIsr(2); }
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+static void scannerIsr3() { scannerIsr(3); }
+
+static void (*const scannerIsrs[MAX_SCANNERS])() = {
+    scannerIsr0, scannerIsr1, scannerIsr2, scannerIsr3
+};
+
+static void dwellExpired(void* arg) {
+    ScannerContext* ctx = (ScannerContext*)arg;
+    xTaskNotify(ctx->task, NOTIFY_DWELL, eSetBits);
+}
+
+// ============================================================================
+// Bus Arbitration
+// ============================================================================
+
+static void busAcquire(ScannerContext* ctx) {
+    if (ctx->busLock != NULL) {
+        xSemaphoreTake(ctx->busLock, portMAX_DELAY);
+    }
+}
+
+static void busRelease(ScannerContext* ctx) {
+    if (ctx->busLock != NULL) {
+        xSemaphoreGive(ctx->busLock);
+    }
+}
+
+// ============================================================================
+// Scanner Task
+// ============================================================================
+
+static void recordTiming(float* mean, uint32_t* worst, int64_t sampleUs) {
+    uint32_t value = (uint32_t)min(max(sampleUs, (int64_t)0), (int64_t)UINT32_MAX);
+    *mean += SCANNER_TIMING_EWMA * ((float)value - *mean);
+    *worst = max(*worst, value);
+}
+
+/**
+ * Arm the dwell timer (radio already receiving on the channel)
+ */
+static void armWindow(ScannerContext* ctx, uint32_t windowUs) {
+    ctx->dwellStartUs = esp_timer_get_time();
+    ctx->dwellUs = windowUs;
+    esp_timer_stop(ctx->dwellTimer);
+    esp_timer_start_once(ctx->dwellTimer, ctx->dwellUs);
+}
+
+/**
+ * Start timing a new dwell of the sweep
+ */
+static void startDwell(ScannerContext* ctx) {
+    armWindow(ctx, (uint32_t)ctx->scanner->dwellMs * 1000);
+}
+
+/**
+ * Put the radio in receive mode: continuous, or RX duty cycle in the
+ * low-power mode (bus lock held)
+ */
+static void startListening(ScannerContext* ctx) {
+    DroneScanner* scanner = ctx->scanner;
+    LowPowerWindow window;
+    if (lowPowerGetWindow(scanner, &window)) {
+        scanner->radio->startReceiveDutyCycle(window.rxUs, window.sleepUs);
+    } else {
+        scanner->radio->startReceive();
+    }
+}
+
+static void postEvent(ScannerContext* ctx, const ScanEvent* event) {
+    if (xQueueSend(eventQueue, event, 0) != pdTRUE) {
+        ctx->stats.dropped++;
+    }
+}
+
+/**
+ * Read a received packet into an event (bus lock held)
+ */
+static bool readPacket(ScannerContext* ctx, ScanEvent* event) {
+    DroneScanner* scanner = ctx->scanner;
+    SX1262* radio = scanner->radio;
+
+    size_t length = min(radio->getPacketLength(), (size_t)SCAN_EVENT_MAX_DATA);
+    int state = radio->readData(event->data, length);
+    if (state != RADIOLIB_ERR_NONE) {
+        ctx->stats.readErrors++;
+        return false;
+    }
+
+    event->type = SCAN_EVENT_PACKET;
+    event->scanner = scanner->index;
+    event->rssi = radio->getRSSI();
+    event->snr = radio->getSNR();
+    event->freqError = radio->getFrequencyError();
+    if (ctx->reportWindow) {
+        event->modulation = MOD_LORA;
+        event->frequency = REPORT_FREQUENCY;
+        event->bitrateKbps = 0.0f;
+        event->bandwidthKhz = REPORT_BANDWIDTH;
+        event->spreadingFactor = REPORT_SPREADING_FACTOR;
+    } else {
+        event->modulation = scanner->modulation;
+        event->frequency = scanner->sweepFrequency;
+        event->bitrateKbps = scannerCaptureBitrate(scanner);
+        bool lora = scanner->modulation == MOD_LORA;
+        event->bandwidthKhz = lora ? scanner->loraBandwidth : 0.0f;
+        event->spreadingFactor = lora ? scanner->loraSpreadingFactor : 0;
+        lockOnAnnotate(scanner->index, event);
+    }
+    event->timestampUs = (uint32_t)ctx->irqCounterUs;
+    event->utcUs = ctx->irqUtcUs;
+    event->length = (uint16_t)length;
+    ctx->stats.packets++;
+    return true;
+}
+
+/**
+ * Tell the main loop a sweep ended, behind the events of its dwells
+ */
+static void postSweepEnd(ScannerContext* ctx, ScanEvent* event, ModulationType modulation,
+                         uint16_t firstChannel, uint16_t lastChannel) {
+    event->type = SCAN_EVENT_SWEEP;
+    event->scanner = ctx->scanner->index;
+    event->modulation = modulation;
+    event->frequency = ctx->scanner->sweepFrequency;
+    event->firstChannel = firstChannel;
+    event->lastChannel = lastChannel;
+    event->length = 0;
+    postEvent(ctx, event);
+}
+
+/**
+ * Move to the next cell of the sweep at the end of a dwell or a lock-on
+ * session and start listening there (bus lock held)
+ * @param lastModulationSwitch Time of the last modulation switch (millis)
+ * @param event Scratch event for the low-power noise sample
+ * @param leftUs Counter time the previous cell was left
+ */
+static void nextDwell(ScannerContext* ctx, uint32_t* lastModulationSwitch, ScanEvent* event,
+                      int64_t leftUs) {
+    DroneScanner* scanner = ctx->scanner;
+
+    if (millis() - *lastModulationSwitch > scanner->modulationMs) {
+        // Periodically switch modulation type, restarting the sweep;
+        // a staged plan starts here too
+        coverageSweepEnd(scanner->index, false);
+        postSweepEnd(ctx, event, scanner->modulation, scanner->firstChannel,
+                     scanner->lastChannel);
+        scannerNextModulation(scanner);
+        scannerResetSweep(scanner);
+        scannerApplyPlan(scanner);
+        *lastModulationSwitch = millis();
+        hierSweepPass(scanner, false);
+    } else {
+        // Detection reports go out between dwells; the retune
+        // below restores the scan configuration
+        if (scanner->index == 0 && meshReportTransmit(scanner->radio)) {
+            // Discard the TX done interrupt
+            xTaskNotifyWait(0, NOTIFY_DIO1, NULL, 0);
+        }
+        // Sweep frequency scanning for FHSS detection; a wrap or a
+        // new plan ends the sweep (a wrap may land on the same channel
+        // when the sweep visits only one)
+        uint32_t previousSweeps = scanner->sweepCount;
+        bool planWasPending = scanner->planPending;
+        uint16_t firstChannel = scanner->firstChannel;
+        uint16_t lastChannel = scanner->lastChannel;
+        ModulationType modulation = scanner->modulation;
+        scannerSweepNext(scanner);
+        if (scanner->sweepCount != previousSweeps ||
+            (planWasPending && !scanner->planPending)) {
+            coverageSweepEnd(scanner->index, true);
+            postSweepEnd(ctx, event, modulation, firstChannel, lastChannel);
+            // A new sweep starts with the coarse energy pass
+            hierSweepPass(scanner, true);
+        }
+    }
+
+    // A due log sector erase stalls the flash cache on both cores: run it
+    // now, while this scanner is between dwells, not in the middle of one
+    detectionLogEraseAhead();
+
+    if (lowPowerEnabled()) {
+        // A duty-cycled radio has no valid RSSI, so take the noise
+        // sample in a short continuous listen on the new channel
+        scanner->radio->startReceive();
+        delayMicroseconds(LOW_POWER_NOISE_SETTLE_US);
+        if (scannerSampleNoise(scanner, &event->rssi)) {
+            event->type = SCAN_EVENT_NOISE;
+            event->scanner = scanner->index;
+            event->modulation = scanner->modulation;
+            event->frequency = scanner->sweepFrequency;
+            event->length = 0;
+            postEvent(ctx, event);
+        }
+    }
+    startListening(ctx);
+    int64_t listeningUs = esp_timer_get_time();
+    coverageEnter(scanner->index, frequencyToSweepChannel(scanner->sweepFrequency),
+                  scanner->modulation, leftUs, listeningUs);
+    hierSweepNoteDwell(scanner, listeningUs);
+    startDwell(ctx);
+}
+
+/**
+ * Leave the sweep for a lock-on session on the current channel (bus lock
+ * held)
+ * @param triggerUs Counter time of the trigger
+ * @return true if a session started and its first window is armed
+ */
+static bool startLock(ScannerContext* ctx, int64_t triggerUs) {
+    DroneScanner* scanner = ctx->scanner;
+    int64_t leftUs = esp_timer_get_time();
+    if (!lockOnStart(scanner, triggerUs)) {
+        return false;
+    }
+    coverageLeave(scanner->index, leftUs);
+    startListening(ctx);
+    coverageEnter(scanner->index, frequencyToSweepChannel(scanner->sweepFrequency),
+                  scanner->modulation, leftUs, esp_timer_get_time());
+    armWindow(ctx, lockOnWindowUs(scanner->index, esp_timer_get_time()));
+    return true;
+}
+
+static void scannerTaskMain(void* param) {
+    ScannerContext* ctx = (ScannerContext*)param;
+    DroneScanner* scanner = ctx->scanner;
+    ScanEvent event;
+
+    uint32_t lastModulationSwitch = millis();
+
+    // Static task creation returns the handle only after the task may
+    // already be running
+    ctx->task = xTaskGetCurrentTaskHandle();
+
+    busAcquire(ctx);
+    startListening(ctx);
+    busRelease(ctx);
+    int64_t listeningUs = esp_timer_get_time();
+    coverageEnter(scanner->index, frequencyToSweepChannel(scanner->sweepFrequency),
+                  scanner->modulation, listeningUs, listeningUs);
+    startDwell(ctx);
+
+    for (;;) {
+        // Block until a packet interrupt or the end of the dwell; the
+        // timeout only paces background noise sampling, which the
+        // low-power mode does once per dwell instead
+        uint32_t bits = 0;
+        ctx->waiting = true;
+        xTaskNotifyWait(0, NOTIFY_DIO1 | NOTIFY_DWELL, &bits,
+                        lowPowerEnabled() ? portMAX_DELAY : pdMS_TO_TICKS(NOISE_FLOOR_SAMPLE_MS));
+        ctx->waiting = false;
+
+        if (bits & NOTIFY_DIO1) {
+            recordTiming(&ctx->stats.latencyMeanUs, &ctx->stats.latencyMaxUs,
+                         esp_timer_get_time() - ctx->irqCounterUs);
+        }
+
+        busAcquire(ctx);
+
+        if (bits & NOTIFY_DIO1) {
+            // The radio is blind from the interrupt until it is re-armed
+            int64_t serviceStartUs = esp_timer_get_time();
+            bool received = readPacket(ctx, &event);
+            if (received) {
+                postEvent(ctx, &event);
+                if (!ctx->reportWindow) {
+                    lockOnPacket(scanner, ctx->irqCounterUs);
+                }
+            }
+            if (ctx->reportWindow) {
+                // A report window is not a scan cell: keep listening
+                scanner->radio->startReceive();
+            } else {
+                startListening(ctx);
+                int64_t stallUs = max(serviceStartUs - ctx->irqCounterUs, (int64_t)0);
+                coverageLost(scanner->index, (uint32_t)min(stallUs, (int64_t)UINT32_MAX),
+                             (uint32_t)(esp_timer_get_time() - serviceStartUs));
+
+                // A failed read is the right channel with wrong or marginal
+                // parameters; the session's window replaces the dwell
+                if (!received && !lockOnActive(scanner->index) &&
+                    startLock(ctx, ctx->irqCounterUs)) {
+                    bits &= ~NOTIFY_DWELL;
+                }
+            }
+        } else if (!(bits & NOTIFY_DWELL) && !lowPowerEnabled() && !ctx->reportWindow &&
+                   !lockOnActive(scanner->index) && scannerSampleNoise(scanner, &event.rssi)) {
+            // No packet pending - sample channel background for the noise floor
+            event.type = SCAN_EVENT_NOISE;
+            event.scanner = scanner->index;
+            event.modulation = scanner->modulation;
+            event.frequency = scanner->sweepFrequency;
+            event.length = 0;
+            postEvent(ctx, &event);
+
+            // Energy well above the threshold that the sweep parameters
+            // do not demodulate
+            if (lockOnEnergyTrigger(scanner, event.rssi)) {
+                startLock(ctx, esp_timer_get_time());
+            }
+        }
+
+        if (ctx->reportWindow) {
+            if (bits & NOTIFY_DWELL) {
+                // End of a report listen window: back to the sweep on the
+                // next channel
+                ctx->reportWindow = false;
+                nextDwell(ctx, &lastModulationSwitch, &event, esp_timer_get_time());
+            }
+        } else if ((bits & NOTIFY_DWELL) && lockOnActive(scanner->index)) {
+            // End of a lock-on window: next candidate, keep following, or
+            // back to the sweep on the next channel
+            int64_t leftUs = esp_timer_get_time();
+            coverageLeave(scanner->index, leftUs);
+            if (lockOnStep(scanner, leftUs)) {
+                startListening(ctx);
+                coverageEnter(scanner->index, frequencyToSweepChannel(scanner->sweepFrequency),
+                              scanner->modulation, leftUs, esp_timer_get_time());
+                armWindow(ctx, lockOnWindowUs(scanner->index, esp_timer_get_time()));
+            } else {
+                nextDwell(ctx, &lastModulationSwitch, &event, leftUs);
+            }
+        } else if (bits & NOTIFY_DWELL) {
+            int64_t dwellUs = esp_timer_get_time() - ctx->dwellStartUs;
+            int64_t errorUs = dwellUs - (int64_t)ctx->dwellUs;
+            recordTiming(&ctx->stats.dwellJitterMeanUs, &ctx->stats.dwellJitterMaxUs,
+                         errorUs < 0 ? -errorUs : errorUs);
+            ctx->stats.dwells++;
+
+            // Everything from here until the radio listens again is
+            // reconfiguration time of the next cell
+            int64_t leftUs = esp_timer_get_time();
+            coverageLeave(scanner->index, leftUs);
+
+            // Reports from other nodes are only heard with the report
+            // PHY, in a window at the start of their slots
+            uint32_t windowUs;
+            if (scanner->index == 0 && meshReportListen(scanner->radio, &windowUs)) {
+                ctx->reportWindow = true;
+                armWindow(ctx, windowUs);
+            } else {
+                nextDwell(ctx, &lastModulationSwitch, &event, leftUs);
+            }
+        }
+
+        busRelease(ctx);
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+SemaphoreHandle_t scannerCreateBusLock() {
+    return xSemaphoreCreateMutex();
+}
+
+bool scannerTaskStart(DroneScanner* scanner, SemaphoreHandle_t busLock, BaseType_t core) {
+    if (scanner == NULL || !scanner->initialized || scanner->index >= MAX_SCANNERS) {
+        return false;
+    }
+
+    if (eventQueue == NULL) {
+        // Event slots double as the packet buffers: internal RAM, touched
+        // for every packet
+        uint8_t* storage = (uint8_t*)arenaAlloc(ARENA_INTERNAL,
+                                                SCAN_EVENT_QUEUE_DEPTH * sizeof(ScanEvent), "events");
+        if (storage != NULL) {
+            eventQueue = xQueueCreateStatic(SCAN_EVENT_QUEUE_DEPTH, sizeof(ScanEvent), storage,
+                                            &eventQueueBuffer);
+        }
+        if (eventQueue == NULL) {
+            Serial.println(F("[Scanner] Failed to create event queue"));
+            return false;
+        }
+    }
+
+    ScannerContext* ctx = &contexts[scanner->index];
+    if (ctx->task != NULL) {
+        return false;
+    }
+    ctx->scanner = scanner;
+    ctx->busLock = busLock;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+
+    if (ctx->dwellTimer == NULL) {
+        esp_timer_create_args_t args = {};
+        args.callback = dwellExpired;
+        args.arg = ctx;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "dwell";
+        if (esp_timer_create(&args, &ctx->dwellTimer) != ESP_OK) {
+            Serial.println(F("[Scanner] Failed to create dwell timer"));
+            return false;
+        }
+    }
+
+    // The task clears any pending interrupt when it starts receiving
+    busAcquire(ctx);
+    scanner->radio->setDio1Action(scannerIsrs[scanner->index]);
+    busRelease(ctx);
+
+    char name[8];
+    snprintf(name, sizeof(name), "scan%u", scanner->index);
+    StackType_t* stack = (StackType_t*)arenaAlloc(ARENA_INTERNAL, SCANNER_TASK_STACK, name);
+    if (stack != NULL) {
+        ctx->task = xTaskCreateStaticPinnedToCore(scannerTaskMain, name, SCANNER_TASK_STACK, ctx,
+                                                  SCANNER_TASK_PRIORITY, stack, &ctx->taskBuffer,
+                                                  core);
+    }
+    if (ctx->task == NULL) {
+        Serial.println(F("[Scanner] Failed to create scanner task"));
+        return false;
+    }
+
+    Serial.print(F("[Scanner] Scanner "));
+    Serial.print(scanner->index);
+    Serial.print(F(" covering channels "));
+    Serial.print(scanner->firstChannel);
+    Serial.print(F("-"));
+    Serial.print(scanner->lastChannel);
+    Serial.print(F(" on core "));
+    Serial.println(core);
+
+    return true;
+}
+
+bool scannerNextEvent(ScanEvent* event, TickType_t timeout) {
+    if (event == NULL || eventQueue == NULL) {
+        return false;
+    }
+    return xQueueReceive(eventQueue, event, timeout) == pdTRUE;
+}
+
+bool scannerTasksIdle() {
+    if (eventQueue != NULL && uxQueueMessagesWaiting(eventQueue) > 0) {
+        return false;
+    }
+    for (int i = 0; i < MAX_SCANNERS; i++) {
+        if (contexts[i].task != NULL && !contexts[i].waiting) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void scannerTaskKick(uint8_t index, int64_t sinceUs) {
+    if (index >= MAX_SCANNERS || contexts[index].task == NULL) {
+        return;
+    }
+    ScannerContext* ctx = &contexts[index];
+
+    // Keep the interrupt's own timestamp if it did fire
+    if (ctx->irqCounterUs < sinceUs) {
+        int64_t counter = esp_timer_get_time();
+        ctx->irqCounterUs = counter;
+        ctx->irqUtcUs = timebaseToUtcUs(counter);
+    }
+    xTaskNotify(ctx->task, NOTIFY_DIO1, eSetBits);
+}
+
+void scannerTaskGetStats(uint8_t index, ScannerTaskStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (index >= MAX_SCANNERS) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = contexts[index].stats;
+}
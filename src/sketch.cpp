@@ -0,0 +1,383 @@
+/**
+ * Sketch Module Implementation
+ *
+ * HyperLogLog: the top SKETCH_HLL_BITS of a hash pick a register, which
+ * keeps the largest rank (leading zeros + 1) of the remaining bits. The
+ * estimate is the bias-corrected harmonic mean of 2^register, with linear
+ * counting while many registers are still empty. Count-min: each row maps
+ * a key to one counter with its own hash; the smallest of the rows' counts
+ * is the estimate.
+ *
+ * Slices roll with time like the coverage epochs. Window queries merge
+ * into one scratch slice, so a query costs the same however busy the band
+ * was. Everything runs in the main loop.
+ */
+
+#include "sketch.h"
+#include "arena.h"
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+#define FNV_OFFSET          2166136261UL
+#define FNV_PRIME           16777619UL
+
+// Sketches of one time slice
+typedef struct {
+    uint32_t packets;
+    HllSketch hll[SKETCH_KINDS];
+    CountMinSketch cms;
+    SketchHeavyHitter heavy[SKETCH_HEAVY_MAX];  // Busiest keys of the slice
+    uint8_t heavyCount;
+} SketchSlice;
+
+static SketchSlice* slices = NULL;          // SKETCH_SLICES + 1 scratch (PSRAM)
+static SketchSlice* window = NULL;          // Scratch for merged windows
+static uint8_t currentSlice = 0;
+static uint8_t slicesFilled = 1;
+static uint32_t sliceStartMs = 0;
+
+// Per-row seeds of the count-min hashes and per-kind hash seeds
+static const uint32_t cmsSeeds[SKETCH_CMS_DEPTH] = {
+    0x9E3779B9UL, 0x85EBCA6BUL, 0xC2B2AE35UL, 0x27D4EB2FUL
+};
+static const uint32_t kindSeeds[SKETCH_KINDS] = {
+    0x5BD1E995UL, 0x1B873593UL, 0xCC9E2D51UL
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline uint32_t mix32(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85EBCA6BUL;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35UL;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline uint16_t cmsColumn(uint32_t key, int row) {
+    return (uint16_t)(mix32(key ^ cmsSeeds[row]) & (SKETCH_CMS_WIDTH - 1));
+}
+
+/**
+ * Slices covering a window ending now, at least the current one
+ */
+static uint8_t windowSlices(uint32_t windowMs) {
+    uint32_t count = (windowMs + SKETCH_SLICE_MS - 1) / SKETCH_SLICE_MS;
+    return (uint8_t)constrain(count, (uint32_t)1, (uint32_t)slicesFilled);
+}
+
+static uint32_t windowLengthMs(uint8_t count) {
+    return (uint32_t)(count - 1) * SKETCH_SLICE_MS + (millis() - sliceStartMs);
+}
+
+static SketchSlice* sliceAgo(uint8_t age) {
+    return &slices[(currentSlice + SKETCH_SLICES - age) % SKETCH_SLICES];
+}
+
+/**
+ * Merge the last count slices into the scratch slice
+ */
+static void mergeWindow(uint8_t count) {
+    memset(window, 0, sizeof(SketchSlice));
+    for (uint8_t age = 0; age < count; age++) {
+        const SketchSlice* slice = sliceAgo(age);
+        window->packets += slice->packets;
+        for (int kind = 0; kind < SKETCH_KINDS; kind++) {
+            hllMerge(&window->hll[kind], &slice->hll[kind]);
+        }
+        cmsMerge(&window->cms, &slice->cms);
+    }
+}
+
+/**
+ * Keep the slice's busiest keys: replace the weakest candidate when full
+ */
+static void noteHeavy(SketchSlice* slice, uint32_t key, uint32_t estimate) {
+    int weakest = 0;
+    for (int i = 0; i < slice->heavyCount; i++) {
+        if (slice->heavy[i].key == key) {
+            slice->heavy[i].packets = estimate;
+            return;
+        }
+        if (slice->heavy[i].packets < slice->heavy[weakest].packets) {
+            weakest = i;
+        }
+    }
+    if (slice->heavyCount < SKETCH_HEAVY_MAX) {
+        weakest = slice->heavyCount++;
+    } else if (estimate <= slice->heavy[weakest].packets) {
+        return;
+    }
+    slice->heavy[weakest].key = key;
+    slice->heavy[weakest].packets = estimate;
+}
+
+static void printHex(const uint8_t* bytes, size_t length) {
+    static const char digits[] = "0123456789abcdef";
+    char text[64];
+    size_t used = 0;
+    for (size_t i = 0; i < length; i++) {
+        text[used++] = digits[bytes[i] >> 4];
+        text[used++] = digits[bytes[i] & 0x0F];
+        if (used == sizeof(text) || i + 1 == length) {
+            Serial.write((const uint8_t*)text, used);
+            used = 0;
+        }
+    }
+}
+
+// ============================================================================
+// Sketch Primitives
+// ============================================================================
+
+uint32_t sketchHash(const uint8_t* data, size_t length, uint32_t seed) {
+    uint32_t h = FNV_OFFSET ^ seed;
+    for (size_t i = 0; i < length; i++) {
+        h = (h ^ data[i]) * FNV_PRIME;
+    }
+    return mix32(h ^ (uint32_t)length);
+}
+
+void hllAdd(HllSketch* hll, uint32_t hash) {
+    uint32_t index = hash >> (32 - SKETCH_HLL_BITS);
+    uint32_t rest = hash << SKETCH_HLL_BITS;
+    uint8_t rank = rest == 0 ? (32 - SKETCH_HLL_BITS + 1) : (uint8_t)(__builtin_clz(rest) + 1);
+    if (rank > hll->registers[index]) {
+        hll->registers[index] = rank;
+    }
+}
+
+void hllMerge(HllSketch* dst, const HllSketch* src) {
+    for (int i = 0; i < SKETCH_HLL_REGISTERS; i++) {
+        dst->registers[i] = max(dst->registers[i], src->registers[i]);
+    }
+}
+
+float hllEstimate(const HllSketch* hll) {
+    const float m = SKETCH_HLL_REGISTERS;
+    float sum = 0.0f;
+    int zeros = 0;
+    for (int i = 0; i < SKETCH_HLL_REGISTERS; i++) {
+        sum += ldexpf(1.0f, -hll->registers[i]);
+        if (hll->registers[i] == 0) {
+            zeros++;
+        }
+    }
+    float estimate = (0.7213f / (1.0f + 1.079f / m)) * m * m / sum;
+    if (estimate <= 2.5f * m && zeros > 0) {
+        estimate = m * logf(m / zeros);
+    }
+    return estimate;
+}
+
+void cmsAdd(CountMinSketch* cms, uint32_t key, uint32_t count) {
+    for (int row = 0; row < SKETCH_CMS_DEPTH; row++) {
+        uint32_t* counter = &cms->counts[row][cmsColumn(key, row)];
+        *counter = *counter > UINT32_MAX - count ? UINT32_MAX : *counter + count;
+    }
+}
+
+void cmsMerge(CountMinSketch* dst, const CountMinSketch* src) {
+    for (int row = 0; row < SKETCH_CMS_DEPTH; row++) {
+        for (int column = 0; column < SKETCH_CMS_WIDTH; column++) {
+            uint32_t sum = dst->counts[row][column] + src->counts[row][column];
+            dst->counts[row][column] = sum < dst->counts[row][column] ? UINT32_MAX : sum;
+        }
+    }
+}
+
+uint32_t cmsEstimate(const CountMinSketch* cms, uint32_t key) {
+    uint32_t estimate = UINT32_MAX;
+    for (int row = 0; row < SKETCH_CMS_DEPTH; row++) {
+        estimate = min(estimate, cms->counts[row][cmsColumn(key, row)]);
+    }
+    return estimate;
+}
+
+// ============================================================================
+// Windowed Sketch Functions
+// ============================================================================
+
+void sketchInit() {
+    if (slices == NULL) {
+        slices = (SketchSlice*)arenaAlloc(ARENA_PSRAM, (SKETCH_SLICES + 1) * sizeof(SketchSlice),
+                                          "sketch");
+    } else {
+        memset(slices, 0, (SKETCH_SLICES + 1) * sizeof(SketchSlice));
+    }
+    window = slices != NULL ? &slices[SKETCH_SLICES] : NULL;
+    currentSlice = 0;
+    slicesFilled = 1;
+    sliceStartMs = millis();
+}
+
+void sketchNotePacket(uint32_t transmitterKey, ModulationType modulation,
+                      const uint8_t* data, uint16_t length) {
+    if (slices == NULL) {
+        return;
+    }
+    if (millis() - sliceStartMs >= SKETCH_SLICE_MS) {
+        sketchService();
+    }
+
+    SketchSlice* slice = &slices[currentSlice];
+    slice->packets++;
+
+    hllAdd(&slice->hll[SKETCH_TRANSMITTERS],
+           sketchHash((const uint8_t*)&transmitterKey, sizeof(transmitterKey),
+                      kindSeeds[SKETCH_TRANSMITTERS]));
+    if (data != NULL && length > 0) {
+        hllAdd(&slice->hll[SKETCH_PAYLOADS],
+               sketchHash(data, length, kindSeeds[SKETCH_PAYLOADS]));
+    }
+
+    // Header: what a protocol fixes per frame type, not per frame
+    uint8_t header[3 + SKETCH_HEADER_BYTES];
+    uint16_t headerBytes = data != NULL ? min(length, (uint16_t)SKETCH_HEADER_BYTES) : 0;
+    header[0] = (uint8_t)modulation;
+    header[1] = (uint8_t)(length & 0xFF);
+    header[2] = (uint8_t)(length >> 8);
+    if (headerBytes > 0) {
+        memcpy(&header[3], data, headerBytes);
+    }
+    hllAdd(&slice->hll[SKETCH_HEADERS], sketchHash(header, 3 + headerBytes,
+                                                   kindSeeds[SKETCH_HEADERS]));
+
+    cmsAdd(&slice->cms, transmitterKey, 1);
+    noteHeavy(slice, transmitterKey, cmsEstimate(&slice->cms, transmitterKey));
+}
+
+void sketchService() {
+    if (slices == NULL) {
+        return;
+    }
+    uint32_t behind = (millis() - sliceStartMs) / SKETCH_SLICE_MS;
+    if (behind == 0) {
+        return;
+    }
+    // Slices older than the ring are cleared, not replayed
+    sliceStartMs += behind * SKETCH_SLICE_MS;
+    behind = min(behind, (uint32_t)SKETCH_SLICES);
+    while (behind-- > 0) {
+        currentSlice = (currentSlice + 1) % SKETCH_SLICES;
+        memset(&slices[currentSlice], 0, sizeof(SketchSlice));
+        if (slicesFilled < SKETCH_SLICES) {
+            slicesFilled++;
+        }
+    }
+}
+
+bool sketchQuery(uint32_t windowMs, SketchSummary* summary) {
+    if (slices == NULL || summary == NULL) {
+        return false;
+    }
+    uint8_t count = windowSlices(windowMs);
+    mergeWindow(count);
+    summary->windowMs = windowLengthMs(count);
+    summary->packets = window->packets;
+    for (int kind = 0; kind < SKETCH_KINDS; kind++) {
+        summary->distinct[kind] = hllEstimate(&window->hll[kind]);
+    }
+    return true;
+}
+
+uint8_t sketchHeavyHitters(uint32_t windowMs, SketchHeavyHitter* out, uint8_t maxCount) {
+    if (slices == NULL || out == NULL || maxCount == 0) {
+        return 0;
+    }
+    uint8_t slicesInWindow = windowSlices(windowMs);
+    mergeWindow(slicesInWindow);
+
+    // Candidates are the slices' busiest keys, ranked on the window's counts
+    uint8_t count = 0;
+    for (uint8_t age = 0; age < slicesInWindow; age++) {
+        const SketchSlice* slice = sliceAgo(age);
+        for (int c = 0; c < slice->heavyCount; c++) {
+            uint32_t key = slice->heavy[c].key;
+            bool listed = false;
+            for (int i = 0; i < count && !listed; i++) {
+                listed = out[i].key == key;
+            }
+            uint32_t packets = cmsEstimate(&window->cms, key);
+            if (listed || (count == maxCount && packets <= out[count - 1].packets)) {
+                continue;
+            }
+            int position = count < maxCount ? count++ : maxCount - 1;
+            while (position > 0 && out[position - 1].packets < packets) {
+                out[position] = out[position - 1];
+                position--;
+            }
+            out[position].key = key;
+            out[position].packets = packets;
+        }
+    }
+    return count;
+}
+
+void sketchExport(uint32_t windowMs) {
+    if (slices == NULL) {
+        return;
+    }
+    uint8_t count = windowSlices(windowMs);
+    mergeWindow(count);
+    uint32_t windowS = windowLengthMs(count) / 1000;
+
+    for (int kind = 0; kind < SKETCH_KINDS; kind++) {
+        Serial.print(F("HLL,"));
+        Serial.print(sketchKindName((SketchKind)kind));
+        Serial.print(',');
+        Serial.print(windowS);
+        Serial.print(',');
+        Serial.print(SKETCH_HLL_BITS);
+        Serial.print(',');
+        printHex(window->hll[kind].registers, SKETCH_HLL_REGISTERS);
+        Serial.println();
+    }
+    for (int row = 0; row < SKETCH_CMS_DEPTH; row++) {
+        Serial.print(F("CMS,"));
+        Serial.print(windowS);
+        Serial.print(',');
+        Serial.print(row);
+        Serial.print(',');
+        Serial.print(SKETCH_CMS_WIDTH);
+        Serial.print(',');
+        for (int column = 0; column < SKETCH_CMS_WIDTH; column++) {
+            // Big-endian so the hex reads as the number
+            uint32_t value = window->cms.counts[row][column];
+            uint8_t bytes[4] = { (uint8_t)(value >> 24), (uint8_t)(value >> 16),
+                                 (uint8_t)(value >> 8), (uint8_t)value };
+            printHex(bytes, sizeof(bytes));
+        }
+        Serial.println();
+    }
+}
+
+void sketchReport(uint32_t windowMs) {
+    SketchSummary summary;
+    if (!sketchQuery(windowMs, &summary)) {
+        return;
+    }
+    Serial.print(F("UNIQ,"));
+    Serial.print(summary.windowMs / 1000);
+    Serial.print(',');
+    Serial.print(summary.packets);
+    for (int kind = 0; kind < SKETCH_KINDS; kind++) {
+        Serial.print(',');
+        Serial.print(summary.distinct[kind], 0);
+    }
+    Serial.println();
+}
+
+const char* sketchKindName(SketchKind kind) {
+    switch (kind) {
+        case SKETCH_TRANSMITTERS: return "transmitters";
+        case SKETCH_PAYLOADS:     return "payloads";
+        case SKETCH_HEADERS:      return "headers";
+        default:                  return "unknown";
+    }
+}
@@ -0,0 +1,259 @@
+/**
+ * Spectrum Codec Module Implementation
+ */
+
+#include "spectrum_codec.h"
+#include <string.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+// Decoder parser states
+#define DECODE_FLAGS            0
+#define DECODE_SEQUENCE         1
+#define DECODE_FIRST            2
+#define DECODE_COUNT            3
+#define DECODE_TOKENS           4
+
+#define VARINT_MAX_SHIFT        21        // Longest varint accepted (3 bytes)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static size_t putVarint(uint8_t* out, size_t length, size_t outSize, uint32_t value) {
+    do {
+        if (length >= outSize) {
+            return outSize + 1;
+        }
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        out[length++] = value != 0 ? (byte | 0x80) : byte;
+    } while (value != 0);
+    return length;
+}
+
+static uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static void resetDecoder(SpectrumDecoder* decoder) {
+    decoder->state = DECODE_FLAGS;
+    decoder->varint = 0;
+    decoder->shift = 0;
+}
+
+/**
+ * Prediction of a channel: the previous row, or within a keyframe the
+ * channel before it
+ */
+static uint8_t decodePrediction(const SpectrumDecoder* decoder) {
+    if (decoder->flags & SPEC_FLAG_KEYFRAME) {
+        return decoder->position > 0 ? decoder->work[decoder->position - 1] : 0;
+    }
+    return decoder->work[decoder->position];
+}
+
+/**
+ * Whether the frame being parsed is a keyframe or the next delta frame of
+ * the stream
+ */
+static bool continuesStream(const SpectrumDecoder* decoder) {
+    if (decoder->flags & SPEC_FLAG_KEYFRAME) {
+        return true;
+    }
+    return decoder->primed && decoder->sequence == (uint8_t)(decoder->lastSequence + 1) &&
+           decoder->frameFirst == decoder->first && decoder->frameCount == decoder->count;
+}
+
+/**
+ * Finish a frame: accept it if it continues the stream
+ */
+static SpectrumDecodeResult finishFrame(SpectrumDecoder* decoder) {
+    resetDecoder(decoder);
+    if (!continuesStream(decoder)) {
+        decoder->primed = false;
+        return SPEC_DECODE_SKIPPED;
+    }
+    decoder->first = decoder->frameFirst;
+    decoder->count = decoder->frameCount;
+    memcpy(decoder->row, decoder->work, decoder->count);
+    decoder->lastSequence = decoder->sequence;
+    decoder->primed = true;
+    return SPEC_DECODE_ROW;
+}
+
+static SpectrumDecodeResult failFrame(SpectrumDecoder* decoder) {
+    resetDecoder(decoder);
+    decoder->primed = false;
+    return SPEC_DECODE_ERROR;
+}
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+void spectrumEncoderInit(SpectrumEncoder* encoder, uint8_t deadband, uint16_t keyframeRows) {
+    if (encoder == NULL) {
+        return;
+    }
+    memset(encoder, 0, sizeof(*encoder));
+    encoder->deadband = deadband;
+    encoder->keyframeRows = keyframeRows > 0 ? keyframeRows : 1;
+}
+
+size_t spectrumEncode(SpectrumEncoder* encoder, uint8_t tag, uint16_t first,
+                      const uint8_t* row, uint16_t count, uint8_t* out, size_t outSize) {
+    if (encoder == NULL || row == NULL || out == NULL || count == 0 ||
+        count > SPEC_MAX_CHANNELS || tag > 7) {
+        return 0;
+    }
+
+    bool keyframe = !encoder->primed || tag != encoder->tag || first != encoder->first ||
+                    count != encoder->count || encoder->sinceKeyframe + 1 >= encoder->keyframeRows;
+
+    size_t length = 0;
+    if (outSize < 2) {
+        return 0;
+    }
+    out[length++] = (uint8_t)((SPEC_VERSION << 4) | (tag << 1) | (keyframe ? SPEC_FLAG_KEYFRAME : 0));
+    out[length++] = encoder->sequence;
+    length = putVarint(out, length, outSize, first);
+    length = putVarint(out, length, outSize, count);
+
+    // reference[] becomes the row the decoder reconstructs, so deadband
+    // errors never accumulate
+    uint8_t* reference = encoder->reference;
+    uint16_t run = 0;
+    for (uint16_t c = 0; c < count; c++) {
+        uint8_t prediction = keyframe ? (c > 0 ? reference[c - 1] : 0) : reference[c];
+        uint8_t value = row[c];
+        if (!keyframe && value == 0) {
+            // No sample: keep the previous value
+            value = prediction;
+        }
+        int delta = (int)value - (int)prediction;
+        if (value != 0 && prediction != 0 && delta >= -encoder->deadband &&
+            delta <= encoder->deadband) {
+            delta = 0;
+        }
+
+        if (delta == 0) {
+            reference[c] = prediction;
+            run++;
+            continue;
+        }
+        if (run > 0) {
+            length = putVarint(out, length, outSize, ((uint32_t)(run - 1) << 1) | 1);
+            run = 0;
+        }
+        length = putVarint(out, length, outSize, zigzag(delta) << 1);
+        reference[c] = value;
+    }
+    if (run > 0) {
+        length = putVarint(out, length, outSize, ((uint32_t)(run - 1) << 1) | 1);
+    }
+    if (length > outSize) {
+        // Too small a buffer: the stream restarts with a keyframe
+        encoder->primed = false;
+        return 0;
+    }
+
+    encoder->sequence++;
+    encoder->tag = tag;
+    encoder->first = first;
+    encoder->count = count;
+    encoder->sinceKeyframe = keyframe ? 0 : encoder->sinceKeyframe + 1;
+    encoder->primed = true;
+    return length;
+}
+
+// ============================================================================
+// Decoder
+// ============================================================================
+
+void spectrumDecoderInit(SpectrumDecoder* decoder) {
+    if (decoder == NULL) {
+        return;
+    }
+    memset(decoder, 0, sizeof(*decoder));
+}
+
+SpectrumDecodeResult spectrumDecoderPush(SpectrumDecoder* decoder, uint8_t byte) {
+    if (decoder == NULL) {
+        return SPEC_DECODE_ERROR;
+    }
+
+    switch (decoder->state) {
+        case DECODE_FLAGS:
+            if ((byte >> 4) != SPEC_VERSION) {
+                return failFrame(decoder);
+            }
+            decoder->flags = byte;
+            decoder->state = DECODE_SEQUENCE;
+            return SPEC_DECODE_MORE;
+        case DECODE_SEQUENCE:
+            decoder->sequence = byte;
+            decoder->state = DECODE_FIRST;
+            return SPEC_DECODE_MORE;
+        default:
+            break;
+    }
+
+    // The rest of the frame is varints
+    decoder->varint |= (uint32_t)(byte & 0x7F) << decoder->shift;
+    if (byte & 0x80) {
+        decoder->shift += 7;
+        return decoder->shift > VARINT_MAX_SHIFT ? failFrame(decoder) : SPEC_DECODE_MORE;
+    }
+    uint32_t value = decoder->varint;
+    decoder->varint = 0;
+    decoder->shift = 0;
+
+    switch (decoder->state) {
+        case DECODE_FIRST:
+            decoder->frameFirst = (uint16_t)(value > UINT16_MAX ? UINT16_MAX : value);
+            decoder->state = DECODE_COUNT;
+            return SPEC_DECODE_MORE;
+        case DECODE_COUNT:
+            if (value == 0 || value > SPEC_MAX_CHANNELS) {
+                return failFrame(decoder);
+            }
+            decoder->frameCount = (uint16_t)value;
+            decoder->position = 0;
+            memcpy(decoder->work, decoder->row, sizeof(decoder->work));
+            decoder->state = DECODE_TOKENS;
+            return SPEC_DECODE_MORE;
+        default:
+            break;
+    }
+
+    if (value & 1) {
+        uint32_t run = (value >> 1) + 1;
+        if (run > (uint32_t)(decoder->frameCount - decoder->position)) {
+            return failFrame(decoder);
+        }
+        for (uint32_t i = 0; i < run; i++) {
+            decoder->work[decoder->position] = decodePrediction(decoder);
+            decoder->position++;
+        }
+    } else {
+        int32_t result = (int32_t)decodePrediction(decoder) + unzigzag(value >> 1);
+        // A dropped delta frame predicts from a stale row, so only its
+        // structure is checked (as tools/spectrum_decode.py skips it unparsed)
+        if (value == 0 || ((result < 0 || result > 255) && continuesStream(decoder))) {
+            return failFrame(decoder);
+        }
+        decoder->work[decoder->position++] = (uint8_t)result;
+    }
+    return decoder->position == decoder->frameCount ? finishFrame(decoder) : SPEC_DECODE_MORE;
+}
+
+uint8_t spectrumDecoderTag(const SpectrumDecoder* decoder) {
+    return decoder != NULL ? (decoder->flags >> 1) & 0x07 : 0;
+}
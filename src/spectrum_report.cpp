@@ -0,0 +1,168 @@
+/**
+ * Spectrum Report Module Implementation
+ */
+
+#include "spectrum_report.h"
+#include "occupancy.h"
+#include "scanner_task.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+static uint8_t rows[MAX_SCANNERS][SPEC_MAX_CHANNELS];   // Open row per scanner
+static SpectrumEncoder encoders[MAX_SCANNERS];
+static bool encodersReady = false;
+static bool enabled = SPEC_REPORT_ENABLED;
+static SpectrumReportStats stats;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void printFrame(uint8_t scanner, const uint8_t* frame, size_t length) {
+    static const char digits[] = "0123456789ABCDEF";
+    char hex[2 * SPEC_MAX_FRAME];
+    for (size_t i = 0; i < length; i++) {
+        hex[2 * i] = digits[frame[i] >> 4];
+        hex[2 * i + 1] = digits[frame[i] & 0x0F];
+    }
+    Serial.print(F("SPEC,"));
+    Serial.print(scanner);
+    Serial.print(',');
+    Serial.write((const uint8_t*)hex, 2 * length);
+    Serial.println();
+}
+
+static void initEncoders() {
+    if (encodersReady) {
+        return;
+    }
+    for (int i = 0; i < MAX_SCANNERS; i++) {
+        spectrumEncoderInit(&encoders[i], SPEC_DEADBAND_STEPS, SPEC_KEYFRAME_ROWS);
+    }
+    encodersReady = true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void spectrumReportNote(uint8_t scanner, int channel, float rssi, bool busy) {
+    if (scanner >= MAX_SCANNERS || channel < 0 || channel >= SPEC_MAX_CHANNELS) {
+        return;
+    }
+    uint8_t value = busy ? occupancyQuantize(rssi) : (uint8_t)SPEC_QUIET;
+    rows[scanner][channel] = max(rows[scanner][channel], value);
+}
+
+void spectrumReportSweepEnd(uint8_t scanner, ModulationType modulation,
+                            uint16_t firstChannel, uint16_t lastChannel) {
+    if (scanner >= MAX_SCANNERS || firstChannel > lastChannel ||
+        lastChannel >= SPEC_MAX_CHANNELS) {
+        return;
+    }
+    initEncoders();
+
+    uint8_t frame[SPEC_MAX_FRAME];
+    uint16_t count = lastChannel - firstChannel + 1;
+    int64_t startUs = esp_timer_get_time();
+    size_t length = spectrumEncode(&encoders[scanner], (uint8_t)modulation, firstChannel,
+                                   &rows[scanner][firstChannel], count, frame, sizeof(frame));
+    uint32_t encodeUs = (uint32_t)(esp_timer_get_time() - startUs);
+    memset(rows[scanner], 0, sizeof(rows[scanner]));
+    if (length == 0) {
+        return;
+    }
+
+    stats.rows++;
+    stats.rawBytes += count;
+    stats.encodedBytes += length;
+    stats.encodeMeanUs += SCANNER_TIMING_EWMA * ((float)encodeUs - stats.encodeMeanUs);
+    stats.encodeMaxUs = max(stats.encodeMaxUs, encodeUs);
+
+    if (enabled) {
+        printFrame(scanner, frame, length);
+    }
+}
+
+void spectrumReportEnable(bool enable) {
+    enabled = enable;
+}
+
+bool spectrumReportEnabled() {
+    return enabled;
+}
+
+void spectrumReportBenchmark(uint16_t rowCount) {
+    SpectrumEncoder encoder;
+    SpectrumDecoder decoder;
+    spectrumEncoderInit(&encoder, SPEC_DEADBAND_STEPS, SPEC_KEYFRAME_ROWS);
+    spectrumDecoderInit(&decoder);
+
+    uint16_t count = min((uint16_t)NUM_SWEEP_CHANNELS, (uint16_t)SPEC_MAX_CHANNELS);
+    uint8_t row[OCC_CHANNELS];
+    uint8_t frame[SPEC_MAX_FRAME];
+    uint32_t replayed = 0;
+    uint32_t encodedBytes = 0;
+    uint32_t totalUs = 0;
+    uint32_t worstUs = 0;
+    int maxError = 0;
+
+    for (int32_t ago = (int32_t)rowCount - 1; ago >= 0; ago--) {
+        if (!occupancyRow((uint16_t)ago, row)) {
+            continue;
+        }
+        // Code the row as spectrumReportNote() would have
+        for (uint16_t c = 0; c < count; c++) {
+            if (row[c] != 0 && !occupancyRowActive(c, (uint16_t)ago)) {
+                row[c] = SPEC_QUIET;
+            }
+        }
+        int64_t startUs = esp_timer_get_time();
+        size_t length = spectrumEncode(&encoder, 0, 0, row, count, frame, sizeof(frame));
+        uint32_t encodeUs = (uint32_t)(esp_timer_get_time() - startUs);
+        totalUs += encodeUs;
+        worstUs = max(worstUs, encodeUs);
+        encodedBytes += length;
+        replayed++;
+
+        // Decode as the host would and check the reconstruction error
+        for (size_t i = 0; i < length; i++) {
+            if (spectrumDecoderPush(&decoder, frame[i]) != SPEC_DECODE_ROW) {
+                continue;
+            }
+            for (uint16_t c = 0; c < count; c++) {
+                if (row[c] != 0) {
+                    maxError = max(maxError, abs((int)decoder.row[c] - (int)row[c]));
+                }
+            }
+        }
+    }
+
+    // SPECBENCH,<rows>,<raw bytes>,<encoded bytes>,<ratio>,<encode mean us>,
+    // <encode max us>,<max error steps>
+    uint32_t rawBytes = replayed * count;
+    Serial.print(F("SPECBENCH,"));
+    Serial.print(replayed);
+    Serial.print(',');
+    Serial.print(rawBytes);
+    Serial.print(',');
+    Serial.print(encodedBytes);
+    Serial.print(',');
+    Serial.print(encodedBytes > 0 ? (float)rawBytes / encodedBytes : 0.0f, 2);
+    Serial.print(',');
+    Serial.print(replayed > 0 ? (float)totalUs / replayed : 0.0f, 1);
+    Serial.print(',');
+    Serial.print(worstUs);
+    Serial.print(',');
+    Serial.println(maxError);
+}
+
+void spectrumReportGetStats(SpectrumReportStats* out) {
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
@@ -0,0 +1,188 @@
+/**
+ * Timebase Module Implementation
+ *
+ * The servo state lives in the main loop; interrupt handlers read a copy
+ * of its mapping, republished under a spinlock after every pulse.
+ */
+
+#include "timebase.h"
+#include "gps.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+// Mapping shared with interrupt handlers
+static portMUX_TYPE mappingLock = portMUX_INITIALIZER_UNLOCKED;
+static TimebaseMapping mapping = {};
+
+// Latest PPS capture
+static portMUX_TYPE ppsLock = portMUX_INITIALIZER_UNLOCKED;
+static volatile int64_t ppsCounterUs = 0;
+static volatile uint32_t ppsPulses = 0;
+
+// Servo state (main loop only)
+static TimebaseServo servo;
+static uint32_t servicedPulses = 0;
+
+// ============================================================================
+// Mapping
+// ============================================================================
+
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+int64_t timebaseToUtcUs(int64_t counterUs) {
+    TimebaseMapping current;
+
+    portENTER_CRITICAL_ISR(&mappingLock);
+    current = mapping;
+    portEXIT_CRITICAL_ISR(&mappingLock);
+
+    return timebaseMapToUtc(&current, counterUs);
+}
+
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+int64_t timebaseUtcUs() {
+    return timebaseToUtcUs(esp_timer_get_time());
+}
+
+static void publishMapping() {
+    portENTER_CRITICAL(&mappingLock);
+    mapping = servo.mapping;
+    portEXIT_CRITICAL(&mappingLock);
+}
+
+// ============================================================================
+// PPS Capture
+// ============================================================================
+
+#if defined(GPS_PPS)
+
+#if defined(ESP32) || defined(ESP8266)
+ICACHE_RAM_ATTR
+#endif
+static void ppsIsr() {
+    int64_t counterUs = esp_timer_get_time();
+    portENTER_CRITICAL_ISR(&ppsLock);
+    ppsCounterUs = counterUs;
+    ppsPulses = ppsPulses + 1;
+    portEXIT_CRITICAL_ISR(&ppsLock);
+}
+
+#endif
+
+/**
+ * UTC second marked by a pulse captured at counterUs, from NMEA time
+ * @return false if no UTC label is available yet
+ */
+static bool labelPulse(int64_t counterUs, int64_t* utcSecond) {
+    // NMEA for a second arrives a few hundred ms after its pulse
+    int64_t utcMs;
+    if (!gpsGetUtcMs(&utcMs)) {
+        return false;
+    }
+    int64_t pulseUtcMs = utcMs - (esp_timer_get_time() - counterUs) / 1000 - TIMEBASE_NMEA_LATENCY_MS;
+    *utcSecond = (pulseUtcMs + 500) / 1000;
+    return true;
+}
+
+// ============================================================================
+// Servo
+// ============================================================================
+
+static void servicePulse(int64_t counterUs) {
+    // Consecutive pulses are labelled by counting seconds, NMEA only
+    // anchors the first one
+    int64_t utcSecond;
+    if (!timebaseServoCountPulse(&servo, counterUs, &utcSecond) &&
+        !labelPulse(counterUs, &utcSecond)) {
+        return;
+    }
+
+    bool wasLocked = servo.locked;
+    ServoPulseResult result = timebaseServoPulse(&servo, counterUs, utcSecond);
+    if (result != SERVO_PULSE_OUTLIER) {
+        publishMapping();
+    }
+
+    switch (result) {
+        case SERVO_PULSE_ANCHORED:
+            Serial.println(F("[Timebase] Anchored to PPS"));
+            break;
+        case SERVO_PULSE_STEPPED:
+            if (wasLocked) {
+                Serial.println(F("[Timebase] Stepped, PPS lock lost"));
+            }
+            break;
+        case SERVO_PULSE_LOCKED:
+            Serial.print(F("[Timebase] Locked to PPS, frequency correction "));
+            Serial.print(servo.frequencyPpb, 0);
+            Serial.println(F(" ppb"));
+            break;
+        default:
+            break;
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void timebaseInit() {
+    timebaseServoReset(&servo);
+
+#if defined(GPS_PPS)
+    pinMode(GPS_PPS, INPUT);
+    attachInterrupt(digitalPinToInterrupt(GPS_PPS), ppsIsr, RISING);
+    Serial.print(F("[Timebase] PPS on GPIO "));
+    Serial.println(GPS_PPS);
+#else
+    Serial.println(F("[Timebase] No PPS pin, timestamps are not disciplined"));
+#endif
+}
+
+void timebaseService() {
+    int64_t counter;
+    uint32_t pulses;
+
+    portENTER_CRITICAL(&ppsLock);
+    counter = ppsCounterUs;
+    pulses = ppsPulses;
+    portEXIT_CRITICAL(&ppsLock);
+
+    if (pulses != servicedPulses) {
+        // Only the latest pulse matters if several were missed
+        servicedPulses = pulses;
+        servicePulse(counter);
+    }
+
+    // Holdover: keep the learned frequency but stop claiming lock
+    if (timebaseServoHoldover(&servo, esp_timer_get_time())) {
+        Serial.println(F("[Timebase] PPS lost, holding over"));
+    }
+}
+
+bool timebaseLocked() {
+    return servo.locked;
+}
+
+void timebaseGetStats(TimebaseStats* out) {
+    if (out == NULL) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    out->anchored = servo.mapping.anchored;
+    out->locked = servo.locked;
+    out->pulses = servicedPulses;
+    out->outliers = servo.outliers;
+    out->steps = servo.steps;
+    out->phaseErrorUs = servo.phaseErrorUs;
+    out->jitterUs = servo.jitterUs;
+    out->frequencyPpb = servo.frequencyPpb;
+    out->sinceLastPulseMs = servo.lastPulseCounterUs != 0 ?
+        (uint32_t)((esp_timer_get_time() - servo.lastPulseCounterUs) / 1000) : 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * Timebase Servo Module Implementation
+ */
+
+#include "timebase_servo.h"
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+#define RATE_Q32_PER_PPB        4.294967296f    // 2^32 / 1e9
+#define MAX_RATE_PPB            (TIMEBASE_MAX_PPM * 1000.0f)
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void stepMapping(TimebaseServo* servo, int64_t counterUs, int64_t utcUs) {
+    servo->mapping.anchorCounterUs = counterUs;
+    servo->mapping.anchorUtcUs = utcUs;
+    servo->mapping.anchored = true;
+    servo->steps++;
+    servo->goodPulses = 0;
+    servo->outlierRun = 0;
+    servo->locked = false;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void timebaseServoReset(TimebaseServo* servo) {
+    memset(servo, 0, sizeof(*servo));
+}
+
+bool timebaseServoCountPulse(const TimebaseServo* servo, int64_t counterUs, int64_t* utcSecond) {
+    int64_t elapsed = counterUs - servo->lastPulseCounterUs;
+    if (!servo->mapping.anchored || servo->lastPulseCounterUs == 0 ||
+        elapsed >= (int64_t)TIMEBASE_HOLDOVER_MS * 1000) {
+        return false;
+    }
+    *utcSecond = servo->lastPulseUtcS + (elapsed + TIMEBASE_US_PER_S / 2) / TIMEBASE_US_PER_S;
+    return true;
+}
+
+ServoPulseResult timebaseServoPulse(TimebaseServo* servo, int64_t counterUs, int64_t utcSecond) {
+    int64_t intervalS = utcSecond - servo->lastPulseUtcS;
+    if (intervalS < 1) {
+        intervalS = 1;
+    }
+    servo->lastPulseCounterUs = counterUs;
+    servo->lastPulseUtcS = utcSecond;
+
+    int64_t pulseUtcUs = utcSecond * TIMEBASE_US_PER_S;
+    if (!servo->mapping.anchored) {
+        stepMapping(servo, counterUs, pulseUtcUs);
+        return SERVO_PULSE_ANCHORED;
+    }
+
+    float error = (float)(timebaseMapToUtc(&servo->mapping, counterUs) - pulseUtcUs);
+    servo->phaseErrorUs = error;
+
+    if (fabsf(error) > TIMEBASE_STEP_US) {
+        stepMapping(servo, counterUs, pulseUtcUs);
+        return SERVO_PULSE_STEPPED;
+    }
+    if (servo->locked && fabsf(error) > TIMEBASE_OUTLIER_US) {
+        // Late capture (interrupt latency spike): ignore unless persistent
+        servo->outliers++;
+        if (++servo->outlierRun >= TIMEBASE_MAX_OUTLIERS) {
+            stepMapping(servo, counterUs, pulseUtcUs);
+            return SERVO_PULSE_STEPPED;
+        }
+        return SERVO_PULSE_OUTLIER;
+    }
+    servo->outlierRun = 0;
+
+    // PI loop: the integral term is the frequency correction, the
+    // proportional term the share of phase error removed now.
+    // 1 us of error per second is 1000 ppb.
+    float ratePpb = (float)servo->mapping.rateQ32 / RATE_Q32_PER_PPB -
+                    TIMEBASE_KI * error * 1000.0f / (float)intervalS;
+    ratePpb = fminf(fmaxf(ratePpb, -MAX_RATE_PPB), MAX_RATE_PPB);
+    servo->mapping.anchorCounterUs = counterUs;
+    servo->mapping.anchorUtcUs = pulseUtcUs + (int64_t)lroundf(error * (1.0f - TIMEBASE_KP));
+    servo->mapping.rateQ32 = (int32_t)lroundf(ratePpb * RATE_Q32_PER_PPB);
+
+    servo->frequencyPpb = ratePpb;
+    servo->jitterUs += 0.1f * (fabsf(error) - servo->jitterUs);
+
+    if (fabsf(error) <= TIMEBASE_LOCK_US) {
+        if (!servo->locked && ++servo->goodPulses >= TIMEBASE_LOCK_PULSES) {
+            servo->locked = true;
+            return SERVO_PULSE_LOCKED;
+        }
+    } else if (!servo->locked) {
+        servo->goodPulses = 0;
+    }
+    return SERVO_PULSE_TRACKED;
+}
+
+bool timebaseServoHoldover(TimebaseServo* servo, int64_t counterUs) {
+    if (!servo->locked || servo->lastPulseCounterUs == 0 ||
+        counterUs - servo->lastPulseCounterUs <= (int64_t)TIMEBASE_HOLDOVER_MS * 1000) {
+        return false;
+    }
+    servo->locked = false;
+    servo->goodPulses = 0;
+    return true;
+}
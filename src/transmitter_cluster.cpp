@@ -0,0 +1,196 @@
+/**
+ * Transmitter Cluster Module Implementation
+ */
+
+#include "transmitter_cluster.h"
+#include <math.h>
+
+// ============================================================================
+// Module State
+// ============================================================================
+
+static TransmitterCluster clusters[MAX_TX_CLUSTERS];
+static uint16_t nextClusterId = 1;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * Offset predicted for a cluster after dtSeconds of drift
+ */
+static float predictCentroid(const TransmitterCluster* cluster, float dtSeconds) {
+    return cluster->centroidPpb + cluster->driftPpbPerS * dtSeconds;
+}
+
+/**
+ * Offset gate of a cluster: its spread plus the drift that could have
+ * accumulated since it was last seen
+ */
+static float clusterGate(const TransmitterCluster* cluster, float dtSeconds) {
+    float spread = max(cluster->spreadPpb, CLUSTER_MIN_SPREAD_PPB);
+    return CLUSTER_GATE_SPREADS * spread + CLUSTER_DRIFT_PPB_PER_S * dtSeconds;
+}
+
+static void clusterStart(TransmitterCluster* cluster, const DroneSignal* signal,
+                         float offsetPpb, uint32_t now) {
+    cluster->active = true;
+    cluster->id = nextClusterId++;
+    if (nextClusterId == 0) {
+        nextClusterId = 1;
+    }
+    cluster->signatureIndex = signal->signatureIndex;
+    cluster->centroidPpb = offsetPpb;
+    cluster->driftPpbPerS = 0.0f;
+    cluster->spreadPpb = CLUSTER_INITIAL_SPREAD_PPB;
+    cluster->meanRssi = signal->rssi;
+    cluster->baselinePpb = offsetPpb;
+    cluster->baselineMs = now;
+    cluster->firstSeenMs = now;
+    cluster->lastSeenMs = now;
+    cluster->hits = 1;
+}
+
+static void clusterUpdate(TransmitterCluster* cluster, const DroneSignal* signal,
+                          float offsetPpb, float dtSeconds, uint32_t now) {
+    // Alpha-beta filter: the drift term follows temperature-driven crystal
+    // drift so the centroid does not lag behind a warming transmitter
+    float predicted = predictCentroid(cluster, dtSeconds);
+    float residual = offsetPpb - predicted;
+
+    cluster->centroidPpb = predicted + CLUSTER_ALPHA * residual;
+
+    // The drift rate comes from the smoothed centroid over a long baseline;
+    // per-packet residuals over a few milliseconds would only add noise
+    uint32_t baselineMs = now - cluster->baselineMs;
+    if (baselineMs >= CLUSTER_DRIFT_BASELINE_MS) {
+        float measured = (cluster->centroidPpb - cluster->baselinePpb) * 1000.0f / baselineMs;
+        float drift = cluster->driftPpbPerS + CLUSTER_BETA * (measured - cluster->driftPpbPerS);
+        cluster->driftPpbPerS = constrain(drift, -CLUSTER_DRIFT_PPB_PER_S, CLUSTER_DRIFT_PPB_PER_S);
+        cluster->baselinePpb = cluster->centroidPpb;
+        cluster->baselineMs = now;
+    }
+    cluster->spreadPpb += CLUSTER_ALPHA * (fabsf(residual) - cluster->spreadPpb);
+    cluster->meanRssi += CLUSTER_ALPHA * (signal->rssi - cluster->meanRssi);
+    cluster->lastSeenMs = now;
+    cluster->hits++;
+}
+
+/**
+ * Absorb other clusters of the same protocol whose centroid lies within
+ * the spread of an updated cluster (duplicates started by outliers)
+ */
+static void clusterMergeDuplicates(TransmitterCluster* cluster, uint32_t now) {
+    for (int i = 0; i < MAX_TX_CLUSTERS; i++) {
+        TransmitterCluster* c = &clusters[i];
+        if (c == cluster || !c->active || c->signatureIndex != cluster->signatureIndex) {
+            continue;
+        }
+
+        float dt = (now - c->lastSeenMs) / 1000.0f;
+        float spread = max(cluster->spreadPpb, CLUSTER_MIN_SPREAD_PPB);
+        if (fabsf(predictCentroid(c, dt) - cluster->centroidPpb) > spread) {
+            continue;
+        }
+
+        // Keep the identity of the established cluster
+        if (c->hits > cluster->hits) {
+            uint16_t id = cluster->id;
+            cluster->id = c->id;
+            c->id = id;
+            cluster->firstSeenMs = c->firstSeenMs;
+        }
+        cluster->hits += c->hits;
+        c->active = false;
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void transmitterClusterInit() {
+    memset(clusters, 0, sizeof(clusters));
+    nextClusterId = 1;
+}
+
+uint32_t transmitterClusterAssign(const DroneSignal* signal) {
+    if (signal == NULL || signal->frequency <= 0.0f) {
+        return 0;
+    }
+
+    uint32_t now = millis();
+
+    // Crystal offsets scale with the carrier, so compare them in ppb
+    float offsetPpb = signal->freqError / signal->frequency * 1000.0f;
+
+    TransmitterCluster* best = NULL;
+    float bestCost = 0.0f;
+    float bestDt = 0.0f;
+    TransmitterCluster* freeSlot = NULL;
+    TransmitterCluster* oldest = NULL;
+
+    for (int i = 0; i < MAX_TX_CLUSTERS; i++) {
+        TransmitterCluster* c = &clusters[i];
+        uint32_t idleMs = now - c->lastSeenMs;
+
+        if (!c->active || idleMs > CLUSTER_TIMEOUT_MS) {
+            if (freeSlot == NULL) {
+                freeSlot = c;
+            }
+            continue;
+        }
+        if (oldest == NULL || c->lastSeenMs < oldest->lastSeenMs) {
+            oldest = c;
+        }
+
+        // Clusters only hold one protocol
+        if (c->signatureIndex != signal->signatureIndex) {
+            continue;
+        }
+
+        float dt = idleMs / 1000.0f;
+        float gate = clusterGate(c, dt);
+        float distance = fabsf(offsetPpb - predictCentroid(c, dt));
+        if (distance > gate) {
+            continue;
+        }
+
+        // Normalised offset distance, plus RSSI continuity and recency
+        float offsetCost = distance / gate;
+        float rssiCost = (signal->rssi - c->meanRssi) / CLUSTER_RSSI_SCALE_DB;
+        float cost = offsetCost * offsetCost + rssiCost * rssiCost +
+                     (float)idleMs / CLUSTER_TIMEOUT_MS;
+
+        if (best == NULL || cost < bestCost) {
+            best = c;
+            bestCost = cost;
+            bestDt = dt;
+        }
+    }
+
+    if (best != NULL) {
+        clusterUpdate(best, signal, offsetPpb, bestDt, now);
+        clusterMergeDuplicates(best, now);
+        return CLUSTER_ID_TAG | best->id;
+    }
+
+    // New transmitter: take a free slot, otherwise the least recently seen
+    TransmitterCluster* slot = (freeSlot != NULL) ? freeSlot : oldest;
+    clusterStart(slot, signal, offsetPpb, now);
+
+    Serial.print(F("[Cluster] New transmitter #"));
+    Serial.print(slot->id);
+    Serial.print(F(" at "));
+    Serial.print(offsetPpb, 0);
+    Serial.println(F(" ppb"));
+
+    return CLUSTER_ID_TAG | slot->id;
+}
+
+const TransmitterCluster* getTransmitterCluster(int index) {
+    if (index < 0 || index >= MAX_TX_CLUSTERS || !clusters[index].active) {
+        return NULL;
+    }
+    return &clusters[index];
+}
@@ -0,0 +1,78 @@
+/**
+ * Host Arduino Stand-In
+ *
+ * Just enough of the Arduino core for the [env:native] unit tests to build
+ * firmware modules on the host. Time is a simulated clock the tests move
+ * with nativeAdvanceMs()/nativeAdvanceUs(); pin writes are kept in
+ * nativePinLevel[] so tests can check outputs; Serial output is dropped.
+ */
+
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#define HIGH                        1
+#define LOW                         0
+#define INPUT                       0
+#define OUTPUT                      1
+#define DEC                         10
+#define HEX                         16
+#define F(text)                     (text)
+#define IRAM_ATTR
+
+#define NATIVE_PINS                 64        // Pins tracked by nativePinLevel[]
+
+using std::min;
+using std::max;
+#define constrain(amt, low, high)   ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// FreeRTOS handle types named by firmware headers (pulled in by Arduino.h
+// on the ESP32)
+typedef void* SemaphoreHandle_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+
+// ============================================================================
+// Simulated Clock and Pins
+// ============================================================================
+
+inline uint64_t nativeClockUs = 0;
+inline uint8_t nativePinLevel[NATIVE_PINS];
+
+inline unsigned long millis() { return (unsigned long)(nativeClockUs / 1000); }
+inline unsigned long micros() { return (unsigned long)nativeClockUs; }
+
+inline void nativeAdvanceUs(uint64_t us) { nativeClockUs += us; }
+inline void nativeAdvanceMs(uint32_t ms) { nativeClockUs += (uint64_t)ms * 1000; }
+
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+
+inline void digitalWrite(uint8_t pin, uint8_t level) {
+    if (pin < NATIVE_PINS) {
+        nativePinLevel[pin] = level;
+    }
+}
+
+inline int digitalRead(uint8_t pin) {
+    return pin < NATIVE_PINS ? nativePinLevel[pin] : LOW;
+}
+
+// ============================================================================
+// Serial
+// ============================================================================
+
+class NativePrint {
+public:
+    template <typename T> size_t print(const T& value, int format = DEC) { return 0; }
+    template <typename T> size_t println(const T& value, int format = DEC) { return 0; }
+    size_t println() { return 0; }
+};
+
+inline NativePrint Serial;
+
+#endif // NATIVE_ARDUINO_H
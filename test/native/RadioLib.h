@@ -0,0 +1,13 @@
+/**
+ * Host RadioLib Stand-In
+ *
+ * Firmware headers only hold radios by pointer, so the native unit tests
+ * need the class name and nothing else.
+ */
+
+#ifndef NATIVE_RADIOLIB_H
+#define NATIVE_RADIOLIB_H
+
+class SX1262;
+
+#endif // NATIVE_RADIOLIB_H
@@ -0,0 +1,249 @@
+/**
+ * Alert State Machine Tests
+ *
+ * Scripts packets and quiet time through src/alert.cpp on the simulated
+ * clock and checks the arm, debounce, confirm and clear transitions
+ * through the outputs and statistics.
+ *
+ *   pio test -e native -f test_alert
+ */
+
+#include <unity.h>
+#include "alert.h"
+
+#define KEY_A   0x45000001UL
+#define KEY_B   0x45000002UL
+
+static DroneSignal packet(uint32_t key, uint8_t confidence) {
+    DroneSignal signal = {};
+    signal.frequency = 915.0f;
+    signal.confidence = confidence;
+    signal.droneType = "ExpressLRS 900";
+    signal.signatureIndex = 0;
+    signal.transmitterId = key;
+    return signal;
+}
+
+/**
+ * Feed one drone packet received now
+ */
+static void observe(uint32_t key, uint8_t confidence) {
+    DroneSignal signal = packet(key, confidence);
+    alertObserve(&signal, key, true, micros());
+}
+
+/**
+ * Move the clock on and run the service call, as the main loop would
+ */
+static void wait(uint32_t ms) {
+    nativeAdvanceMs(ms);
+    alertService();
+}
+
+static AlertStats getStats() {
+    AlertStats stats;
+    alertGetStats(&stats);
+    return stats;
+}
+
+static void assertOutputs(bool on) {
+    TEST_ASSERT_EQUAL(on, alertActive());
+    TEST_ASSERT_EQUAL(on ? ALERT_ACTIVE_LEVEL : !ALERT_ACTIVE_LEVEL, nativePinLevel[ALERT_LED_PIN]);
+    TEST_ASSERT_EQUAL(on ? ALERT_ACTIVE_LEVEL : !ALERT_ACTIVE_LEVEL, nativePinLevel[ALERT_RELAY_PIN]);
+}
+
+void setUp() {
+    nativeClockUs = 1000000;
+    alertInit();
+}
+
+void tearDown() {}
+
+// ============================================================================
+// Arming and Confirmation
+// ============================================================================
+
+void test_single_packet_arms_without_output() {
+    observe(KEY_A, ALERT_MIN_CONFIDENCE);
+    assertOutputs(false);
+    TEST_ASSERT_EQUAL_UINT32(0, getStats().confirmed);
+}
+
+void test_ignores_weak_and_non_drone_packets() {
+    DroneSignal weak = packet(KEY_A, ALERT_MIN_CONFIDENCE - 1);
+    DroneSignal strong = packet(KEY_A, 100);
+    for (int i = 0; i < ALERT_CONFIRM_PACKETS; i++) {
+        alertObserve(&weak, KEY_A, true, micros());
+        alertObserve(&strong, KEY_A, false, micros());
+        wait(100);
+    }
+    assertOutputs(false);
+    TEST_ASSERT_EQUAL_UINT32(0, getStats().confirmed);
+}
+
+void test_confirms_after_packets_within_window() {
+    for (int i = 0; i < ALERT_CONFIRM_PACKETS - 1; i++) {
+        observe(KEY_A, ALERT_MIN_CONFIDENCE);
+        wait(ALERT_CONFIRM_WINDOW_MS / ALERT_CONFIRM_PACKETS);
+        assertOutputs(false);
+    }
+    observe(KEY_A, ALERT_MIN_CONFIDENCE);
+
+    assertOutputs(true);
+    TEST_ASSERT_EQUAL(ALERT_ACTIVE_LEVEL, nativePinLevel[ALERT_BUZZER_PIN]);
+    AlertStats stats = getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.confirmed);
+    TEST_ASSERT_EQUAL_UINT8(1, stats.alerting);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overBudget);
+}
+
+void test_buzzer_pulses_once_per_confirmation() {
+    observe(KEY_A, ALERT_INSTANT_CONFIDENCE);
+    wait(ALERT_BUZZER_MS - 1);
+    TEST_ASSERT_EQUAL(ALERT_ACTIVE_LEVEL, nativePinLevel[ALERT_BUZZER_PIN]);
+    wait(1);
+    TEST_ASSERT_EQUAL(!ALERT_ACTIVE_LEVEL, nativePinLevel[ALERT_BUZZER_PIN]);
+
+    // Further packets of a confirmed emitter keep the alert without buzzing
+    observe(KEY_A, ALERT_INSTANT_CONFIDENCE);
+    TEST_ASSERT_EQUAL(!ALERT_ACTIVE_LEVEL, nativePinLevel[ALERT_BUZZER_PIN]);
+    TEST_ASSERT_EQUAL_UINT32(1, getStats().confirmed);
+}
+
+void test_instant_confidence_escalates_at_once() {
+    observe(KEY_A, ALERT_INSTANT_CONFIDENCE);
+    assertOutputs(true);
+    TEST_ASSERT_EQUAL_UINT32(1, getStats().confirmed);
+}
+
+void test_instant_packet_escalates_arming_emitter() {
+    observe(KEY_A, ALERT_MIN_CONFIDENCE);
+    wait(100);
+    observe(KEY_A, ALERT_INSTANT_CONFIDENCE);
+    assertOutputs(true);
+}
+
+void test_latency_measured_from_packet_timestamp() {
+    DroneSignal signal = packet(KEY_A, ALERT_INSTANT_CONFIDENCE);
+    uint32_t timestampUs = micros();
+    nativeAdvanceUs(ALERT_LATENCY_BUDGET_US + 1);
+    alertObserve(&signal, KEY_A, true, timestampUs);
+
+    AlertStats stats = getStats();
+    TEST_ASSERT_EQUAL_UINT32(ALERT_LATENCY_BUDGET_US + 1, stats.latencyMaxUs);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overBudget);
+}
+
+// ============================================================================
+// Debounce
+// ============================================================================
+
+void test_arming_expires_without_confirmation() {
+    for (int i = 0; i < ALERT_CONFIRM_PACKETS - 1; i++) {
+        observe(KEY_A, ALERT_MIN_CONFIDENCE);
+    }
+    wait(ALERT_CONFIRM_WINDOW_MS + 1);
+    TEST_ASSERT_EQUAL_UINT32(1, getStats().suppressed);
+
+    // The expired packets do not count towards the next confirmation
+    observe(KEY_A, ALERT_MIN_CONFIDENCE);
+    assertOutputs(false);
+}
+
+void test_packets_spread_past_window_never_confirm() {
+    // Without service calls in between: the expiry is applied on arrival
+    uint32_t gapMs = ALERT_CONFIRM_WINDOW_MS / (ALERT_CONFIRM_PACKETS - 1) + 1;
+    for (int i = 0; i < ALERT_CONFIRM_PACKETS * 3; i++) {
+        observe(KEY_A, ALERT_MIN_CONFIDENCE);
+        nativeAdvanceMs(gapMs);
+    }
+    assertOutputs(false);
+    TEST_ASSERT_EQUAL_UINT32(0, getStats().confirmed);
+}
+
+void test_emitters_arm_independently() {
+    // Interleaved packets of two emitters each fall short of confirming
+    for (int i = 0; i < ALERT_CONFIRM_PACKETS - 1; i++) {
+        observe(KEY_A, ALERT_MIN_CONFIDENCE);
+        observe(KEY_B, ALERT_MIN_CONFIDENCE);
+    }
+    assertOutputs(false);
+
+    observe(KEY_B, ALERT_MIN_CONFIDENCE);
+    assertOutputs(true);
+    TEST_ASSERT_EQUAL_UINT8(1, getStats().alerting);
+}
+
+// ============================================================================
+// Clearing
+// ============================================================================
+
+void test_clears_after_quiet_and_hold() {
+    observe(KEY_A, ALERT_INSTANT_CONFIDENCE);
+
+    // Clearing keeps the outputs on through the hold time
+    wait(ALERT_CLEAR_MS + 1);
+    assertOutputs(true);
+    wait(ALERT_HOLD_MS - 1);
+    assertOutputs(true);
+    TEST_ASSERT_EQUAL_UINT32(0, getStats().cleared);
+
+    wait(1);
+    assertOutputs(false);
+    AlertStats stats = getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.cleared);
+    TEST_ASSERT_EQUAL_UINT8(0, stats.alerting);
+}
+
+void test_packet_while_clearing_keeps_alert() {
+    observe(KEY_A, ALERT_INSTANT_CONFIDENCE);
+    wait(ALERT_CLEAR_MS + ALERT_HOLD_MS / 2);
+
+    // One packet, even a weak one, is enough to stay confirmed
+    observe(KEY_A, ALERT_MIN_CONFIDENCE);
+    wait(ALERT_CLEAR_MS + ALERT_HOLD_MS / 2);
+    assertOutputs(true);
+    AlertStats stats = getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.confirmed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.cleared);
+}
+
+void test_outputs_stay_on_until_last_emitter_clears() {
+    observe(KEY_A, ALERT_INSTANT_CONFIDENCE);
+    wait(ALERT_CLEAR_MS);
+    observe(KEY_B, ALERT_INSTANT_CONFIDENCE);
+
+    wait(ALERT_HOLD_MS + 1);
+    TEST_ASSERT_EQUAL_UINT32(1, getStats().cleared);
+    assertOutputs(true);
+
+    wait(ALERT_CLEAR_MS);
+    assertOutputs(false);
+    TEST_ASSERT_EQUAL_UINT32(2, getStats().cleared);
+}
+
+void test_late_service_applies_all_transitions() {
+    observe(KEY_A, ALERT_INSTANT_CONFIDENCE);
+    wait(ALERT_CLEAR_MS + ALERT_HOLD_MS + 1);
+    assertOutputs(false);
+    TEST_ASSERT_EQUAL_UINT32(1, getStats().cleared);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_single_packet_arms_without_output);
+    RUN_TEST(test_ignores_weak_and_non_drone_packets);
+    RUN_TEST(test_confirms_after_packets_within_window);
+    RUN_TEST(test_buzzer_pulses_once_per_confirmation);
+    RUN_TEST(test_instant_confidence_escalates_at_once);
+    RUN_TEST(test_instant_packet_escalates_arming_emitter);
+    RUN_TEST(test_latency_measured_from_packet_timestamp);
+    RUN_TEST(test_arming_expires_without_confirmation);
+    RUN_TEST(test_packets_spread_past_window_never_confirm);
+    RUN_TEST(test_emitters_arm_independently);
+    RUN_TEST(test_clears_after_quiet_and_hold);
+    RUN_TEST(test_packet_while_clearing_keeps_alert);
+    RUN_TEST(test_outputs_stay_on_until_last_emitter_clears);
+    RUN_TEST(test_late_service_applies_all_transitions);
+    return UNITY_END();
+}
@@ -0,0 +1,1038 @@
+/**
+ * Change Detector Replay Trace
+ *
+ * GENERATED by tools/change_sim.py --export (seed 1) - do not edit.
+ *
+ * Simulated dwells of one channel and the steps the simulator's
+ * detector reports on them (ChangeStep values).
+ */
+
+#ifndef CHANGE_TRACE_H
+#define CHANGE_TRACE_H
+
+#include <stdint.h>
+
+#define TRACE_DWELLS        1000
+#define TRACE_EVENTS        4
+
+typedef struct {
+    uint8_t busy;               // Packet or energy above the detection threshold
+    float excessDb;             // Peak RSSI over the noise floor
+} TraceDwell;
+
+typedef struct {
+    uint16_t dwell;             // Index in kDwells
+    uint8_t step;               // ChangeStep reported
+} TraceEvent;
+
+static const TraceDwell kDwells[TRACE_DWELLS] = {
+    { 0, 1.87f },
+    { 0, 1.17f },
+    { 0, 1.05f },
+    { 0, 3.09f },
+    { 0, 0.31f },
+    { 0, 3.27f },
+    { 0, 2.37f },
+    { 0, -0.02f },
+    { 0, 1.74f },
+    { 0, -0.06f },
+    { 0, -0.05f },
+    { 0, 1.77f },
+    { 1, 14.38f },
+    { 0, 2.42f },
+    { 0, -0.19f },
+    { 0, 1.89f },
+    { 0, 0.17f },
+    { 0, 0.04f },
+    { 0, 0.72f },
+    { 0, 3.52f },
+    { 0, 1.16f },
+    { 0, 3.69f },
+    { 0, 2.25f },
+    { 0, 2.43f },
+    { 0, 1.70f },
+    { 0, 1.26f },
+    { 0, -0.06f },
+    { 0, -0.06f },
+    { 0, 1.09f },
+    { 0, 1.41f },
+    { 0, 1.79f },
+    { 0, 0.65f },
+    { 0, 1.38f },
+    { 0, 1.71f },
+    { 0, 1.20f },
+    { 0, 0.97f },
+    { 0, 0.67f },
+    { 0, 1.36f },
+    { 0, -0.38f },
+    { 0, 3.16f },
+    { 0, 0.54f },
+    { 0, 2.41f },
+    { 0, 1.98f },
+    { 0, 2.43f },
+    { 0, 2.44f },
+    { 0, 0.79f },
+    { 0, 2.60f },
+    { 0, 1.86f },
+    { 0, 2.34f },
+    { 0, 1.35f },
+    { 0, 0.01f },
+    { 0, 0.93f },
+    { 0, 1.66f },
+    { 0, 1.63f },
+    { 0, 0.58f },
+    { 0, 1.58f },
+    { 0, 0.85f },
+    { 0, 1.81f },
+    { 0, 4.14f },
+    { 0, 0.73f },
+    { 0, 1.61f },
+    { 0, 0.47f },
+    { 0, 2.28f },
+    { 0, 1.91f },
+    { 0, 3.04f },
+    { 0, 2.28f },
+    { 0, 1.04f },
+    { 0, -0.19f },
+    { 0, 2.01f },
+    { 0, 1.46f },
+    { 0, 2.23f },
+    { 0, 1.93f },
+    { 0, 0.69f },
+    { 0, -0.24f },
+    { 0, 2.11f },
+    { 0, 1.55f },
+    { 0, 1.32f },
+    { 0, 1.10f },
+    { 0, 2.34f },
+    { 0, 1.90f },
+    { 0, 2.98f },
+    { 0, 2.15f },
+    { 0, 1.29f },
+    { 0, 0.69f },
+    { 0, 2.54f },
+    { 0, 2.13f },
+    { 0, 1.80f },
+    { 0, -0.48f },
+    { 0, 1.79f },
+    { 0, 1.13f },
+    { 0, 2.38f },
+    { 0, 0.53f },
+    { 0, 1.58f },
+    { 0, 1.63f },
+    { 0, 0.32f },
+    { 0, 1.26f },
+    { 0, -0.91f },
+    { 0, 2.34f },
+    { 0, 0.95f },
+    { 0, 2.20f },
+    { 0, 1.98f },
+    { 0, -0.34f },
+    { 0, 2.22f },
+    { 0, 1.41f },
+    { 0, 3.37f },
+    { 0, 2.48f },
+    { 0, 1.23f },
+    { 0, 1.08f },
+    { 0, 1.85f },
+    { 1, 23.37f },
+    { 0, 0.84f },
+    { 0, 2.00f },
+    { 1, 25.18f },
+    { 0, 2.53f },
+    { 0, 0.89f },
+    { 0, 1.16f },
+    { 0, 1.41f },
+    { 0, -0.44f },
+    { 0, 2.05f },
+    { 0, 0.94f },
+    { 0, 1.05f },
+    { 0, 0.27f },
+    { 0, 1.13f },
+    { 0, 2.44f },
+    { 0, 2.39f },
+    { 0, 2.02f },
+    { 0, -0.89f },
+    { 0, 2.47f },
+    { 0, 2.55f },
+    { 1, 11.90f },
+    { 0, -0.38f },
+    { 0, 2.15f },
+    { 0, 0.44f },
+    { 0, 2.67f },
+    { 0, -0.02f },
+    { 0, 0.55f },
+    { 0, 2.25f },
+    { 0, 0.29f },
+    { 0, 1.40f },
+    { 0, 1.67f },
+    { 0, 0.83f },
+    { 0, 0.11f },
+    { 0, -0.75f },
+    { 0, 3.81f },
+    { 0, 2.38f },
+    { 0, 3.19f },
+    { 0, 1.19f },
+    { 0, 1.57f },
+    { 1, 10.90f },
+    { 0, 2.59f },
+    { 0, 0.57f },
+    { 0, 2.75f },
+    { 0, 1.85f },
+    { 0, 1.76f },
+    { 0, 1.96f },
+    { 1, 21.69f },
+    { 0, 1.00f },
+    { 0, 1.25f },
+    { 0, 2.45f },
+    { 0, 0.74f },
+    { 0, 1.67f },
+    { 0, 2.47f },
+    { 0, 1.22f },
+    { 0, 2.56f },
+    { 0, 0.57f },
+    { 0, 1.53f },
+    { 0, 2.66f },
+    { 0, 1.64f },
+    { 0, 0.14f },
+    { 0, 0.32f },
+    { 0, 1.76f },
+    { 0, 0.66f },
+    { 0, 2.28f },
+    { 0, 2.43f },
+    { 0, 1.00f },
+    { 0, 1.54f },
+    { 0, 1.84f },
+    { 1, 36.42f },
+    { 0, 2.59f },
+    { 0, 0.65f },
+    { 0, 1.25f },
+    { 1, 25.24f },
+    { 0, 0.78f },
+    { 0, 1.45f },
+    { 0, 1.76f },
+    { 0, 0.27f },
+    { 0, 2.30f },
+    { 1, 34.09f },
+    { 0, 0.30f },
+    { 0, 1.42f },
+    { 0, 1.08f },
+    { 0, 0.40f },
+    { 0, 1.88f },
+    { 0, 2.27f },
+    { 0, 2.68f },
+    { 0, 2.25f },
+    { 0, 1.36f },
+    { 0, 1.99f },
+    { 0, 0.65f },
+    { 0, 0.99f },
+    { 0, 0.63f },
+    { 0, 1.55f },
+    { 0, 1.55f },
+    { 0, 1.51f },
+    { 0, 2.29f },
+    { 0, 1.57f },
+    { 0, 1.23f },
+    { 0, 0.43f },
+    { 0, 1.00f },
+    { 0, 0.57f },
+    { 0, 2.95f },
+    { 0, 0.28f },
+    { 0, -0.77f },
+    { 0, 1.05f },
+    { 0, 2.65f },
+    { 0, 3.71f },
+    { 0, -0.23f },
+    { 0, 0.79f },
+    { 0, 1.54f },
+    { 0, 2.62f },
+    { 0, 0.80f },
+    { 0, -0.09f },
+    { 0, 1.16f },
+    { 0, 2.47f },
+    { 0, -0.04f },
+    { 0, 3.54f },
+    { 0, 1.58f },
+    { 0, 0.88f },
+    { 0, 2.18f },
+    { 0, 0.25f },
+    { 0, 1.50f },
+    { 0, 0.49f },
+    { 0, 0.85f },
+    { 0, 0.41f },
+    { 0, 2.28f },
+    { 0, 1.29f },
+    { 0, 3.06f },
+    { 0, 2.35f },
+    { 0, 1.88f },
+    { 0, 1.96f },
+    { 0, 2.28f },
+    { 0, 2.85f },
+    { 0, 1.20f },
+    { 0, 1.05f },
+    { 0, 1.44f },
+    { 0, 2.57f },
+    { 0, 3.05f },
+    { 0, 0.68f },
+    { 0, 0.38f },
+    { 0, 1.05f },
+    { 0, 0.44f },
+    { 0, 0.90f },
+    { 0, 0.68f },
+    { 0, 2.71f },
+    { 0, 0.34f },
+    { 0, 0.95f },
+    { 0, 0.55f },
+    { 0, -1.01f },
+    { 0, 1.99f },
+    { 0, -0.60f },
+    { 0, 1.12f },
+    { 0, 0.23f },
+    { 0, 0.54f },
+    { 0, 2.51f },
+    { 0, 3.85f },
+    { 0, 2.31f },
+    { 0, 1.38f },
+    { 0, 2.27f },
+    { 0, 0.74f },
+    { 0, 0.11f },
+    { 0, 2.70f },
+    { 0, 1.07f },
+    { 0, 1.44f },
+    { 0, 0.32f },
+    { 0, 0.55f },
+    { 0, -0.83f },
+    { 0, 2.01f },
+    { 0, 1.44f },
+    { 0, 2.97f },
+    { 0, 1.11f },
+    { 0, 0.45f },
+    { 0, 1.36f },
+    { 0, 0.67f },
+    { 0, 1.26f },
+    { 0, 2.22f },
+    { 0, 0.85f },
+    { 0, 0.47f },
+    { 0, 2.20f },
+    { 0, 1.99f },
+    { 0, 2.94f },
+    { 0, 0.78f },
+    { 0, 1.33f },
+    { 0, 1.73f },
+    { 0, 0.74f },
+    { 0, 0.73f },
+    { 0, 1.67f },
+    { 0, 2.09f },
+    { 0, 3.58f },
+    { 0, 2.31f },
+    { 0, 3.09f },
+    { 0, 2.64f },
+    { 0, 1.23f },
+    { 0, 0.51f },
+    { 0, 1.73f },
+    { 0, 0.65f },
+    { 0, 0.82f },
+    { 0, 2.31f },
+    { 0, 1.98f },
+    { 0, 1.46f },
+    { 0, 0.13f },
+    { 0, 2.39f },
+    { 0, 2.16f },
+    { 0, 2.76f },
+    { 0, 1.06f },
+    { 0, 0.27f },
+    { 0, 0.92f },
+    { 0, 0.85f },
+    { 0, 2.08f },
+    { 0, 0.13f },
+    { 0, 1.58f },
+    { 0, 0.88f },
+    { 0, 0.96f },
+    { 0, 2.33f },
+    { 0, -1.03f },
+    { 0, 0.98f },
+    { 0, 0.84f },
+    { 0, -0.08f },
+    { 0, 2.16f },
+    { 0, 2.83f },
+    { 0, 0.77f },
+    { 0, 1.03f },
+    { 0, 1.34f },
+    { 0, 3.04f },
+    { 0, 1.23f },
+    { 0, 0.73f },
+    { 0, 2.07f },
+    { 0, 2.47f },
+    { 0, -0.50f },
+    { 0, 0.89f },
+    { 0, 1.90f },
+    { 0, 0.78f },
+    { 0, 1.26f },
+    { 0, 0.40f },
+    { 0, 0.45f },
+    { 0, 1.45f },
+    { 0, 3.87f },
+    { 0, 1.48f },
+    { 0, 2.12f },
+    { 1, 19.23f },
+    { 0, 0.70f },
+    { 0, 2.49f },
+    { 0, 1.60f },
+    { 0, 1.22f },
+    { 0, 2.58f },
+    { 0, -0.22f },
+    { 0, 2.42f },
+    { 0, 1.64f },
+    { 0, 1.80f },
+    { 0, 0.97f },
+    { 0, 0.13f },
+    { 0, 1.52f },
+    { 0, 1.50f },
+    { 0, 0.79f },
+    { 0, 2.57f },
+    { 0, 2.09f },
+    { 0, 1.38f },
+    { 0, 0.49f },
+    { 0, 0.01f },
+    { 0, 2.11f },
+    { 0, 5.25f },
+    { 0, 2.00f },
+    { 0, 2.16f },
+    { 0, 1.47f },
+    { 0, 1.44f },
+    { 0, 1.76f },
+    { 0, 1.92f },
+    { 0, 2.35f },
+    { 0, 4.71f },
+    { 0, 1.06f },
+    { 0, 1.35f },
+    { 1, 14.45f },
+    { 0, 2.12f },
+    { 0, 1.51f },
+    { 0, 1.48f },
+    { 0, 0.88f },
+    { 0, 0.02f },
+    { 0, 2.31f },
+    { 0, 4.35f },
+    { 0, 0.87f },
+    { 0, 3.83f },
+    { 0, 0.97f },
+    { 0, 1.49f },
+    { 0, 0.34f },
+    { 0, 0.33f },
+    { 0, 1.58f },
+    { 0, 1.08f },
+    { 0, 1.74f },
+    { 0, -0.96f },
+    { 0, 1.79f },
+    { 0, 1.67f },
+    { 1, 13.82f },
+    { 1, 13.10f },
+    { 1, 13.33f },
+    { 1, 10.74f },
+    { 1, 17.32f },
+    { 1, 13.05f },
+    { 1, 13.32f },
+    { 1, 18.91f },
+    { 1, 17.91f },
+    { 0, 1.79f },
+    { 1, 16.05f },
+    { 1, 16.89f },
+    { 0, 0.48f },
+    { 1, 15.85f },
+    { 1, 17.89f },
+    { 0, 0.90f },
+    { 1, 14.32f },
+    { 1, 14.60f },
+    { 1, 14.71f },
+    { 1, 15.97f },
+    { 1, 14.19f },
+    { 1, 13.76f },
+    { 0, 1.55f },
+    { 1, 13.29f },
+    { 1, 10.80f },
+    { 1, 15.16f },
+    { 1, 18.59f },
+    { 1, 13.19f },
+    { 1, 14.95f },
+    { 1, 15.12f },
+    { 1, 18.03f },
+    { 0, 0.49f },
+    { 0, 1.39f },
+    { 1, 16.24f },
+    { 1, 13.84f },
+    { 1, 15.51f },
+    { 0, 2.93f },
+    { 1, 13.72f },
+    { 1, 12.22f },
+    { 1, 14.37f },
+    { 0, 1.27f },
+    { 1, 15.72f },
+    { 1, 12.07f },
+    { 0, 0.73f },
+    { 1, 10.82f },
+    { 1, 12.94f },
+    { 0, 0.78f },
+    { 1, 15.00f },
+    { 1, 16.05f },
+    { 0, 1.18f },
+    { 1, 14.69f },
+    { 0, 2.39f },
+    { 0, 1.36f },
+    { 1, 15.02f },
+    { 0, 0.29f },
+    { 1, 13.15f },
+    { 1, 15.50f },
+    { 1, 13.90f },
+    { 0, 0.15f },
+    { 1, 10.93f },
+    { 0, 1.45f },
+    { 0, 2.20f },
+    { 0, 1.29f },
+    { 0, 2.08f },
+    { 0, 2.29f },
+    { 1, 15.17f },
+    { 0, 1.75f },
+    { 0, 2.79f },
+    { 0, 1.15f },
+    { 1, 15.51f },
+    { 1, 12.86f },
+    { 1, 16.74f },
+    { 0, 2.79f },
+    { 1, 12.23f },
+    { 0, 1.10f },
+    { 1, 14.59f },
+    { 0, 0.57f },
+    { 1, 11.71f },
+    { 0, 1.91f },
+    { 0, 0.45f },
+    { 1, 15.10f },
+    { 1, 15.68f },
+    { 1, 13.94f },
+    { 1, 30.66f },
+    { 1, 10.87f },
+    { 1, 17.24f },
+    { 1, 14.45f },
+    { 0, 1.21f },
+    { 1, 16.33f },
+    { 1, 11.61f },
+    { 1, 16.73f },
+    { 1, 11.97f },
+    { 1, 13.99f },
+    { 1, 10.87f },
+    { 0, 1.45f },
+    { 1, 14.62f },
+    { 1, 17.63f },
+    { 0, 1.95f },
+    { 1, 15.05f },
+    { 1, 15.07f },
+    { 1, 18.24f },
+    { 0, 1.19f },
+    { 0, 3.33f },
+    { 0, 2.59f },
+    { 1, 12.52f },
+    { 0, 3.13f },
+    { 0, 0.95f },
+    { 1, 15.06f },
+    { 0, 1.55f },
+    { 1, 16.49f },
+    { 1, 14.98f },
+    { 1, 16.85f },
+    { 1, 13.69f },
+    { 1, 14.38f },
+    { 0, 0.88f },
+    { 0, 1.35f },
+    { 1, 11.14f },
+    { 1, 13.93f },
+    { 1, 12.04f },
+    { 0, -0.57f },
+    { 0, 0.95f },
+    { 0, 1.15f },
+    { 0, 1.45f },
+    { 0, 2.32f },
+    { 0, 0.37f },
+    { 0, 2.87f },
+    { 0, 1.10f },
+    { 0, -0.15f },
+    { 0, 1.22f },
+    { 0, 0.78f },
+    { 0, 1.55f },
+    { 0, 1.83f },
+    { 0, 0.97f },
+    { 0, 1.44f },
+    { 0, 1.30f },
+    { 0, 2.75f },
+    { 0, 0.37f },
+    { 0, 1.67f },
+    { 0, 3.93f },
+    { 0, 0.70f },
+    { 0, 1.42f },
+    { 0, 1.69f },
+    { 0, 1.37f },
+    { 0, 1.33f },
+    { 0, 0.70f },
+    { 0, -0.30f },
+    { 0, 2.44f },
+    { 0, 1.40f },
+    { 0, 2.18f },
+    { 0, 5.36f },
+    { 0, 1.72f },
+    { 0, 0.88f },
+    { 0, 0.64f },
+    { 0, 0.12f },
+    { 0, 1.63f },
+    { 0, 0.19f },
+    { 0, 1.27f },
+    { 0, 0.17f },
+    { 0, 1.11f },
+    { 0, 1.31f },
+    { 0, 0.18f },
+    { 0, 3.71f },
+    { 0, 3.67f },
+    { 0, 2.12f },
+    { 0, 2.21f },
+    { 0, 2.23f },
+    { 1, 33.79f },
+    { 0, 5.19f },
+    { 0, 1.79f },
+    { 0, 1.52f },
+    { 0, 1.93f },
+    { 0, 2.57f },
+    { 0, 0.62f },
+    { 0, 2.52f },
+    { 0, 2.01f },
+    { 0, 3.19f },
+    { 0, 2.37f },
+    { 0, 3.97f },
+    { 0, 1.69f },
+    { 0, 0.84f },
+    { 0, 0.29f },
+    { 0, 2.53f },
+    { 0, 1.44f },
+    { 0, 3.71f },
+    { 0, 0.72f },
+    { 0, 1.94f },
+    { 0, 2.10f },
+    { 0, 0.88f },
+    { 0, 1.15f },
+    { 0, 2.35f },
+    { 0, 3.60f },
+    { 0, 1.57f },
+    { 0, 4.02f },
+    { 0, 0.63f },
+    { 0, 1.70f },
+    { 0, 0.71f },
+    { 0, 1.69f },
+    { 0, 1.64f },
+    { 0, 1.71f },
+    { 0, 0.49f },
+    { 0, 2.07f },
+    { 0, 1.54f },
+    { 0, 0.34f },
+    { 0, 2.27f },
+    { 0, 2.49f },
+    { 0, 1.58f },
+    { 0, 2.24f },
+    { 0, 2.21f },
+    { 0, 0.61f },
+    { 0, 3.15f },
+    { 0, 3.15f },
+    { 0, 0.48f },
+    { 1, 39.83f },
+    { 0, 1.48f },
+    { 0, 2.57f },
+    { 0, 4.63f },
+    { 0, 2.49f },
+    { 0, 1.95f },
+    { 0, 2.54f },
+    { 0, 1.85f },
+    { 0, 0.63f },
+    { 0, 0.94f },
+    { 0, 0.89f },
+    { 0, -0.15f },
+    { 0, 2.09f },
+    { 0, 0.20f },
+    { 0, 2.18f },
+    { 0, 0.10f },
+    { 0, 2.73f },
+    { 0, 1.92f },
+    { 0, 0.16f },
+    { 0, 1.72f },
+    { 0, 0.31f },
+    { 0, 3.16f },
+    { 0, 2.18f },
+    { 0, 1.67f },
+    { 0, 2.36f },
+    { 0, 0.57f },
+    { 0, 3.19f },
+    { 0, 1.23f },
+    { 0, 3.25f },
+    { 0, 2.88f },
+    { 0, 1.24f },
+    { 0, 2.48f },
+    { 0, 2.86f },
+    { 0, 2.84f },
+    { 0, 2.08f },
+    { 0, 0.25f },
+    { 0, 1.20f },
+    { 0, 1.33f },
+    { 0, 2.69f },
+    { 0, 0.43f },
+    { 0, 1.58f },
+    { 0, 0.81f },
+    { 0, 1.31f },
+    { 0, 0.13f },
+    { 0, 2.53f },
+    { 0, 2.45f },
+    { 0, 4.03f },
+    { 0, 3.11f },
+    { 0, 2.02f },
+    { 0, 0.15f },
+    { 0, 1.38f },
+    { 0, 0.82f },
+    { 0, 1.41f },
+    { 0, 2.49f },
+    { 0, 0.06f },
+    { 0, -0.15f },
+    { 0, 1.30f },
+    { 0, 2.33f },
+    { 0, 1.41f },
+    { 0, 1.10f },
+    { 0, 0.37f },
+    { 0, 1.59f },
+    { 0, 0.62f },
+    { 0, 1.73f },
+    { 0, 1.58f },
+    { 0, 0.02f },
+    { 0, 1.94f },
+    { 0, 0.67f },
+    { 0, 2.68f },
+    { 0, 3.09f },
+    { 0, 3.82f },
+    { 0, 0.05f },
+    { 0, 1.34f },
+    { 0, 0.56f },
+    { 0, 2.21f },
+    { 0, 0.65f },
+    { 0, 1.90f },
+    { 0, 2.68f },
+    { 0, 1.28f },
+    { 0, 1.25f },
+    { 0, 0.48f },
+    { 0, 4.56f },
+    { 0, 1.31f },
+    { 0, 2.56f },
+    { 0, 1.51f },
+    { 0, 1.14f },
+    { 0, 2.23f },
+    { 0, 3.52f },
+    { 0, 0.83f },
+    { 0, 1.71f },
+    { 0, -0.62f },
+    { 0, 0.27f },
+    { 0, 0.12f },
+    { 0, 1.97f },
+    { 0, 1.84f },
+    { 0, 1.52f },
+    { 0, 2.78f },
+    { 0, 1.00f },
+    { 0, 1.59f },
+    { 0, 2.95f },
+    { 0, 1.17f },
+    { 0, 2.53f },
+    { 0, 0.37f },
+    { 0, 3.50f },
+    { 0, 2.43f },
+    { 0, 3.11f },
+    { 0, 3.42f },
+    { 0, 1.55f },
+    { 1, 7.34f },
+    { 0, 4.24f },
+    { 0, 5.93f },
+    { 1, 9.07f },
+    { 1, 7.96f },
+    { 1, 10.03f },
+    { 1, 7.60f },
+    { 0, 4.48f },
+    { 1, 8.06f },
+    { 0, 4.15f },
+    { 1, 9.74f },
+    { 1, 8.32f },
+    { 1, 11.75f },
+    { 1, 8.41f },
+    { 1, 9.05f },
+    { 1, 9.38f },
+    { 1, 7.19f },
+    { 0, 1.70f },
+    { 0, 3.06f },
+    { 0, 0.45f },
+    { 0, 3.85f },
+    { 1, 10.78f },
+    { 1, 7.60f },
+    { 1, 10.08f },
+    { 1, 17.08f },
+    { 1, 8.84f },
+    { 1, 7.67f },
+    { 1, 8.62f },
+    { 1, 6.51f },
+    { 1, 6.89f },
+    { 1, 9.50f },
+    { 1, 8.87f },
+    { 1, 7.35f },
+    { 1, 6.82f },
+    { 1, 8.63f },
+    { 0, 0.06f },
+    { 0, 4.51f },
+    { 1, 9.00f },
+    { 1, 6.96f },
+    { 1, 10.51f },
+    { 1, 7.01f },
+    { 1, 11.00f },
+    { 1, 8.79f },
+    { 1, 8.88f },
+    { 1, 8.21f },
+    { 0, 5.87f },
+    { 1, 7.71f },
+    { 1, 9.66f },
+    { 1, 8.93f },
+    { 0, 1.86f },
+    { 1, 10.42f },
+    { 0, 0.95f },
+    { 1, 7.83f },
+    { 1, 9.84f },
+    { 0, 5.21f },
+    { 1, 11.48f },
+    { 1, 11.91f },
+    { 0, 5.02f },
+    { 0, -0.34f },
+    { 1, 8.43f },
+    { 1, 12.18f },
+    { 1, 7.07f },
+    { 0, 3.29f },
+    { 1, 10.49f },
+    { 1, 9.08f },
+    { 1, 7.71f },
+    { 1, 7.46f },
+    { 0, 4.83f },
+    { 1, 8.36f },
+    { 0, 5.92f },
+    { 1, 6.25f },
+    { 1, 8.49f },
+    { 1, 9.91f },
+    { 1, 7.75f },
+    { 1, 7.94f },
+    { 0, 2.26f },
+    { 1, 7.43f },
+    { 0, 1.01f },
+    { 0, 0.57f },
+    { 1, 8.07f },
+    { 1, 18.10f },
+    { 1, 6.65f },
+    { 1, 7.02f },
+    { 1, 8.11f },
+    { 1, 7.57f },
+    { 0, 4.12f },
+    { 1, 11.57f },
+    { 0, -0.06f },
+    { 0, 4.89f },
+    { 1, 7.46f },
+    { 1, 6.85f },
+    { 1, 7.14f },
+    { 0, 1.26f },
+    { 1, 6.75f },
+    { 1, 6.90f },
+    { 1, 6.27f },
+    { 1, 12.16f },
+    { 1, 8.06f },
+    { 1, 8.21f },
+    { 1, 8.88f },
+    { 0, -0.33f },
+    { 1, 10.04f },
+    { 1, 9.50f },
+    { 0, 5.82f },
+    { 1, 10.50f },
+    { 1, 8.99f },
+    { 1, 12.09f },
+    { 1, 7.22f },
+    { 1, 8.12f },
+    { 0, 2.08f },
+    { 0, 4.96f },
+    { 1, 7.10f },
+    { 1, 7.52f },
+    { 1, 20.38f },
+    { 1, 8.14f },
+    { 1, 7.82f },
+    { 1, 9.87f },
+    { 0, 5.91f },
+    { 1, 10.17f },
+    { 1, 6.94f },
+    { 0, 0.33f },
+    { 0, 3.52f },
+    { 0, 0.93f },
+    { 0, 0.15f },
+    { 0, 2.53f },
+    { 0, 0.30f },
+    { 0, 0.75f },
+    { 0, 1.73f },
+    { 0, 2.95f },
+    { 0, 0.07f },
+    { 0, 0.24f },
+    { 0, 1.13f },
+    { 0, 0.48f },
+    { 0, 0.70f },
+    { 0, 0.04f },
+    { 0, 1.94f },
+    { 0, 0.76f },
+    { 0, 1.31f },
+    { 0, 1.27f },
+    { 0, 0.69f },
+    { 0, -0.08f },
+    { 0, 1.73f },
+    { 0, 1.89f },
+    { 0, 0.48f },
+    { 0, 1.47f },
+    { 0, 1.10f },
+    { 0, 0.56f },
+    { 0, 1.84f },
+    { 0, 3.60f },
+    { 0, 1.80f },
+    { 0, 2.20f },
+    { 0, 1.53f },
+    { 0, 1.25f },
+    { 0, 1.30f },
+    { 0, 2.01f },
+    { 0, 1.46f },
+    { 0, 0.91f },
+    { 0, 1.15f },
+    { 0, 2.93f },
+    { 0, 3.66f },
+    { 0, 0.37f },
+    { 0, 0.89f },
+    { 0, 2.23f },
+    { 0, 2.01f },
+    { 0, 2.83f },
+    { 0, 0.23f },
+    { 0, 0.63f },
+    { 0, 1.92f },
+    { 0, 0.40f },
+    { 0, 2.76f },
+    { 0, 1.95f },
+    { 0, 2.00f },
+    { 0, 3.82f },
+    { 0, -0.40f },
+    { 0, 2.09f },
+    { 0, 1.69f },
+    { 0, 2.32f },
+    { 0, -0.52f },
+    { 0, 0.18f },
+    { 0, 1.55f },
+    { 0, 2.26f },
+    { 0, 1.44f },
+    { 0, 3.36f },
+    { 0, 2.49f },
+    { 0, 0.17f },
+    { 0, 2.02f },
+    { 0, 1.43f },
+    { 0, 1.59f },
+    { 0, 0.81f },
+    { 0, 2.79f },
+    { 0, 1.06f },
+    { 0, 3.18f },
+    { 1, 24.43f },
+    { 0, 1.55f },
+    { 0, 1.62f },
+    { 0, 1.38f },
+    { 0, 1.24f },
+    { 0, 1.12f },
+    { 0, 0.44f },
+    { 0, 1.65f },
+    { 0, 2.48f },
+    { 0, 2.69f },
+    { 0, -0.25f },
+    { 0, 1.24f },
+    { 0, 1.06f },
+    { 0, 1.57f },
+    { 0, 1.16f },
+    { 0, 1.38f },
+    { 0, 1.01f },
+    { 0, 2.18f },
+    { 0, 1.25f },
+    { 0, 0.35f },
+    { 0, 1.18f },
+    { 0, 1.59f },
+    { 0, 2.40f },
+    { 0, 0.47f },
+    { 0, 1.56f },
+    { 0, -0.97f },
+    { 0, 1.00f },
+    { 0, 1.61f },
+    { 0, 0.67f },
+    { 0, 1.24f },
+    { 0, 2.98f },
+    { 0, 1.48f },
+    { 0, 3.90f },
+    { 0, 2.47f },
+    { 0, 2.26f },
+    { 0, -0.02f },
+    { 0, 1.42f },
+    { 0, 1.27f },
+    { 0, 0.35f },
+    { 0, 0.47f },
+    { 0, 1.13f },
+    { 0, -0.00f },
+    { 0, 1.72f },
+    { 0, 0.61f },
+    { 0, 2.95f },
+    { 0, 2.49f },
+    { 0, 2.08f },
+    { 0, 0.67f },
+    { 0, 1.04f },
+    { 0, 1.62f },
+    { 0, 1.43f },
+    { 0, 0.91f },
+    { 0, 1.56f },
+    { 0, 1.50f },
+    { 0, -0.47f },
+    { 0, 0.26f },
+    { 0, 3.85f },
+    { 0, 0.82f },
+    { 0, 1.59f },
+    { 0, 0.59f },
+    { 0, 1.27f },
+    { 0, 1.97f },
+    { 0, -0.10f },
+    { 0, 2.22f },
+    { 0, 2.10f },
+    { 0, 1.18f },
+    { 0, 1.08f },
+    { 0, 2.50f },
+    { 0, 1.46f },
+    { 0, 2.90f },
+    { 0, 1.87f },
+    { 0, 1.29f },
+    { 1, 37.87f },
+    { 0, 0.90f },
+    { 0, 1.88f },
+    { 0, 0.62f },
+    { 0, 2.12f },
+    { 0, 2.48f },
+    { 0, 1.42f },
+    { 0, 1.85f },
+    { 0, 1.82f },
+    { 0, 2.78f },
+    { 0, 2.80f },
+    { 0, 1.69f },
+    { 0, 1.88f },
+    { 0, 1.52f },
+    { 0, 0.99f },
+    { 0, 1.17f }
+};
+
+static const TraceEvent kEvents[TRACE_EVENTS] = {
+    { 405, 1 },
+    { 534, 2 },
+    { 726, 1 },
+    { 857, 2 }
+};
+
+#endif // CHANGE_TRACE_H
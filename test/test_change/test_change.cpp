@@ -0,0 +1,139 @@
+/**
+ * Change Detector Tests
+ *
+ * Replays the dwell trace of change_trace.h (exported by
+ * tools/change_sim.py --export) through changeChannelStep() of
+ * src/change_channel.cpp and requires the onsets and ends at the dwells
+ * the simulator's detector reports them, so the false-alarm and delay
+ * figures of the simulator hold for the firmware. Scripted dwells then
+ * check learning, absorption and the onset cause.
+ *
+ *   pio test -e native -f test_change
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "change_channel.h"
+#include "change_trace.h"
+
+#define NOISE_EXCESS_DB     2.0f      // Background excess of the scripted dwells
+
+static ChangeChannel channel;
+
+/**
+ * Feed background dwells until the channel is armed
+ */
+static void learnBackground() {
+    for (int i = 0; i < CHANGE_LEARN_DWELLS; i++) {
+        TEST_ASSERT_EQUAL(CHANGE_STEP_NONE, changeChannelStep(&channel, false, NOISE_EXCESS_DB));
+    }
+}
+
+/**
+ * Feed the same dwell until the detector reports a step
+ * @return Dwells fed, or -1 if none of limit dwells caused a step
+ */
+static int stepUntil(bool busy, float excessDb, int limit, ChangeStep* step) {
+    for (int i = 1; i <= limit; i++) {
+        *step = changeChannelStep(&channel, busy, excessDb);
+        if (*step != CHANGE_STEP_NONE) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void setUp() {
+    changeChannelReset(&channel);
+}
+
+void tearDown() {}
+
+// ============================================================================
+// Simulator Trace
+// ============================================================================
+
+void test_trace_steps_match_simulator() {
+    int event = 0;
+    for (int i = 0; i < TRACE_DWELLS; i++) {
+        ChangeStep step = changeChannelStep(&channel, kDwells[i].busy != 0, kDwells[i].excessDb);
+        if (step == CHANGE_STEP_NONE) {
+            continue;
+        }
+        TEST_ASSERT_LESS_THAN(TRACE_EVENTS, event);
+        TEST_ASSERT_EQUAL_UINT16(kEvents[event].dwell, i);
+        TEST_ASSERT_EQUAL_UINT8(kEvents[event].step, step);
+        event++;
+    }
+    TEST_ASSERT_EQUAL(TRACE_EVENTS, event);
+}
+
+// ============================================================================
+// Scripted Dwells
+// ============================================================================
+
+void test_learning_never_alarms() {
+    ChangeStep step;
+    TEST_ASSERT_EQUAL(-1, stepUntil(true, 30.0f, CHANGE_LEARN_DWELLS - 1, &step));
+    TEST_ASSERT_EQUAL_UINT16(CHANGE_LEARN_DWELLS - 1, channel.dwells);
+}
+
+void test_missing_excess_is_ignored() {
+    learnBackground();
+    ChangeChannel before = channel;
+    TEST_ASSERT_EQUAL(CHANGE_STEP_NONE, changeChannelStep(&channel, true, NAN));
+    TEST_ASSERT_EQUAL_MEMORY(&before, &channel, sizeof(channel));
+}
+
+void test_busy_emitter_raises_busy_onset() {
+    learnBackground();
+    ChangeStep step;
+    // Busy but no stronger than the background: only the CUSUM can fire
+    TEST_ASSERT_GREATER_THAN(0, stepUntil(true, NOISE_EXCESS_DB, 100, &step));
+    TEST_ASSERT_EQUAL(CHANGE_STEP_ONSET, step);
+    TEST_ASSERT_TRUE(channel.busyCause);
+}
+
+void test_strong_burst_needs_several_dwells() {
+    learnBackground();
+    // Each dwell adds at most CHANGE_RSSI_CLIP - CHANGE_RSSI_DRIFT spreads
+    int minimum = (int)ceilf(CHANGE_RSSI_THRESHOLD / (CHANGE_RSSI_CLIP - CHANGE_RSSI_DRIFT));
+    ChangeStep step;
+    int dwells = stepUntil(false, 60.0f, 100, &step);
+    TEST_ASSERT_EQUAL(CHANGE_STEP_ONSET, step);
+    TEST_ASSERT_FALSE(channel.busyCause);
+    TEST_ASSERT_GREATER_OR_EQUAL(minimum, dwells);
+}
+
+void test_emitter_clears_after_quiet_dwells() {
+    learnBackground();
+    ChangeStep step;
+    TEST_ASSERT_GREATER_THAN(0, stepUntil(true, 20.0f, 100, &step));
+    TEST_ASSERT_EQUAL(CHANGE_CLEAR_DWELLS,
+                      stepUntil(false, NOISE_EXCESS_DB, CHANGE_CLEAR_DWELLS, &step));
+    TEST_ASSERT_EQUAL(CHANGE_STEP_QUIET, step);
+    TEST_ASSERT_FALSE(channel.alarmed);
+}
+
+void test_persistent_emitter_is_absorbed() {
+    learnBackground();
+    ChangeStep step;
+    TEST_ASSERT_GREATER_THAN(0, stepUntil(true, 20.0f, 100, &step));
+    TEST_ASSERT_EQUAL(CHANGE_ABSORB_DWELLS, stepUntil(true, 20.0f, CHANGE_ABSORB_DWELLS, &step));
+    TEST_ASSERT_EQUAL(CHANGE_STEP_ABSORBED, step);
+
+    // Relearnt with the emitter as background: no new onset
+    TEST_ASSERT_EQUAL(-1, stepUntil(true, 20.0f, 500, &step));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_trace_steps_match_simulator);
+    RUN_TEST(test_learning_never_alarms);
+    RUN_TEST(test_missing_excess_is_ignored);
+    RUN_TEST(test_busy_emitter_raises_busy_onset);
+    RUN_TEST(test_strong_burst_needs_several_dwells);
+    RUN_TEST(test_emitter_clears_after_quiet_dwells);
+    RUN_TEST(test_persistent_emitter_is_absorbed);
+    return UNITY_END();
+}
@@ -0,0 +1,428 @@
+/**
+ * Classifier Replay Trace
+ *
+ * GENERATED by tools/classifier_compile.py from tools/classifier_trace.csv - do not edit.
+ *
+ * Labelled feature rows and the score evaluate_int() gives each with
+ * the model compiled into include/classifier_model.h.
+ */
+
+#ifndef CLASSIFIER_TRACE_H
+#define CLASSIFIER_TRACE_H
+
+#include <stdint.h>
+#include "classifier_model.h"
+
+#define TRACE_ROWS          400
+#define TRACE_THRESHOLD     50         // Score counted as a drone
+
+typedef struct {
+    int32_t value[CLASSIFIER_NUM_FEATURES];
+    uint8_t label;              // 1 = drone link
+    uint8_t score;              // Host emulation of the integer model
+} TraceRow;
+
+static const TraceRow kTrace[TRACE_ROWS] = {
+    { { 410, 0, 10675, 500, 4951, 8617, 8 }, 1, 100 },
+    { { 349, -10, 9952, 500, 100000, 0, 13 }, 1, 31 },
+    { { -28, 6, 5321, 234, 6774, 1252, 24 }, 1, 46 },
+    { { -21, 35, 1816, 250, 100000, 0, 80 }, 0, 1 },
+    { { 174, 44, 3765, 250, 100000, 0, 20 }, 0, 17 },
+    { { 253, 30, 6087, 234, 6583, 23962, 32 }, 1, 100 },
+    { { 144, 77, 1163, 59, 40012, 0, 12 }, 0, 75 },
+    { { 374, 170, 1417, 234, 19794, 13497, 32 }, 1, 100 },
+    { { 470, 47, 3188, 94, 98345, 339, 128 }, 0, 37 },
+    { { 579, 171, 2368, 156, 49938, 157, 128 }, 0, 97 },
+    { { 511, -61, 6626, 500, 5054, 9341, 13 }, 1, 100 },
+    { { 474, 147, 2117, 250, 6635, 12432, 20 }, 1, 100 },
+    { { 154, 129, 1693, 59, 40111, 0, 8 }, 0, 83 },
+    { { 503, 159, 6442, 234, 100000, 0, 24 }, 1, 88 },
+    { { 600, -105, 4511, 125, 100000, 0, 20 }, 0, 78 },
+    { { 22, 41, 3555, 94, 98129, 344, 64 }, 0, 2 },
+    { { 139, -32, 4756, 500, 4953, 10736, 8 }, 1, 99 },
+    { { 251, -4, 11511, 500, 5031, 11120, 13 }, 1, 99 },
+    { { 345, 27, 6896, 250, 100000, 0, 20 }, 1, 37 },
+    { { 392, 89, 341, 500, 20381, 10422, 8 }, 1, 100 },
+    { { 114, 114, 5772, 234, 100000, 0, 32 }, 1, 10 },
+    { { -19, 121, 2764, 156, 98892, 332, 128 }, 0, 1 },
+    { { 255, -118, 1737, 125, 100000, 0, 32 }, 0, 12 },
+    { { 255, 70, 2592, 500, 100000, 0, 13 }, 1, 52 },
+    { { 533, -3, 2810, 500, 5018, 4065, 13 }, 1, 100 },
+    { { 537, 52, 14689, 500, 100000, 0, 8 }, 1, 70 },
+    { { -33, 23, 10029, 250, 19836, 8488, 20 }, 1, 71 },
+    { { 88, -34, 7032, 500, 10124, 9729, 13 }, 1, 97 },
+    { { 510, -12, 5628, 250, 100000, 0, 120 }, 0, 30 },
+    { { 501, -66, 4391, 500, 4926, 3228, 13 }, 1, 100 },
+    { { 450, 34, 4751, 234, 19788, 20041, 24 }, 1, 100 },
+    { { 100, 92, 2048, 500, 100000, 0, 8 }, 1, 25 },
+    { { 337, -131, 4675, 125, 100000, 0, 51 }, 0, 10 },
+    { { 418, 109, 4541, 500, 10025, 2372, 8 }, 1, 100 },
+    { { -36, 43, 1693, 94, 100000, 0, 32 }, 0, 2 },
+    { { 411, -78, 11155, 500, 19936, 2393, 8 }, 1, 96 },
+    { { 337, 106, 4447, 250, 100000, 0, 120 }, 0, 19 },
+    { { -10, 6, 86, 234, 6589, 10651, 32 }, 1, 97 },
+    { { 270, -48, 515, 125, 100000, 0, 32 }, 0, 24 },
+    { { 582, 199, 2223, 59, 9900, 0, 12 }, 0, 100 },
+    { { 162, 78, 1631, 234, 100000, 0, 24 }, 1, 24 },
+    { { 297, 120, 3726, 500, 9836, 9910, 13 }, 1, 100 },
+    { { 542, 108, 4961, 500, 100000, 0, 13 }, 1, 94 },
+    { { -30, 86, 3993, 500, 19673, 4107, 8 }, 1, 84 },
+    { { 247, 192, 6489, 234, 6539, 574, 24 }, 1, 97 },
+    { { 28, 70, 10899, 250, 6667, 5675, 12 }, 1, 82 },
+    { { 476, 233, 3765, 156, 99222, 363, 32 }, 0, 93 },
+    { { -18, 219, 1294, 94, 100000, 0, 32 }, 0, 10 },
+    { { 203, 64, 6371, 234, 6724, 22131, 32 }, 1, 100 },
+    { { 399, 137, 1856, 59, 99000, 0, 8 }, 0, 85 },
+    { { 447, 26, 3248, 156, 100000, 0, 128 }, 0, 26 },
+    { { 91, -54, 13581, 500, 19710, 2550, 13 }, 1, 41 },
+    { { 41, -91, 3981, 125, 100000, 0, 20 }, 0, 2 },
+    { { 398, 88, 5623, 125, 100000, 0, 20 }, 0, 63 },
+    { { 523, 156, 7429, 234, 6723, 11291, 32 }, 1, 100 },
+    { { 113, 10, 12550, 500, 20116, 6540, 13 }, 1, 85 },
+    { { 425, 152, 696, 234, 19732, 23229, 32 }, 1, 100 },
+    { { 386, 55, 2332, 59, 9862, 0, 8 }, 0, 99 },
+    { { 306, -2, 4219, 250, 100000, 0, 120 }, 0, 7 },
+    { { 42, 106, 2090, 250, 100000, 0, 80 }, 0, 4 },
+    { { 92, 98, 5053, 250, 100000, 0, 80 }, 0, 3 },
+    { { 356, 62, 3727, 156, 100000, 221, 64 }, 0, 38 },
+    { { 496, -16, 14897, 500, 4923, 10341, 13 }, 1, 100 },
+    { { 399, 148, 172, 234, 6789, 17563, 32 }, 1, 100 },
+    { { 241, 37, 2221, 59, 39530, 0, 8 }, 0, 85 },
+    { { 508, 91, 4020, 234, 20232, 5754, 14 }, 1, 100 },
+    { { -26, 50, 2331, 94, 98819, 55, 128 }, 0, 0 },
+    { { 536, 79, 3581, 234, 6553, 12496, 32 }, 1, 100 },
+    { { 410, 89, 2496, 234, 100000, 0, 24 }, 1, 77 },
+    { { 341, 72, 2281, 94, 98452, 193, 64 }, 0, 41 },
+    { { 473, -100, 3781, 250, 100000, 0, 51 }, 0, 45 },
+    { { 124, 15, 5079, 250, 100000, 0, 80 }, 0, 3 },
+    { { 543, -41, 3319, 250, 100000, 0, 51 }, 0, 72 },
+    { { 19, -24, 2028, 250, 100000, 0, 51 }, 0, 2 },
+    { { 226, 96, 2918, 500, 5026, 7009, 8 }, 1, 100 },
+    { { 260, 38, 3785, 234, 20299, 18083, 24 }, 1, 100 },
+    { { 554, -12, 1142, 500, 10004, 12701, 8 }, 1, 100 },
+    { { 469, 31, 1324, 125, 100000, 0, 32 }, 0, 78 },
+    { { 261, -97, 4326, 125, 100000, 0, 20 }, 0, 12 },
+    { { 327, 139, 2095, 94, 50398, 267, 32 }, 0, 93 },
+    { { 187, 100, 4596, 234, 19884, 24493, 14 }, 1, 100 },
+    { { 574, 120, 4001, 250, 20172, 4539, 20 }, 1, 100 },
+    { { 24, 160, 5999, 234, 6743, 6472, 32 }, 1, 94 },
+    { { 420, 74, 2662, 250, 6695, 4592, 12 }, 1, 100 },
+    { { 68, 203, 844, 156, 100000, 123, 32 }, 0, 22 },
+    { { -4, -106, 13262, 500, 10171, 3559, 8 }, 1, 30 },
+    { { 491, 108, 5930, 250, 100000, 0, 80 }, 0, 64 },
+    { { 577, 27, 1414, 125, 100000, 0, 20 }, 0, 93 },
+    { { 191, 72, 3789, 234, 20200, 7842, 14 }, 1, 99 },
+    { { 30, -49, 252, 250, 20074, 3803, 20 }, 1, 77 },
+    { { 113, 194, 5292, 234, 20335, 13354, 14 }, 1, 100 },
+    { { 505, -106, 9252, 500, 100000, 0, 13 }, 1, 54 },
+    { { 499, -105, 8600, 500, 10162, 1081, 8 }, 1, 99 },
+    { { -22, 127, 2611, 59, 39345, 0, 12 }, 0, 40 },
+    { { 287, 161, 2195, 234, 6710, 13019, 32 }, 1, 100 },
+    { { 552, 89, 4837, 125, 100000, 0, 32 }, 0, 88 },
+    { { 372, 77, 3266, 250, 6775, 9260, 12 }, 1, 100 },
+    { { 24, -36, 1454, 250, 100000, 0, 40 }, 0, 3 },
+    { { 43, 113, 13321, 500, 10140, 1365, 13 }, 1, 63 },
+    { { 81, 109, 6474, 500, 5006, 7763, 8 }, 1, 99 },
+    { { 206, 104, 2665, 250, 100000, 0, 80 }, 0, 15 },
+    { { 83, -54, 13018, 500, 19808, 12545, 8 }, 1, 94 },
+    { { 520, 72, 1352, 156, 100000, 257, 128 }, 0, 60 },
+    { { 409, 154, 2288, 94, 98418, 334, 64 }, 0, 72 },
+    { { 348, 33, 2656, 250, 100000, 0, 80 }, 0, 30 },
+    { { 496, 80, 3420, 234, 6613, 21585, 24 }, 1, 100 },
+    { { 274, 186, 2667, 234, 6673, 5124, 32 }, 1, 100 },
+    { { 339, 88, 14574, 500, 9981, 6466, 8 }, 1, 99 },
+    { { 201, 59, 9400, 500, 20282, 4627, 13 }, 1, 95 },
+    { { 425, 153, 1394, 59, 39844, 0, 4 }, 0, 99 },
+    { { 139, 76, 6735, 500, 19706, 2347, 8 }, 1, 91 },
+    { { 217, 17, 2589, 59, 98427, 0, 4 }, 0, 26 },
+    { { -28, 171, 1507, 156, 50022, 221, 128 }, 0, 9 },
+    { { 385, 135, 2767, 156, 50196, 120, 128 }, 0, 78 },
+    { { 443, 205, 297, 156, 100000, 0, 64 }, 0, 88 },
+    { { 28, -17, 10089, 500, 10005, 8480, 8 }, 1, 90 },
+    { { -45, 138, 983, 234, 6584, 10059, 32 }, 1, 98 },
+    { { 480, 124, 2468, 156, 100000, 277, 64 }, 0, 80 },
+    { { 208, 162, 78, 234, 6680, 5590, 32 }, 1, 100 },
+    { { 380, -48, 2306, 125, 100000, 0, 20 }, 0, 46 },
+    { { 228, 200, 1526, 59, 39630, 0, 8 }, 0, 95 },
+    { { 101, 4, 1409, 234, 19883, 13855, 24 }, 1, 99 },
+    { { 214, 151, 1176, 156, 100000, 211, 128 }, 0, 12 },
+    { { 361, 183, 3482, 234, 19772, 16351, 14 }, 1, 100 },
+    { { 209, -81, 7860, 500, 5046, 2191, 13 }, 1, 89 },
+    { { -47, -128, 3503, 125, 100000, 0, 51 }, 0, 0 },
+    { { 516, 53, 6875, 500, 5089, 2190, 13 }, 1, 100 },
+    { { -2, 101, 1754, 250, 100000, 0, 80 }, 0, 2 },
+    { { 68, 35, 13989, 500, 20006, 6940, 8 }, 1, 81 },
+    { { 213, -14, 12176, 500, 19760, 9031, 13 }, 1, 97 },
+    { { 169, 51, 5108, 250, 100000, 0, 32 }, 0, 12 },
+    { { 223, -106, 8856, 500, 20125, 12112, 13 }, 1, 99 },
+    { { 202, 125, 607, 94, 50016, 138, 64 }, 0, 70 },
+    { { 495, 93, 9977, 500, 20322, 1457, 13 }, 1, 99 },
+    { { 460, 94, 4907, 234, 19813, 7275, 14 }, 1, 100 },
+    { { 411, 136, 1224, 234, 6730, 19273, 32 }, 1, 100 },
+    { { 441, 84, 969, 234, 6617, 16428, 14 }, 1, 100 },
+    { { 600, 37, 5758, 250, 100000, 0, 120 }, 0, 60 },
+    { { 526, -69, 8241, 500, 100000, 0, 13 }, 1, 70 },
+    { { 36, 190, 1839, 234, 20257, 7467, 32 }, 1, 97 },
+    { { 225, 3, 5888, 250, 100000, 0, 20 }, 0, 15 },
+    { { 537, -110, 5685, 500, 4950, 2847, 8 }, 1, 100 },
+    { { 274, -37, 2206, 250, 100000, 0, 80 }, 0, 12 },
+    { { 358, -25, 11797, 500, 100000, 0, 8 }, 1, 26 },
+    { { 477, -18, 919, 250, 100000, 0, 120 }, 0, 40 },
+    { { 227, 3, 746, 250, 100000, 0, 120 }, 0, 6 },
+    { { 259, 80, 2181, 250, 20318, 10666, 12 }, 1, 100 },
+    { { 206, 17, 4438, 500, 9909, 827, 13 }, 1, 94 },
+    { { 507, -28, 8925, 500, 19898, 11222, 13 }, 1, 100 },
+    { { 26, 88, 2325, 250, 100000, 0, 20 }, 1, 8 },
+    { { 113, 59, 3477, 156, 99460, 149, 64 }, 0, 5 },
+    { { 568, 2, 4401, 234, 6605, 22102, 32 }, 1, 100 },
+    { { 562, 53, 6918, 500, 4991, 7577, 13 }, 1, 100 },
+    { { -12, 165, 5768, 234, 6560, 25780, 14 }, 1, 100 },
+    { { 531, 187, 1459, 156, 100000, 400, 128 }, 0, 80 },
+    { { 112, -91, 12727, 500, 4921, 6360, 13 }, 1, 81 },
+    { { 7, 97, 7124, 250, 20126, 12949, 20 }, 1, 97 },
+    { { 193, 162, 4994, 234, 19952, 23162, 14 }, 1, 100 },
+    { { 475, 44, 4448, 234, 100000, 0, 24 }, 1, 77 },
+    { { 546, 25, 1967, 94, 100000, 0, 64 }, 0, 78 },
+    { { 356, 33, 1866, 125, 100000, 0, 20 }, 0, 59 },
+    { { 432, 94, 4035, 234, 6742, 15366, 24 }, 1, 100 },
+    { { 103, -57, 6162, 250, 20341, 2351, 12 }, 1, 64 },
+    { { 464, 224, 3338, 156, 49917, 193, 32 }, 0, 99 },
+    { { 425, -19, 13285, 500, 5089, 807, 13 }, 1, 97 },
+    { { 112, 169, 733, 59, 10192, 0, 12 }, 0, 94 },
+    { { 334, 29, 353, 500, 20368, 3377, 13 }, 1, 99 },
+    { { 478, 65, 3116, 500, 100000, 0, 8 }, 1, 91 },
+    { { 46, 164, 6676, 234, 6636, 18598, 14 }, 1, 100 },
+    { { 269, 119, 1138, 59, 9808, 0, 4 }, 0, 98 },
+    { { 275, 47, 4380, 250, 100000, 0, 51 }, 0, 23 },
+    { { 457, 229, 1140, 156, 100000, 102, 32 }, 0, 94 },
+    { { 35, 187, 2953, 234, 6741, 20633, 14 }, 1, 100 },
+    { { -37, 38, 7813, 234, 19823, 15577, 24 }, 1, 97 },
+    { { 543, 17, 10132, 500, 100000, 0, 13 }, 1, 79 },
+    { { 92, 41, 3772, 250, 100000, 0, 120 }, 0, 1 },
+    { { 8, -113, 12228, 500, 4930, 11432, 13 }, 1, 87 },
+    { { 561, -27, 11021, 250, 100000, 0, 12 }, 1, 67 },
+    { { 157, 189, 2944, 156, 100000, 0, 64 }, 0, 19 },
+    { { 254, 81, 1178, 250, 100000, 0, 80 }, 0, 23 },
+    { { 256, -97, 5778, 250, 100000, 0, 20 }, 0, 10 },
+    { { 404, 65, 5065, 234, 6697, 24981, 14 }, 1, 100 },
+    { { 55, 48, 3497, 156, 50913, 322, 128 }, 0, 6 },
+    { { 466, -21, 3250, 125, 100000, 0, 51 }, 0, 55 },
+    { { 542, -55, 11879, 500, 20338, 2694, 8 }, 1, 99 },
+    { { 578, 79, 1096, 94, 100000, 279, 128 }, 0, 74 },
+    { { 230, 76, 10840, 500, 20002, 7224, 13 }, 1, 98 },
+    { { 82, 47, 4583, 234, 100000, 0, 24 }, 1, 6 },
+    { { 294, 82, 385, 94, 100000, 275, 128 }, 0, 16 },
+    { { 402, -52, 1419, 250, 100000, 0, 120 }, 0, 19 },
+    { { 16, 87, 7420, 234, 6629, 19453, 24 }, 1, 100 },
+    { { 430, -109, 9557, 500, 5070, 5178, 13 }, 1, 99 },
+    { { 258, -20, 4389, 500, 20273, 11085, 13 }, 1, 100 },
+    { { 438, 4, 1748, 59, 100000, 0, 12 }, 0, 72 },
+    { { 560, 50, 4552, 250, 100000, 0, 40 }, 0, 86 },
+    { { -26, 167, 2382, 94, 99660, 266, 32 }, 0, 6 },
+    { { 290, -64, 3017, 125, 100000, 0, 51 }, 0, 14 },
+    { { 599, 21, 6939, 234, 100000, 0, 24 }, 1, 87 },
+    { { -47, 86, 1316, 250, 100000, 0, 32 }, 0, 4 },
+    { { 274, 101, 8333, 500, 5017, 7118, 13 }, 1, 100 },
+    { { 14, 196, 2583, 59, 99473, 0, 8 }, 0, 14 },
+    { { 35, 39, 2902, 94, 100000, 316, 64 }, 0, 2 },
+    { { 514, 185, 5251, 234, 100000, 0, 14 }, 1, 94 },
+    { { 258, 81, 14311, 500, 9818, 8891, 8 }, 1, 99 },
+    { { 253, 70, 4228, 125, 100000, 0, 20 }, 0, 30 },
+    { { 377, 131, 2683, 250, 6541, 5468, 20 }, 1, 100 },
+    { { 550, 9, 2006, 500, 4922, 2630, 13 }, 1, 100 },
+    { { 417, -35, 10067, 500, 100000, 0, 8 }, 1, 45 },
+    { { -17, 42, 1037, 59, 10192, 0, 4 }, 0, 64 },
+    { { 490, -69, 3431, 500, 20253, 1075, 13 }, 1, 99 },
+    { { 25, -71, 9737, 500, 9956, 11205, 8 }, 1, 93 },
+    { { 545, 9, 5027, 250, 100000, 0, 80 }, 0, 63 },
+    { { 57, 48, 10250, 500, 100000, 0, 13 }, 1, 3 },
+    { { 572, 144, 5410, 234, 6720, 16448, 32 }, 1, 100 },
+    { { 410, 54, 3859, 250, 100000, 0, 80 }, 0, 43 },
+    { { 526, 95, 3247, 250, 100000, 0, 80 }, 0, 78 },
+    { { 314, 59, 4161, 234, 6742, 15242, 14 }, 1, 100 },
+    { { 590, -63, 3144, 250, 100000, 0, 40 }, 0, 82 },
+    { { -42, -85, 4432, 125, 100000, 0, 32 }, 0, 1 },
+    { { 163, 183, 669, 234, 20071, 1879, 14 }, 1, 98 },
+    { { 17, -68, 5658, 250, 100000, 0, 80 }, 0, 0 },
+    { { 137, 43, 4130, 250, 100000, 0, 32 }, 0, 10 },
+    { { 153, 104, 7680, 234, 20248, 2681, 32 }, 1, 86 },
+    { { 338, -67, 10188, 500, 4948, 6966, 13 }, 1, 99 },
+    { { -49, 82, 5771, 250, 100000, 0, 80 }, 0, 1 },
+    { { 517, 27, 8408, 250, 6798, 7459, 20 }, 1, 100 },
+    { { 249, 140, 2714, 59, 100000, 0, 8 }, 0, 51 },
+    { { 463, -64, 14257, 500, 5027, 2383, 13 }, 1, 98 },
+    { { 473, 41, 1062, 234, 6692, 17098, 14 }, 1, 100 },
+    { { -47, 172, 253, 59, 100000, 0, 12 }, 0, 9 },
+    { { 6, -98, 285, 250, 100000, 0, 80 }, 0, 1 },
+    { { 252, 168, 2255, 156, 49937, 136, 32 }, 0, 89 },
+    { { 413, -111, 5429, 500, 4947, 9598, 13 }, 1, 100 },
+    { { 139, -65, 3684, 500, 20112, 12976, 13 }, 1, 99 },
+    { { 271, 244, 2975, 94, 100000, 0, 32 }, 0, 64 },
+    { { -6, 211, 1172, 156, 100000, 0, 32 }, 0, 12 },
+    { { 183, 20, 1516, 125, 100000, 0, 20 }, 0, 19 },
+    { { 175, 120, 4687, 500, 4917, 12664, 13 }, 1, 100 },
+    { { 308, 111, 1860, 156, 100000, 166, 128 }, 0, 18 },
+    { { 301, 45, 4955, 234, 6755, 16284, 14 }, 1, 100 },
+    { { 329, -16, 7476, 500, 10012, 5989, 13 }, 1, 99 },
+    { { 122, 77, 4643, 234, 6632, 10159, 32 }, 1, 99 },
+    { { 418, 65, 5138, 250, 100000, 0, 40 }, 0, 60 },
+    { { 272, -77, 4542, 500, 9894, 11068, 13 }, 1, 100 },
+    { { 311, 106, 7367, 500, 100000, 0, 8 }, 1, 55 },
+    { { 141, 22, 4379, 250, 100000, 0, 40 }, 0, 7 },
+    { { 314, 88, 2998, 250, 100000, 0, 120 }, 0, 17 },
+    { { 300, 17, 986, 125, 100000, 0, 32 }, 0, 38 },
+    { { 13, -57, 13725, 500, 20169, 3943, 13 }, 1, 31 },
+    { { 0, -91, 2380, 125, 100000, 0, 20 }, 0, 1 },
+    { { 327, 9, 14587, 500, 100000, 0, 8 }, 1, 18 },
+    { { 537, 10, 8343, 500, 100000, 0, 13 }, 1, 82 },
+    { { 474, 71, 2913, 125, 100000, 0, 32 }, 0, 80 },
+    { { 163, 25, 670, 156, 50525, 68, 64 }, 0, 43 },
+    { { 166, -98, 7229, 500, 5021, 11607, 13 }, 1, 99 },
+    { { 172, -40, 14576, 500, 20165, 794, 8 }, 1, 49 },
+    { { 449, 37, 2093, 156, 100000, 69, 128 }, 0, 33 },
+    { { 269, 54, 2603, 250, 100000, 0, 80 }, 0, 19 },
+    { { 280, 4, 1476, 234, 19650, 21824, 14 }, 1, 100 },
+    { { 375, 3, 2412, 234, 20295, 16227, 32 }, 1, 100 },
+    { { 390, 156, 1780, 234, 100000, 0, 24 }, 1, 84 },
+    { { 212, 192, 706, 156, 100000, 311, 32 }, 0, 54 },
+    { { 103, 123, 7955, 234, 6639, 14970, 14 }, 1, 100 },
+    { { 22, -91, 4254, 250, 100000, 0, 120 }, 0, 0 },
+    { { 357, -57, 6324, 250, 6683, 8445, 12 }, 1, 100 },
+    { { 327, 60, 2891, 250, 100000, 0, 20 }, 0, 55 },
+    { { 260, 117, 722, 250, 100000, 0, 80 }, 0, 31 },
+    { { -4, -27, 9295, 500, 100000, 0, 8 }, 1, 1 },
+    { { 539, -91, 4992, 125, 100000, 0, 32 }, 0, 62 },
+    { { 359, -31, 1010, 250, 100000, 0, 32 }, 0, 49 },
+    { { 84, -74, 13196, 500, 100000, 0, 8 }, 1, 1 },
+    { { 418, -20, 4523, 250, 100000, 0, 20 }, 0, 57 },
+    { { 266, 1, 1693, 250, 100000, 0, 51 }, 0, 23 },
+    { { 298, -90, 6970, 500, 100000, 0, 8 }, 1, 21 },
+    { { 496, -37, 2979, 125, 100000, 0, 20 }, 0, 72 },
+    { { 501, -21, 2249, 500, 100000, 0, 13 }, 1, 87 },
+    { { 554, -5, 8000, 500, 19629, 3677, 13 }, 1, 100 },
+    { { 134, 244, 3177, 94, 50683, 139, 128 }, 0, 36 },
+    { { 402, -35, 14562, 500, 19783, 5726, 13 }, 1, 98 },
+    { { 48, -78, 6574, 500, 9986, 8814, 13 }, 1, 92 },
+    { { 308, 98, 1124, 125, 100000, 0, 20 }, 0, 62 },
+    { { 55, 198, 421, 156, 100000, 79, 32 }, 0, 21 },
+    { { -36, 39, 7980, 250, 20350, 6821, 20 }, 1, 70 },
+    { { 545, -1, 2565, 250, 100000, 0, 40 }, 0, 84 },
+    { { 107, -3, 1728, 500, 100000, 0, 13 }, 1, 14 },
+    { { 525, 151, 6545, 234, 20178, 10729, 24 }, 1, 100 },
+    { { 154, 92, 4019, 250, 6577, 9090, 20 }, 1, 99 },
+    { { 302, 112, 1480, 156, 99679, 15, 32 }, 0, 57 },
+    { { 356, 198, 1575, 94, 100000, 160, 32 }, 0, 80 },
+    { { 580, 56, 1916, 234, 20083, 25812, 32 }, 1, 100 },
+    { { 309, 23, 6623, 234, 19676, 379, 14 }, 1, 93 },
+    { { 334, -9, 5333, 500, 5050, 2863, 8 }, 1, 99 },
+    { { 500, -79, 2403, 500, 100000, 0, 13 }, 1, 81 },
+    { { 87, 67, 2734, 250, 100000, 0, 51 }, 0, 7 },
+    { { 458, 31, 8007, 500, 4945, 11854, 8 }, 1, 100 },
+    { { 91, -49, 14641, 500, 4941, 12113, 8 }, 1, 96 },
+    { { 422, 50, 5890, 234, 100000, 0, 14 }, 1, 66 },
+    { { 261, -90, 2187, 250, 100000, 0, 40 }, 0, 14 },
+    { { 57, 134, 2943, 156, 50734, 169, 128 }, 0, 12 },
+    { { 371, 111, 3015, 234, 20345, 12823, 14 }, 1, 100 },
+    { { 417, 80, 10103, 500, 4948, 6948, 8 }, 1, 100 },
+    { { 235, -14, 2175, 500, 19606, 7548, 13 }, 1, 99 },
+    { { 485, 113, 2395, 94, 50012, 66, 64 }, 0, 96 },
+    { { 102, 86, 312, 500, 20111, 7655, 8 }, 1, 99 },
+    { { -23, 3, 1099, 500, 100000, 0, 8 }, 1, 6 },
+    { { 353, 104, 9863, 250, 6567, 11343, 12 }, 1, 100 },
+    { { 398, 49, 275, 94, 100000, 162, 128 }, 0, 29 },
+    { { 56, -126, 2907, 125, 100000, 0, 20 }, 0, 2 },
+    { { 190, -97, 5035, 500, 4900, 7575, 8 }, 1, 98 },
+    { { 351, 10, 335, 125, 100000, 0, 32 }, 0, 52 },
+    { { 439, 133, 2187, 94, 49537, 164, 64 }, 0, 95 },
+    { { 398, -34, 2422, 125, 100000, 0, 32 }, 0, 48 },
+    { { 373, 25, 4587, 250, 100000, 0, 32 }, 0, 48 },
+    { { 455, 230, 3656, 94, 49126, 75, 64 }, 0, 97 },
+    { { 91, 116, 6970, 234, 19710, 16694, 24 }, 1, 100 },
+    { { -36, 77, 3301, 250, 20033, 2350, 12 }, 1, 67 },
+    { { -28, 164, 1644, 94, 100000, 256, 32 }, 0, 6 },
+    { { 536, 14, 749, 250, 100000, 0, 120 }, 0, 62 },
+    { { 581, 29, 6605, 234, 6583, 2070, 14 }, 1, 100 },
+    { { 155, -109, 4368, 125, 100000, 0, 20 }, 0, 4 },
+    { { 311, 249, 2826, 156, 100000, 0, 64 }, 0, 63 },
+    { { 204, -133, 4882, 250, 100000, 0, 20 }, 0, 6 },
+    { { 575, 72, 1944, 59, 100000, 0, 8 }, 0, 95 },
+    { { 169, 216, 2781, 94, 100000, 0, 128 }, 0, 8 },
+    { { 313, 130, 607, 59, 39767, 0, 4 }, 0, 97 },
+    { { 279, 88, 3565, 500, 9826, 7814, 13 }, 1, 100 },
+    { { 439, 55, 11997, 500, 20016, 2256, 13 }, 1, 98 },
+    { { 85, 176, 5215, 234, 20396, 7083, 32 }, 1, 97 },
+    { { 84, -61, 14043, 500, 10014, 898, 8 }, 1, 37 },
+    { { 50, 83, 993, 156, 98803, 170, 128 }, 0, 2 },
+    { { 599, 108, 10234, 500, 20114, 10244, 13 }, 1, 100 },
+    { { -26, 10, 3270, 125, 100000, 0, 32 }, 0, 2 },
+    { { 156, 33, 4446, 500, 19944, 2062, 13 }, 1, 91 },
+    { { 524, 182, 4406, 234, 6620, 5264, 32 }, 1, 100 },
+    { { 49, 217, 1518, 156, 100000, 0, 64 }, 0, 11 },
+    { { -22, 142, 2386, 94, 49812, 194, 128 }, 0, 6 },
+    { { 335, 15, 1681, 59, 10003, 0, 4 }, 0, 98 },
+    { { 35, -25, 5003, 250, 100000, 0, 80 }, 0, 1 },
+    { { -4, 169, 1256, 156, 100000, 0, 64 }, 0, 5 },
+    { { 592, -30, 14363, 500, 10140, 3303, 13 }, 1, 100 },
+    { { 599, 47, 5746, 125, 100000, 0, 32 }, 0, 88 },
+    { { 259, 150, 19, 59, 99291, 0, 8 }, 0, 67 },
+    { { 36, 86, 1633, 94, 50944, 82, 32 }, 0, 33 },
+    { { 166, -80, 633, 500, 19659, 6825, 8 }, 1, 98 },
+    { { 268, 197, 1800, 234, 100000, 0, 32 }, 1, 64 },
+    { { 22, 59, 490, 59, 39333, 0, 12 }, 0, 48 },
+    { { 62, 69, 63, 94, 49916, 276, 64 }, 0, 30 },
+    { { 222, -47, 778, 500, 9905, 6225, 8 }, 1, 99 },
+    { { 401, -140, 1689, 125, 100000, 0, 32 }, 0, 33 },
+    { { 147, -53, 3189, 250, 6713, 2119, 12 }, 1, 88 },
+    { { 494, -58, 3669, 250, 6755, 3132, 12 }, 1, 100 },
+    { { 540, -99, 8477, 500, 100000, 0, 8 }, 1, 69 },
+    { { 344, 103, 4342, 234, 19807, 18036, 24 }, 1, 100 },
+    { { 163, 14, 420, 500, 19915, 10621, 13 }, 1, 100 },
+    { { 557, 1, 13630, 500, 5076, 12430, 8 }, 1, 100 },
+    { { -5, -65, 3183, 500, 10017, 10196, 13 }, 1, 95 },
+    { { 223, 48, 2194, 59, 10173, 0, 4 }, 0, 94 },
+    { { 239, -117, 2473, 500, 5031, 7095, 8 }, 1, 99 },
+    { { 129, 109, 1786, 250, 100000, 0, 120 }, 0, 4 },
+    { { 179, 16, 520, 59, 99619, 0, 12 }, 0, 22 },
+    { { 204, 53, 4257, 250, 19946, 9840, 20 }, 1, 99 },
+    { { 58, 46, 5626, 234, 6634, 20586, 14 }, 1, 100 },
+    { { 421, 110, 1804, 500, 9824, 12994, 13 }, 1, 100 },
+    { { 293, 173, 303, 234, 100000, 0, 32 }, 1, 71 },
+    { { 293, -117, 4684, 125, 100000, 0, 32 }, 0, 10 },
+    { { 199, 25, 3143, 250, 100000, 0, 120 }, 0, 4 },
+    { { 590, 131, 5428, 234, 6684, 10886, 14 }, 1, 100 },
+    { { 416, 95, 3267, 234, 100000, 0, 32 }, 1, 75 },
+    { { 35, 111, 557, 250, 6683, 9516, 12 }, 1, 99 },
+    { { 295, 4, 3725, 234, 6677, 20496, 14 }, 1, 100 },
+    { { 152, 120, 627, 94, 49045, 262, 32 }, 0, 72 },
+    { { 277, -119, 7441, 500, 100000, 0, 8 }, 1, 14 },
+    { { 143, 234, 166, 156, 100000, 224, 64 }, 0, 33 },
+    { { 30, 120, 6817, 234, 19869, 1033, 14 }, 1, 66 },
+    { { 506, 150, 3184, 94, 100000, 0, 64 }, 0, 83 },
+    { { 417, 101, 2258, 59, 40732, 0, 8 }, 0, 98 },
+    { { 221, -115, 13962, 500, 20163, 4195, 13 }, 1, 71 },
+    { { 220, 97, 4816, 250, 100000, 0, 80 }, 0, 12 },
+    { { 343, -106, 2827, 500, 4943, 2350, 8 }, 1, 99 },
+    { { 227, -47, 8671, 250, 20228, 1248, 12 }, 1, 76 },
+    { { 348, 74, 676, 234, 20318, 12774, 32 }, 1, 100 },
+    { { 396, 90, 4366, 250, 19945, 12228, 12 }, 1, 100 },
+    { { 596, 171, 3248, 156, 100000, 34, 128 }, 0, 82 },
+    { { 590, 49, 2176, 94, 100000, 0, 64 }, 0, 86 },
+    { { 591, 182, 661, 59, 100000, 0, 8 }, 0, 98 },
+    { { 309, 60, 12780, 500, 19919, 8514, 8 }, 1, 99 },
+    { { 472, 30, 4468, 500, 5081, 7768, 13 }, 1, 100 },
+    { { 6, 198, 570, 59, 10036, 0, 4 }, 0, 89 },
+    { { 137, -49, 3182, 500, 100000, 0, 13 }, 1, 11 },
+    { { 220, 42, 3148, 250, 100000, 0, 120 }, 0, 5 },
+    { { -23, 161, 5789, 234, 19707, 20030, 32 }, 1, 100 },
+    { { 585, -8, 5197, 500, 20291, 776, 13 }, 1, 100 },
+    { { 2, 149, 2799, 59, 40310, 0, 12 }, 0, 49 },
+    { { 365, 88, 1009, 250, 100000, 0, 40 }, 0, 67 },
+    { { 129, 123, 3008, 94, 100000, 178, 32 }, 0, 16 },
+    { { 370, 165, 680, 59, 100000, 0, 12 }, 0, 85 },
+    { { 350, 138, 7702, 234, 20192, 1394, 14 }, 1, 98 },
+    { { 30, 154, 4819, 234, 6667, 21298, 24 }, 1, 100 },
+    { { 225, 99, 2245, 234, 19727, 21011, 24 }, 1, 100 },
+    { { 59, 119, 619, 59, 100000, 0, 4 }, 0, 17 }
+};
+
+#endif // CLASSIFIER_TRACE_H
@@ -0,0 +1,112 @@
+/**
+ * Classifier Replay Benchmark
+ *
+ * Replays the labelled feature trace of classifier_trace.h (exported from
+ * tools/classifier_trace.csv) through the compiled model of
+ * src/classifier.cpp. Checks that every score matches the host emulation
+ * the accuracy figures of tools/classifier_compile.py come from, and
+ * reports the accuracy on the trace and the time per inference.
+ *
+ *   pio test -e native -f test_classifier -v
+ *
+ * The time is the host's; it bounds the model's cost relative to the rest
+ * of the analysis, not the ESP32-S3 figure.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "classifier.h"
+#include "classifier_trace.h"
+
+#define BENCH_PASSES        2000      // Trace replays timed
+
+typedef struct {
+    uint32_t tp;
+    uint32_t fp;
+    uint32_t tn;
+    uint32_t fn;
+} Confusion;
+
+static uint8_t score(const TraceRow* row) {
+    ClassifierFeatures features;
+    for (int i = 0; i < CLASSIFIER_NUM_FEATURES; i++) {
+        features.value[i] = row->value[i];
+    }
+    return classifierConfidence(&features);
+}
+
+static void count(Confusion* confusion, bool predicted, bool drone) {
+    if (predicted && drone) {
+        confusion->tp++;
+    } else if (predicted) {
+        confusion->fp++;
+    } else if (drone) {
+        confusion->fn++;
+    } else {
+        confusion->tn++;
+    }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_scores_match_host_emulation() {
+    for (int i = 0; i < TRACE_ROWS; i++) {
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(kTrace[i].score, score(&kTrace[i]), "trace row");
+    }
+}
+
+void test_accuracy_on_trace() {
+    Confusion device = {};
+    Confusion host = {};
+    for (int i = 0; i < TRACE_ROWS; i++) {
+        count(&device, score(&kTrace[i]) >= TRACE_THRESHOLD, kTrace[i].label != 0);
+        count(&host, kTrace[i].score >= TRACE_THRESHOLD, kTrace[i].label != 0);
+    }
+    TEST_ASSERT_EQUAL_UINT32(host.tp, device.tp);
+    TEST_ASSERT_EQUAL_UINT32(host.fp, device.fp);
+
+    char message[128];
+    snprintf(message, sizeof(message),
+             "accuracy %.2f%% (tp=%u fp=%u tn=%u fn=%u) over %d rows",
+             100.0 * (device.tp + device.tn) / TRACE_ROWS, (unsigned)device.tp,
+             (unsigned)device.fp, (unsigned)device.tn, (unsigned)device.fn, TRACE_ROWS);
+    TEST_MESSAGE(message);
+}
+
+void test_inference_time() {
+    ClassifierFeatures features[TRACE_ROWS];
+    for (int i = 0; i < TRACE_ROWS; i++) {
+        for (int f = 0; f < CLASSIFIER_NUM_FEATURES; f++) {
+            features[i].value[f] = kTrace[i].value[f];
+        }
+    }
+
+    // The sum keeps the compiler from dropping the evaluations
+    uint32_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (int i = 0; i < TRACE_ROWS; i++) {
+            sum += classifierConfidence(&features[i]);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() /
+                ((double)BENCH_PASSES * TRACE_ROWS);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, sum);
+
+    char message[96];
+    snprintf(message, sizeof(message), "%.1f ns per inference (host, %d inferences)", ns,
+             BENCH_PASSES * TRACE_ROWS);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_scores_match_host_emulation);
+    RUN_TEST(test_accuracy_on_trace);
+    RUN_TEST(test_inference_time);
+    return UNITY_END();
+}
@@ -0,0 +1,199 @@
+/**
+ * Localizer Drive-By Benchmark
+ *
+ * Runs the position filter of src/localizer_grid.cpp on the drive-by
+ * scenario of tools/report_aggregator.py --benchmark: one node driving a
+ * 1.6 km square loop at 10 m/s, 20 packets/s with 6 dB fast fading, past
+ * an emitter of unknown power within 600 m of the loop's centre, whose
+ * path loss exponent differs from the model's. Reports the firmware's
+ * error, uncertainty and throughput in the benchmark's CSV columns and
+ * requires them to stay within bounds.
+ *
+ *   pio test -e native -f test_localizer -v
+ *
+ * The fixed-node scenario of the benchmark is the host aggregator's only:
+ * the device filter sees its own node's observations, and a node that
+ * does not move never commits enough of them for an estimate.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include "localizer_grid.h"
+
+#define TRIALS              30        // Emitters simulated
+#define DRIVE_PACKETS       6400      // Packets over two laps of the loop
+#define DRIVE_STEP_M        0.5f      // Distance driven between packets
+#define LOOP_SIDE_M         1600.0f   // Side of the square loop
+#define FADING_SIGMA_DB     6.0       // Fast fading of each packet
+#define SENSITIVITY_DBM     -120.0    // Weakest packet received
+#define SIM_ORIGIN_LAT      47.0      // Simulated area
+#define SIM_ORIGIN_LON      8.0
+#define METRES_PER_DEG_LAT  110574.0
+#define METRES_PER_DEG_LON  111320.0
+
+// Bounds on the figures of TRIALS emitters
+#define MAX_MEDIAN_ERROR_M  250.0
+#define MAX_P90_ERROR_M     800.0
+#define MIN_WITHIN_2_SIGMA  0.8
+
+static uint64_t randomState;
+
+static double uniform(double low, double high) {
+    // splitmix64: deterministic scenarios without the C library's generator
+    uint64_t z = (randomState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return low + (high - low) * (double)(z >> 11) / 9007199254740992.0;
+}
+
+static double gauss(double sigma) {
+    // Box-Muller
+    double u = uniform(0.0, 1.0);
+    double v = uniform(0.0, 1.0);
+    return sigma * sqrt(-2.0 * log(1.0 - u)) * cos(2.0 * M_PI * v);
+}
+
+static double metresPerDegLon() {
+    return METRES_PER_DEG_LON * cos(SIM_ORIGIN_LAT * M_PI / 180.0);
+}
+
+/**
+ * Observer position on the loop after a distance driven
+ */
+static void loopPosition(float driven, double* x, double* y) {
+    int side = (int)(driven / LOOP_SIDE_M) % 4;
+    double along = fmod(driven, LOOP_SIDE_M) - LOOP_SIDE_M / 2;
+    double half = LOOP_SIDE_M / 2;
+    const double xs[4] = {along, half, -along, -half};
+    const double ys[4] = {-half, along, half, -along};
+    *x = xs[side];
+    *y = ys[side];
+}
+
+typedef struct {
+    double errorM;
+    double uncertaintyM;
+    int packets;
+    double seconds;             // Host time in the filter
+} DriveResult;
+
+/**
+ * Localize one random emitter from the drive
+ * @return false if the filter gave no estimate
+ */
+static bool driveRun(LocalizerGrid* grid, DriveResult* result) {
+    double ex = uniform(-600, 600);
+    double ey = uniform(-600, 600);
+    double power = uniform(0, 30);
+    double exponent = uniform(2.4, 3.0);    // True exponent differs from the model's
+
+    result->packets = 0;
+    result->seconds = 0.0;
+    bool started = false;
+    for (int k = 0; k < DRIVE_PACKETS; k++) {
+        double x, y;
+        loopPosition(k * DRIVE_STEP_M, &x, &y);
+        double distance = sqrt((x - ex) * (x - ex) + (y - ey) * (y - ey) +
+                               LOCALIZER_ANTENNA_M * LOCALIZER_ANTENNA_M);
+        double rssi = power - 40.0 - 10.0 * exponent * log10(distance) + gauss(FADING_SIGMA_DB);
+        if (rssi <= SENSITIVITY_DBM) {
+            continue;
+        }
+        double latitude = SIM_ORIGIN_LAT + y / METRES_PER_DEG_LAT;
+        double longitude = SIM_ORIGIN_LON + x / metresPerDegLon();
+
+        auto start = std::chrono::steady_clock::now();
+        if (!started) {
+            // Centred where the emitter was first heard, as on the device
+            localizerGridInit(grid, latitude, longitude);
+            started = true;
+        }
+        localizerGridObserve(grid, (float)rssi, latitude, longitude);
+        result->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result->packets++;
+    }
+
+    double latitude, longitude;
+    float uncertaintyM;
+    if (!started || !localizerGridEstimate(grid, &latitude, &longitude, &uncertaintyM)) {
+        return false;
+    }
+    double x = (longitude - SIM_ORIGIN_LON) * metresPerDegLon();
+    double y = (latitude - SIM_ORIGIN_LAT) * METRES_PER_DEG_LAT;
+    result->errorM = hypot(x - ex, y - ey);
+    result->uncertaintyM = uncertaintyM;
+    return true;
+}
+
+void setUp() {
+    randomState = 1;
+}
+
+void tearDown() {}
+
+void test_stationary_observer_gives_no_estimate() {
+    static LocalizerGrid grid;
+    localizerGridInit(&grid, SIM_ORIGIN_LAT, SIM_ORIGIN_LON);
+    for (int i = 0; i < 100; i++) {
+        // GPS jitter well inside the spacing
+        TEST_ASSERT_FALSE(localizerGridObserve(&grid, -80.0f, SIM_ORIGIN_LAT + uniform(-2e-5, 2e-5),
+                                               SIM_ORIGIN_LON));
+    }
+    double latitude, longitude;
+    float uncertaintyM;
+    TEST_ASSERT_FALSE(localizerGridEstimate(&grid, &latitude, &longitude, &uncertaintyM));
+}
+
+void test_drive_by_accuracy() {
+    static LocalizerGrid grid;
+    double errors[TRIALS];
+    double uncertainties[TRIALS];
+    int located = 0;
+    int consistent = 0;
+    long packets = 0;
+    double seconds = 0.0;
+
+    for (int trial = 0; trial < TRIALS; trial++) {
+        DriveResult result;
+        if (!driveRun(&grid, &result)) {
+            continue;
+        }
+        errors[located] = result.errorM;
+        uncertainties[located] = result.uncertaintyM;
+        consistent += result.errorM <= 2 * result.uncertaintyM;
+        packets += result.packets;
+        seconds += result.seconds;
+        located++;
+    }
+    TEST_ASSERT_EQUAL(TRIALS, located);
+
+    std::sort(errors, errors + located);
+    std::sort(uncertainties, uncertainties + located);
+    double medianError = errors[located / 2];
+    double p90Error = errors[std::min(located - 1, located * 9 / 10)];
+    double within = (double)consistent / located;
+
+    char message[160];
+    snprintf(message, sizeof(message),
+             "scenario,grid,trials,median_error_m,p90_error_m,median_uncertainty_m,"
+             "within_2_sigma,observations_per_s");
+    TEST_MESSAGE(message);
+    snprintf(message, sizeof(message), "drive,firmware,%d,%.0f,%.0f,%.0f,%.2f,%.0f", located,
+             medianError, p90Error, uncertainties[located / 2], within, packets / seconds);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_LESS_THAN_FLOAT(MAX_MEDIAN_ERROR_M, medianError);
+    TEST_ASSERT_LESS_THAN_FLOAT(MAX_P90_ERROR_M, p90Error);
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(MIN_WITHIN_2_SIGMA, within);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_stationary_observer_gives_no_estimate);
+    RUN_TEST(test_drive_by_accuracy);
+    return UNITY_END();
+}
@@ -0,0 +1,379 @@
+/**
+ * Report Codec Tests
+ *
+ * Encodes reports with src/report_codec.cpp and floods them through small
+ * networks of simulated nodes, each running the receive and relay
+ * decisions of the firmware, then checks who hears which report, how
+ * often, and that relaying stops at the hop limit. A golden frame from
+ * tools/report_aggregator.py pins the byte format to the host decoder.
+ *
+ *   pio test -e native -f test_report
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "report_codec.h"
+
+#define MAX_NODES           6
+#define MAX_PENDING         8             // Relay copies a node holds for its slot
+
+/**
+ * Simulated node: its seen cache, relay queue and what it heard
+ */
+typedef struct {
+    uint16_t id;
+    ReportSeenCache seen;
+    uint8_t pending[MAX_PENDING][REPORT_MAX_FRAME];
+    size_t pendingLength[MAX_PENDING];
+    int pendingCount;
+    int received;               // New reports heard
+    int duplicates;             // Reports heard again
+    int relayed;                // Relay copies transmitted
+} SimNode;
+
+typedef struct {
+    SimNode nodes[MAX_NODES];
+    bool link[MAX_NODES][MAX_NODES];  // Radio range
+    int count;
+} SimNetwork;
+
+static SimNetwork net;
+
+static void addNodes(int count) {
+    net.count = count;
+    for (int i = 0; i < count; i++) {
+        net.nodes[i].id = (uint16_t)(0x1000 + i);
+        reportSeenReset(&net.nodes[i].seen);
+    }
+}
+
+static void linkNodes(int a, int b) {
+    net.link[a][b] = true;
+    net.link[b][a] = true;
+}
+
+/**
+ * Every node in range of the sender runs the frame through the receive path
+ */
+static void broadcast(int sender, const uint8_t* frame, size_t length) {
+    for (int i = 0; i < net.count; i++) {
+        if (!net.link[sender][i]) {
+            continue;
+        }
+        SimNode* node = &net.nodes[i];
+        uint8_t relay[REPORT_MAX_FRAME];
+        switch (reportReceive(&node->seen, frame, length, relay)) {
+            case REPORT_RX_INVALID:
+                TEST_FAIL_MESSAGE("valid frame rejected");
+                break;
+            case REPORT_RX_DUPLICATE:
+                node->duplicates++;
+                break;
+            case REPORT_RX_RELAY:
+                TEST_ASSERT_LESS_THAN(MAX_PENDING, node->pendingCount);
+                memcpy(node->pending[node->pendingCount], relay, length);
+                node->pendingLength[node->pendingCount++] = length;
+                node->received++;
+                break;
+            case REPORT_RX_NEW:
+                node->received++;
+                break;
+        }
+    }
+}
+
+/**
+ * Node originates a report, as meshReportService() does
+ */
+static void originate(int sender, uint16_t sequence, uint8_t count) {
+    SimNode* node = &net.nodes[sender];
+    ReportHeader header = {};
+    header.nodeId = node->id;
+    header.sequence = sequence;
+    header.timeS = 1767225600UL + sequence * 30;
+    header.latitudeE7 = REPORT_NO_POSITION;
+    header.longitudeE7 = REPORT_NO_POSITION;
+    header.count = count;
+    ReportEntry entries[REPORT_MAX_ENTRIES] = {};
+    for (int i = 0; i < count; i++) {
+        entries[i].key = 0x45000000UL | (uint32_t)(sender * 16 + i);
+        entries[i].signatureIndex = -1;
+        entries[i].packets = (uint16_t)(100 + i);
+    }
+
+    uint8_t frame[REPORT_MAX_FRAME];
+    size_t length = reportEncode(&header, entries, frame);
+    TEST_ASSERT_NOT_EQUAL(0, length);
+    TEST_ASSERT_TRUE(reportMarkSeen(&node->seen, node->id, sequence));
+    broadcast(sender, frame, length);
+}
+
+/**
+ * Slots pass until no node holds a relay copy
+ * @return Slots needed
+ */
+static int flood() {
+    int slots = 0;
+    bool busy = true;
+    while (busy) {
+        busy = false;
+        for (int i = 0; i < net.count; i++) {
+            SimNode* node = &net.nodes[i];
+            int pending = node->pendingCount;
+            uint8_t frames[MAX_PENDING][REPORT_MAX_FRAME];
+            size_t lengths[MAX_PENDING];
+            memcpy(frames, node->pending, sizeof(frames));
+            memcpy(lengths, node->pendingLength, sizeof(lengths));
+            node->pendingCount = 0;
+            for (int f = 0; f < pending; f++) {
+                node->relayed++;
+                broadcast(i, frames[f], lengths[f]);
+                busy = true;
+            }
+        }
+        TEST_ASSERT_LESS_THAN(REPORT_HOP_LIMIT + 2, ++slots);
+    }
+    return slots;
+}
+
+static uint8_t hopsOf(const uint8_t* frame, size_t length) {
+    ReportHeader header;
+    TEST_ASSERT_TRUE(reportDecode(frame, length, &header));
+    return header.versionHops & 0x0F;
+}
+
+void setUp() {
+    memset(&net, 0, sizeof(net));
+}
+
+void tearDown() {}
+
+// ============================================================================
+// Frame Format
+// ============================================================================
+
+void test_crc_matches_zlib() {
+    const uint8_t check[] = "123456789";
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926UL, reportCrc32(check, 9));
+}
+
+void test_encode_matches_aggregator_golden_frame() {
+    // tools/report_aggregator.py encode_report(0x1234, 7, 1767225600,
+    //     [key 0x45ABCDEF, 13500 kHz, signature 0, LoRa, rate 4, -61/-70 dBm,
+    //      812 packets, 95 s, age 2], position=(47.3769, 8.5417))
+    static const uint8_t golden[] = {
+        0xD7, 0x22, 0x34, 0x12, 0x07, 0x00, 0x00, 0xB9, 0x55, 0x69, 0x28, 0x24, 0x3D, 0x1C,
+        0x28, 0x5C, 0x17, 0x05, 0x01, 0xEF, 0xCD, 0xAB, 0x45, 0xBC, 0x34, 0x00, 0x04, 0xC3,
+        0xBA, 0x2C, 0x03, 0x5F, 0x00, 0x02, 0xF9, 0xA5, 0x57, 0x2A
+    };
+
+    ReportHeader header = {};
+    header.nodeId = 0x1234;
+    header.sequence = 7;
+    header.timeS = 1767225600UL;
+    header.latitudeE7 = 473769000;
+    header.longitudeE7 = 85417000;
+    header.count = 1;
+    ReportEntry entry = {};
+    entry.key = 0x45ABCDEFUL;
+    entry.frequencyKHz = 13500;
+    entry.signatureIndex = 0;
+    entry.modulationRate = 0x04;
+    entry.peakRssi = -61;
+    entry.meanRssi = -70;
+    entry.packets = 812;
+    entry.durationS = 95;
+    entry.ageS = 2;
+
+    uint8_t frame[REPORT_MAX_FRAME];
+    TEST_ASSERT_EQUAL(sizeof(golden), reportEncode(&header, &entry, frame));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(golden, frame, sizeof(golden));
+    TEST_ASSERT_TRUE(reportDecode(golden, sizeof(golden), NULL));
+}
+
+void test_round_trip_full_frame() {
+    ReportHeader header = {};
+    header.nodeId = 0xBEEF;
+    header.sequence = 65535;
+    header.latitudeE7 = -337000000;
+    header.longitudeE7 = 1512000000;
+    header.count = REPORT_MAX_ENTRIES;
+    ReportEntry entries[REPORT_MAX_ENTRIES];
+    for (int i = 0; i < REPORT_MAX_ENTRIES; i++) {
+        memset(&entries[i], 0x11 * (i + 1), sizeof(entries[i]));
+    }
+
+    uint8_t frame[REPORT_MAX_FRAME];
+    size_t length = reportEncode(&header, entries, frame);
+    TEST_ASSERT_EQUAL(REPORT_MAX_FRAME, length);
+
+    ReportHeader decoded;
+    TEST_ASSERT_TRUE(reportDecode(frame, length, &decoded));
+    TEST_ASSERT_EQUAL_UINT16(0xBEEF, decoded.nodeId);
+    TEST_ASSERT_EQUAL_UINT16(65535, decoded.sequence);
+    TEST_ASSERT_EQUAL(-337000000, decoded.latitudeE7);
+    TEST_ASSERT_EQUAL_UINT8((REPORT_VERSION << 4) | REPORT_HOP_LIMIT, decoded.versionHops);
+    for (int i = 0; i < REPORT_MAX_ENTRIES; i++) {
+        ReportEntry entry;
+        reportGetEntry(frame, (uint8_t)i, &entry);
+        TEST_ASSERT_EQUAL_MEMORY(&entries[i], &entry, sizeof(entry));
+    }
+}
+
+void test_encode_rejects_too_many_entries() {
+    ReportHeader header = {};
+    header.count = REPORT_MAX_ENTRIES + 1;
+    ReportEntry entries[REPORT_MAX_ENTRIES + 1] = {};
+    uint8_t frame[REPORT_MAX_FRAME];
+    TEST_ASSERT_EQUAL(0, reportEncode(&header, entries, frame));
+}
+
+void test_rejects_corrupt_and_foreign_frames() {
+    ReportHeader header = {};
+    header.count = 2;
+    ReportEntry entries[2] = {};
+    uint8_t frame[REPORT_MAX_FRAME];
+    size_t length = reportEncode(&header, entries, frame);
+    ReportSeenCache seen;
+    reportSeenReset(&seen);
+    uint8_t relay[REPORT_MAX_FRAME];
+
+    // Any flipped bit, a short or long frame
+    for (size_t i = 0; i < length; i++) {
+        frame[i] ^= 0x10;
+        TEST_ASSERT_EQUAL(REPORT_RX_INVALID, reportReceive(&seen, frame, length, relay));
+        frame[i] ^= 0x10;
+    }
+    TEST_ASSERT_EQUAL(REPORT_RX_INVALID, reportReceive(&seen, frame, length - 1, relay));
+    TEST_ASSERT_EQUAL(REPORT_RX_INVALID, reportReceive(&seen, frame, length + 1, relay));
+
+    // Sealed, but of another version
+    uint8_t forged[REPORT_MAX_FRAME];
+    memcpy(forged, frame, length);
+    forged[1] = (uint8_t)(((REPORT_VERSION + 1) << 4) | REPORT_HOP_LIMIT);
+    uint32_t crc = reportCrc32(forged, length - 4);
+    memcpy(forged + length - 4, &crc, sizeof(crc));
+    TEST_ASSERT_FALSE(reportDecode(forged, length, NULL));
+
+    // An ELRS-sized LoRa packet that starts with the magic byte
+    const uint8_t detection[8] = { REPORT_MAGIC, 0x22, 1, 2, 3, 4, 5, 6 };
+    TEST_ASSERT_EQUAL(REPORT_RX_INVALID, reportReceive(&seen, detection, sizeof(detection), relay));
+
+    // The intact frame is still new
+    TEST_ASSERT_EQUAL(REPORT_RX_RELAY, reportReceive(&seen, frame, length, relay));
+}
+
+// ============================================================================
+// Receive and Relay
+// ============================================================================
+
+void test_relay_copy_has_one_hop_fewer() {
+    ReportHeader header = {};
+    header.nodeId = 0x2222;
+    header.count = 1;
+    ReportEntry entry = {};
+    uint8_t frame[REPORT_MAX_FRAME];
+    size_t length = reportEncode(&header, &entry, frame);
+
+    ReportSeenCache seen;
+    reportSeenReset(&seen);
+    uint8_t relay[REPORT_MAX_FRAME];
+    TEST_ASSERT_EQUAL(REPORT_RX_RELAY, reportReceive(&seen, frame, length, relay));
+    TEST_ASSERT_EQUAL_UINT8(REPORT_HOP_LIMIT - 1, hopsOf(relay, length));
+
+    // Identical apart from the hop count and CRC
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frame + 2, relay + 2, length - 6);
+
+    // The same report relayed back is a duplicate, not a new relay
+    TEST_ASSERT_EQUAL(REPORT_RX_DUPLICATE, reportReceive(&seen, relay, length, relay));
+}
+
+void test_line_of_nodes_stops_at_hop_limit() {
+    // 0 - 1 - 2 - 3 - 4 - 5: the report travels one direct hop and
+    // REPORT_HOP_LIMIT relays
+    addNodes(6);
+    for (int i = 0; i + 1 < net.count; i++) {
+        linkNodes(i, i + 1);
+    }
+
+    originate(0, 1, 3);
+    flood();
+
+    for (int i = 1; i < net.count; i++) {
+        TEST_ASSERT_EQUAL(i <= REPORT_HOP_LIMIT + 1 ? 1 : 0, net.nodes[i].received);
+    }
+    // The last node in reach has no hops left to relay
+    TEST_ASSERT_EQUAL(1, net.nodes[REPORT_HOP_LIMIT].relayed);
+    TEST_ASSERT_EQUAL(0, net.nodes[REPORT_HOP_LIMIT + 1].relayed);
+    // Relays heard back by the previous node are duplicates
+    TEST_ASSERT_EQUAL(1, net.nodes[0].duplicates);
+    TEST_ASSERT_EQUAL(0, net.nodes[0].received);
+}
+
+void test_full_mesh_hears_every_report_once() {
+    addNodes(5);
+    for (int a = 0; a < net.count; a++) {
+        for (int b = a + 1; b < net.count; b++) {
+            linkNodes(a, b);
+        }
+    }
+
+    for (int sender = 0; sender < net.count; sender++) {
+        originate(sender, 42, (uint8_t)(sender + 1));
+        flood();
+    }
+
+    for (int i = 0; i < net.count; i++) {
+        SimNode* node = &net.nodes[i];
+        TEST_ASSERT_EQUAL(net.count - 1, node->received);
+        // Every receiver relays each report once, and nobody relays a
+        // relay: the originator hears all copies again, each receiver the
+        // copies of the other receivers
+        TEST_ASSERT_EQUAL(net.count - 1, node->relayed);
+        TEST_ASSERT_EQUAL((net.count - 1) + (net.count - 1) * (net.count - 2), node->duplicates);
+    }
+}
+
+void test_two_paths_deliver_once() {
+    // 0 reaches 3 through 1 and through 2
+    addNodes(4);
+    linkNodes(0, 1);
+    linkNodes(0, 2);
+    linkNodes(1, 3);
+    linkNodes(2, 3);
+
+    originate(0, 9, 1);
+    flood();
+
+    TEST_ASSERT_EQUAL(1, net.nodes[3].received);
+    TEST_ASSERT_EQUAL(1, net.nodes[3].duplicates);
+    TEST_ASSERT_EQUAL(1, net.nodes[3].relayed);
+}
+
+void test_seen_cache_forgets_oldest_report() {
+    ReportSeenCache seen;
+    reportSeenReset(&seen);
+    for (int i = 0; i < REPORT_SEEN_CACHE; i++) {
+        TEST_ASSERT_TRUE(reportMarkSeen(&seen, 0x3333, (uint16_t)i));
+    }
+    TEST_ASSERT_FALSE(reportMarkSeen(&seen, 0x3333, 0));
+    TEST_ASSERT_TRUE(reportMarkSeen(&seen, 0x3333, REPORT_SEEN_CACHE));
+    TEST_ASSERT_TRUE(reportMarkSeen(&seen, 0x3333, 0));
+    // Same sequence from another node is another report
+    TEST_ASSERT_TRUE(reportMarkSeen(&seen, 0x4444, REPORT_SEEN_CACHE));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc_matches_zlib);
+    RUN_TEST(test_encode_matches_aggregator_golden_frame);
+    RUN_TEST(test_round_trip_full_frame);
+    RUN_TEST(test_encode_rejects_too_many_entries);
+    RUN_TEST(test_rejects_corrupt_and_foreign_frames);
+    RUN_TEST(test_relay_copy_has_one_hop_fewer);
+    RUN_TEST(test_line_of_nodes_stops_at_hop_limit);
+    RUN_TEST(test_full_mesh_hears_every_report_once);
+    RUN_TEST(test_two_paths_deliver_once);
+    RUN_TEST(test_seen_cache_forgets_oldest_report);
+    return UNITY_END();
+}
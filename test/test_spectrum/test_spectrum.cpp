@@ -0,0 +1,236 @@
+/**
+ * Spectrum Codec Tests
+ *
+ * Runs the row codec of src/spectrum_codec.cpp against the golden stream
+ * tools/spectrum_decode.py --golden checks its own codec against, then
+ * round-trips simulated rows and corrupts the stream to check the
+ * decoder's recovery.
+ *
+ *   pio test -e native -f test_spectrum
+ */
+
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include "spectrum_report.h"
+
+#define GOLDEN_FRAMES   4
+#define GOLDEN_FIRST    4
+#define GOLDEN_COUNT    8
+#define ROUND_TRIP_ROWS 200
+
+// Same stream as GOLDEN_ROWS, GOLDEN_FRAMES and GOLDEN_DECODED in
+// tools/spectrum_decode.py
+static const uint8_t kGoldenTag[GOLDEN_FRAMES] = {1, 1, 1, 2};
+static const uint8_t kGoldenRow[GOLDEN_FRAMES][GOLDEN_COUNT] = {
+    {1, 1, 100, 104, 1, 0, 180, 1},
+    {1, 1, 103, 104, 1, 1, 200, 0},
+    {1, 1, 1, 104, 150, 1, 200, 1},
+    {1, 1, 1, 104, 150, 1, 200, 1},
+};
+static const char* const kGoldenFrame[GOLDEN_FRAMES] = {
+    "1300040804018C03018A0302D005CA05",
+    "1201040809045001",
+    "12020408038A0301D40405",
+    "1503040804039C03B801D2049C069A06",
+};
+static const uint8_t kGoldenDecoded[GOLDEN_FRAMES][GOLDEN_COUNT] = {
+    {1, 1, 100, 100, 1, 0, 180, 1},
+    {1, 1, 100, 100, 1, 1, 200, 1},
+    {1, 1, 1, 100, 150, 1, 200, 1},
+    {1, 1, 1, 104, 150, 1, 200, 1},
+};
+
+static uint32_t randomState;
+
+static uint32_t nextRandom() {
+    // xorshift32: deterministic rows without the C library's generator
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+/**
+ * A simulated row: noise floor, a few strong channels, unsampled gaps
+ */
+static void randomRow(uint8_t* row, uint16_t count) {
+    for (uint16_t c = 0; c < count; c++) {
+        uint32_t r = nextRandom();
+        if ((r & 0x0F) == 0) {
+            row[c] = 0;
+        } else if ((r & 0x0F) < 3) {
+            row[c] = (uint8_t)(100 + (r >> 8) % 150);
+        } else {
+            row[c] = SPEC_QUIET;
+        }
+    }
+}
+
+static size_t parseHex(const char* hex, uint8_t* out) {
+    size_t length = strlen(hex) / 2;
+    for (size_t i = 0; i < length; i++) {
+        char byte[3] = {hex[2 * i], hex[2 * i + 1], 0};
+        out[i] = (uint8_t)strtoul(byte, NULL, 16);
+    }
+    return length;
+}
+
+/**
+ * Push a whole frame; every byte but the last must ask for more
+ */
+static SpectrumDecodeResult pushFrame(SpectrumDecoder* decoder, const uint8_t* frame,
+                                      size_t length) {
+    for (size_t i = 0; i + 1 < length; i++) {
+        TEST_ASSERT_EQUAL(SPEC_DECODE_MORE, spectrumDecoderPush(decoder, frame[i]));
+    }
+    return spectrumDecoderPush(decoder, frame[length - 1]);
+}
+
+void setUp() {
+    randomState = 0x2545F491UL;
+}
+
+void tearDown() {}
+
+// ============================================================================
+// Golden Stream
+// ============================================================================
+
+void test_encoder_reproduces_golden_frames() {
+    SpectrumEncoder encoder;
+    spectrumEncoderInit(&encoder, SPEC_DEADBAND_STEPS, SPEC_KEYFRAME_ROWS);
+    for (int i = 0; i < GOLDEN_FRAMES; i++) {
+        uint8_t expected[SPEC_MAX_FRAME];
+        uint8_t frame[SPEC_MAX_FRAME];
+        size_t expectedLength = parseHex(kGoldenFrame[i], expected);
+        size_t length = spectrumEncode(&encoder, kGoldenTag[i], GOLDEN_FIRST, kGoldenRow[i],
+                                       GOLDEN_COUNT, frame, sizeof(frame));
+        TEST_ASSERT_EQUAL(expectedLength, length);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, frame, length);
+    }
+}
+
+void test_decoder_reconstructs_golden_rows() {
+    SpectrumDecoder decoder;
+    spectrumDecoderInit(&decoder);
+    for (int i = 0; i < GOLDEN_FRAMES; i++) {
+        uint8_t frame[SPEC_MAX_FRAME];
+        size_t length = parseHex(kGoldenFrame[i], frame);
+        TEST_ASSERT_EQUAL(SPEC_DECODE_ROW, pushFrame(&decoder, frame, length));
+        TEST_ASSERT_EQUAL_UINT8(kGoldenTag[i], spectrumDecoderTag(&decoder));
+        TEST_ASSERT_EQUAL_UINT16(GOLDEN_FIRST, decoder.first);
+        TEST_ASSERT_EQUAL_UINT16(GOLDEN_COUNT, decoder.count);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(kGoldenDecoded[i], decoder.row, GOLDEN_COUNT);
+    }
+}
+
+// ============================================================================
+// Round Trips
+// ============================================================================
+
+/**
+ * Encode simulated rows and check each decoded channel against its input;
+ * unsampled channels keep the previous value, 0 in a keyframe's first row
+ */
+static void roundTrip(uint8_t deadband, int maxError) {
+    SpectrumEncoder encoder;
+    SpectrumDecoder decoder;
+    spectrumEncoderInit(&encoder, deadband, SPEC_KEYFRAME_ROWS);
+    spectrumDecoderInit(&decoder);
+
+    for (int i = 0; i < ROUND_TRIP_ROWS; i++) {
+        uint8_t row[SPEC_MAX_CHANNELS];
+        uint8_t frame[SPEC_MAX_FRAME];
+        randomRow(row, SPEC_MAX_CHANNELS);
+        size_t length = spectrumEncode(&encoder, 0, 0, row, SPEC_MAX_CHANNELS, frame,
+                                       sizeof(frame));
+        TEST_ASSERT_GREATER_THAN(0, length);
+        TEST_ASSERT_EQUAL(SPEC_DECODE_ROW, pushFrame(&decoder, frame, length));
+        for (int c = 0; c < SPEC_MAX_CHANNELS; c++) {
+            if (row[c] == 0) {
+                continue;
+            }
+            int error = (int)decoder.row[c] - (int)row[c];
+            TEST_ASSERT_INT_WITHIN(maxError, 0, error);
+        }
+    }
+}
+
+void test_round_trip_lossless_without_deadband() {
+    roundTrip(0, 0);
+}
+
+void test_round_trip_within_deadband() {
+    roundTrip(SPEC_DEADBAND_STEPS, SPEC_DEADBAND_STEPS);
+}
+
+void test_worst_case_row_fits_largest_frame() {
+    uint8_t row[SPEC_MAX_CHANNELS];
+    uint8_t frame[SPEC_MAX_FRAME];
+    for (int c = 0; c < SPEC_MAX_CHANNELS; c++) {
+        row[c] = (c & 1) ? 255 : 1;
+    }
+    SpectrumEncoder encoder;
+    spectrumEncoderInit(&encoder, 0, SPEC_KEYFRAME_ROWS);
+    TEST_ASSERT_GREATER_THAN(0, spectrumEncode(&encoder, 7, 0xFFFF, row, SPEC_MAX_CHANNELS,
+                                               frame, sizeof(frame)));
+}
+
+// ============================================================================
+// Recovery
+// ============================================================================
+
+void test_lost_frame_skips_deltas_until_keyframe() {
+    SpectrumEncoder encoder;
+    SpectrumDecoder decoder;
+    spectrumEncoderInit(&encoder, SPEC_DEADBAND_STEPS, SPEC_KEYFRAME_ROWS);
+    spectrumDecoderInit(&decoder);
+
+    uint8_t row[SPEC_MAX_CHANNELS];
+    uint8_t frame[SPEC_MAX_FRAME];
+    for (int i = 0; i < SPEC_KEYFRAME_ROWS + 1; i++) {
+        randomRow(row, SPEC_MAX_CHANNELS);
+        size_t length = spectrumEncode(&encoder, 0, 0, row, SPEC_MAX_CHANNELS, frame,
+                                       sizeof(frame));
+        SpectrumDecodeResult expected = SPEC_DECODE_ROW;
+        if (i == 1) {
+            // Lost in transit
+            continue;
+        } else if (i > 1 && i < SPEC_KEYFRAME_ROWS) {
+            expected = SPEC_DECODE_SKIPPED;
+        }
+        TEST_ASSERT_EQUAL(expected, pushFrame(&decoder, frame, length));
+    }
+}
+
+void test_bad_version_fails_and_next_frame_decodes() {
+    SpectrumDecoder decoder;
+    spectrumDecoderInit(&decoder);
+    TEST_ASSERT_EQUAL(SPEC_DECODE_ERROR, spectrumDecoderPush(&decoder, 0x00));
+
+    uint8_t frame[SPEC_MAX_FRAME];
+    size_t length = parseHex(kGoldenFrame[0], frame);
+    TEST_ASSERT_EQUAL(SPEC_DECODE_ROW, pushFrame(&decoder, frame, length));
+}
+
+void test_overlong_run_fails() {
+    // Keyframe of two channels with a run of three
+    const uint8_t frame[] = {0x11, 0x00, 0x00, 0x02, 0x05};
+    SpectrumDecoder decoder;
+    spectrumDecoderInit(&decoder);
+    TEST_ASSERT_EQUAL(SPEC_DECODE_ERROR, pushFrame(&decoder, frame, sizeof(frame)));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_encoder_reproduces_golden_frames);
+    RUN_TEST(test_decoder_reconstructs_golden_rows);
+    RUN_TEST(test_round_trip_lossless_without_deadband);
+    RUN_TEST(test_round_trip_within_deadband);
+    RUN_TEST(test_worst_case_row_fits_largest_frame);
+    RUN_TEST(test_lost_frame_skips_deltas_until_keyframe);
+    RUN_TEST(test_bad_version_fails_and_next_frame_decodes);
+    RUN_TEST(test_overlong_run_fails);
+    return UNITY_END();
+}
@@ -0,0 +1,228 @@
+/**
+ * Timebase Servo Tests
+ *
+ * Feeds src/timebase_servo.cpp simulated PPS pulses from a counter with a
+ * frequency offset, capture jitter and latency spikes, as the firmware
+ * would capture them, and checks the lock time, the residual phase error
+ * of the mapping and its behaviour through spikes, phase jumps and
+ * outages.
+ *
+ *   pio test -e native -f test_timebase
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "timebase_servo.h"
+
+#define SIM_EPOCH_S         1767225600LL  // UTC of the first pulse
+#define SIM_START_US        5000000LL     // Counter value at the first pulse
+#define SIM_OFFSET_PPB      25000         // Counter frequency error
+#define SIM_JITTER_US       3             // Uniform capture jitter (+/-)
+#define SIM_SEED            0x2545F491    // Jitter sequence
+
+#define LOCK_PULSES_MAX     20            // Pulses allowed to acquire lock
+#define RESIDUAL_RMS_US     3.0f          // Residual phase error allowed once locked (RMS)
+#define RESIDUAL_MAX_US     8.0f          // Largest residual phase error allowed once locked
+#define FREQUENCY_PPB       1000.0f       // Error allowed in the learned frequency (per pulse PI noise)
+
+/**
+ * Simulated PPS source and the firmware's pulse handling
+ */
+typedef struct {
+    TimebaseServo servo;
+    int64_t offsetPpb;          // Counter frequency error
+    int64_t phaseUs;            // Counter phase jump applied so far
+    int64_t second;             // Pulses since the first (true UTC second - epoch)
+    uint32_t random;            // Jitter generator state
+} Simulation;
+
+static Simulation sim;
+
+static uint32_t nextRandom() {
+    // xorshift32: the same pulse train on every run
+    sim.random ^= sim.random << 13;
+    sim.random ^= sim.random >> 17;
+    sim.random ^= sim.random << 5;
+    return sim.random;
+}
+
+/**
+ * Counter value at a true UTC second of the simulation
+ */
+static int64_t counterAt(int64_t second) {
+    return SIM_START_US + sim.phaseUs +
+           second * (TIMEBASE_US_PER_S + TIMEBASE_US_PER_S * sim.offsetPpb / 1000000000LL);
+}
+
+/**
+ * Timestamp error of the current mapping at the next pulse's true time
+ */
+static float mappingErrorUs() {
+    int64_t trueUtcUs = (SIM_EPOCH_S + sim.second) * TIMEBASE_US_PER_S;
+    return (float)(timebaseMapToUtc(&sim.servo.mapping, counterAt(sim.second)) - trueUtcUs);
+}
+
+/**
+ * Capture the next pulse, late by extraUs on top of the jitter, and run
+ * the servo on it the way timebaseService() does (NMEA labels only the
+ * pulses the servo cannot count)
+ */
+static ServoPulseResult pulse(int64_t extraUs) {
+    int64_t jitter = (int64_t)(nextRandom() % (2 * SIM_JITTER_US + 1)) - SIM_JITTER_US;
+    int64_t counterUs = counterAt(sim.second) + jitter + extraUs;
+    int64_t utcSecond;
+    if (!timebaseServoCountPulse(&sim.servo, counterUs, &utcSecond)) {
+        utcSecond = SIM_EPOCH_S + sim.second;
+    }
+    sim.second++;
+    return timebaseServoPulse(&sim.servo, counterUs, utcSecond);
+}
+
+/**
+ * Pulses until lock
+ * @return Pulses fed, or 0 if lock was not acquired within limit
+ */
+static int pulsesToLock(int limit) {
+    for (int i = 1; i <= limit; i++) {
+        if (pulse(0) == SERVO_PULSE_LOCKED) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+void setUp() {
+    timebaseServoReset(&sim.servo);
+    sim.offsetPpb = SIM_OFFSET_PPB;
+    sim.phaseUs = 0;
+    sim.second = 0;
+    sim.random = SIM_SEED;
+}
+
+void tearDown() {}
+
+// ============================================================================
+// Acquisition
+// ============================================================================
+
+void test_first_pulse_anchors() {
+    TEST_ASSERT_FALSE(sim.servo.mapping.anchored);
+    TEST_ASSERT_EQUAL(SERVO_PULSE_ANCHORED, pulse(0));
+    TEST_ASSERT_TRUE(sim.servo.mapping.anchored);
+    TEST_ASSERT_FALSE(sim.servo.locked);
+}
+
+void test_locks_with_frequency_offset_and_jitter() {
+    int pulses = pulsesToLock(LOCK_PULSES_MAX);
+    TEST_ASSERT_GREATER_THAN(0, pulses);
+    TEST_ASSERT_TRUE(sim.servo.locked);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.servo.steps);
+}
+
+void test_locks_at_frequency_limit() {
+    sim.offsetPpb = -(TIMEBASE_MAX_PPM - 20) * 1000LL;
+    TEST_ASSERT_GREATER_THAN(0, pulsesToLock(LOCK_PULSES_MAX * 2));
+}
+
+void test_residual_phase_error_once_locked() {
+    TEST_ASSERT_GREATER_THAN(0, pulsesToLock(LOCK_PULSES_MAX));
+
+    // Error a timestamp taken at the next pulse would carry
+    float sumSquares = 0.0f;
+    float worst = 0.0f;
+    const int pulses = 600;
+    for (int i = 0; i < pulses; i++) {
+        float error = mappingErrorUs();
+        sumSquares += error * error;
+        worst = fmaxf(worst, fabsf(error));
+        TEST_ASSERT_NOT_EQUAL(SERVO_PULSE_STEPPED, pulse(0));
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(RESIDUAL_RMS_US, sqrtf(sumSquares / pulses));
+    TEST_ASSERT_LESS_THAN_FLOAT(RESIDUAL_MAX_US, worst);
+    TEST_ASSERT_TRUE(sim.servo.locked);
+}
+
+void test_learns_counter_frequency() {
+    TEST_ASSERT_GREATER_THAN(0, pulsesToLock(LOCK_PULSES_MAX));
+    for (int i = 0; i < 120; i++) {
+        pulse(0);
+    }
+    // The correction cancels the counter running fast
+    TEST_ASSERT_FLOAT_WITHIN(FREQUENCY_PPB, -(float)SIM_OFFSET_PPB, sim.servo.frequencyPpb);
+}
+
+// ============================================================================
+// Disturbances
+// ============================================================================
+
+void test_latency_spike_ignored_when_locked() {
+    TEST_ASSERT_GREATER_THAN(0, pulsesToLock(LOCK_PULSES_MAX));
+    TimebaseMapping before = sim.servo.mapping;
+
+    TEST_ASSERT_EQUAL(SERVO_PULSE_OUTLIER, pulse(TIMEBASE_OUTLIER_US + 30));
+    TEST_ASSERT_TRUE(sim.servo.locked);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.servo.outliers);
+    TEST_ASSERT_TRUE(before.anchorCounterUs == sim.servo.mapping.anchorCounterUs);
+
+    // The next good pulse is tracked as usual
+    TEST_ASSERT_EQUAL(SERVO_PULSE_TRACKED, pulse(0));
+    TEST_ASSERT_LESS_THAN_FLOAT(RESIDUAL_MAX_US, fabsf(mappingErrorUs()));
+}
+
+void test_persistent_offset_steps_and_relocks() {
+    TEST_ASSERT_GREATER_THAN(0, pulsesToLock(LOCK_PULSES_MAX));
+
+    // The counter jumps by less than a step: outliers, then a step
+    sim.phaseUs = TIMEBASE_OUTLIER_US * 4;
+    for (int i = 0; i < TIMEBASE_MAX_OUTLIERS - 1; i++) {
+        TEST_ASSERT_EQUAL(SERVO_PULSE_OUTLIER, pulse(0));
+    }
+    TEST_ASSERT_EQUAL(SERVO_PULSE_STEPPED, pulse(0));
+    TEST_ASSERT_FALSE(sim.servo.locked);
+
+    // The learned frequency survives the step, so lock returns quickly
+    TEST_ASSERT_GREATER_THAN(0, pulsesToLock(TIMEBASE_LOCK_PULSES + 2));
+}
+
+void test_large_phase_error_steps_at_once() {
+    TEST_ASSERT_GREATER_THAN(0, pulsesToLock(LOCK_PULSES_MAX));
+    sim.phaseUs = TIMEBASE_STEP_US * 2;
+    TEST_ASSERT_EQUAL(SERVO_PULSE_STEPPED, pulse(0));
+    TEST_ASSERT_LESS_THAN_FLOAT(RESIDUAL_MAX_US, fabsf(mappingErrorUs()));
+}
+
+void test_holdover_after_outage() {
+    TEST_ASSERT_GREATER_THAN(0, pulsesToLock(LOCK_PULSES_MAX));
+    for (int i = 0; i < 120; i++) {
+        pulse(0);
+    }
+    int64_t lastPulseUs = sim.servo.lastPulseCounterUs;
+
+    // Lock holds until the holdover time has passed without a pulse
+    TEST_ASSERT_FALSE(timebaseServoHoldover(&sim.servo, lastPulseUs + TIMEBASE_HOLDOVER_MS * 1000LL));
+    TEST_ASSERT_TRUE(timebaseServoHoldover(&sim.servo, lastPulseUs + TIMEBASE_HOLDOVER_MS * 1000LL + 1));
+    TEST_ASSERT_FALSE(sim.servo.locked);
+
+    // The learned frequency carries the mapping through a 10 s outage
+    sim.second += 9;
+    TEST_ASSERT_LESS_THAN_FLOAT(RESIDUAL_MAX_US + FREQUENCY_PPB * 10 / 1000.0f, fabsf(mappingErrorUs()));
+
+    // After the outage the pulse needs a new label and is tracked again
+    int64_t utcSecond;
+    TEST_ASSERT_FALSE(timebaseServoCountPulse(&sim.servo, counterAt(sim.second), &utcSecond));
+    TEST_ASSERT_EQUAL(SERVO_PULSE_TRACKED, pulse(0));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_pulse_anchors);
+    RUN_TEST(test_locks_with_frequency_offset_and_jitter);
+    RUN_TEST(test_locks_at_frequency_limit);
+    RUN_TEST(test_residual_phase_error_once_locked);
+    RUN_TEST(test_learns_counter_frequency);
+    RUN_TEST(test_latency_spike_ignored_when_locked);
+    RUN_TEST(test_persistent_offset_steps_and_relocks);
+    RUN_TEST(test_large_phase_error_steps_at_once);
+    RUN_TEST(test_holdover_after_outage);
+    return UNITY_END();
+}
@@ -0,0 +1,310 @@
+#!/usr/bin/env python3
+"""
+Change-Point Detector Simulator
+
+Measures the new-emitter detector of src/change_detect.cpp on a simulated
+band. Each sweep gives every channel one dwell: a busy flag (packet or
+energy above the detection threshold) and the peak RSSI over the noise
+floor. The background of each channel is noise plus a low rate of busy
+dwells from traffic the detector should learn (hopping links passing
+through). New emitters start on random channels with a random duty cycle
+and strength.
+
+    python3 tools/change_sim.py
+    python3 tools/change_sim.py --hours 24 --emitters 200 --revisit 1.3
+
+The detector is the same per-channel CUSUM on the busy rate and
+Page-Hinkley test on the RSSI excess as the firmware, with the same
+constants. The output is CSV: the false alarms per channel-hour on
+emitter-free channels, and for the injected emitters the share detected
+and the mean and 90th percentile detection delay. --sweep-threshold prints
+the same figures for a range of alarm thresholds.
+
+On the device, "change bench" replays the occupancy history through the
+detector and prints the alarms per channel-hour of the recorded band.
+
+--export writes a fixed dwell trace (background, then two emitters coming
+and going) with the dwells at which this detector reports each onset and
+end, as the C header the native test test/test_change replays through
+changeChannelStep():
+
+    python3 tools/change_sim.py --export test/test_change/change_trace.h
+"""
+
+import argparse
+import math
+import random
+import sys
+
+# Mirrors include/change_channel.h
+CHANGE_LEARN_DWELLS = 32
+CHANGE_BACKGROUND_ALPHA = 0.02
+CHANGE_BUSY_MIN = 0.01
+CHANGE_BUSY_MAX = 0.5
+CHANGE_BUSY_SHIFT = 0.3
+CHANGE_BUSY_THRESHOLD = 10.0
+CHANGE_RSSI_DRIFT = 1.0
+CHANGE_RSSI_CLIP = 3.0
+CHANGE_RSSI_THRESHOLD = 12.0
+CHANGE_SPREAD_MIN_DB = 1.0
+CHANGE_CLEAR_DWELLS = 16
+CHANGE_ABSORB_DWELLS = 1000
+
+NOISE_DETECT_MARGIN_DB = 6.0
+NUM_SWEEP_CHANNELS = 52
+
+ONSET, END_QUIET, END_ABSORBED = 1, 2, 3
+
+
+class Channel:
+    """Detector state of one channel (ChangeChannel)."""
+
+    def __init__(self, busy_threshold=CHANGE_BUSY_THRESHOLD, rssi_threshold=CHANGE_RSSI_THRESHOLD):
+        self.busy_threshold = busy_threshold
+        self.rssi_threshold = rssi_threshold
+        self.reset()
+
+    def reset(self):
+        self.busy_rate = 0.0
+        self.excess_mean = 0.0
+        self.excess_spread = 0.0
+        self.busy_sum = 0.0
+        self.rssi_sum = 0.0
+        self.dwells = 0
+        self.alarmed = False
+        self.alarm_dwells = 0
+        self.quiet_dwells = 0
+
+    def learn(self, busy, excess):
+        alpha = max(1.0 / (self.dwells + 1), CHANGE_BACKGROUND_ALPHA)
+        self.busy_rate += alpha * ((1.0 if busy else 0.0) - self.busy_rate)
+        deviation = abs(excess - self.excess_mean)
+        self.excess_mean += alpha * (excess - self.excess_mean)
+        self.excess_spread += alpha * (deviation - self.excess_spread)
+        if self.dwells < CHANGE_LEARN_DWELLS:
+            self.dwells += 1
+
+    def step(self, busy, excess):
+        if self.dwells < CHANGE_LEARN_DWELLS:
+            self.learn(busy, excess)
+            return 0
+
+        spread = max(self.excess_spread, CHANGE_SPREAD_MIN_DB)
+        z = (excess - self.excess_mean) / spread
+        if self.alarmed:
+            self.alarm_dwells += 1
+            self.quiet_dwells = self.quiet_dwells + 1 if not busy and z <= CHANGE_RSSI_DRIFT else 0
+            if self.quiet_dwells >= CHANGE_CLEAR_DWELLS:
+                self.alarmed = False
+                self.busy_sum = self.rssi_sum = 0.0
+                return END_QUIET
+            if self.alarm_dwells >= CHANGE_ABSORB_DWELLS:
+                self.reset()
+                return END_ABSORBED
+            return 0
+
+        if self.busy_rate < CHANGE_BUSY_MAX:
+            p0 = max(self.busy_rate, CHANGE_BUSY_MIN)
+            p1 = p0 + CHANGE_BUSY_SHIFT
+            llr = math.log(p1 / p0) if busy else math.log((1.0 - p1) / (1.0 - p0))
+            self.busy_sum = max(0.0, self.busy_sum + llr)
+        else:
+            self.busy_sum = 0.0
+        self.rssi_sum = max(0.0, self.rssi_sum + min(z, CHANGE_RSSI_CLIP) - CHANGE_RSSI_DRIFT)
+
+        if self.busy_sum > self.busy_threshold or self.rssi_sum > self.rssi_threshold:
+            self.alarmed = True
+            self.alarm_dwells = 0
+            self.quiet_dwells = 0
+            return ONSET
+        if self.busy_sum < self.busy_threshold / 2 and self.rssi_sum < self.rssi_threshold / 2:
+            self.learn(busy, excess)
+        return 0
+
+
+# ============================================================================
+# Simulation
+# ============================================================================
+
+class Background:
+    """Noise and learned traffic of one channel."""
+
+    def __init__(self, rng):
+        self.rng = rng
+        self.noise_sd = rng.uniform(1.0, 2.5)
+        self.samples = rng.randint(2, 6)            # Background samples per dwell
+        self.traffic = rng.choice([0.0, 0.0, 0.005, 0.02, 0.05])
+
+    def dwell(self):
+        excess = max(self.rng.gauss(0.0, self.noise_sd) for _ in range(self.samples))
+        if self.rng.random() < self.traffic:
+            strength = self.rng.uniform(8.0, 40.0)
+            return True, max(excess, strength)
+        return excess > NOISE_DETECT_MARGIN_DB, excess
+
+
+def simulate(args, busy_threshold, rssi_threshold):
+    rng = random.Random(args.seed)
+    dwells = int(args.hours * 3600 / args.revisit)
+    false_alarms = 0
+    quiet_hours = 0.0
+    delays = []
+    missed = 0
+
+    for _ in range(args.channels_runs):
+        background = Background(rng)
+        channel = Channel(busy_threshold, rssi_threshold)
+        for _ in range(dwells):
+            busy, excess = background.dwell()
+            if channel.step(busy, excess) == ONSET:
+                false_alarms += 1
+        quiet_hours += args.hours
+
+    for _ in range(args.emitters):
+        background = Background(rng)
+        channel = Channel(busy_threshold, rssi_threshold)
+        warmup = rng.randint(200, 2000)
+        duty = rng.uniform(0.2, 1.0)
+        strength = rng.uniform(4.0, 30.0)
+        for _ in range(warmup):
+            channel.step(*background.dwell())
+        channel.alarmed = False     # Background false alarms are counted above
+        channel.busy_sum = channel.rssi_sum = 0.0
+        detected = None
+        for t in range(args.window):
+            busy, excess = background.dwell()
+            if rng.random() < duty:
+                excess = max(excess, strength + rng.gauss(0.0, 2.0))
+                busy = busy or excess > NOISE_DETECT_MARGIN_DB
+            if channel.step(busy, excess) == ONSET:
+                detected = t + 1
+                break
+        if detected is None:
+            missed += 1
+        else:
+            delays.append(detected)
+
+    delays.sort()
+    mean_delay = sum(delays) / len(delays) if delays else 0.0
+    p90 = delays[int(0.9 * (len(delays) - 1))] if delays else 0
+    return (false_alarms, false_alarms / max(quiet_hours, 1e-9),
+            len(delays) / max(args.emitters, 1), mean_delay * args.revisit, p90 * args.revisit)
+
+
+# ============================================================================
+# Replay Trace
+# ============================================================================
+
+# (dwells, emitter duty, emitter strength dB) per phase of the trace
+TRACE_PHASES = [
+    (400, 0.0, 0.0),
+    (120, 0.6, 14.0),
+    (200, 0.0, 0.0),
+    (120, 0.9, 8.0),
+    (160, 0.0, 0.0),
+]
+
+
+def trace(seed):
+    """Return the (busy, excess dB) dwells of the replay trace and the
+    (dwell index, step) events the detector reports on them."""
+    rng = random.Random(seed)
+    background = Background(rng)
+    background.noise_sd, background.samples, background.traffic = 1.5, 4, 0.02
+    dwells = []
+    for count, duty, strength in TRACE_PHASES:
+        for _ in range(count):
+            busy, excess = background.dwell()
+            if rng.random() < duty:
+                excess = max(excess, strength + rng.gauss(0.0, 2.0))
+                busy = busy or excess > NOISE_DETECT_MARGIN_DB
+            # Rounded as exported, so both detectors see the same input
+            dwells.append((busy, round(excess, 2)))
+
+    channel = Channel()
+    events = []
+    for index, (busy, excess) in enumerate(dwells):
+        step = channel.step(busy, excess)
+        if step:
+            events.append((index, step))
+    return dwells, events
+
+
+def emit_trace_header(dwells, events, seed):
+    lines = [
+        "/**",
+        " * Change Detector Replay Trace",
+        " *",
+        " * GENERATED by tools/change_sim.py --export (seed %d) - do not edit." % seed,
+        " *",
+        " * Simulated dwells of one channel and the steps the simulator's",
+        " * detector reports on them (ChangeStep values).",
+        " */",
+        "",
+        "#ifndef CHANGE_TRACE_H",
+        "#define CHANGE_TRACE_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#define TRACE_DWELLS        %d" % len(dwells),
+        "#define TRACE_EVENTS        %d" % len(events),
+        "",
+        "typedef struct {",
+        "    uint8_t busy;               // Packet or energy above the detection threshold",
+        "    float excessDb;             // Peak RSSI over the noise floor",
+        "} TraceDwell;",
+        "",
+        "typedef struct {",
+        "    uint16_t dwell;             // Index in kDwells",
+        "    uint8_t step;               // ChangeStep reported",
+        "} TraceEvent;",
+        "",
+        "static const TraceDwell kDwells[TRACE_DWELLS] = {",
+    ]
+    for busy, excess in dwells:
+        lines.append("    { %d, %.2ff }," % (busy, excess))
+    lines[-1] = lines[-1].rstrip(",")
+    lines += ["};", "", "static const TraceEvent kEvents[TRACE_EVENTS] = {"]
+    for index, step in events:
+        lines.append("    { %d, %d }," % (index, step))
+    lines[-1] = lines[-1].rstrip(",")
+    lines += ["};", "", "#endif // CHANGE_TRACE_H", ""]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Simulate the new-emitter change-point detector")
+    parser.add_argument("--hours", type=float, default=12.0, help="simulated hours per background channel")
+    parser.add_argument("--channels", dest="channels_runs", type=int, default=NUM_SWEEP_CHANNELS,
+                        help="emitter-free channels simulated")
+    parser.add_argument("--emitters", type=int, default=100, help="injected emitters")
+    parser.add_argument("--window", type=int, default=200, help="dwells an emitter is given to be detected")
+    parser.add_argument("--revisit", type=float, default=2.6, help="seconds between dwells on a channel")
+    parser.add_argument("--sweep-threshold", action="store_true",
+                        help="repeat for a range of alarm thresholds")
+    parser.add_argument("--seed", type=int, default=1, help="simulation random seed")
+    parser.add_argument("--export", metavar="PATH",
+                        help="write the replay trace of the native test as a C header")
+    args = parser.parse_args()
+
+    if args.export:
+        dwells, events = trace(args.seed)
+        with open(args.export, "w") as f:
+            f.write(emit_trace_header(dwells, events, args.seed))
+        print(f"{len(dwells)} dwells, events at {events}", file=sys.stderr)
+        return 0
+
+    print("busy_threshold,rssi_threshold,false_alarms,false_alarms_per_channel_hour,"
+          "detected,mean_delay_s,p90_delay_s")
+    scales = (0.5, 0.75, 1.0, 1.25, 1.5) if args.sweep_threshold else (1.0,)
+    for scale in scales:
+        busy_threshold = CHANGE_BUSY_THRESHOLD * scale
+        rssi_threshold = CHANGE_RSSI_THRESHOLD * scale
+        alarms, rate, detected, mean_delay, p90 = simulate(args, busy_threshold, rssi_threshold)
+        print(f"{busy_threshold:.1f},{rssi_threshold:.1f},{alarms},{rate:.4f},"
+              f"{detected:.2f},{mean_delay:.1f},{p90:.1f}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
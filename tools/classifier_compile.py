@@ -0,0 +1,393 @@
+#!/usr/bin/env python3
+"""
+Detection Classifier Compiler
+
+Trains, compiles and evaluates the quantised logistic model used by
+src/classifier.cpp.
+
+Traces are CSV files with one column per feature (see FEATURES) plus a
+"label" column (1 = drone link, 0 = other emitter). Build firmware with
+-DCLASSIFIER_TRACE to print "FEAT,..." lines over serial, label them and
+save them as CSV.
+
+    python3 tools/classifier_compile.py train trace.csv -o model.json
+    python3 tools/classifier_compile.py compile model.json -o include/classifier_model.h
+    python3 tools/classifier_compile.py evaluate model.json trace.csv
+
+The native unit test test/test_classifier replays a trace through the
+compiled C++ model and reports its accuracy and time per inference. It
+reads the trace from a generated header; regenerate it after compiling a
+new model:
+
+    python3 tools/classifier_compile.py export model.json trace.csv \
+        -o test/test_classifier/classifier_trace.h
+
+Without recorded field traces, `simulate` writes a labelled synthetic
+trace of the link types in the signature database:
+
+    python3 tools/classifier_compile.py simulate -o trace.csv
+
+The compiled model evaluates in integer arithmetic only. `evaluate` runs a
+bit-exact emulation of that integer path, so the reported accuracy is what
+the firmware will achieve on the same trace.
+"""
+
+import argparse
+import csv
+import json
+import math
+import random
+import sys
+import time
+
+# Feature order and integer units, must match ClassifierFeatures
+FEATURES = [
+    ("rssi_margin", "RSSI above noise floor (0.1 dB)", -200, 1000),
+    ("snr", "SNR (0.1 dB)", -300, 300),
+    ("freq_error", "Absolute frequency error (Hz)", 0, 30000),
+    ("bandwidth", "Receiver bandwidth (kHz)", 0, 600),
+    ("interarrival", "Shortest track inter-arrival (us, 100000 = none)", 0, 100000),
+    ("hop_spacing", "Track hop spacing (kHz, 0 = none)", 0, 26000),
+    ("payload_length", "Payload length (bytes)", 0, 255),
+]
+
+SCORE_FRAC_BITS = 8         # Score fixed point (Q8)
+SCORE_RANGE = 8             # Sigmoid table covers [-8, 8)
+SIGMOID_ENTRIES = 256
+
+
+# ============================================================================
+# Training (plain logistic regression, no external dependencies)
+# ============================================================================
+
+def load_trace(path):
+    rows = []
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            x = [float(row[name]) for name, _, _, _ in FEATURES]
+            rows.append((x, int(row["label"])))
+    return rows
+
+
+def train(rows, epochs, rate, l2):
+    n = len(FEATURES)
+    means = [sum(r[0][i] for r in rows) / len(rows) for i in range(n)]
+    stds = []
+    for i in range(n):
+        var = sum((r[0][i] - means[i]) ** 2 for r in rows) / len(rows)
+        stds.append(math.sqrt(var) if var > 0 else 1.0)
+
+    weights = [0.0] * n
+    bias = 0.0
+    data = [([(x[i] - means[i]) / stds[i] for i in range(n)], y) for x, y in rows]
+
+    for _ in range(epochs):
+        random.shuffle(data)
+        for z, y in data:
+            s = bias + sum(w * v for w, v in zip(weights, z))
+            p = 1.0 / (1.0 + math.exp(-max(min(s, 30), -30)))
+            g = p - y
+            bias -= rate * g
+            for i in range(n):
+                weights[i] -= rate * (g * z[i] + l2 * weights[i])
+
+    return {
+        "features": [name for name, _, _, _ in FEATURES],
+        "mean": means,
+        "std": stds,
+        "weight": weights,
+        "bias": bias,
+    }
+
+
+# ============================================================================
+# Quantisation
+# ============================================================================
+
+def quantise(model):
+    """Fold standardisation into per-feature int16 weights with shifts."""
+    q = {"mean": [], "weight": [], "shift": [], "min": [], "max": []}
+    for i, (name, _, lo, hi) in enumerate(FEATURES):
+        # contribution = (x - mean) * w / std, in Q8 score units
+        real = model["weight"][i] / model["std"][i] * (1 << SCORE_FRAC_BITS)
+        mean = int(round(model["mean"][i]))
+        # Largest shift that keeps the weight in int16 and the product in int32
+        deviation = max(hi - mean, mean - lo, 1)
+        shift = 0
+        while shift < 30:
+            scaled = abs(real) * (1 << (shift + 1))
+            if scaled >= 32767 or scaled * deviation >= 2 ** 31:
+                break
+            shift += 1
+        q["mean"].append(mean)
+        q["weight"].append(int(round(real * (1 << shift))))
+        q["shift"].append(shift)
+        q["min"].append(lo)
+        q["max"].append(hi)
+    q["bias"] = int(round(model["bias"] * (1 << SCORE_FRAC_BITS)))
+
+    q["sigmoid"] = []
+    for k in range(SIGMOID_ENTRIES):
+        s = (k + 0.5) * (2 * SCORE_RANGE) / SIGMOID_ENTRIES - SCORE_RANGE
+        q["sigmoid"].append(int(round(100.0 / (1.0 + math.exp(-s)))))
+    return q
+
+
+def evaluate_int(q, x):
+    """Bit-exact emulation of classifierConfidence()."""
+    score = q["bias"]
+    for i in range(len(FEATURES)):
+        v = min(max(int(x[i]), q["min"][i]), q["max"][i])
+        score += ((v - q["mean"][i]) * q["weight"][i]) >> q["shift"][i]
+    span = SCORE_RANGE << SCORE_FRAC_BITS
+    score = min(max(score, -span), span - 1)
+    index = (score + span) * SIGMOID_ENTRIES // (2 * span)
+    return q["sigmoid"][index]
+
+
+# ============================================================================
+# Synthetic Traces
+# ============================================================================
+
+# (label, weight, bandwidths kHz, SNR range 0.1 dB, packet interval us or
+#  None, hop spacing kHz range, payload lengths, frequency error range Hz)
+LINK_TYPES = [
+    ("elrs", 1, 3, [500], (-120, 120), [5000, 10000, 20000], (500, 13000), [8, 13], (0, 15000)),
+    ("crossfire", 1, 2, [234], (0, 200), [6667, 20000], (250, 26000), [14, 24, 32], (0, 8000)),
+    ("r9", 1, 1, [250], (-60, 150), [6667, 20000], (300, 13000), [12, 20], (0, 12000)),
+    ("lorawan", 0, 2, [125, 250], (-150, 100), None, (0, 0), [20, 32, 51], (0, 6000)),
+    ("meshtastic", 0, 1, [250], (-100, 120), None, (0, 0), [40, 80, 120], (0, 6000)),
+    ("telemetry", 0, 2, [94, 156], (20, 250), [50000, 100000], (0, 400), [32, 64, 128], (0, 4000)),
+    ("ook_remote", 0, 1, [59], (0, 200), [10000, 40000, 100000], (0, 0), [4, 8, 12], (0, 3000)),
+]
+
+
+def simulate(samples, seed):
+    """Labelled feature rows of the link types above, in FEATURES order."""
+    rng = random.Random(seed)
+    weights = [link[2] for link in LINK_TYPES]
+    rows = []
+    for _ in range(samples):
+        _, label, _, bandwidths, snr, intervals, hops, lengths, ferr = \
+            rng.choices(LINK_TYPES, weights)[0]
+        # A track's first packet has no timing and no hop spacing yet
+        first = rng.random() < 0.2
+        interval = 100000
+        if intervals is not None and not first:
+            interval = min(100000, int(rng.choice(intervals) * rng.uniform(0.98, 1.02)))
+        hop = 0 if first or hops[1] == 0 else rng.randint(*hops)
+        x = [
+            rng.randint(-50, 600),
+            rng.randint(*snr),
+            rng.randint(*ferr),
+            rng.choice(bandwidths),
+            interval,
+            hop,
+            rng.choice(lengths),
+        ]
+        rows.append((x, label))
+    return rows
+
+
+# ============================================================================
+# Code Generation
+# ============================================================================
+
+def emit_header(q, source):
+    def arr(values):
+        return ", ".join(str(v) for v in values)
+
+    lines = [
+        "/**",
+        " * Classifier Model Tables",
+        " *",
+        " * GENERATED by tools/classifier_compile.py from %s - do not edit." % source,
+        " *",
+        " * Quantised logistic model over ClassifierFeatures (see classifier.h).",
+        " */",
+        "",
+        "#ifndef CLASSIFIER_MODEL_H",
+        "#define CLASSIFIER_MODEL_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#define CLASSIFIER_NUM_FEATURES     %d" % len(FEATURES),
+        "#define CLASSIFIER_SCORE_FRAC_BITS  %d" % SCORE_FRAC_BITS,
+        "#define CLASSIFIER_SCORE_RANGE      %d" % SCORE_RANGE,
+        "#define CLASSIFIER_SIGMOID_ENTRIES  %d" % SIGMOID_ENTRIES,
+        "",
+        "// Feature clamp range (training range, avoids extrapolation)",
+        "constexpr int32_t kClassifierMin[CLASSIFIER_NUM_FEATURES] = { %s };" % arr(q["min"]),
+        "constexpr int32_t kClassifierMax[CLASSIFIER_NUM_FEATURES] = { %s };" % arr(q["max"]),
+        "",
+        "// Standardisation mean folded into integer offsets",
+        "constexpr int32_t kClassifierMean[CLASSIFIER_NUM_FEATURES] = { %s };" % arr(q["mean"]),
+        "",
+        "// Weights scaled by 2^shift, contribution = ((x - mean) * weight) >> shift",
+        "constexpr int16_t kClassifierWeight[CLASSIFIER_NUM_FEATURES] = { %s };" % arr(q["weight"]),
+        "constexpr uint8_t kClassifierShift[CLASSIFIER_NUM_FEATURES] = { %s };" % arr(q["shift"]),
+        "",
+        "constexpr int32_t kClassifierBias = %d;" % q["bias"],
+        "",
+        "// Logistic function over [-%d, %d) in confidence percent" % (SCORE_RANGE, SCORE_RANGE),
+        "constexpr uint8_t kClassifierSigmoid[CLASSIFIER_SIGMOID_ENTRIES] = {",
+    ]
+    for k in range(0, SIGMOID_ENTRIES, 16):
+        lines.append("    " + ", ".join("%3d" % v for v in q["sigmoid"][k:k + 16]) + ",")
+    lines[-1] = lines[-1].rstrip(",")
+    lines += ["};", "", "#endif // CLASSIFIER_MODEL_H", ""]
+    return "\n".join(lines)
+
+
+def emit_trace_header(q, rows, source, threshold):
+    lines = [
+        "/**",
+        " * Classifier Replay Trace",
+        " *",
+        " * GENERATED by tools/classifier_compile.py from %s - do not edit." % source,
+        " *",
+        " * Labelled feature rows and the score evaluate_int() gives each with",
+        " * the model compiled into include/classifier_model.h.",
+        " */",
+        "",
+        "#ifndef CLASSIFIER_TRACE_H",
+        "#define CLASSIFIER_TRACE_H",
+        "",
+        "#include <stdint.h>",
+        "#include \"classifier_model.h\"",
+        "",
+        "#define TRACE_ROWS          %d" % len(rows),
+        "#define TRACE_THRESHOLD     %d         // Score counted as a drone" % threshold,
+        "",
+        "typedef struct {",
+        "    int32_t value[CLASSIFIER_NUM_FEATURES];",
+        "    uint8_t label;              // 1 = drone link",
+        "    uint8_t score;              // Host emulation of the integer model",
+        "} TraceRow;",
+        "",
+        "static const TraceRow kTrace[TRACE_ROWS] = {",
+    ]
+    for x, y in rows:
+        values = ", ".join(str(int(v)) for v in x)
+        lines.append("    { { %s }, %d, %d }," % (values, y, evaluate_int(q, x)))
+    lines[-1] = lines[-1].rstrip(",")
+    lines += ["};", "", "#endif // CLASSIFIER_TRACE_H", ""]
+    return "\n".join(lines)
+
+
+# ============================================================================
+# Commands
+# ============================================================================
+
+def cmd_train(args):
+    rows = load_trace(args.trace)
+    if not rows:
+        sys.exit("empty trace")
+    model = train(rows, args.epochs, args.rate, args.l2)
+    with open(args.output, "w") as f:
+        json.dump(model, f, indent=2)
+    print("trained on %d samples -> %s" % (len(rows), args.output))
+
+
+def cmd_compile(args):
+    with open(args.model) as f:
+        model = json.load(f)
+    if model["features"] != [name for name, _, _, _ in FEATURES]:
+        sys.exit("model feature list does not match this compiler")
+    with open(args.output, "w") as f:
+        f.write(emit_header(quantise(model), args.model))
+    print("wrote %s" % args.output)
+
+
+def cmd_evaluate(args):
+    with open(args.model) as f:
+        model = json.load(f)
+    q = quantise(model)
+    rows = load_trace(args.trace)
+
+    tp = fp = tn = fn = 0
+    start = time.perf_counter()
+    for x, y in rows:
+        predicted = 1 if evaluate_int(q, x) >= args.threshold else 0
+        if predicted and y:
+            tp += 1
+        elif predicted:
+            fp += 1
+        elif y:
+            fn += 1
+        else:
+            tn += 1
+    elapsed = time.perf_counter() - start
+
+    total = max(len(rows), 1)
+    print("samples:   %d" % len(rows))
+    print("accuracy:  %.2f%%" % (100.0 * (tp + tn) / total))
+    print("precision: %.2f%%" % (100.0 * tp / max(tp + fp, 1)))
+    print("recall:    %.2f%%" % (100.0 * tp / max(tp + fn, 1)))
+    print("confusion: tp=%d fp=%d tn=%d fn=%d" % (tp, fp, tn, fn))
+    print("emulation: %.2f us/sample (host)" % (1e6 * elapsed / total))
+
+
+def cmd_simulate(args):
+    rows = simulate(args.samples, args.seed)
+    with open(args.output, "w", newline="") as f:
+        writer = csv.writer(f, lineterminator="\n")
+        writer.writerow([name for name, _, _, _ in FEATURES] + ["label"])
+        for x, y in rows:
+            writer.writerow(x + [y])
+    print("wrote %d samples -> %s" % (len(rows), args.output))
+
+
+def cmd_export(args):
+    with open(args.model) as f:
+        model = json.load(f)
+    rows = load_trace(args.trace)
+    if not rows:
+        sys.exit("empty trace")
+    with open(args.output, "w") as f:
+        f.write(emit_trace_header(quantise(model), rows, args.trace, args.threshold))
+    print("wrote %d samples -> %s" % (len(rows), args.output))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Detection classifier compiler")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("train", help="train a model from a labelled trace")
+    p.add_argument("trace")
+    p.add_argument("-o", "--output", default="model.json")
+    p.add_argument("--epochs", type=int, default=50)
+    p.add_argument("--rate", type=float, default=0.05)
+    p.add_argument("--l2", type=float, default=0.001)
+    p.set_defaults(func=cmd_train)
+
+    p = sub.add_parser("compile", help="emit constexpr C++ tables")
+    p.add_argument("model")
+    p.add_argument("-o", "--output", default="include/classifier_model.h")
+    p.set_defaults(func=cmd_compile)
+
+    p = sub.add_parser("evaluate", help="bit-exact accuracy over a trace")
+    p.add_argument("model")
+    p.add_argument("trace")
+    p.add_argument("--threshold", type=int, default=50)
+    p.set_defaults(func=cmd_evaluate)
+
+    p = sub.add_parser("simulate", help="write a labelled synthetic trace")
+    p.add_argument("-o", "--output", default="trace.csv")
+    p.add_argument("--samples", type=int, default=400)
+    p.add_argument("--seed", type=int, default=1)
+    p.set_defaults(func=cmd_simulate)
+
+    p = sub.add_parser("export", help="emit a trace as a C header for the native test")
+    p.add_argument("model")
+    p.add_argument("trace")
+    p.add_argument("-o", "--output", default="test/test_classifier/classifier_trace.h")
+    p.add_argument("--threshold", type=int, default=50)
+    p.set_defaults(func=cmd_export)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Detection Log Exporter
+
+Decodes a dump of the on-device "detlog" flash partition into CSV.
+
+Dump the partition with esptool (offset/size from partitions.csv):
+
+    esptool.py --chip esp32s3 read_flash 0x610000 0x1E0000 detlog.bin
+    python3 tools/detlog_export.py detlog.bin > detections.csv
+    python3 tools/detlog_export.py --tracks detlog.bin > tracks.csv
+
+The on-flash format is defined in src/detection_log.cpp.
+"""
+
+import argparse
+import csv
+import datetime
+import struct
+import sys
+import zlib
+
+SECTOR_SIZE = 4096
+SECTOR_HEADER = struct.Struct("<IIII")          # magic, sequence, eraseCount, crc
+SECTOR_FOOTER = struct.Struct("<IIIQHBBI")      # magic, first, last, mask, count, types, rsvd, crc
+RECORD_HEADER = struct.Struct("<BBBBII")        # marker, type, length, channel, timestamp, crc
+DETECTION = struct.Struct("<IIhhiBBbB")
+DETECTION_UTC = struct.Struct("<q")     # Appended to detection records by newer firmware
+TRACK = struct.Struct("<IIIIIBbHh")
+
+SECTOR_HEADER_MAGIC = 0x31474C44
+RECORD_MARKER = 0xA5
+RECORD_AREA_END = SECTOR_SIZE - SECTOR_FOOTER.size
+
+RECORD_DETECTION = 0x01
+RECORD_TRACK = 0x02
+
+MODULATIONS = ["LoRa", "FSK", "OOK", "Unknown"]
+
+# Mirrors knownSignatures[] in src/drone_detection.cpp
+SIGNATURES = [
+    "ExpressLRS 900",
+    "ELRS 900 Narrow",
+    "TBS Crossfire",
+    "RFD900/SiK",
+    "FrSky R9",
+    "FSK Telemetry",
+    "OOK Remote",
+]
+
+
+def format_utc(utc_us):
+    """ISO 8601 UTC with microseconds, or empty if the node had no timebase."""
+    if utc_us <= 0:
+        return ""
+    stamp = datetime.datetime.fromtimestamp(utc_us // 1000000, datetime.timezone.utc)
+    return stamp.strftime("%Y-%m-%dT%H:%M:%S") + ".%06dZ" % (utc_us % 1000000)
+
+
+def read_sectors(image):
+    """Yield (sequence, data) for every sector with a valid header."""
+    for base in range(0, len(image) - SECTOR_SIZE + 1, SECTOR_SIZE):
+        data = image[base:base + SECTOR_SIZE]
+        magic, sequence, _erases, crc = SECTOR_HEADER.unpack_from(data, 0)
+        if magic != SECTOR_HEADER_MAGIC:
+            continue
+        if zlib.crc32(data[:12]) != crc:
+            continue
+        yield sequence, data
+
+
+def read_records(data):
+    """Yield (type, channel, timestamp, payload) for valid records in a sector."""
+    offset = SECTOR_HEADER.size
+    while offset + RECORD_HEADER.size <= RECORD_AREA_END:
+        marker, rtype, length, channel, timestamp, crc = RECORD_HEADER.unpack_from(data, offset)
+        if marker != RECORD_MARKER:
+            break
+        start = offset + RECORD_HEADER.size
+        payload = data[start:start + length]
+        expected = zlib.crc32(payload, zlib.crc32(data[offset:offset + 8]))
+        if expected != crc:
+            print("warning: CRC mismatch at sector offset %d" % offset, file=sys.stderr)
+            break
+        yield rtype, channel, timestamp, payload
+        offset += (RECORD_HEADER.size + length + 3) & ~3
+
+
+def export_tracks(image, since, writer):
+    writer.writerow(["log_time_s", "track_id", "key", "first_seen_ms", "duration_ms", "packets",
+                     "modulation", "protocol", "rate_hz", "peak_rssi_dbm"])
+
+    for _sequence, data in sorted(read_sectors(image), key=lambda s: s[0]):
+        for rtype, _channel, timestamp, payload in read_records(data):
+            if timestamp < since or rtype != RECORD_TRACK:
+                continue
+            if len(payload) < TRACK.size:
+                continue
+            (track_id, key, first, duration, packets, mod, sig, rate, peak) = TRACK.unpack_from(payload)
+            writer.writerow([
+                timestamp, track_id, "0x%08X" % key, first, duration, packets,
+                MODULATIONS[min(mod, 3)],
+                SIGNATURES[sig] if 0 <= sig < len(SIGNATURES) else "",
+                rate, peak / 10.0,
+            ])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Export detlog partition dump to CSV")
+    parser.add_argument("image", help="raw partition dump")
+    parser.add_argument("--since", type=int, default=0, help="only records at or after this log time (s)")
+    parser.add_argument("--tracks", action="store_true", help="export track summaries instead of detections")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    writer = csv.writer(sys.stdout)
+    if args.tracks:
+        export_tracks(image, args.since, writer)
+        return
+
+    writer.writerow(["log_time_s", "uptime_ms", "channel", "frequency_mhz", "modulation",
+                     "rssi_dbm", "snr_db", "freq_error_hz", "confidence", "drone", "protocol",
+                     "utc"])
+
+    for _sequence, data in sorted(read_sectors(image), key=lambda s: s[0]):
+        for rtype, channel, timestamp, payload in read_records(data):
+            if timestamp < args.since or rtype != RECORD_DETECTION:
+                continue
+            if len(payload) < DETECTION.size:
+                continue
+            (uptime, freq_khz, rssi, snr, ferr, mod, conf, sig, flags) = DETECTION.unpack_from(payload)
+            utc_us = 0
+            if len(payload) >= DETECTION.size + DETECTION_UTC.size:
+                (utc_us,) = DETECTION_UTC.unpack_from(payload, DETECTION.size)
+            writer.writerow([
+                timestamp, uptime, channel, "%.3f" % (freq_khz / 1000.0),
+                MODULATIONS[min(mod, 3)], rssi / 10.0, snr / 10.0, ferr, conf,
+                1 if flags & 0x01 else 0,
+                SIGNATURES[sig] if 0 <= sig < len(SIGNATURES) else "",
+                format_utc(utc_us),
+            ])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Packet Capture Reassembler
+
+Turns the "PCAP,<block>,<offset>,<block length>,<hex>" lines a node prints
+after the console command "pcap on" back into a pcapng file (LoRaTap link
+type) for Wireshark:
+
+    pio device monitor | tee node.log
+    python3 tools/pcap_capture.py node.log -o capture.pcapng
+
+or live, writing each block as soon as it is complete:
+
+    python3 tools/pcap_capture.py - -o capture.pcapng < /dev/ttyACM0
+
+Blocks with missing lines are dropped whole; they only ever hold complete
+pcapng blocks, so the file stays valid. If the block with the section header
+was lost, the same header is written first. The stream format is defined
+in src/pcap_export.cpp.
+"""
+
+import argparse
+import struct
+import sys
+
+PCAPNG_SHB = 0x0A0D0D0A
+LINKTYPE_LORATAP = 270
+SNAPLEN = 512
+
+
+def section_header():
+    """Section header and interface description, as the firmware writes them."""
+    shb = struct.pack("<IIIHHqI", PCAPNG_SHB, 28, 0x1A2B3C4D, 1, 0, -1, 28)
+    idb = struct.pack("<IIHHIHHBxxxHHI", 1, 32, LINKTYPE_LORATAP, 0, SNAPLEN, 9, 1, 6, 0, 0, 32)
+    return shb + idb
+
+
+def read_lines(paths):
+    """Yield text lines from logs ('-' for stdin), one at a time."""
+    for path in paths:
+        stream = sys.stdin if path == "-" else open(path, "r", errors="replace")
+        try:
+            for line in stream:
+                yield line
+        finally:
+            if stream is not sys.stdin:
+                stream.close()
+
+
+def read_blocks(lines, stats):
+    """Yield the bytes of every complete block."""
+    current = None
+    data = bytearray()
+    length = 0
+    for line in lines:
+        start = line.find("PCAP,")
+        if start < 0:
+            continue
+        fields = line[start:].strip().split(",")
+        if len(fields) != 5:
+            stats["bad_lines"] += 1
+            continue
+        try:
+            block, offset, total = int(fields[1]), int(fields[2]), int(fields[3])
+            chunk = bytes.fromhex(fields[4])
+        except ValueError:
+            stats["bad_lines"] += 1
+            continue
+
+        if block != current:
+            if current is not None and len(data) < length:
+                stats["lost_blocks"] += 1
+            current, data, length = block, bytearray(), total
+        if offset != len(data) or total != length:
+            # A line went missing: skip the rest of this block
+            if len(data) < length:
+                stats["lost_blocks"] += 1
+            length = -1
+            continue
+        data += chunk
+        if len(data) == length:
+            stats["blocks"] += 1
+            yield bytes(data)
+            length = -1
+    if current is not None and 0 <= len(data) < length:
+        stats["lost_blocks"] += 1
+
+
+def count_packets(block):
+    """Enhanced Packet Blocks in a block of pcapng data."""
+    count = 0
+    offset = 0
+    while offset + 8 <= len(block):
+        block_type, block_length = struct.unpack_from("<II", block, offset)
+        if block_length < 12 or block_length % 4:
+            break
+        if block_type == 6:
+            count += 1
+        offset += block_length
+    return count
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Reassemble PCAP serial lines into a pcapng file")
+    parser.add_argument("logs", nargs="+", help="serial logs with PCAP lines ('-' for stdin)")
+    parser.add_argument("-o", "--output", default="capture.pcapng", help="pcapng file to write")
+    args = parser.parse_args()
+
+    stats = {"blocks": 0, "lost_blocks": 0, "bad_lines": 0}
+    packets = 0
+    with open(args.output, "wb") as out:
+        started = False
+        for block in read_blocks(read_lines(args.logs), stats):
+            if not started and struct.unpack_from("<I", block, 0)[0] != PCAPNG_SHB:
+                out.write(section_header())
+            started = True
+            out.write(block)
+            out.flush()
+            packets += count_packets(block)
+
+    print("%s: %d packets in %d blocks, %d blocks lost, %d bad lines"
+          % (args.output, packets, stats["blocks"], stats["lost_blocks"], stats["bad_lines"]),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,509 @@
+#!/usr/bin/env python3
+"""
+Mesh Report Aggregator
+
+Merges the emitter reports of several detector nodes into one picture.
+Every node prints its own reports, and the reports it hears from other
+nodes, as "RPT,<hex>" serial lines. Feed the serial logs of one or more
+nodes (or stdin) to the aggregator:
+
+    python3 tools/report_aggregator.py node1.log node2.log
+    pio device monitor | python3 tools/report_aggregator.py -
+
+Reports are de-duplicated by (node, sequence), so the same report heard
+directly and through relays is counted once. Tracks keyed by a decoded
+transmitter ID are merged across nodes by that ID; other tracks are merged
+by protocol (modulation, signature and rate mode).
+
+Reports carry the originating node's GPS position. Emitters with a decoded
+transmitter ID are localized from the RSSI seen at each node position, with
+the grid filter of src/localizer.cpp on a larger grid.
+
+Without hardware, --simulate N generates reports from N nodes observing a
+random set of emitters, pushes them through the same encoder/decoder and
+checks that the aggregate matches the simulated ground truth. --benchmark
+measures the host localizer's accuracy and throughput on simulated
+fixed-node and drive-by scenarios. The firmware's filter is measured on
+the same drive-by scenario by the native test test/test_localizer.
+
+The frame format is defined in include/report_codec.h.
+"""
+
+import argparse
+import math
+import random
+import struct
+import sys
+import time
+import zlib
+
+HEADER = struct.Struct("<BBHHIiiB")     # magic, versionHops, nodeId, sequence, timeS, lat, lon, count
+ENTRY = struct.Struct("<IHbBbbHHB")     # key, kHz, signature, modRate, peak, mean, packets, duration, age
+CRC = struct.Struct("<I")
+
+REPORT_MAGIC = 0xD7
+REPORT_VERSION = 2
+REPORT_NO_POSITION = -(1 << 31)
+REPORT_HOP_LIMIT = 2
+REPORT_MAX_ENTRIES = 8
+FREQ_900_MIN = 902.0
+
+ELRS_ID_TAG = 0x45000000                # Decoded transmitter IDs (src/packet_decoder.cpp)
+
+MODULATIONS = ["LoRa", "FSK", "OOK", "Unknown"]
+
+# Mirrors the name and modulation (MODULATIONS index) of knownSignatures[]
+# in src/drone_detection.cpp
+SIGNATURES = [
+    ("ExpressLRS 900", 0),
+    ("ELRS 900 Narrow", 0),
+    ("TBS Crossfire", 1),
+    ("RFD900/SiK", 1),
+    ("FrSky R9", 0),
+    ("FSK Telemetry", 1),
+    ("OOK Remote", 2),
+]
+
+# Mirrors PacketRateMode in include/interarrival.h
+RATES = ["25Hz", "50Hz", "100Hz", "150Hz", "200Hz", "250Hz", "333Hz", "500Hz", "1000Hz"]
+
+
+# ============================================================================
+# Frame Encoding
+# ============================================================================
+
+def encode_report(node, sequence, time_s, entries, position=None, hops=REPORT_HOP_LIMIT):
+    """Build a sealed report frame from entry dicts (inverse of decode_report)."""
+    lat, lon = (REPORT_NO_POSITION, REPORT_NO_POSITION) if position is None else \
+        (round(position[0] * 1e7), round(position[1] * 1e7))
+    payload = bytearray(HEADER.pack(REPORT_MAGIC, (REPORT_VERSION << 4) | hops,
+                                    node, sequence, time_s, lat, lon, len(entries)))
+    for e in entries:
+        rate = 0x0F if e["rate"] is None else e["rate"]
+        payload += ENTRY.pack(e["key"], e["khz"], e["signature"], (e["modulation"] << 4) | rate,
+                              e["peak"], e["mean"], e["packets"], e["duration"], e["age"])
+    return bytes(payload) + CRC.pack(zlib.crc32(payload))
+
+
+def decode_report(frame):
+    """Return (node, sequence, time_s, hops, position, entries) or None if invalid."""
+    if len(frame) < HEADER.size + CRC.size or frame[0] != REPORT_MAGIC:
+        return None
+    _magic, version_hops, node, sequence, time_s, lat, lon, count = HEADER.unpack_from(frame, 0)
+    payload_length = HEADER.size + count * ENTRY.size
+    if version_hops >> 4 != REPORT_VERSION or count > REPORT_MAX_ENTRIES:
+        return None
+    if len(frame) != payload_length + CRC.size:
+        return None
+    if zlib.crc32(frame[:payload_length]) != CRC.unpack_from(frame, payload_length)[0]:
+        return None
+
+    entries = []
+    for i in range(count):
+        key, khz, sig, mod_rate, peak, mean, packets, duration, age = \
+            ENTRY.unpack_from(frame, HEADER.size + i * ENTRY.size)
+        rate = mod_rate & 0x0F
+        entries.append({
+            "key": key, "khz": khz, "signature": sig, "modulation": mod_rate >> 4,
+            "rate": None if rate == 0x0F else rate, "peak": peak, "mean": mean,
+            "packets": packets, "duration": duration, "age": age,
+        })
+    position = None if lat == REPORT_NO_POSITION else (lat / 1e7, lon / 1e7)
+    return node, sequence, time_s, version_hops & 0x0F, position, entries
+
+
+def report_lines(stream):
+    """Yield frame bytes from every RPT line in a text stream."""
+    for line in stream:
+        start = line.find("RPT,")
+        if start < 0:
+            continue
+        try:
+            yield bytes.fromhex(line[start + 4:].strip())
+        except ValueError:
+            continue
+
+
+# ============================================================================
+# Localization
+# ============================================================================
+
+# Mirrors include/localizer_grid.h
+PATH_LOSS_EXP = 2.7
+RSSI_SIGMA_DB = 6.0
+ANTENNA_M = 2.0
+MIN_SPACING_M = 15.0
+MIN_OBSERVATIONS = 3
+RECENTRE_MARGIN_CELLS = 3
+METRES_PER_DEG_LAT = 110574.0
+METRES_PER_DEG_LON = 111320.0
+
+HOST_GRID = (64, 50.0)                  # Cells per side, cell size (m): 3.2 km square
+
+
+class GridLocalizer:
+    """Unknown-power log-distance grid filter (see include/localizer_grid.h).
+
+    Each observer spot (node and position rounded to MIN_SPACING_M)
+    contributes once with its average RSSI, so fixed nodes that report the
+    same emitter repeatedly do not become overconfident. Observations only
+    update their spot; changed spots are folded into the grid when an
+    estimate is requested, replacing their previous contribution. Like the
+    device, the grid recentres on the estimate when it nears the edge.
+    """
+
+    def __init__(self, latitude, longitude, grid=HOST_GRID):
+        self.size, self.cell = grid
+        self.origin = (latitude, longitude)
+        self.metres_per_deg_lon = METRES_PER_DEG_LON * math.cos(math.radians(latitude))
+        self.centres = [(i - (self.size - 1) / 2.0) * self.cell for i in range(self.size)]
+        self.sum = [0.0] * (self.size * self.size)
+        self.sum_sq = [0.0] * (self.size * self.size)
+        self.spots = {}
+        self.dirty = set()
+
+    def to_local(self, latitude, longitude):
+        return ((longitude - self.origin[1]) * self.metres_per_deg_lon,
+                (latitude - self.origin[0]) * METRES_PER_DEG_LAT)
+
+    def observe(self, observer, latitude, longitude, rssi):
+        x, y = self.to_local(latitude, longitude)
+        spot = (observer, round(x / MIN_SPACING_M), round(y / MIN_SPACING_M))
+        state = self.spots.get(spot)
+        if state is None:
+            self.spots[spot] = [x, y, rssi, 1, None]
+        else:
+            state[2] += rssi
+            state[3] += 1
+        self.dirty.add(spot)
+
+    def apply(self):
+        """Fold spots changed since the last call into the grid."""
+        # z = RSSI + 10 n log10(d) = RSSI + 5 n log10(d^2)
+        path_loss = 5.0 * PATH_LOSS_EXP
+        floor_sq = ANTENNA_M * ANTENNA_M
+        for spot in self.dirty:
+            state = self.spots[spot]
+            x, y, old = state[0], state[1], state[4]
+            new = state[2] / state[3]
+            state[4] = new
+            # Replace the spot's previous average with the new one
+            shift = 0.0 if old is None else new - old
+            dx_sq = [(cx - x) ** 2 for cx in self.centres]
+            i = 0
+            for cy in self.centres:
+                dy_sq = (cy - y) ** 2 + floor_sq
+                for d in dx_sq:
+                    g = path_loss * math.log10(d + dy_sq)
+                    if old is None:
+                        self.sum[i] += new + g
+                        self.sum_sq[i] += (new + g) ** 2
+                    else:
+                        self.sum[i] += shift
+                        self.sum_sq[i] += shift * (new + old + 2.0 * g)
+                    i += 1
+        self.dirty.clear()
+
+    def recentre(self, x, y):
+        """Move the grid centre to local (x, y) and rebuild it from all spots."""
+        self.origin = (self.origin[0] + y / METRES_PER_DEG_LAT,
+                       self.origin[1] + x / self.metres_per_deg_lon)
+        for state in self.spots.values():
+            state[0] -= x
+            state[1] -= y
+            state[4] = None
+        self.sum = [0.0] * (self.size * self.size)
+        self.sum_sq = [0.0] * (self.size * self.size)
+        self.dirty = set(self.spots)
+
+    def estimate(self):
+        """Return (latitude, longitude, uncertainty m) or None with too few spots."""
+        if len(self.spots) < MIN_OBSERVATIONS:
+            return None
+        edge = (self.size / 2.0 - RECENTRE_MARGIN_CELLS) * self.cell
+        for _ in range(3):
+            mx, my, variance = self.posterior()
+            if max(abs(mx), abs(my)) <= edge:
+                break
+            self.recentre(mx, my)
+        return (self.origin[0] + my / METRES_PER_DEG_LAT,
+                self.origin[1] + mx / self.metres_per_deg_lon,
+                math.sqrt(max(variance, 0.0)))
+
+    def posterior(self):
+        """Posterior mean (local m) and radial variance over the grid."""
+        self.apply()
+        n = len(self.spots)
+        misfit = [sq - s * s / n for s, sq in zip(self.sum, self.sum_sq)]
+        best = min(misfit)
+        scale = 1.0 / (2.0 * RSSI_SIGMA_DB * RSSI_SIGMA_DB)
+        sw = sx = sy = sxx = syy = 0.0
+        i = 0
+        for y in self.centres:
+            for x in self.centres:
+                w = math.exp(-(misfit[i] - best) * scale)
+                sw += w
+                sx += w * x
+                sy += w * y
+                sxx += w * x * x
+                syy += w * y * y
+                i += 1
+        mx, my = sx / sw, sy / sw
+        variance = (sxx / sw - mx * mx) + (syy / sw - my * my) + self.cell * self.cell / 6.0
+        return mx, my, variance
+
+
+# ============================================================================
+# Aggregation
+# ============================================================================
+
+def emitter_identity(entry):
+    """Key under which tracks from different nodes are merged."""
+    if entry["key"] & 0xFF000000 == ELRS_ID_TAG:
+        return ("tx", entry["key"])
+    return ("proto", entry["modulation"], entry["signature"], entry["rate"])
+
+
+class Aggregator:
+    def __init__(self):
+        self.seen = set()
+        self.emitters = {}
+        self.frames = 0
+        self.invalid = 0
+        self.duplicates = 0
+
+    def add_frame(self, frame):
+        self.frames += 1
+        report = decode_report(frame)
+        if report is None:
+            self.invalid += 1
+            return
+        node, sequence, time_s, _hops, position, entries = report
+        if (node, sequence) in self.seen:
+            self.duplicates += 1
+            return
+        self.seen.add((node, sequence))
+
+        for entry in entries:
+            identity = emitter_identity(entry)
+            emitter = self.emitters.setdefault(identity, {"nodes": {}, "localizer": None})
+            emitter.update(modulation=entry["modulation"], signature=entry["signature"],
+                           rate=entry["rate"], khz=entry["khz"])
+            # Track counters are cumulative, so keep each node's latest view
+            previous = emitter["nodes"].get(node)
+            if previous is None or previous["time"] <= time_s:
+                emitter["nodes"][node] = {"time": time_s, "peak": entry["peak"],
+                                          "mean": entry["mean"], "packets": entry["packets"]}
+
+            # Protocol-merged tracks may mix several emitters, so only
+            # transmitter IDs are localized
+            if position is not None and identity[0] == "tx":
+                if emitter["localizer"] is None:
+                    emitter["localizer"] = GridLocalizer(*position)
+                emitter["localizer"].observe(node, position[0], position[1], entry["mean"])
+
+    def rows(self):
+        for identity, emitter in sorted(self.emitters.items(), key=lambda kv: str(kv[0])):
+            nodes = emitter["nodes"]
+            strongest = max(nodes, key=lambda n: nodes[n]["peak"])
+            sig = emitter["signature"]
+            located = emitter["localizer"].estimate() if emitter["localizer"] else None
+            yield {
+                "emitter": ("%08X" % identity[1]) if identity[0] == "tx" else "-",
+                "protocol": SIGNATURES[sig][0] if 0 <= sig < len(SIGNATURES) else "Unknown",
+                "modulation": MODULATIONS[min(emitter["modulation"], len(MODULATIONS) - 1)],
+                "rate": RATES[emitter["rate"]] if emitter["rate"] is not None
+                        and emitter["rate"] < len(RATES) else "",
+                "nodes": len(nodes),
+                "strongest": "%04X" % strongest,
+                "peak": nodes[strongest]["peak"],
+                "packets": sum(n["packets"] for n in nodes.values()),
+                "latitude": "%.6f" % located[0] if located else "",
+                "longitude": "%.6f" % located[1] if located else "",
+                "uncertainty_m": "%.0f" % located[2] if located else "",
+            }
+
+    def print_table(self, out=sys.stdout):
+        columns = ["emitter", "protocol", "modulation", "rate", "nodes", "strongest", "peak", "packets",
+                   "latitude", "longitude", "uncertainty_m"]
+        print(",".join(columns), file=out)
+        for row in self.rows():
+            print(",".join(str(row[c]) for c in columns), file=out)
+        print("# %d frames, %d reports, %d duplicates, %d invalid" %
+              (self.frames, len(self.seen), self.duplicates, self.invalid), file=sys.stderr)
+
+
+# ============================================================================
+# Simulation
+# ============================================================================
+
+SIM_ORIGIN = (47.0, 8.0)                # Latitude/longitude of the simulated area
+
+
+def sim_position(x, y):
+    """Latitude/longitude of a point x metres east, y metres north of SIM_ORIGIN."""
+    return (SIM_ORIGIN[0] + y / METRES_PER_DEG_LAT,
+            SIM_ORIGIN[1] + x / (METRES_PER_DEG_LON * math.cos(math.radians(SIM_ORIGIN[0]))))
+
+
+def sim_rssi(rng, power, exponent, x, y, ex, ey, sigma):
+    distance = math.sqrt((x - ex) ** 2 + (y - ey) ** 2 + ANTENNA_M ** 2)
+    return power - 40.0 - 10.0 * exponent * math.log10(distance) + rng.gauss(0, sigma)
+
+
+def simulate(node_count, seed):
+    """Simulate nodes and emitters; return True if the aggregate matches the truth."""
+    rng = random.Random(seed)
+
+    nodes = [(rng.getrandbits(16), rng.uniform(0, 5000), rng.uniform(0, 5000))
+             for _ in range(node_count)]
+    emitters = []
+    for _ in range(rng.randint(3, 12)):
+        decoded = rng.random() < 0.6
+        # Decoded IDs are ExpressLRS; undecoded protocols take the modulation
+        # of their signature
+        signature = 0 if decoded else rng.choice([2, 3, 4, 5, 6])
+        modulation = SIGNATURES[signature][1]
+        emitters.append({
+            "key": (ELRS_ID_TAG | rng.getrandbits(14)) if decoded else None,
+            "signature": signature,
+            "modulation": modulation,
+            "rate": rng.choice([1, 4]) if decoded else None,
+            "x": rng.uniform(0, 5000), "y": rng.uniform(0, 5000),
+        })
+    lines = []
+    reported = set()
+    sent = 0
+    for node, nx, ny in nodes:
+        entries = []
+        for e in emitters:
+            rssi = round(sim_rssi(rng, 14, PATH_LOSS_EXP, nx, ny, e["x"], e["y"], 4))
+            if rssi < -118:
+                continue
+            key = e["key"] if e["key"] is not None else (e["modulation"] << 8) | (e["signature"] + 1)
+            entries.append({"key": key, "khz": rng.randint(0, 26000), "signature": e["signature"],
+                            "modulation": e["modulation"], "rate": e["rate"], "peak": rssi + 3,
+                            "mean": rssi, "packets": rng.randint(10, 5000),
+                            "duration": rng.randint(1, 600), "age": rng.randint(0, 20)})
+        entries = entries[:REPORT_MAX_ENTRIES]
+        if not entries:
+            continue
+        # Undecoded emitters of the same protocol are indistinguishable by design
+        reported.update(emitter_identity(e) for e in entries)
+        frame = encode_report(node, 1, 1000, entries, sim_position(nx, ny))
+        sent += 1
+        lines.append("RPT," + frame.hex().upper())
+        # Relayed copies and an occasional corrupted frame
+        for _ in range(rng.randint(0, REPORT_HOP_LIMIT)):
+            lines.append("[Report] relayed\nRPT," + frame.hex().upper())
+        if rng.random() < 0.2:
+            broken = bytearray(frame)
+            broken[rng.randrange(len(broken))] ^= 0x10
+            lines.append("RPT," + bytes(broken).hex())
+    rng.shuffle(lines)
+
+    aggregator = Aggregator()
+    for frame in report_lines("\n".join(lines).splitlines()):
+        aggregator.add_frame(frame)
+    aggregator.print_table()
+
+    heard = set(aggregator.emitters)
+    ok = heard == reported and len(aggregator.seen) == sent
+    print("simulate: %d nodes, %d emitters, %d identities heard, %s" %
+          (len(nodes), len(emitters), len(heard), "OK" if ok else "MISMATCH"), file=sys.stderr)
+    return ok
+
+
+def benchmark_run(rng, scenario, grid):
+    """Localize one random emitter; return (error m, uncertainty m, observations)."""
+    ex, ey = rng.uniform(-600, 600), rng.uniform(-600, 600)
+    power = rng.uniform(0, 30)
+    exponent = rng.uniform(2.4, 3.0)          # True exponent differs from the model's
+    observations = []
+    if scenario == "fixed":
+        # Fixed nodes with static shadowing, reporting a smoothed RSSI each period
+        for node in range(5):
+            x, y = rng.uniform(-1000, 1000), rng.uniform(-1000, 1000)
+            shadow = rng.gauss(0, 4)
+            for _ in range(20):
+                rssi = sim_rssi(rng, power, exponent, x, y, ex, ey, 1.5) + shadow
+                observations.append((node, x, y, rssi))
+    else:
+        # One node driving a 1.6 km loop at 10 m/s, 20 packets/s with fast fading
+        for k in range(6400):
+            p = k * 0.5
+            side, along = int(p // 1600) % 4, p % 1600 - 800
+            x, y = [(along, -800), (800, along), (-along, 800), (-800, -along)][side]
+            observations.append((0, x, y, sim_rssi(rng, power, exponent, x, y, ex, ey, 6)))
+
+    observations = [o for o in observations if o[3] > -120]
+    if not observations:
+        return None
+    lat, lon = sim_position(observations[0][1], observations[0][2])
+    localizer = GridLocalizer(lat, lon, grid)
+    for node, x, y, rssi in observations:
+        localizer.observe(node, *sim_position(x, y), rssi)
+    located = localizer.estimate()
+    if located is None:
+        return None
+    x = (located[1] - SIM_ORIGIN[1]) * METRES_PER_DEG_LON * math.cos(math.radians(SIM_ORIGIN[0]))
+    y = (located[0] - SIM_ORIGIN[0]) * METRES_PER_DEG_LAT
+    return math.hypot(x - ex, y - ey), located[2], len(observations)
+
+
+def benchmark(trials, seed):
+    print("scenario,grid,trials,median_error_m,p90_error_m,median_uncertainty_m,"
+          "within_2_sigma,observations_per_s")
+    for scenario in ("fixed", "drive"):
+        rng = random.Random(seed)
+        errors, uncertainties, consistent, observations, elapsed = [], [], 0, 0, 0.0
+        for _ in range(trials):
+            start = time.perf_counter()
+            result = benchmark_run(rng, scenario, HOST_GRID)
+            elapsed += time.perf_counter() - start
+            if result is None:
+                continue
+            error, uncertainty, count = result
+            errors.append(error)
+            uncertainties.append(uncertainty)
+            consistent += error <= 2 * uncertainty
+            observations += count
+        if not errors:
+            continue
+        errors.sort()
+        uncertainties.sort()
+        print("%s,host,%d,%.0f,%.0f,%.0f,%.2f,%.0f" % (
+            scenario, len(errors), errors[len(errors) // 2],
+            errors[min(len(errors) - 1, len(errors) * 9 // 10)],
+            uncertainties[len(uncertainties) // 2], consistent / len(errors),
+            observations / elapsed))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Merge mesh detection reports from several nodes")
+    parser.add_argument("logs", nargs="*", help="serial logs with RPT lines ('-' for stdin)")
+    parser.add_argument("--simulate", type=int, metavar="N", help="simulate N nodes instead")
+    parser.add_argument("--benchmark", type=int, metavar="TRIALS",
+                        help="benchmark localization on TRIALS simulated emitters per scenario")
+    parser.add_argument("--seed", type=int, default=1, help="simulation random seed")
+    args = parser.parse_args()
+
+    if args.benchmark:
+        benchmark(args.benchmark, args.seed)
+        return 0
+
+    if args.simulate:
+        return 0 if simulate(args.simulate, args.seed) else 1
+
+    aggregator = Aggregator()
+    for path in args.logs or ["-"]:
+        stream = sys.stdin if path == "-" else open(path, errors="replace")
+        with stream:
+            for frame in report_lines(stream):
+                aggregator.add_frame(frame)
+    aggregator.print_table()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""
+Traffic Sketch Merger
+
+Combines the traffic sketches of several detector nodes into network-wide
+estimates. On each node, the console command "sketch [minutes]" prints the
+node's HyperLogLog and count-min sketches for the window as
+
+    HLL,<kind>,<window s>,<bits>,<hex registers>
+    CMS,<window s>,<row>,<width>,<hex counters, 8 digits each>
+
+Feed the serial logs of the nodes to the merger; the last export in each
+log is used:
+
+    python3 tools/sketch_merge.py node1.log node2.log
+    python3 tools/sketch_merge.py node1.log node2.log --key 45A1B2C3
+
+HyperLogLog sketches merge by register maximum, so a transmitter heard by
+several nodes is counted once. That holds because nodes sketch only keys
+that mean the same on every node: decoded ELRS transmitter IDs, and
+otherwise the modulation and protocol (an undecoded emitter counts once per
+protocol; per-node crystal-offset cluster IDs are left out). Count-min
+sketches merge by sum (packets heard by several nodes count once per
+node). The hashes are defined in src/sketch.cpp.
+"""
+
+import argparse
+import math
+import sys
+
+CMS_SEEDS = [0x9E3779B9, 0x85EBCA6B, 0xC2B2AE35, 0x27D4EB2F]
+MASK32 = 0xFFFFFFFF
+
+
+def mix32(h):
+    """murmur3 finaliser, as in src/sketch.cpp."""
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & MASK32
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & MASK32
+    h ^= h >> 16
+    return h
+
+
+def hll_estimate(registers):
+    """Distinct count estimate, as hllEstimate() computes it."""
+    m = len(registers)
+    total = sum(2.0 ** -r for r in registers)
+    estimate = (0.7213 / (1.0 + 1.079 / m)) * m * m / total
+    zeros = registers.count(0)
+    if estimate <= 2.5 * m and zeros > 0:
+        estimate = m * math.log(m / zeros)
+    return estimate
+
+
+def cms_estimate(rows, key):
+    """Count estimate of a key (an upper bound)."""
+    width = len(rows[0])
+    return min(row[mix32(key ^ CMS_SEEDS[i]) & (width - 1)] for i, row in enumerate(rows))
+
+
+def read_export(path):
+    """Last sketch export in a log: ({kind: registers}, {row: counters}, window s)."""
+    hll, cms, window = {}, {}, 0
+    stream = sys.stdin if path == "-" else open(path, "r", errors="replace")
+    try:
+        for line in stream:
+            for tag in ("HLL,", "CMS,"):
+                start = line.find(tag)
+                if start < 0:
+                    continue
+                fields = line[start:].strip().split(",")
+                try:
+                    if tag == "HLL," and len(fields) == 5:
+                        registers = list(bytes.fromhex(fields[4]))
+                        if len(registers) != 1 << int(fields[3]):
+                            continue
+                        if fields[1] in hll:
+                            # A new export starts: forget the previous one
+                            hll, cms = {}, {}
+                        hll[fields[1]] = registers
+                        window = int(fields[2])
+                    elif tag == "CMS," and len(fields) == 5:
+                        width = int(fields[3])
+                        data = bytes.fromhex(fields[4])
+                        if len(data) != 4 * width:
+                            continue
+                        cms[int(fields[2])] = [int.from_bytes(data[i:i + 4], "big")
+                                               for i in range(0, len(data), 4)]
+                except ValueError:
+                    continue
+    finally:
+        if stream is not sys.stdin:
+            stream.close()
+    return hll, cms, window
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Merge node traffic sketches")
+    parser.add_argument("logs", nargs="+", help="serial logs with HLL/CMS lines ('-' for stdin)")
+    parser.add_argument("--key", action="append", default=[],
+                        help="transmitter key (hex) to estimate packets for")
+    args = parser.parse_args()
+
+    merged_hll, merged_cms = {}, None
+    nodes = 0
+    for path in args.logs:
+        hll, cms, window = read_export(path)
+        if not hll:
+            print("%s: no sketch export" % path, file=sys.stderr)
+            continue
+        nodes += 1
+        print("%s: window %d s, %s" % (path, window, ", ".join(
+            "%s %.0f" % (kind, hll_estimate(registers)) for kind, registers in sorted(hll.items()))))
+        for kind, registers in hll.items():
+            if kind in merged_hll and len(merged_hll[kind]) == len(registers):
+                merged_hll[kind] = [max(a, b) for a, b in zip(merged_hll[kind], registers)]
+            else:
+                merged_hll[kind] = registers
+        if len(cms) == len(CMS_SEEDS):
+            rows = [cms[i] for i in range(len(CMS_SEEDS))]
+            if merged_cms is None:
+                merged_cms = rows
+            else:
+                merged_cms = [[a + b for a, b in zip(x, y)] for x, y in zip(merged_cms, rows)]
+
+    if nodes == 0:
+        sys.exit(1)
+    print("merged (%d nodes):" % nodes)
+    for kind, registers in sorted(merged_hll.items()):
+        print("  distinct %s: %.0f" % (kind, hll_estimate(registers)))
+    for key in args.key:
+        if merged_cms is None:
+            print("  no count-min sketches to estimate key %s" % key)
+            break
+        print("  packets of %s: %d" % (key.upper(), cms_estimate(merged_cms, int(key, 16))))
+
+
+if __name__ == "__main__":
+    main()
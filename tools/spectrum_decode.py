@@ -0,0 +1,412 @@
+#!/usr/bin/env python3
+"""
+Spectrum Row Decoder
+
+Turns the compressed spectrum rows of a detector node back into per-sweep
+RSSI rows. With "spec on" every scanner prints one line per completed
+sweep:
+
+    SPEC,<scanner>,<hex frame>
+
+Feed serial logs (or stdin) to the decoder; it prints one CSV row per
+sweep with the peak RSSI in dBm of every channel (blank = never sampled,
+"quiet" = sampled only below the detection threshold):
+
+    python3 tools/spectrum_decode.py node.log > rows.csv
+    pio device monitor | python3 tools/spectrum_decode.py -
+
+Each scanner is its own stream. After a lost line the delta frames of that
+stream are dropped until its next keyframe.
+
+--benchmark replays rows through the encoder and decoder for several
+deadbands and prints the compression ratio, host encode time and largest
+reconstruction error as CSV. The rows are the ones decoded from the given
+logs, or with --synthetic N a simulated band (noise floor and hopping
+emitters). The device's own encode time is printed by "spec bench".
+
+--golden checks this codec against the golden stream it shares with the
+firmware's native unit test (test/test_spectrum), so both implementations
+are held to the same bytes.
+
+The frame format is defined in include/spectrum_codec.h.
+"""
+
+import argparse
+import random
+import sys
+import time
+
+SPEC_VERSION = 1
+SPEC_MAX_CHANNELS = 64
+SPEC_FLAG_KEYFRAME = 0x01
+SPEC_DEADBAND_STEPS = 6
+SPEC_KEYFRAME_ROWS = 32
+SPEC_QUIET = 1
+
+OCC_RSSI_MIN_DBM = -160.0
+OCC_RSSI_STEP_DB = 0.5
+FREQ_900_MIN = 902.0
+SWEEP_STEP_MHZ = 0.5
+NUM_SWEEP_CHANNELS = 52
+NOISE_DETECT_MARGIN_DB = 6.0
+
+MODULATIONS = ["LoRa", "FSK", "OOK", "Unknown"]
+
+
+def quantize(dbm):
+    """occupancyQuantize() in src/occupancy.cpp."""
+    return max(1, min(255, int(round((dbm - OCC_RSSI_MIN_DBM) / OCC_RSSI_STEP_DB)) + 1))
+
+
+def dequantize(value):
+    return None if value == 0 else OCC_RSSI_MIN_DBM + (value - 1) * OCC_RSSI_STEP_DB
+
+
+def zigzag(value):
+    return value << 1 if value >= 0 else (-value << 1) - 1
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def put_varint(out, value):
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        out.append(byte | 0x80 if value else byte)
+        if not value:
+            return
+
+
+# ============================================================================
+# Codec (mirrors src/spectrum_codec.cpp)
+# ============================================================================
+
+class Encoder:
+    """Encoder state of one stream."""
+
+    def __init__(self, deadband=SPEC_DEADBAND_STEPS, keyframe_rows=SPEC_KEYFRAME_ROWS):
+        self.deadband = deadband
+        self.keyframe_rows = max(1, keyframe_rows)
+        self.reference = [0] * SPEC_MAX_CHANNELS
+        self.since_keyframe = 0
+        self.sequence = 0
+        self.shape = None               # (tag, first, count) of the last frame
+
+    def encode(self, tag, first, row):
+        count = len(row)
+        if not 0 < count <= SPEC_MAX_CHANNELS or not 0 <= tag <= 7:
+            raise ValueError("invalid row")
+        keyframe = (self.shape != (tag, first, count) or
+                    self.since_keyframe + 1 >= self.keyframe_rows)
+
+        out = bytearray([(SPEC_VERSION << 4) | (tag << 1) | (SPEC_FLAG_KEYFRAME if keyframe else 0),
+                         self.sequence])
+        put_varint(out, first)
+        put_varint(out, count)
+
+        # reference becomes the row the decoder reconstructs
+        reference = self.reference
+        run = 0
+        for c in range(count):
+            if keyframe:
+                prediction = reference[c - 1] if c > 0 else 0
+            else:
+                prediction = reference[c]
+            value = row[c]
+            if not keyframe and value == 0:
+                value = prediction
+            delta = value - prediction
+            if value and prediction and -self.deadband <= delta <= self.deadband:
+                delta = 0
+            if delta == 0:
+                reference[c] = prediction
+                run += 1
+                continue
+            if run:
+                put_varint(out, ((run - 1) << 1) | 1)
+                run = 0
+            put_varint(out, zigzag(delta) << 1)
+            reference[c] = value
+        if run:
+            put_varint(out, ((run - 1) << 1) | 1)
+
+        self.sequence = (self.sequence + 1) & 0xFF
+        self.shape = (tag, first, count)
+        self.since_keyframe = 0 if keyframe else self.since_keyframe + 1
+        return bytes(out)
+
+
+class Decoder:
+    """Frame decoder of one stream."""
+
+    def __init__(self):
+        self.row = None                 # Last decoded row
+        self.tag = 0
+        self.first = 0
+        self.last_sequence = 0
+        self.skipped = 0
+        self.errors = 0
+
+    def decode(self, frame):
+        """Return the decoded row, or None when the frame is dropped."""
+        try:
+            return self._decode(frame)
+        except (IndexError, ValueError):
+            self.row = None
+            self.errors += 1
+            return None
+
+    def _decode(self, frame):
+        flags, sequence = frame[0], frame[1]
+        if flags >> 4 != SPEC_VERSION:
+            raise ValueError("version")
+        position = 2
+        fields = []
+        while len(fields) < 2 or position < len(frame):
+            value, shift = 0, 0
+            while True:
+                byte = frame[position]
+                position += 1
+                value |= (byte & 0x7F) << shift
+                if not byte & 0x80:
+                    break
+                shift += 7
+                if shift > 21:
+                    raise ValueError("varint")
+            fields.append(value)
+        first, count, tokens = fields[0], fields[1], fields[2:]
+        if not 0 < count <= SPEC_MAX_CHANNELS:
+            raise ValueError("count")
+
+        keyframe = bool(flags & SPEC_FLAG_KEYFRAME)
+        if not keyframe and (self.row is None or sequence != (self.last_sequence + 1) & 0xFF or
+                             first != self.first or count != len(self.row)):
+            self.row = None
+            self.skipped += 1
+            return None
+
+        work = list(self.row) if self.row is not None else [0] * count
+        work += [0] * (count - len(work))
+        position = 0
+
+        def prediction():
+            if keyframe:
+                return work[position - 1] if position > 0 else 0
+            return work[position]
+
+        for token in tokens:
+            if position >= count:
+                raise ValueError("trailing tokens")
+            if token & 1:
+                run = (token >> 1) + 1
+                if run > count - position:
+                    raise ValueError("run")
+                for _ in range(run):
+                    work[position] = prediction()
+                    position += 1
+            else:
+                value = prediction() + unzigzag(token >> 1)
+                if token == 0 or not 0 <= value <= 255:
+                    raise ValueError("delta")
+                work[position] = value
+                position += 1
+        if position != count:
+            raise ValueError("short frame")
+
+        self.row = work[:count]
+        self.tag = (flags >> 1) & 0x07
+        self.first = first
+        self.last_sequence = sequence
+        return self.row
+
+
+# Golden stream, shared with test/test_spectrum: (tag, first, row) per
+# frame, the frames an encoder with the default deadband and keyframe
+# interval produces for them, and the rows a decoder reconstructs
+GOLDEN_ROWS = [
+    (1, 4, [1, 1, 100, 104, 1, 0, 180, 1]),
+    (1, 4, [1, 1, 103, 104, 1, 1, 200, 0]),
+    (1, 4, [1, 1, 1, 104, 150, 1, 200, 1]),
+    (2, 4, [1, 1, 1, 104, 150, 1, 200, 1]),
+]
+GOLDEN_FRAMES = [
+    "1300040804018C03018A0302D005CA05",
+    "1201040809045001",
+    "12020408038A0301D40405",
+    "1503040804039C03B801D2049C069A06",
+]
+GOLDEN_DECODED = [
+    [1, 1, 100, 100, 1, 0, 180, 1],
+    [1, 1, 100, 100, 1, 1, 200, 1],
+    [1, 1, 1, 100, 150, 1, 200, 1],
+    [1, 1, 1, 104, 150, 1, 200, 1],
+]
+
+
+def check_golden():
+    """Return True if this codec reproduces the golden stream."""
+    encoder = Encoder()
+    decoder = Decoder()
+    ok = True
+    for index, ((tag, first, row), frame, decoded) in enumerate(
+            zip(GOLDEN_ROWS, GOLDEN_FRAMES, GOLDEN_DECODED)):
+        encoded = encoder.encode(tag, first, row).hex().upper()
+        result = decoder.decode(bytes.fromhex(frame))
+        if encoded != frame or result != decoded:
+            print(f"golden frame {index}: encoded {encoded}, decoded {result}", file=sys.stderr)
+            ok = False
+    return ok
+
+
+def spec_lines(stream):
+    """Yield (scanner, frame bytes) from every SPEC line in a text stream."""
+    for line in stream:
+        start = line.find("SPEC,")
+        if start < 0:
+            continue
+        parts = line[start + 5:].strip().split(",")
+        if len(parts) != 2:
+            continue
+        try:
+            yield int(parts[0]), bytes.fromhex(parts[1])
+        except ValueError:
+            continue
+
+
+def decode_logs(paths):
+    """Return the decoders and the decoded (scanner, tag, first, row) rows."""
+    decoders = {}
+    rows = []
+    for path in paths:
+        stream = sys.stdin if path == "-" else open(path, errors="replace")
+        with stream:
+            for scanner, frame in spec_lines(stream):
+                decoder = decoders.setdefault(scanner, Decoder())
+                row = decoder.decode(frame)
+                if row is not None:
+                    rows.append((scanner, decoder.tag, decoder.first, list(row)))
+    return decoders, rows
+
+
+# ============================================================================
+# Benchmark
+# ============================================================================
+
+def synthetic_rows(count, seed):
+    """Simulated band: a noise floor, a few fixed and hopping emitters.
+
+    Channels under the detection threshold are coded SPEC_QUIET, as
+    spectrumReportNote() does on the device."""
+    rng = random.Random(seed)
+    floor = [-112.0 + rng.gauss(0, 2) for _ in range(NUM_SWEEP_CHANNELS)]
+    fixed = rng.sample(range(NUM_SWEEP_CHANNELS), 3)
+    rows = []
+    for _ in range(count):
+        row = []
+        for c in range(NUM_SWEEP_CHANNELS):
+            if rng.random() < 0.1:
+                row.append(0)           # Channel skipped this sweep
+                continue
+            dbm = floor[c] + rng.gauss(0, 1.5)
+            if c in fixed:
+                dbm = max(dbm, -70.0 + rng.gauss(0, 2))
+            busy = dbm > floor[c] + NOISE_DETECT_MARGIN_DB
+            row.append(quantize(dbm) if busy else SPEC_QUIET)
+        for _ in range(2):              # Hopping emitters land on random channels
+            c = rng.randrange(NUM_SWEEP_CHANNELS)
+            row[c] = quantize(-60.0 + rng.gauss(0, 4))
+        rows.append((0, 0, 0, row))
+    return rows
+
+
+def replay(rows, deadband):
+    """Encode and decode rows; return (raw, encoded, seconds, max error)."""
+    encoders = {}
+    decoders = {}
+    raw = encoded = 0
+    seconds = 0.0
+    max_error = 0
+    for scanner, tag, first, row in rows:
+        encoder = encoders.setdefault(scanner, Encoder(deadband))
+        decoder = decoders.setdefault(scanner, Decoder())
+        start = time.perf_counter()
+        frame = encoder.encode(tag, first, row)
+        seconds += time.perf_counter() - start
+        decoded = decoder.decode(frame)
+        if decoded is None:
+            raise RuntimeError("roundtrip failed")
+        raw += len(row)
+        encoded += len(frame)
+        for value, result in zip(row, decoded):
+            if value:
+                max_error = max(max_error, abs(result - value))
+    return raw, encoded, seconds, max_error
+
+
+def benchmark(rows):
+    print("deadband,rows,raw_bytes,encoded_bytes,ratio,encode_us_per_row,max_error_steps")
+    for deadband in (0, 2, 4, 6, 8):
+        raw, encoded, seconds, max_error = replay(rows, deadband)
+        print(f"{deadband},{len(rows)},{raw},{encoded},{raw / max(encoded, 1):.2f},"
+              f"{seconds * 1e6 / max(len(rows), 1):.1f},{max_error}")
+
+
+# ============================================================================
+# Main
+# ============================================================================
+
+def print_rows(rows):
+    width = max((first + len(row) for _, _, first, row in rows), default=0)
+    header = ",".join(f"{FREQ_900_MIN + c * SWEEP_STEP_MHZ:.1f}" for c in range(width))
+    print(f"row,scanner,modulation,{header}")
+    for index, (scanner, tag, first, row) in enumerate(rows):
+        values = [""] * width
+        for c, value in enumerate(row):
+            dbm = dequantize(value)
+            if value == SPEC_QUIET:
+                values[first + c] = "quiet"
+            else:
+                values[first + c] = "" if dbm is None else f"{dbm:.1f}"
+        modulation = MODULATIONS[tag] if tag < len(MODULATIONS) else str(tag)
+        print(f"{index},{scanner},{modulation}," + ",".join(values))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode compressed spectrum rows (SPEC lines)")
+    parser.add_argument("logs", nargs="*", help="serial logs with SPEC lines ('-' for stdin)")
+    parser.add_argument("--benchmark", action="store_true",
+                        help="replay the rows through the codec for several deadbands")
+    parser.add_argument("--synthetic", type=int, metavar="N",
+                        help="benchmark N simulated rows instead of decoded ones")
+    parser.add_argument("--seed", type=int, default=1, help="simulation random seed")
+    parser.add_argument("--golden", action="store_true",
+                        help="check the codec against the golden stream of the unit test")
+    args = parser.parse_args()
+
+    if args.golden:
+        if not check_golden():
+            return 1
+        print(f"{len(GOLDEN_FRAMES)} golden frames match")
+        return 0
+
+    if args.synthetic:
+        benchmark(synthetic_rows(args.synthetic, args.seed))
+        return 0
+
+    decoders, rows = decode_logs(args.logs or ["-"])
+    if args.benchmark:
+        benchmark(rows)
+        return 0
+
+    print_rows(rows)
+    for scanner, decoder in sorted(decoders.items()):
+        if decoder.skipped or decoder.errors:
+            print(f"scanner {scanner}: {decoder.skipped} frames skipped, "
+                  f"{decoder.errors} malformed", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())